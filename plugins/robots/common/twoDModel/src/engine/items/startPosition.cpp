@@ -30,15 +30,30 @@ void StartPosition::drawItem(QPainter *painter, const QStyleOptionGraphicsItem *
 }
 
 void StartPosition::serialize(QDomElement &robotElement, QDomDocument &target) const
+{
+	writePosition(robotElement, target, scenePos(), rotation());
+}
+
+void StartPosition::deserialize(const QDomElement &robotElement)
+{
+	QPointF position = pos();
+	qreal direction = rotation();
+	readPosition(robotElement, position, direction);
+	setPos(position);
+	setRotation(direction);
+}
+
+void StartPosition::writePosition(QDomElement &robotElement, QDomDocument &target
+		, const QPointF &position, qreal direction)
 {
 	QDomElement startPositionElement = target.createElement("startPosition");
-	startPositionElement.setAttribute("startPosX", scenePos().x());
-	startPositionElement.setAttribute("startPosY", scenePos().y());
-	startPositionElement.setAttribute("direction", rotation());
+	startPositionElement.setAttribute("startPosX", position.x());
+	startPositionElement.setAttribute("startPosY", position.y());
+	startPositionElement.setAttribute("direction", direction);
 	robotElement.appendChild(startPositionElement);
 }
 
-void StartPosition::deserialize(const QDomElement &robotElement)
+void StartPosition::readPosition(const QDomElement &robotElement, QPointF &position, qreal &direction)
 {
 	const QDomElement startPositionElement = robotElement.firstChildElement("startPosition");
 	if (startPositionElement.isNull()) {
@@ -51,12 +66,11 @@ void StartPosition::deserialize(const QDomElement &robotElement)
 		const QString startPositionY = robotElement.hasAttribute("startPosY")
 				? robotElement.attribute("startPosY")
 				: robotY;
-		setX(startPositionX.toDouble());
-		setY(startPositionY.toDouble());
+		position = QPointF(startPositionX.toDouble(), startPositionY.toDouble());
 	} else {
-		setX(startPositionElement.attribute("x").toDouble());
-		setX(startPositionElement.attribute("y").toDouble());
-		setRotation(startPositionElement.attribute("direction").toDouble());
+		position = QPointF(startPositionElement.attribute("startPosX", startPositionElement.attribute("x")).toDouble()
+				, startPositionElement.attribute("startPosY", startPositionElement.attribute("y")).toDouble());
+		direction = startPositionElement.attribute("direction").toDouble();
 	}
 }
 
@@ -16,6 +16,15 @@ public:
 	void serialize(QDomElement &robotElement, QDomDocument &target) const;
 	void deserialize(const QDomElement &robotElement) override;
 
+	/// Appends start position element with given scene position and direction to @p robotElement.
+	/// Lets robot model save start position without creating graphics item.
+	static void writePosition(QDomElement &robotElement, QDomDocument &target
+			, const QPointF &position, qreal direction);
+
+	/// Reads start position from @p robotElement into @p position and @p direction. Old formats do not store
+	/// direction, then @p direction is left as is.
+	static void readPosition(const QDomElement &robotElement, QPointF &position, qreal &direction);
+
 private:
 	void drawFieldForResizeItem(QPainter* painter) override;
 	void changeDragState(qreal x, qreal y) override;
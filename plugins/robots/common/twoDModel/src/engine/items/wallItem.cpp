@@ -13,6 +13,9 @@ using namespace graphicsUtils;
 
 const int wallWidth = 10;
 
+/// Width of an area around wall segment that is considered occupied by a wall.
+const int bordersWidth = wallWidth * 3 / 2;
+
 WallItem::WallItem(const QPointF &begin, const QPointF &end)
 	: LineItem(begin, end)
 	, mDragged(false)
@@ -157,13 +160,39 @@ QPainterPath WallItem::path() const
 	return mPath;
 }
 
+QPolygonF WallItem::borders() const
+{
+	return mBorders;
+}
+
 void WallItem::recalculateBorders()
 {
+	const QPointF wallBegin = begin();
+	const QPointF wallEnd = end();
+
+	// Stroker uses square caps, so stroke of a segment is a rectangle prolonged by half of width at both ends.
+	const QLineF segment(wallBegin, wallEnd);
+	const QPointF direction = qFuzzyIsNull(segment.length())
+			? QPointF(1, 0)
+			: (wallEnd - wallBegin) / segment.length();
+	const QPointF along = direction * bordersWidth / 2;
+	const QPointF normal(-along.y(), along.x());
+	const QPolygonF borders = QPolygonF() << wallBegin - along + normal << wallEnd + along + normal
+			<< wallEnd + along - normal << wallBegin - along - normal;
+
+	if (borders == mBorders) {
+		return;
+	}
+
+	mBorders = borders;
+
 	QPainterPath wallPath;
-	wallPath.moveTo(begin());
-	wallPath.lineTo(end());
+	wallPath.moveTo(wallBegin);
+	wallPath.lineTo(wallEnd);
 
 	QPainterPathStroker stroker;
-	stroker.setWidth(wallWidth * 3 / 2);
+	stroker.setWidth(bordersWidth);
 	mPath = stroker.createStroke(wallPath);
+
+	emit bordersChanged(this);
 }
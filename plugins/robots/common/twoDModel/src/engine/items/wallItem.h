@@ -32,15 +32,23 @@ public:
 
 	QPainterPath path() const;
 
+	/// Returns the same area as path(), a rectangle around wall segment, as a polygon with 4 vertices.
+	QPolygonF borders() const;
+
+	/// Recalculates path() and borders() after wall was moved or resized. Emits bordersChanged() if they
+	/// were changed.
+	void recalculateBorders();
+
 signals:
 	void wallDragged(WallItem *item, const QPainterPath &shape, const QRectF &oldPos);
 
+	/// Emitted when collision area of a wall (path() and borders()) changes.
+	void bordersChanged(WallItem *item);
+
 protected:
 	void setPrivateData();
 
 private:
-	void recalculateBorders();
-
 	bool mDragged;
 	bool mOverlappedWithRobot;
 	QImage mImage;
@@ -49,6 +57,7 @@ private:
 	int mOldY1;
 
 	QPainterPath mPath;
+	QPolygonF mBorders;
 };
 
 }
@@ -0,0 +1,168 @@
+#include "floorCache.h"
+
+#include <algorithm>
+
+#include <QtCore/QtMath>
+#include <QtGui/QPainter>
+#include <QtWidgets/QGraphicsItem>
+#include <QtWidgets/QStyleOptionGraphicsItem>
+
+#include <qrutils/graphicsUtils/abstractItem.h>
+
+using namespace twoDModel::model;
+
+/// Margin in pixels added to item bounds when invalidating tiles, for antialiasing and pen caps.
+const int invalidationMargin = 2;
+
+FloorCache::FloorCache()
+	: mRendering(false)
+{
+}
+
+void FloorCache::addItem(QGraphicsItem *item)
+{
+	mItems << item;
+	mRects.insert(item, item->sceneBoundingRect());
+	graphicsUtils::AbstractItem * const abstractItem = dynamic_cast<graphicsUtils::AbstractItem *>(item);
+	if (abstractItem) {
+		// Other items (robot trace segments) are never changed after addition, so only these ones are tracked.
+		auto update = [this, item]() { updateItem(item); };
+		connect(abstractItem, &graphicsUtils::AbstractItem::changed, this, update);
+		connect(abstractItem, &QGraphicsObject::xChanged, this, update);
+		connect(abstractItem, &QGraphicsObject::yChanged, this, update);
+		connect(abstractItem, &QGraphicsObject::zChanged, this, update);
+		connect(abstractItem, &QGraphicsObject::rotationChanged, this, update);
+		connect(abstractItem, &QGraphicsObject::scaleChanged, this, update);
+	}
+
+	invalidate(item->sceneBoundingRect());
+}
+
+void FloorCache::removeItem(QGraphicsItem *item)
+{
+	if (!mItems.removeOne(item)) {
+		return;
+	}
+
+	graphicsUtils::AbstractItem * const abstractItem = dynamic_cast<graphicsUtils::AbstractItem *>(item);
+	if (abstractItem) {
+		disconnect(abstractItem, nullptr, this, nullptr);
+	}
+
+	invalidate(mRects.take(item));
+	invalidate(item->sceneBoundingRect());
+}
+
+void FloorCache::clear()
+{
+	for (QGraphicsItem * const item : mItems) {
+		graphicsUtils::AbstractItem * const abstractItem = dynamic_cast<graphicsUtils::AbstractItem *>(item);
+		if (abstractItem) {
+			disconnect(abstractItem, nullptr, this, nullptr);
+		}
+	}
+
+	mItems.clear();
+	mRects.clear();
+	mTiles.clear();
+}
+
+void FloorCache::updateItem(QGraphicsItem *item)
+{
+	const auto rect = mRects.find(item);
+	if (rect == mRects.end()) {
+		return;
+	}
+
+	const QRectF current = item->sceneBoundingRect();
+	invalidate(*rect);
+	invalidate(current);
+	*rect = current;
+}
+
+int FloorCache::tileCoordinate(int coordinate)
+{
+	return qFloor(static_cast<qreal>(coordinate) / tileSize);
+}
+
+qint64 FloorCache::tileKey(int x, int y)
+{
+	return (static_cast<qint64>(x) << 32) | static_cast<quint32>(y);
+}
+
+const QImage &FloorCache::tile(int x, int y) const
+{
+	const auto cached = mTiles.constFind(tileKey(x, y));
+	if (cached != mTiles.constEnd()) {
+		return *cached;
+	}
+
+	const QRectF tileRect(x * tileSize, y * tileSize, tileSize, tileSize);
+	QList<QGraphicsItem *> items;
+	for (QGraphicsItem * const item : mItems) {
+		if (item->sceneBoundingRect().adjusted(-invalidationMargin, -invalidationMargin
+				, invalidationMargin, invalidationMargin).intersects(tileRect))
+		{
+			items << item;
+		}
+	}
+
+	std::stable_sort(items.begin(), items.end(), [](QGraphicsItem *first, QGraphicsItem *second) {
+		return first->zValue() < second->zValue();
+	});
+
+	// Painting may have side effects reported as item changes (walls recalculate their borders), so tiles are
+	// not invalidated meanwhile and the image is put into the cache only when it is ready.
+	QImage image(tileSize, tileSize, QImage::Format_RGB32);
+	image.fill(Qt::white);
+	mRendering = true;
+	{
+		QPainter painter(&image);
+		painter.translate(-tileRect.topLeft());
+		for (QGraphicsItem * const item : items) {
+			QStyleOptionGraphicsItem option;
+			option.exposedRect = item->boundingRect();
+			painter.save();
+			painter.setTransform(item->sceneTransform(), true);
+			item->paint(&painter, &option, nullptr);
+			painter.restore();
+		}
+	}
+
+	mRendering = false;
+	return *mTiles.insert(tileKey(x, y), image);
+}
+
+void FloorCache::invalidate(const QRectF &rect) const
+{
+	if (mRendering) {
+		return;
+	}
+
+	const QRect bounds = rect.toAlignedRect().adjusted(-invalidationMargin, -invalidationMargin
+			, invalidationMargin, invalidationMargin);
+	const int left = tileCoordinate(bounds.left());
+	const int right = tileCoordinate(bounds.right());
+	const int top = tileCoordinate(bounds.top());
+	const int bottom = tileCoordinate(bounds.bottom());
+	if (static_cast<qint64>(right - left + 1) * (bottom - top + 1) > mTiles.size()) {
+		// Large item, it is cheaper to check all rendered tiles.
+		for (auto tile = mTiles.begin(); tile != mTiles.end(); ) {
+			const int x = static_cast<int>(tile.key() >> 32);
+			const int y = static_cast<int>(static_cast<quint32>(tile.key()));
+			if (x >= left && x <= right && y >= top && y <= bottom) {
+				tile = mTiles.erase(tile);
+			} else {
+				++tile;
+			}
+		}
+
+		return;
+	}
+
+	for (int x = left; x <= right; ++x) {
+		for (int y = top; y <= bottom; ++y) {
+			mTiles.remove(tileKey(x, y));
+		}
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QRect>
+#include <QtGui/QImage>
+
+class QGraphicsItem;
+
+namespace twoDModel {
+namespace model {
+
+/// Rasterized floor of 2D model world as seen by color and light sensors: color fields, walls and robot trace
+/// over white background, without robots, sensors, regions and grid. Floor is split into square tiles rendered
+/// lazily on first access. Each item invalidates only tiles it covers when it is added, removed, moved, resized
+/// or repainted with another pen or brush, as reported by its signals, so reading pixels is a plain lookup
+/// of ready images instead of rendering a scene.
+class FloorCache : public QObject
+{
+	Q_OBJECT
+
+public:
+	FloorCache();
+
+	/// Adds an item to the floor. Items are painted in order of their z-values, then in order of addition,
+	/// as in a scene.
+	void addItem(QGraphicsItem *item);
+
+	/// Removes an item from the floor.
+	void removeItem(QGraphicsItem *item);
+
+	/// Removes all items.
+	void clear();
+
+	/// Invalidates tiles covered by an item before and after its change. Changes of graphicsUtils::AbstractItem
+	/// are tracked automatically, other items are considered unchangeable after addition.
+	void updateItem(QGraphicsItem *item);
+
+	/// Calls visitor(uint color) for each pixel of the floor inside given rectangle in scene coordinates.
+	/// Pixels have QImage::Format_RGB32 format.
+	template<typename Visitor>
+	void forEachPixel(const QRect &rect, Visitor visitor) const
+	{
+		const int left = tileCoordinate(rect.left());
+		const int right = tileCoordinate(rect.right());
+		const int top = tileCoordinate(rect.top());
+		const int bottom = tileCoordinate(rect.bottom());
+		for (int tileY = top; tileY <= bottom; ++tileY) {
+			for (int tileX = left; tileX <= right; ++tileX) {
+				const QImage &image = tile(tileX, tileY);
+				const QRect tileRect(tileX * tileSize, tileY * tileSize, tileSize, tileSize);
+				const QRect part = (rect & tileRect).translated(-tileRect.topLeft());
+				for (int y = part.top(); y <= part.bottom(); ++y) {
+					const uint *line = reinterpret_cast<const uint *>(image.constScanLine(y));
+					for (int x = part.left(); x <= part.right(); ++x) {
+						visitor(line[x]);
+					}
+				}
+			}
+		}
+	}
+
+private:
+	/// Size of a side of a tile in pixels.
+	static const int tileSize = 128;
+
+	static int tileCoordinate(int coordinate);
+	static qint64 tileKey(int x, int y);
+
+	/// Returns rendered tile with given coordinates, renders it if needed.
+	const QImage &tile(int x, int y) const;
+
+	/// Drops tiles that intersect given rectangle in scene coordinates. Does nothing while a tile is being rendered.
+	void invalidate(const QRectF &rect) const;
+
+	QList<QGraphicsItem *> mItems;
+
+	/// Scene bounding rectangles of items at the moment of their last change, to invalidate tiles they covered.
+	QHash<QGraphicsItem *, QRectF> mRects;
+
+	mutable QHash<qint64, QImage> mTiles;
+
+	/// True while items are painted into a new tile.
+	mutable bool mRendering;
+};
+
+}
+}
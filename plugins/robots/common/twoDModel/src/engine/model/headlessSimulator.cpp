@@ -0,0 +1,201 @@
+#include "headlessSimulator.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVector>
+#include <QtWidgets/QGraphicsItem>
+#include <QtXml/QDomDocument>
+
+#include <qrkernel/settingsManager.h>
+#include <qrgui/plugins/toolPluginInterface/usedInterfaces/errorReporterInterface.h>
+
+#include "model.h"
+#include "src/engine/constraints/constraintsChecker.h"
+#include "src/engine/twoDModelEngineApi.h"
+
+using namespace twoDModel::model;
+
+namespace {
+
+/// Collects errors and warnings reported during simulation instead of showing them to user.
+class CollectingErrorReporter : public qReal::ErrorReporterInterface
+{
+public:
+	explicit CollectingErrorReporter(QStringList &messages)
+		: mMessages(messages)
+		, mWereErrors(false)
+	{
+	}
+
+	void addInformation(const QString &message, const qReal::Id &position) override
+	{
+		Q_UNUSED(message)
+		Q_UNUSED(position)
+	}
+
+	void addWarning(const QString &message, const qReal::Id &position) override
+	{
+		Q_UNUSED(position)
+		mMessages << message;
+	}
+
+	void addError(const QString &message, const qReal::Id &position) override
+	{
+		Q_UNUSED(position)
+		mMessages << message;
+		mWereErrors = true;
+	}
+
+	void addCritical(const QString &message, const qReal::Id &position) override
+	{
+		addError(message, position);
+	}
+
+	void clear() override
+	{
+		mMessages.clear();
+		clearErrors();
+	}
+
+	void clearErrors() override
+	{
+		mWereErrors = false;
+	}
+
+	bool wereErrors() override
+	{
+		return mWereErrors;
+	}
+
+private:
+	QStringList &mMessages;
+	bool mWereErrors;
+};
+
+/// Runs one simulation in a worker thread.
+class SimulationRunnable : public QRunnable
+{
+public:
+	SimulationRunnable(const SimulationTask &task, SimulationResult &result)
+		: mTask(task)
+		, mResult(result)
+	{
+	}
+
+	void run() override
+	{
+		mResult = HeadlessSimulator::simulate(mTask);
+	}
+
+private:
+	const SimulationTask &mTask;
+	SimulationResult &mResult;
+};
+
+}
+
+HeadlessSimulator::HeadlessSimulator(int threadsCount)
+	: mThreadsCount(threadsCount > 0 ? threadsCount : QThread::idealThreadCount())
+	, mLastBatchSpeed(0.0)
+{
+}
+
+SimulationResult HeadlessSimulator::simulate(const SimulationTask &task)
+{
+	SimulationResult result;
+	QElapsedTimer wallTimer;
+	wallTimer.start();
+
+	CollectingErrorReporter errorReporter(result.errors);
+	bool finished = false;
+	auto finish = [&result, &finished](SimulationResult::Verdict verdict, const QString &message) {
+		if (!finished) {
+			finished = true;
+			result.verdict = verdict;
+			result.message = message;
+		}
+	};
+
+	Model model;
+	model.initChecker(errorReporter);
+
+	// There is no scene that owns world items, so they are deleted here the same way as scene does it.
+	QObject::connect(&model.worldModel(), &WorldModel::itemRemoved, [](QGraphicsItem *item) { delete item; });
+
+	constraints::ConstraintsChecker &checker = model.checker();
+	QObject::connect(&checker, &constraints::ConstraintsChecker::success, [&finish]() {
+		finish(SimulationResult::Verdict::success, QString());
+	});
+	QObject::connect(&checker, &constraints::ConstraintsChecker::fail, [&finish](const QString &message) {
+		finish(SimulationResult::Verdict::fail, message);
+	});
+	QObject::connect(&checker, &constraints::ConstraintsChecker::checkerError, [&finish](const QString &message) {
+		finish(SimulationResult::Verdict::checkerError, message);
+	});
+
+	if (task.setUp) {
+		task.setUp(model);
+	}
+
+	QDomDocument world;
+	world.setContent(task.worldXml);
+	model.deserialize(world);
+	if (errorReporter.wereErrors()) {
+		// Constraints were not parsed, there is nothing to check.
+		finish(SimulationResult::Verdict::checkerError, result.errors.join("\n"));
+	}
+
+	twoDModel::TwoDModelEngineApi engine(model, nullptr);
+	Timeline &timeline = model.timeline();
+	timeline.startManually();
+	const quint64 startTimestamp = timeline.timestamp();
+	while (!finished && timeline.timestamp() - startTimestamp < task.timeLimit) {
+		if (task.controller) {
+			task.controller(model, engine, timeline.timestamp() - startTimestamp);
+		}
+
+		timeline.step();
+	}
+
+	timeline.stop();
+
+	result.modelTime = timeline.timestamp() - startTimestamp;
+	model.worldModel().clear();
+
+	result.wallTime = wallTimer.elapsed();
+	return result;
+}
+
+QList<SimulationResult> HeadlessSimulator::simulate(const QList<SimulationTask> &tasks)
+{
+	// Settings manager is created lazily, so it must be created here, not concurrently by workers.
+	qReal::SettingsManager::instance();
+
+	QVector<SimulationResult> results(tasks.size());
+	QElapsedTimer wallTimer;
+	wallTimer.start();
+
+	QThreadPool pool;
+	pool.setMaxThreadCount(mThreadsCount);
+	for (int i = 0; i < tasks.size(); ++i) {
+		pool.start(new SimulationRunnable(tasks[i], results[i]));
+	}
+
+	pool.waitForDone();
+
+	quint64 totalModelTime = 0;
+	for (const SimulationResult &result : results) {
+		totalModelTime += result.modelTime;
+	}
+
+	const qint64 elapsed = qMax<qint64>(1, wallTimer.elapsed());
+	mLastBatchSpeed = static_cast<qreal>(totalModelTime) / elapsed;
+	return results.toList();
+}
+
+qreal HeadlessSimulator::lastBatchSpeed() const
+{
+	return mLastBatchSpeed;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <functional>
+
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+namespace twoDModel {
+
+namespace engine {
+class TwoDModelEngineInterface;
+}
+
+namespace model {
+
+class Model;
+
+/// Description of one independent 2D model simulation.
+struct SimulationTask
+{
+	/// Saved 2D model: world, robots and constraints, in the same format as Model::serialize() produces.
+	/// Kept as a string since QDomDocument can not be shared between threads.
+	QString worldXml;
+
+	/// Simulation stops after this amount of model time in ms if constraints checker did not stop it before.
+	quint64 timeLimit = 0;
+
+	/// Called before world is loaded, may add robot models of a needed kit to a model. Robots described in
+	/// saved world but not added here will be created with null robot models.
+	std::function<void(Model &model)> setUp;
+
+	/// Called before each cycle of a model time with current timestamp, plays the role of robot program:
+	/// reads sensors and sets motors of robots of a model. Engine works with the first robot of a model and
+	/// computes sensor readings from the world model, it has no display.
+	std::function<void(Model &model, engine::TwoDModelEngineInterface &engine, quint64 timestamp)> controller;
+};
+
+/// Result of one simulation.
+struct SimulationResult
+{
+	enum class Verdict
+	{
+		/// Constraints checker reported success.
+		success
+		/// Constraints checker reported failure, message contains its reason.
+		, fail
+		/// Constraints program contains errors, message contains them.
+		, checkerError
+		/// Time limit has passed without verdict from constraints checker.
+		, timeout
+	};
+
+	Verdict verdict = Verdict::timeout;
+	QString message;
+
+	/// Errors and warnings reported by model during simulation.
+	QStringList errors;
+
+	/// Model time simulated, in ms.
+	quint64 modelTime = 0;
+
+	/// Real time spent on simulation, in ms.
+	qint64 wallTime = 0;
+};
+
+/// Runs 2D model simulations without user interface: steps timeline, robots, physics engines and constraints
+/// checker of a model in a loop, as fast as possible and independently of Qt event loop. So results depend only
+/// on a task, unless realistic sensors or motors noise is enabled in settings. Model is driven only by
+/// Timeline::step(), no timers, scenes or views are created, world items are used only as world model data. Many independent worlds can be
+/// simulated in parallel on a thread pool, each world is created, run and destroyed inside one worker thread.
+class HeadlessSimulator
+{
+public:
+	/// @param threadsCount - maximal number of simulations run simultaneously, ideal thread count by default.
+	explicit HeadlessSimulator(int threadsCount = 0);
+
+	/// Runs one simulation in calling thread.
+	static SimulationResult simulate(const SimulationTask &task);
+
+	/// Runs simulations in parallel and waits for all of them. Returns results in order of tasks.
+	QList<SimulationResult> simulate(const QList<SimulationTask> &tasks);
+
+	/// Returns simulation speed of the last batch run by simulate(tasks): seconds of model time simulated
+	/// in all worlds per second of real time.
+	qreal lastBatchSpeed() const;
+
+private:
+	int mThreadsCount;
+	qreal mLastBatchSpeed;
+};
+
+}
+}
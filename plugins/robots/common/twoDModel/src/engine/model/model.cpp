@@ -23,8 +23,7 @@ Model::~Model()
 void Model::init(qReal::ErrorReporterInterface &errorReporter
 		, kitBase::InterpreterControlInterface &interpreterControl)
 {
-	mErrorReporter = &errorReporter;
-	mChecker.reset(new constraints::ConstraintsChecker(errorReporter, *this));
+	initChecker(errorReporter);
 	connect(mChecker.data(), &constraints::ConstraintsChecker::success, [&]() {
 		errorReporter.addInformation(tr("The task is accomplished!"));
 		interpreterControl.stopRobot();
@@ -38,6 +37,17 @@ void Model::init(qReal::ErrorReporterInterface &errorReporter
 	});
 }
 
+void Model::initChecker(qReal::ErrorReporterInterface &errorReporter)
+{
+	mErrorReporter = &errorReporter;
+	mChecker.reset(new constraints::ConstraintsChecker(errorReporter, *this));
+}
+
+twoDModel::constraints::ConstraintsChecker &Model::checker()
+{
+	return *mChecker;
+}
+
 WorldModel &Model::worldModel()
 {
 	return mWorldModel;
@@ -35,6 +35,13 @@ public:
 	void init(qReal::ErrorReporterInterface &errorReporter
 			, kitBase::InterpreterControlInterface &interpreterControl);
 
+	/// Creates constraints checker without binding it to interpreter, checker signals are to be handled by caller.
+	/// Used when model runs without user interface. Called by init().
+	void initChecker(qReal::ErrorReporterInterface &errorReporter);
+
+	/// Returns constraints checker, shall be called only after initialization.
+	constraints::ConstraintsChecker &checker();
+
 	/// Returns a reference to a world map.
 	WorldModel &worldModel();
 
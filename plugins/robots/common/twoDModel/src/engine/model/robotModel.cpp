@@ -35,7 +35,8 @@ RobotModel::RobotModel(robotModel::TwoDRobotModel &robotModel
 	, mIsOnTheGround(true)
 	, mMarker(Qt::transparent)
 	, mPhysicsEngine(nullptr)
-	, mStartPositionMarker(new items::StartPosition)
+	, mStartDirection(0)
+	, mStartPositionMarker(nullptr)
 {
 	reinit();
 }
@@ -177,6 +178,17 @@ QPointF RobotModel::rotationCenter() const
 	return QPointF(mPos.x() + robotWidth / 2, mPos.y() + robotHeight / 2);
 }
 
+QPair<QPointF, qreal> RobotModel::sensorPositionAndDirection(const PortInfo &port) const
+{
+	// Sensor items are children of robot item rotated around rotatePoint, so they are mapped the same way.
+	QTransform transform;
+	transform.translate(rotationCenter().x(), rotationCenter().y());
+	transform.rotate(mAngle);
+	transform.translate(-rotatePoint.x(), -rotatePoint.y());
+	const QPointF position = transform.map(mSensorsConfiguration.position(port));
+	return { position, mSensorsConfiguration.direction(port) + mAngle };
+}
+
 QPainterPath RobotModel::robotBoundingPath() const
 {
 	QPainterPath path;
@@ -326,7 +338,12 @@ QDomElement RobotModel::serialize(QDomDocument &target) const
 	robot.setAttribute("position", QString::number(mPos.x()) + ":" + QString::number(mPos.y()));
 	robot.setAttribute("direction", mAngle);
 	mSensorsConfiguration.serialize(robot, target);
-	mStartPositionMarker->serialize(robot, target);
+	if (mStartPositionMarker) {
+		mStartPositionMarker->serialize(robot, target);
+	} else {
+		items::StartPosition::writePosition(robot, target, mStartPosition, mStartDirection);
+	}
+
 	return robot;
 }
 
@@ -339,7 +356,12 @@ void RobotModel::deserialize(const QDomElement &robotElement)
 	onRobotReturnedOnGround();
 	setPosition(QPointF(x, y));
 	setRotation(robotElement.attribute("direction", "0").toDouble());
-	mStartPositionMarker->deserialize(robotElement);
+	items::StartPosition::readPosition(robotElement, mStartPosition, mStartDirection);
+	if (mStartPositionMarker) {
+		mStartPositionMarker->setPos(mStartPosition);
+		mStartPositionMarker->setRotation(mStartDirection);
+	}
+
 	nextFragment();
 }
 
@@ -378,5 +400,11 @@ int RobotModel::varySpeed(const int speed) const
 
 QGraphicsItem *RobotModel::startPositionMarker() const
 {
+	if (!mStartPositionMarker) {
+		mStartPositionMarker = new items::StartPosition;
+		mStartPositionMarker->setPos(mStartPosition);
+		mStartPositionMarker->setRotation(mStartDirection);
+	}
+
 	return mStartPositionMarker;
 }
@@ -94,7 +94,13 @@ public:
 
 	/// Returns a position of the center of the robot in scene coordinates.
 	QPointF rotationCenter() const;
+
+	/// Returns scene position and direction of a sensor on a given port, computed from robot position and
+	/// sensors configuration, so sensors can be read without graphical representation of a robot.
+	QPair<QPointF, qreal> sensorPositionAndDirection(const kitBase::robotModel::PortInfo &port) const;
+
 	/// Returns the item whose scene position will determine robot`s start position.
+	/// The item is created on first call, until then start position is kept by model itself.
 	/// Transfers ownership.
 	QGraphicsItem *startPositionMarker() const;
 
@@ -164,7 +170,9 @@ private:
 
 	physics::PhysicsEngineBase *mPhysicsEngine;
 
-	items::StartPosition *mStartPositionMarker;  // Transfers ownership to QGraphicsScene
+	QPointF mStartPosition;
+	qreal mStartDirection;
+	mutable items::StartPosition *mStartPositionMarker;  // Transfers ownership to QGraphicsScene
 };
 
 }
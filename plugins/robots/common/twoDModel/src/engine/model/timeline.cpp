@@ -1,4 +1,5 @@
 #include <QtCore/QDateTime>
+#include <QtCore/QTimer>
 
 #include "timeline.h"
 #include "modelTimer.h"
@@ -7,12 +8,12 @@ using namespace twoDModel::model;
 
 Timeline::Timeline(QObject *parent)
 	: QObject(parent)
+	, mTimer(nullptr)
 	, mSpeedFactor(normalSpeedFactor)
 	, mCyclesCount(0)
 	, mIsStarted(false)
+	, mTimestamp(0)
 {
-	connect(&mTimer, SIGNAL(timeout()), this, SLOT(onTimer()));
-	mTimer.setInterval(defaultRealTimeInterval);
 }
 
 void Timeline::start()
@@ -24,6 +25,15 @@ void Timeline::start()
 	}
 }
 
+void Timeline::startManually()
+{
+	if (!mIsStarted) {
+		mIsStarted = true;
+		emit started();
+		emit nextFrame();
+	}
+}
+
 void Timeline::stop()
 {
 	if (mIsStarted) {
@@ -35,7 +45,7 @@ void Timeline::stop()
 void Timeline::onTimer()
 {
 	if (!mIsStarted) {
-		mTimer.stop();
+		mTimer->stop();
 		return;
 	}
 
@@ -44,7 +54,7 @@ void Timeline::onTimer()
 		emit tick();
 		++mCyclesCount;
 		if (mCyclesCount >= mSpeedFactor) {
-			mTimer.stop();
+			mTimer->stop();
 			mCyclesCount = 0;
 			const int msFromFrameStart = static_cast<int>(QDateTime::currentMSecsSinceEpoch() - mFrameStartTimestamp);
 			const int pauseBeforeFrameEnd = mFrameLength - msFromFrameStart;
@@ -62,8 +72,29 @@ void Timeline::gotoNextFrame()
 {
 	emit nextFrame();
 	mFrameStartTimestamp = QDateTime::currentMSecsSinceEpoch();
-	if (!mTimer.isActive()) {
-		mTimer.start();
+	if (!mTimer) {
+		mTimer = new QTimer(this);
+		mTimer->setInterval(defaultRealTimeInterval);
+		connect(mTimer, SIGNAL(timeout()), this, SLOT(onTimer()));
+	}
+
+	if (!mTimer->isActive()) {
+		mTimer->start();
+	}
+}
+
+void Timeline::step()
+{
+	if (!mIsStarted) {
+		return;
+	}
+
+	mTimestamp += timeInterval;
+	emit tick();
+	++mCyclesCount;
+	if (mCyclesCount >= mSpeedFactor) {
+		mCyclesCount = 0;
+		emit nextFrame();
 	}
 }
 
@@ -84,7 +115,10 @@ utils::AbstractTimer *Timeline::produceTimer()
 
 void Timeline::setImmediateMode(bool immediateMode)
 {
-	mTimer.setInterval(immediateMode ? 0 : defaultRealTimeInterval);
+	if (mTimer) {
+		mTimer->setInterval(immediateMode ? 0 : defaultRealTimeInterval);
+	}
+
 	setSpeedFactor(immediateMode ? immediateSpeedFactor : normalSpeedFactor);
 	mFrameLength = immediateMode ? 0 : defaultFrameLength;
 }
@@ -1,9 +1,11 @@
 #pragma once
 
-#include <QtCore/QTimer>
+#include <QtCore/QObject>
 
 #include "utils/timelineInterface.h"
 
+class QTimer;
+
 namespace twoDModel {
 namespace model {
 
@@ -34,6 +36,14 @@ public:
 	/// Thus the immediate process modeling may be performed in background.
 	void setImmediateMode(bool immediateMode);
 
+	/// Synchronously advances model time by one cycle emitting tick(), and emits nextFrame() after each
+	/// speedFactor() cycles, the same way timer does, but without Qt event loop and real time delays.
+	/// Used by headless simulation, does nothing if timeline is not started.
+	void step();
+
+	/// Starts timeline without real time timer, so model time advances only by step() calls.
+	void startManually();
+
 public slots:
 	void start();
 	void stop();
@@ -56,7 +66,7 @@ private:
 	static const int defaultRealTimeInterval = 0;
 	static const int ticksPerCycle = 3;
 
-	QTimer mTimer;
+	QTimer *mTimer;  // Has ownership. Created on first real time start, so manual stepping needs no timers.
 	int mSpeedFactor;
 	int mCyclesCount;
 	qint64 mFrameStartTimestamp;
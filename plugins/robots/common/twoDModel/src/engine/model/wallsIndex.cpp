@@ -0,0 +1,227 @@
+#include "wallsIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QSet>
+#include <QtCore/QtMath>
+
+#include "src/engine/items/wallItem.h"
+
+using namespace twoDModel;
+using namespace model;
+
+/// Size of a grid cell in pixels, about the length of a typical wall.
+const qreal cellSize = 100.0;
+
+namespace {
+
+int cellCoordinate(qreal coordinate)
+{
+	return static_cast<int>(qFloor(coordinate / cellSize));
+}
+
+qint64 cellKey(int x, int y)
+{
+	return (static_cast<qint64>(x) << 32) | static_cast<quint32>(y);
+}
+
+qreal crossProduct(const QPointF &first, const QPointF &second)
+{
+	return first.x() * second.y() - first.y() * second.x();
+}
+
+/// Clips a convex polygon by a half-plane of points p with crossProduct(p, boundary) * side >= 0
+/// (Sutherland-Hodgman algorithm for one clipping edge going through the origin).
+QPolygonF clip(const QPolygonF &polygon, const QPointF &boundary, qreal side)
+{
+	QPolygonF result;
+	for (int i = 0; i < polygon.size(); ++i) {
+		const QPointF &current = polygon[i];
+		const QPointF &next = polygon[(i + 1) % polygon.size()];
+		const qreal currentSide = crossProduct(current, boundary) * side;
+		const qreal nextSide = crossProduct(next, boundary) * side;
+		if (currentSide >= 0) {
+			result << current;
+		}
+
+		if ((currentSide < 0 && nextSide > 0) || (currentSide > 0 && nextSide < 0)) {
+			result << current + (next - current) * (currentSide / (currentSide - nextSide));
+		}
+	}
+
+	return result;
+}
+
+qreal distanceToSegment(const QPointF &begin, const QPointF &end)
+{
+	const QPointF segment = end - begin;
+	const qreal lengthSquared = QPointF::dotProduct(segment, segment);
+	const qreal t = qFuzzyIsNull(lengthSquared)
+			? 0.0
+			: qBound(0.0, -QPointF::dotProduct(begin, segment) / lengthSquared, 1.0);
+	const QPointF nearest = begin + segment * t;
+	return qSqrt(QPointF::dotProduct(nearest, nearest));
+}
+
+QPointF directionVector(qreal degrees)
+{
+	const qreal radians = qDegreesToRadians(degrees);
+	return QPointF(qCos(radians), qSin(radians));
+}
+
+}
+
+template<typename Function>
+void WallsIndex::forEachCell(const QRectF &rect, Function function) const
+{
+	const int left = cellCoordinate(rect.left());
+	const int right = cellCoordinate(rect.right());
+	const int top = cellCoordinate(rect.top());
+	const int bottom = cellCoordinate(rect.bottom());
+	for (int x = left; x <= right; ++x) {
+		for (int y = top; y <= bottom; ++y) {
+			function(cellKey(x, y));
+		}
+	}
+}
+
+WallsIndex::WallsIndex()
+	: mNextOrder(0)
+{
+}
+
+void WallsIndex::update(items::WallItem *wall)
+{
+	const auto existing = mEntries.constFind(wall);
+	const int order = existing == mEntries.constEnd() ? mNextOrder++ : existing->order;
+	remove(wall);
+
+	Entry entry;
+	entry.borders = wall->borders();
+	entry.path = wall->path();
+	entry.boundingRect = entry.borders.boundingRect();
+	entry.order = order;
+	mEntries.insert(wall, entry);
+
+	forEachCell(entry.boundingRect, [this, wall](qint64 key) {
+		mCells[key] << wall;
+	});
+}
+
+void WallsIndex::remove(items::WallItem *wall)
+{
+	const auto entry = mEntries.find(wall);
+	if (entry == mEntries.end()) {
+		return;
+	}
+
+	forEachCell(entry->boundingRect, [this, wall](qint64 key) {
+		QList<items::WallItem *> &cell = mCells[key];
+		cell.removeOne(wall);
+		if (cell.isEmpty()) {
+			mCells.remove(key);
+		}
+	});
+
+	mEntries.erase(entry);
+}
+
+void WallsIndex::clear()
+{
+	mEntries.clear();
+	mCells.clear();
+	mNextOrder = 0;
+}
+
+QList<items::WallItem *> WallsIndex::walls(const QRectF &rect) const
+{
+	QSet<items::WallItem *> result;
+	const auto collect = [this, &rect, &result](qint64 key) {
+		for (items::WallItem * const wall : mCells.value(key)) {
+			if (mEntries.constFind(wall)->boundingRect.intersects(rect)) {
+				result << wall;
+			}
+		}
+	};
+
+	const qint64 cellsInRect = static_cast<qint64>(cellCoordinate(rect.right()) - cellCoordinate(rect.left()) + 1)
+			* (cellCoordinate(rect.bottom()) - cellCoordinate(rect.top()) + 1);
+	if (cellsInRect > mCells.size()) {
+		// Huge rectangle, it is cheaper to look through all non-empty cells.
+		for (auto cell = mCells.constBegin(); cell != mCells.constEnd(); ++cell) {
+			collect(cell.key());
+		}
+	} else {
+		forEachCell(rect, collect);
+	}
+
+	QList<items::WallItem *> sorted = result.toList();
+	std::sort(sorted.begin(), sorted.end(), [this](items::WallItem *first, items::WallItem *second) {
+		return mEntries.constFind(first)->order < mEntries.constFind(second)->order;
+	});
+
+	return sorted;
+}
+
+bool WallsIndex::intersects(const QPainterPath &path) const
+{
+	for (items::WallItem * const wall : walls(path.boundingRect())) {
+		if (mEntries.constFind(wall)->path.intersects(path)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+qreal WallsIndex::distanceInSector(const QPointF &position, qreal direction, qreal halfAngle, qreal radius) const
+{
+	// Sum of sensor and robot rotations may be out of [0, 360), but axes below are checked only in that range.
+	direction = std::fmod(direction, 360);
+	if (direction < 0) {
+		direction += 360;
+	}
+
+	const QPointF from = directionVector(direction - halfAngle);
+	const QPointF to = directionVector(direction + halfAngle);
+
+	// Bounding rectangle of a sector: its apex, ends of its arc and extreme points of a circle lying on the arc.
+	QPolygonF sectorPoints = QPolygonF() << position << position + from * radius << position + to * radius;
+	for (int axis = 0; axis <= 360; axis += 90) {
+		if (axis > direction - halfAngle && axis < direction + halfAngle) {
+			sectorPoints << position + directionVector(axis) * radius;
+		}
+	}
+
+	qreal result = -1;
+	for (items::WallItem * const wall : walls(sectorPoints.boundingRect())) {
+		const QPolygonF borders = mEntries.constFind(wall)->borders.translated(-position);
+		const qreal distance = distanceInWedge(borders, from, to);
+		if (distance >= 0 && distance <= radius && (result < 0 || distance < result)) {
+			result = distance;
+		}
+	}
+
+	return result;
+}
+
+qreal WallsIndex::distanceInWedge(const QPolygonF &polygon, const QPointF &from, const QPointF &to)
+{
+	if (polygon.containsPoint(QPointF(), Qt::OddEvenFill)) {
+		return 0;
+	}
+
+	// Wedge is an intersection of half-planes to the one side of "from" ray and to the other side of "to" ray.
+	const QPolygonF clipped = clip(clip(polygon, from, -1), to, 1);
+	if (clipped.isEmpty()) {
+		return -1;
+	}
+
+	qreal result = distanceToSegment(clipped.last(), clipped.first());
+	for (int i = 0; i + 1 < clipped.size(); ++i) {
+		result = qMin(result, distanceToSegment(clipped[i], clipped[i + 1]));
+	}
+
+	return result;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QRectF>
+#include <QtGui/QPainterPath>
+#include <QtGui/QPolygonF>
+
+namespace twoDModel {
+
+namespace items {
+class WallItem;
+}
+
+namespace model {
+
+/// Uniform grid over walls of 2D model world. Each wall is registered in all cells its bounding rectangle
+/// overlaps, so queries test only walls near the area of interest instead of all walls in the world.
+/// Keeps its own copy of walls geometry, so it shall be notified by update() about wall movements.
+class WallsIndex
+{
+public:
+	WallsIndex();
+
+	/// Adds a wall to the index or updates its geometry if it is already there.
+	void update(items::WallItem *wall);
+
+	/// Removes a wall from the index.
+	void remove(items::WallItem *wall);
+
+	/// Removes all walls.
+	void clear();
+
+	/// Returns walls whose bounding rectangles intersect given rectangle, in order of their addition to index.
+	QList<items::WallItem *> walls(const QRectF &rect) const;
+
+	/// Returns true if given path intersects some wall.
+	bool intersects(const QPainterPath &path) const;
+
+	/// Returns the distance from a given point to the nearest wall point lying inside a circular sector.
+	/// @param position - apex of a sector.
+	/// @param direction - direction of sector bisector in degrees, clockwise from X axis as in scene, any value.
+	/// @param halfAngle - half of sector angle in degrees, less than 90.
+	/// @param radius - sector radius.
+	/// @returns distance or -1 if no wall intersects the sector.
+	qreal distanceInSector(const QPointF &position, qreal direction, qreal halfAngle, qreal radius) const;
+
+private:
+	struct Entry
+	{
+		QPolygonF borders;
+		QPainterPath path;
+		QRectF boundingRect;
+
+		/// Sequence number of a wall in index, makes order of query results independent of hashing.
+		int order;
+	};
+
+	/// Calls given function for each cell overlapped by a rectangle.
+	template<typename Function>
+	void forEachCell(const QRectF &rect, Function function) const;
+
+	/// Returns the distance from the origin to the nearest point of convex polygon part that lies inside
+	/// a wedge between rays with given directions, or -1 if there is no such part.
+	static qreal distanceInWedge(const QPolygonF &polygon, const QPointF &from, const QPointF &to);
+
+	QHash<items::WallItem *, Entry> mEntries;
+	QHash<qint64, QList<items::WallItem *>> mCells;
+	int mNextOrder;
+};
+
+}
+}
@@ -1,5 +1,6 @@
 #include <QtGui/QTransform>
 #include <QtCore/QStringList>
+#include <QtCore/QtMath>
 
 #include "constants.h"
 #include "worldModel.h"
@@ -15,6 +16,9 @@
 using namespace twoDModel;
 using namespace model;
 
+/// Half of the angle of sonar scanning region in degrees.
+const qreal sonarHalfAngle = 10.0;
+
 #ifdef D2_MODEL_FRAMES_DEBUG
 #include <QtWidgets/QGraphicsPathItem>
 QGraphicsPathItem *debugPath = nullptr;
@@ -26,33 +30,15 @@ WorldModel::WorldModel()
 
 int WorldModel::sonarReading(const QPointF &position, qreal direction) const
 {
-	int maxSonarRangeCms = 255;
-	int minSonarRangeCms = 0;
-	int currentRangeInCm = (minSonarRangeCms + maxSonarRangeCms) / 2;
-
-	const QPainterPath wallPath = buildWallPath();
-	if (!checkSonarDistance(maxSonarRangeCms, position, direction, wallPath)) {
+	const int maxSonarRangeCms = 255;
+	const qreal distance = mWallsIndex.distanceInSector(position, direction, sonarHalfAngle
+			, maxSonarRangeCms * pixelsInCm);
+	if (distance < 0) {
 		return maxSonarRangeCms;
 	}
 
-	for ( ; minSonarRangeCms < maxSonarRangeCms;
-			currentRangeInCm = (minSonarRangeCms + maxSonarRangeCms) / 2)
-	{
-		if (checkSonarDistance(currentRangeInCm, position, direction, wallPath)) {
-			maxSonarRangeCms = currentRangeInCm;
-		} else {
-			minSonarRangeCms = currentRangeInCm + 1;
-		}
-	}
-
-	return currentRangeInCm;
-}
-
-bool WorldModel::checkSonarDistance(const int distance, const QPointF &position
-		, const qreal direction, const QPainterPath &wallPath) const
-{
-	const QPainterPath rayPath = sonarScanningRegion(position, direction, distance);
-	return rayPath.intersects(wallPath);
+	// Rounding up, the same as the smallest scanning region that touches some wall.
+	return qBound(0, qCeil(distance / pixelsInCm), maxSonarRangeCms);
 }
 
 QPainterPath WorldModel::sonarScanningRegion(const QPointF &position, int range) const
@@ -62,7 +48,7 @@ QPainterPath WorldModel::sonarScanningRegion(const QPointF &position, int range)
 
 QPainterPath WorldModel::sonarScanningRegion(const QPointF &position, qreal direction, int range) const
 {
-	const qreal rayWidthDegrees = 10.0;
+	const qreal rayWidthDegrees = sonarHalfAngle;
 	const qreal rangeInPixels = range * pixelsInCm;
 
 	QPainterPath rayPath;
@@ -94,7 +80,12 @@ bool WorldModel::checkCollision(const QPainterPath &path) const
 	}
 #endif
 
-	return buildWallPath().intersects(path);
+	return mWallsIndex.intersects(path);
+}
+
+QList<items::WallItem *> WorldModel::wallsNear(const QRectF &rect) const
+{
+	return mWallsIndex.walls(rect);
 }
 
 QList<items::WallItem *> const &WorldModel::walls() const
@@ -105,20 +96,38 @@ QList<items::WallItem *> const &WorldModel::walls() const
 void WorldModel::addWall(items::WallItem *wall)
 {
 	mWalls.append(wall);
+	wall->recalculateBorders();
+	mWallsIndex.update(wall);
+	mFloor.addItem(wall);
+	connect(wall, &items::WallItem::bordersChanged, this, &WorldModel::onWallBordersChanged);
 	emit wallAdded(wall);
 }
 
 void WorldModel::removeWall(items::WallItem *wall)
 {
 	mWalls.removeOne(wall);
+	disconnect(wall, &items::WallItem::bordersChanged, this, &WorldModel::onWallBordersChanged);
+	mWallsIndex.remove(wall);
+	mFloor.removeItem(wall);
 	emit itemRemoved(wall);
 }
 
+void WorldModel::onWallBordersChanged(items::WallItem *wall)
+{
+	mWallsIndex.update(wall);
+	mFloor.updateItem(wall);
+}
+
 QList<items::ColorFieldItem *> const &WorldModel::colorFields() const
 {
 	return mColorFields;
 }
 
+const FloorCache &WorldModel::floor() const
+{
+	return mFloor;
+}
+
 int WorldModel::wallsCount() const
 {
 	return mWalls.count();
@@ -132,12 +141,14 @@ items::WallItem *WorldModel::wallAt(int index) const
 void WorldModel::addColorField(items::ColorFieldItem *colorField)
 {
 	mColorFields.append(colorField);
+	mFloor.addItem(colorField);
 	emit colorItemAdded(colorField);
 }
 
 void WorldModel::removeColorField(items::ColorFieldItem *colorField)
 {
 	mColorFields.removeOne(colorField);
+	mFloor.removeItem(colorField);
 	emit itemRemoved(colorField);
 }
 
@@ -174,6 +185,7 @@ void WorldModel::appendRobotTrace(const QPen &pen, const QPointF &begin, const Q
 	}
 
 	mRobotTrace << traceItem;
+	mFloor.addItem(traceItem);
 	emit otherItemAdded(traceItem);
 }
 
@@ -182,6 +194,7 @@ void WorldModel::clearRobotTrace()
 	while (!mRobotTrace.isEmpty()) {
 		QGraphicsLineItem * const toRemove = mRobotTrace.first();
 		mRobotTrace.removeOne(toRemove);
+		mFloor.removeItem(toRemove);
 		emit itemRemoved(toRemove);
 	}
 
@@ -190,7 +203,6 @@ void WorldModel::clearRobotTrace()
 
 QPainterPath WorldModel::buildWallPath() const
 {
-	/// @todo Maintain a cache for this.
 	QPainterPath wallPath;
 
 	for (items::WallItem *wall : mWalls) {
@@ -8,6 +8,9 @@
 #include <QtWidgets/QGraphicsLineItem>
 #include <QtXml/QDomDocument>
 
+#include "floorCache.h"
+#include "wallsIndex.h"
+
 class QGraphicsItem;
 
 namespace twoDModel {
@@ -39,11 +42,17 @@ public:
 	/// Checks if the given path intersects some wall.
 	bool checkCollision(const QPainterPath &path) const;
 
+	/// Returns walls that may intersect given rectangle, that are walls whose bounding rectangles intersect it.
+	QList<items::WallItem *> wallsNear(const QRectF &rect) const;
+
 	/// Returns a list of walls in the world model.
 	QList<items::WallItem *> const &walls() const;
 
 	QList<items::ColorFieldItem *> const &colorFields() const;
 
+	/// Returns rasterized floor of the world for color and light sensors.
+	const FloorCache &floor() const;
+
 	int wallsCount() const;
 	items::WallItem *wallAt(int index) const;
 	void addWall(items::WallItem *wall);
@@ -83,13 +92,16 @@ signals:
 	/// Emitted when robot trace is non-empty any more or was cleared from the floor.
 	void robotTraceAppearedOrDisappeared(bool appeared);
 
+private slots:
+	void onWallBordersChanged(items::WallItem *wall);
+
 private:
-	/// Returns true if ray intersects some wall.
-	bool checkSonarDistance(const int distance, const QPointF &position
-			, const qreal direction, const QPainterPath &wallPath) const;
+	/// Returns united area of all walls, used for debug drawing.
 	QPainterPath buildWallPath() const;
 
 	QList<items::WallItem *> mWalls;
+	WallsIndex mWallsIndex;
+	FloorCache mFloor;
 	QList<items::ColorFieldItem *> mColorFields;
 	QList<QGraphicsLineItem *> mRobotTrace;
 	QList<items::RegionItem *> mRegions;
@@ -17,14 +17,12 @@
 #include "model/constants.h"
 
 #include "twoDModel/engine/view/d2ModelWidget.h"
-#include "view/d2ModelScene.h"
-#include "view/robotItem.h"
 
 using namespace twoDModel;
 using namespace kitBase::robotModel;
 using namespace twoDModel::model;
 
-TwoDModelEngineApi::TwoDModelEngineApi(model::Model &model, view::D2ModelWidget &view)
+TwoDModelEngineApi::TwoDModelEngineApi(model::Model &model, view::D2ModelWidget *view)
 	: mModel(model)
 	, mView(view)
 {
@@ -83,15 +81,14 @@ int TwoDModelEngineApi::spoilSonarReading(const int distance) const
 
 int TwoDModelEngineApi::readColorSensor(const PortInfo &port) const
 {
-	const QImage image = printColorSensor(port);
+	const QRect rect = sensorFootprint(port);
+	const bool realisticSensors = mModel.settings().realisticSensors();
 	QHash<uint, int> countsColor;
+	mModel.worldModel().floor().forEachPixel(rect, [this, realisticSensors, &countsColor](uint color) {
+		++countsColor[realisticSensors ? spoilColor(color) : color];
+	});
 
-	const uint *data = reinterpret_cast<const uint *>(image.bits());
-	const int n = image.byteCount() / 4;
-	for (int i = 0; i < n; ++i) {
-		const uint color = mModel.settings().realisticSensors() ? spoilColor(data[i]) : data[i];
-		++countsColor[color];
-	}
+	const int n = rect.width() * rect.height();
 
 	if (mModel.robotModels()[0]->configuration().type(port).isA<robotParts::ColorSensorFull>()) {
 		return readColorFullSensor(countsColor);
@@ -125,43 +122,17 @@ uint TwoDModelEngineApi::spoilColor(const uint color) const
 	return ((r & 0xFF) << 16) + ((g & 0xFF) << 8) + (b & 0xFF) + ((a & 0xFF) << 24);
 }
 
-QImage TwoDModelEngineApi::printColorSensor(const PortInfo &port) const
+QRect TwoDModelEngineApi::sensorFootprint(const PortInfo &port) const
 {
 	const DeviceInfo device = mModel.robotModels()[0]->configuration().type(port);
 	if (device.isNull()) {
-		return QImage();
+		return QRect();
 	}
 
-	QPair<QPointF, qreal> const neededPosDir = countPositionAndDirection(port);
-	const QPointF position = neededPosDir.first;
+	const QPointF position = countPositionAndDirection(port).first;
 	const qreal width = mModel.robotModels()[0]->info().sensorImageRect(device).width() / 2.0;
 	const QRectF scanningRect = QRectF(position.x() - width, position.y() - width, 2 * width, 2 * width);
-
-	QImage image(scanningRect.size().toSize(), QImage::Format_RGB32);
-	QPainter painter(&image);
-
-	QBrush brush(Qt::SolidPattern);
-	brush.setColor(Qt::white);
-	painter.setBrush(brush);
-	painter.setPen(QPen(Qt::white));
-	painter.drawRect(scanningRect.translated(-scanningRect.topLeft()));
-
-	QGraphicsItem * const sensorItem = mView.sensorItem(port);
-	view::RobotItem * const robot = dynamic_cast<view::RobotItem *>(mView.sensorItem(port)->parentItem());
-	const bool wasSelected = sensorItem->isSelected();
-	const bool rotaterWasVisible = robot->rotater().isVisible();
-	const bool rotaterWasSelected = robot->rotater().isSelected();
-	mView.setSensorVisible(port, false);
-	robot->rotater().setVisible(false);
-
-	mView.scene()->render(&painter, QRectF(), scanningRect);
-
-	mView.setSensorVisible(port, true);
-	mView.sensorItem(port)->setSelected(wasSelected);
-	robot->rotater().setVisible(rotaterWasVisible);
-	robot->rotater().setSelected(rotaterWasSelected);
-
-	return image;
+	return QRect(scanningRect.topLeft().toPoint(), scanningRect.size().toSize());
 }
 
 int TwoDModelEngineApi::readColorFullSensor(QHash<uint, int> const &countsColor) const
@@ -231,17 +202,17 @@ int TwoDModelEngineApi::readLightSensor(const PortInfo &port) const
 	// Must return 1023 on white and 0 on black normalized to percents
 	// http://stackoverflow.com/questions/596216/formula-to-determine-brightness-of-rgb-color
 
-	const QImage image = printColorSensor(port);
-	if (image.isNull()) {
+	const QRect rect = sensorFootprint(port);
+	if (rect.isEmpty()) {
 		return 0;
 	}
 
 	uint sum = 0;
-	const uint *data = reinterpret_cast<const uint *>(image.bits());
-	const int n = image.byteCount() / 4;
+	const int n = rect.width() * rect.height();
+	const bool realisticSensors = mModel.settings().realisticSensors();
 
-	for (int i = 0; i < n; ++i) {
-		const int color = mModel.settings().realisticSensors() ? spoilLight(data[i]) : data[i];
+	mModel.worldModel().floor().forEachPixel(rect, [this, realisticSensors, &sum](uint pixel) {
+		const int color = realisticSensors ? spoilLight(pixel) : pixel;
 		const int b = (color >> 0) & 0xFF;
 		const int g = (color >> 8) & 0xFF;
 		const int r = (color >> 16) & 0xFF;
@@ -249,7 +220,8 @@ int TwoDModelEngineApi::readLightSensor(const PortInfo &port) const
 		const int brightness = 0.2126 * r + 0.7152 * g + 0.0722 * b;
 
 		sum += 4 * brightness; // 4 = max sensor value / max brightness value
-	}
+	});
+
 	const qreal rawValue = sum / n; // Average by whole region
 	return rawValue * 100 / maxLightSensorValur; // Normalizing to percents
 }
@@ -276,7 +248,7 @@ utils::TimelineInterface &TwoDModelEngineApi::modelTimeline()
 
 engine::TwoDModelDisplayInterface *TwoDModelEngineApi::display()
 {
-	return mView.display();
+	return mView ? mView->display() : nullptr;
 }
 
 uint TwoDModelEngineApi::spoilLight(const uint color) const
@@ -294,8 +266,5 @@ uint TwoDModelEngineApi::spoilLight(const uint color) const
 
 QPair<QPointF, qreal> TwoDModelEngineApi::countPositionAndDirection(const PortInfo &port) const
 {
-	const view::SensorItem *sensor = mView.sensorItem(port);
-	const QPointF position = sensor ? sensor->scenePos() : QPointF();
-	const qreal direction = sensor ? sensor->rotation() + mModel.robotModels()[0]->rotation() : 0;
-	return { position, direction };
+	return mModel.robotModels()[0]->sensorPositionAndDirection(port);
 }
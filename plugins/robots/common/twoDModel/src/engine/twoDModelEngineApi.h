@@ -14,7 +14,8 @@ class D2ModelWidget;
 class TwoDModelEngineApi : public engine::TwoDModelEngineInterface
 {
 public:
-	TwoDModelEngineApi(model::Model &model, view::D2ModelWidget &view);
+	/// @param view - 2D model window, may be null for headless simulation, then there is no display.
+	TwoDModelEngineApi(model::Model &model, view::D2ModelWidget *view);
 
 	void setNewMotor(int speed, uint degrees
 			, const kitBase::robotModel::PortInfo &port, bool breakMode) override;
@@ -39,7 +40,8 @@ public:
 private:
 	QPair<QPointF, qreal> countPositionAndDirection(const kitBase::robotModel::PortInfo &port) const;
 
-	QImage printColorSensor(const kitBase::robotModel::PortInfo &port) const;
+	/// Returns the area of the floor seen by color or light sensor on a given port, in scene coordinates.
+	QRect sensorFootprint(const kitBase::robotModel::PortInfo &port) const;
 	int readColorFullSensor(QHash<uint, int> const &countsColor) const;
 	int readColorNoneSensor(QHash<uint, int> const &countsColor, int n) const;
 	int readSingleColorSensor(uint color, QHash<uint, int> const &countsColor, int n) const;
@@ -49,7 +51,7 @@ private:
 	int spoilSonarReading(const int distance) const;
 
 	model::Model &mModel;
-	view::D2ModelWidget &mView;
+	view::D2ModelWidget *mView;  // Does not have ownership, may be null.
 };
 
 }
@@ -14,7 +14,7 @@ TwoDModelEngineFacade::TwoDModelEngineFacade(twoDModel::robotModel::TwoDRobotMod
 			, "tools")
 	, mModel(new model::Model())
 	, mView(new view::D2ModelWidget(*mModel.data()))
-	, mApi(new TwoDModelEngineApi(*mModel.data(), *mView.data()))
+	, mApi(new TwoDModelEngineApi(*mModel.data(), mView.data()))
 {
 	mModel.data()->addRobotModel(robotModel);
 	connect(mTwoDModelActionInfo.action(), &QAction::triggered, mView.data(), &view::D2ModelWidget::init);
@@ -56,6 +56,9 @@ HEADERS += \
 	$$PWD/src/engine/model/settings.h \
 	$$PWD/src/engine/model/sensorsConfiguration.h \
 	$$PWD/src/engine/model/worldModel.h \
+	$$PWD/src/engine/model/wallsIndex.h \
+	$$PWD/src/engine/model/floorCache.h \
+	$$PWD/src/engine/model/headlessSimulator.h \
 	$$PWD/src/engine/model/timeline.h \
 	$$PWD/src/engine/model/modelTimer.h \
 	$$PWD/src/engine/model/robotModel.h \
@@ -89,6 +92,9 @@ SOURCES += \
 	$$PWD/src/engine/model/modelTimer.cpp \
 	$$PWD/src/engine/model/sensorsConfiguration.cpp \
 	$$PWD/src/engine/model/worldModel.cpp \
+	$$PWD/src/engine/model/wallsIndex.cpp \
+	$$PWD/src/engine/model/floorCache.cpp \
+	$$PWD/src/engine/model/headlessSimulator.cpp \
 	$$PWD/src/engine/model/timeline.cpp \
 	$$PWD/src/engine/model/physics/physicsEngineBase.cpp \
 	$$PWD/src/engine/model/physics/simplePhysicsEngine.cpp \
@@ -48,6 +48,7 @@ HEADERS += \
 	$$PWD/include/generatorBase/lua/precedenceConverter.h \
 
 HEADERS += \
+	$$PWD/src/templateRegistry.h \
 	$$PWD/src/readableControlFlowGenerator.h \
 	$$PWD/src/gotoControlFlowGenerator.h \
 	$$PWD/src/rules/semanticTransformationRule.h \
@@ -80,6 +81,7 @@ SOURCES += \
 	$$PWD/src/primaryControlFlowValidator.cpp \
 	$$PWD/src/generatorFactoryBase.cpp \
 	$$PWD/src/templateParametrizedEntity.cpp \
+	$$PWD/src/templateRegistry.cpp \
 	$$PWD/src/parts/variables.cpp \
 	$$PWD/src/parts/subprograms.cpp \
 	$$PWD/src/parts/threads.cpp \
@@ -1,12 +1,18 @@
 #pragma once
 
+#include <QtCore/QHash>
 #include <QtCore/QString>
 
 #include "robotsGeneratorDeclSpec.h"
 
 namespace generatorBase {
 
-/// This class can be inherited by those entities who need to use generator templates
+namespace details {
+class Template;
+}
+
+/// This class can be inherited by those entities who need to use generator templates. Templates are read once per
+/// process and shared by all entities.
 class ROBOTS_GENERATOR_EXPORT TemplateParametrizedEntity
 {
 public:
@@ -31,10 +37,20 @@ protected:
 	/// @param pathFromRoot A path to a concrete template relatively to specified in constructor folder.
 	QString readTemplateIfExists(const QString &pathFromRoot, const QString &fallback = QString()) const;
 
+	/// Reads the given template and substitutes its placeholders in one pass, which is faster than a series of
+	/// replace() calls on readTemplate() result. Values are not scanned for placeholders again.
+	/// @param pathFromRoot A path to a concrete template relatively to specified in constructor folder.
+	/// @param values Maps placeholders with "@@" around them to their values, placeholders that are not mentioned
+	/// here are left as they are.
+	QString renderTemplate(const QString &pathFromRoot, const QHash<QString, QString> &values) const;
+
 	/// Returns a given in constructor path to tempates root.
 	QString pathToRoot() const;
 
 private:
+	/// Returns template from process-wide registry, reports missing templates into debug output.
+	details::Template findTemplate(const QString &pathFromRoot) const;
+
 	QString mPathToRoot;
 };
 
@@ -125,27 +125,28 @@ void LuaPrinter::processTemplate(const qrtext::lua::ast::Node &node
 		, const QString &templateFileName
 		, QMap<QString, QSharedPointer<qrtext::lua::ast::Node>> const &bindings)
 {
-	QString result = readTemplate(templateFileName);
+	QHash<QString, QString> values;
 	for (const QString &toReplace : bindings.keys()) {
-		result.replace(toReplace, popResult(*bindings[toReplace]));
+		values[toReplace] = popResult(*bindings[toReplace]);
 	}
 
-	pushResult(node, result);
+	pushResult(node, renderTemplate(templateFileName, values));
 }
 
 void LuaPrinter::processUnary(const qrtext::core::ast::UnaryOperator &node, const QString &templateFileName)
 {
-	pushResult(node, readTemplate(templateFileName)
-			.replace("@@OPERAND@@", popResult(*node.operand(), needBrackets(node, *node.operand()))));
+	pushResult(node, renderTemplate(templateFileName
+			, { { "@@OPERAND@@", popResult(*node.operand(), needBrackets(node, *node.operand())) } }));
 }
 
 void LuaPrinter::processBinary(const qrtext::core::ast::BinaryOperator &node, const QString &templateFileName)
 {
-	pushResult(node, readTemplate(templateFileName)
-			.replace("@@LEFT@@", popResult(*node.leftOperand(), needBrackets(node
-					, *node.leftOperand(), qrtext::core::Associativity::left)))
-			.replace("@@RIGHT@@", popResult(*node.rightOperand(), needBrackets(node
-					, *node.rightOperand(), qrtext::core::Associativity::right))));
+	pushResult(node, renderTemplate(templateFileName, {
+		{ "@@LEFT@@", popResult(*node.leftOperand()
+				, needBrackets(node, *node.leftOperand(), qrtext::core::Associativity::left)) }
+		, { "@@RIGHT@@", popResult(*node.rightOperand()
+				, needBrackets(node, *node.rightOperand(), qrtext::core::Associativity::right)) }
+	}));
 }
 
 bool LuaPrinter::needBrackets(const qrtext::lua::ast::Node &parent
@@ -255,9 +256,10 @@ void LuaPrinter::visit(const qrtext::lua::ast::BitwiseRightShift &node)
 
 void LuaPrinter::visit(const qrtext::lua::ast::Concatenation &node)
 {
-	pushResult(node, readTemplate("concatenation.t")
-			.replace("@@LEFT@@", toString(node.leftOperand()))
-			.replace("@@RIGHT@@", toString(node.rightOperand())));
+	pushResult(node, renderTemplate("concatenation.t", {
+		{ "@@LEFT@@", toString(node.leftOperand()) }
+		, { "@@RIGHT@@", toString(node.rightOperand()) }
+	}));
 }
 
 void LuaPrinter::visit(const qrtext::lua::ast::Equality &node)
@@ -311,14 +313,15 @@ void LuaPrinter::visit(const qrtext::lua::ast::FieldInitialization &node)
 void LuaPrinter::visit(const qrtext::lua::ast::TableConstructor &node)
 {
 	const QStringList initializers = popResults(qrtext::as<qrtext::lua::ast::Node>(node.initializers()));
-	pushResult(node, readTemplate("tableConstructor.t")
-			.replace("@@COUNT@@", QString::number(initializers.count()))
-			.replace("@@INITIALIZERS@@", initializers.join(readTemplate("fieldInitializersSeparator.t"))));
+	pushResult(node, renderTemplate("tableConstructor.t", {
+		{ "@@COUNT@@", QString::number(initializers.count()) }
+		, { "@@INITIALIZERS@@", initializers.join(readTemplate("fieldInitializersSeparator.t")) }
+	}));
 }
 
 void LuaPrinter::visit(const qrtext::lua::ast::String &node)
 {
-	pushResult(node, readTemplate("string.t").replace("@@VALUE@@", node.string()));
+	pushResult(node, renderTemplate("string.t", { { "@@VALUE@@", node.string() } }));
 }
 
 void LuaPrinter::visit(const qrtext::lua::ast::True &node)
@@ -353,9 +356,10 @@ void LuaPrinter::visit(const qrtext::lua::ast::FunctionCall &node)
 			: QString();
 
 	if (reservedFunctionCall.isEmpty()) {
-		pushResult(node, readTemplate("functionCall.t")
-				.replace("@@FUNCTION@@", expression)
-				.replace("@@ARGUMENTS@@", arguments.join(readTemplate("argumentsSeparator.t"))));
+		pushResult(node, renderTemplate("functionCall.t", {
+			{ "@@FUNCTION@@", expression }
+			, { "@@ARGUMENTS@@", arguments.join(readTemplate("argumentsSeparator.t")) }
+		}));
 	} else {
 		pushResult(node, reservedFunctionCall);
 	}
@@ -366,10 +370,11 @@ void LuaPrinter::visit(const qrtext::lua::ast::MethodCall &node)
 	const QString object = popResult(*node.object());
 	const QString method = popResult(*node.methodName());
 	const QStringList arguments = popResults(qrtext::as<qrtext::lua::ast::Node>(node.arguments()));
-	pushResult(node, readTemplate("methodCall.t")
-			.replace("@@OBJECT@@", object)
-			.replace("@@METHOD@@", method)
-			.replace("@@ARGUMENTS@@", arguments.join(readTemplate("argumentsSeparator.t"))));
+	pushResult(node, renderTemplate("methodCall.t", {
+		{ "@@OBJECT@@", object }
+		, { "@@METHOD@@", method }
+		, { "@@ARGUMENTS@@", arguments.join(readTemplate("argumentsSeparator.t")) }
+	}));
 }
 
 void LuaPrinter::visit(const qrtext::lua::ast::Assignment &node)
@@ -397,16 +402,16 @@ QString LuaPrinter::toString(const QSharedPointer<qrtext::lua::ast::Node> &node)
 	}
 
 	if (type->is<qrtext::lua::types::Integer>()) {
-		return readTemplate("intToString.t").replace("@@VALUE@@", value);
+		return renderTemplate("intToString.t", { { "@@VALUE@@", value } });
 	}
 
 	if (type->is<qrtext::lua::types::Float>()) {
-		return readTemplate("floatToString.t").replace("@@VALUE@@", value);
+		return renderTemplate("floatToString.t", { { "@@VALUE@@", value } });
 	}
 
 	if (type->is<qrtext::lua::types::Integer>()) {
-		return readTemplate("boolToString.t").replace("@@VALUE@@", value);
+		return renderTemplate("boolToString.t", { { "@@VALUE@@", value } });
 	}
 
-	return readTemplate("otherToString.t").replace("@@VALUE@@", value);
+	return renderTemplate("otherToString.t", { { "@@VALUE@@", value } });
 }
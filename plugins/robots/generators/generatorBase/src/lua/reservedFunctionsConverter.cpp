@@ -15,8 +15,8 @@ QString ReservedFunctionsConverter::convert(const QString &name, const QStringLi
 			, "sgn", "sqrt", "abs", "ceil", "floor", "random" };
 	const int index = oneArgumentFloatFunctions.indexOf(name);
 	if (index >= 0) {
-		return readTemplate(QString("functions/%1.t").arg(name)).replace("@@ARGUMENT@@"
-				, args.count() ? args[0] : QString());
+		return renderTemplate(QString("functions/%1.t").arg(name)
+				, { { "@@ARGUMENT@@", args.count() ? args[0] : QString() } });
 	}
 
 	if (name == "time") {
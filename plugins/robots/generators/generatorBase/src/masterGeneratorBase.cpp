@@ -112,19 +112,20 @@ QString MasterGeneratorBase::generate(const QString &indentString)
 		return QString();
 	}
 
-	QString resultCode = readTemplate("main.t");
-	resultCode.replace("@@SUBPROGRAMS_FORWARDING@@", mCustomizer->factory()->subprograms()->forwardDeclarations());
-	resultCode.replace("@@SUBPROGRAMS@@", mCustomizer->factory()->subprograms()->implementations());
-	resultCode.replace("@@THREADS_FORWARDING@@", mCustomizer->factory()->threads().generateDeclarations());
-	resultCode.replace("@@THREADS@@", mCustomizer->factory()->threads().generateImplementations(indentString));
-	resultCode.replace("@@MAIN_CODE@@", mainCode);
-	resultCode.replace("@@INITHOOKS@@", utils::StringUtils::addIndent(
-			mCustomizer->factory()->initCode(), 1, indentString));
-	resultCode.replace("@@TERMINATEHOOKS@@", utils::StringUtils::addIndent(
-			mCustomizer->factory()->terminateCode(), 1, indentString));
-	resultCode.replace("@@USERISRHOOKS@@", utils::StringUtils::addIndent(
-			mCustomizer->factory()->isrHooksCode(), 1, indentString));
-	resultCode.replace("@@VARIABLES@@", mCustomizer->factory()->variables()->generateVariableString());
+	QString resultCode = renderTemplate("main.t", {
+		{ "@@SUBPROGRAMS_FORWARDING@@", mCustomizer->factory()->subprograms()->forwardDeclarations() }
+		, { "@@SUBPROGRAMS@@", mCustomizer->factory()->subprograms()->implementations() }
+		, { "@@THREADS_FORWARDING@@", mCustomizer->factory()->threads().generateDeclarations() }
+		, { "@@THREADS@@", mCustomizer->factory()->threads().generateImplementations(indentString) }
+		, { "@@MAIN_CODE@@", mainCode }
+		, { "@@INITHOOKS@@", utils::StringUtils::addIndent(mCustomizer->factory()->initCode(), 1, indentString) }
+		, { "@@TERMINATEHOOKS@@", utils::StringUtils::addIndent(
+				mCustomizer->factory()->terminateCode(), 1, indentString) }
+		, { "@@USERISRHOOKS@@", utils::StringUtils::addIndent(
+				mCustomizer->factory()->isrHooksCode(), 1, indentString) }
+		, { "@@VARIABLES@@", mCustomizer->factory()->variables()->generateVariableString() }
+	});
+
 	// This will remove too many empty lines
 	resultCode.replace(QRegExp("\n(\n)+"), "\n\n");
 
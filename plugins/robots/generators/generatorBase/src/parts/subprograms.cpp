@@ -91,7 +91,9 @@ void Subprograms::obtainCode(QMap<Id, QString> const &declarations
 		mForwardDeclarationsCode << readTemplate("subprograms/declarationsSectionHeader.t");
 	}
 
-	for (const Id &id : declarations.keys()) {
+	IdList declared = declarations.keys();
+	IdListHelper::sortByString(declared);
+	for (const Id &id : declared) {
 		mForwardDeclarationsCode << declarations[id];
 	}
 
@@ -99,7 +101,9 @@ void Subprograms::obtainCode(QMap<Id, QString> const &declarations
 		mImplementationsCode << readTemplate("subprograms/implementationsSectionHeader.t");
 	}
 
-	for (const Id &id : implementations.keys()) {
+	IdList implemented = implementations.keys();
+	IdListHelper::sortByString(implemented);
+	for (const Id &id : implemented) {
 		const QString signature = readSubprogramTemplate(id, "subprograms/implementation.t");
 		QString subprogramCode = signature;
 		subprogramCode.replace("@@BODY@@", implementations[id]);
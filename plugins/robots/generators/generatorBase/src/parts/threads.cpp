@@ -45,7 +45,14 @@ qReal::Id Threads::nextUnprocessedThread() const
 
 QList<semantics::SemanticTree *> Threads::threads() const
 {
-	return mProcessedThreads.values();
+	qReal::IdList ids = mProcessedThreads.keys();
+	qReal::IdListHelper::sortByString(ids);
+	QList<semantics::SemanticTree *> result;
+	for (const qReal::Id &id : ids) {
+		result << mProcessedThreads[id];
+	}
+
+	return result;
 }
 
 QStringList Threads::threadNames() const
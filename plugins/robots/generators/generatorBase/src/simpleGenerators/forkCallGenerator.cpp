@@ -18,7 +18,9 @@ QString ForkCallGenerator::generate()
 {
 	QString result;
 	const QString callPattern = readTemplate("threads/call.t");
-	for (const qReal::Id &thread : mThreads.keys()) {
+	qReal::IdList threads = mThreads.keys();
+	qReal::IdListHelper::sortByString(threads);
+	for (const qReal::Id &thread : threads) {
 		const QString threadName = utils::NameNormalizer::normalizeStrongly(thread.id(), false);
 		const QString threadId = mThreads[thread];
 		result += QString(callPattern).replace("@@THREAD_ID@@", threadId).replace("@@NAME@@", threadName);
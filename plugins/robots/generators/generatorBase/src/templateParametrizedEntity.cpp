@@ -2,8 +2,7 @@
 
 #include <QtCore/QDebug>
 
-#include <qrutils/inFile.h>
-#include <qrkernel/exception/exception.h>
+#include "templateRegistry.h"
 
 using namespace generatorBase;
 
@@ -22,36 +21,29 @@ TemplateParametrizedEntity::~TemplateParametrizedEntity()
 
 QString TemplateParametrizedEntity::readTemplate(const QString &pathFromRoot) const
 {
-	const QString fullPath = mPathToRoot + '/' + pathFromRoot;
-	QString result;
-
-	try {
-		result = utils::InFile::readAll(fullPath);
-	} catch (const qReal::Exception &exception) {
-		// Without this try-catch program would be failing every time when
-		// someone forgets or missprints tamplate name or unknown block with
-		// common generation rule will ty to read template
-		qDebug() << "UNHANDLED EXCEPTION: " + exception.message();
-	}
-
-	return result;
+	return findTemplate(pathFromRoot).text();
 }
 
 QString TemplateParametrizedEntity::readTemplateIfExists(const QString &pathFromRoot, const QString &fallback) const
 {
-	const QString fullPath = mPathToRoot + '/' + pathFromRoot;
-	if (!QFile(fullPath).exists()) {
-		return fallback;
-	}
+	const details::Template result = details::TemplateRegistry::find(mPathToRoot + '/' + pathFromRoot);
+	return result.isNull() ? fallback : result.text();
+}
 
-	QString result = fallback;
+QString TemplateParametrizedEntity::renderTemplate(const QString &pathFromRoot
+		, const QHash<QString, QString> &values) const
+{
+	return findTemplate(pathFromRoot).render(values);
+}
 
-	try {
-		result = utils::InFile::readAll(fullPath);
-	} catch (const qReal::Exception &) {
-		// Without this try-catch program would be failing every time when
-		// someone forgets or missprints tamplate name or unknown block with
-		// common generation rule will ty to read template
+details::Template TemplateParametrizedEntity::findTemplate(const QString &pathFromRoot) const
+{
+	const QString fullPath = mPathToRoot + '/' + pathFromRoot;
+	const details::Template result = details::TemplateRegistry::find(fullPath);
+	if (result.isNull()) {
+		// Not throwing here, otherwise program would be failing every time when someone forgets or misprints
+		// template name or unknown block with common generation rule tries to read template.
+		qDebug() << "Template" << fullPath << "can not be read";
 	}
 
 	return result;
@@ -0,0 +1,114 @@
+#include "templateRegistry.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QMutex>
+#include <QtCore/QVarLengthArray>
+
+#include <qrutils/inFile.h>
+#include <qrkernel/exception/exception.h>
+
+using namespace generatorBase::details;
+
+static bool isPlaceholderCharacter(const QChar &character)
+{
+	return character.isLetterOrNumber() || character == '_';
+}
+
+Template::Template()
+	: mIsNull(true)
+{
+}
+
+Template::Template(const QString &text)
+	: mIsNull(false)
+	, mText(text)
+{
+	const QString marker = "@@";
+	int literalStart = 0;
+	int position = text.indexOf(marker);
+	while (position != -1) {
+		int end = position + marker.size();
+		while (end < text.size() && isPlaceholderCharacter(text[end])) {
+			++end;
+		}
+
+		if (end == position + marker.size() || text.midRef(end, marker.size()) != marker) {
+			// Not a placeholder, but its closing marker may start a placeholder, like in "@@@NAME@@".
+			position = text.indexOf(marker, position + 1);
+			continue;
+		}
+
+		end += marker.size();
+		if (position > literalStart) {
+			mSegments << Segment{text.mid(literalStart, position - literalStart), false};
+		}
+
+		mSegments << Segment{text.mid(position, end - position), true};
+		literalStart = end;
+		position = text.indexOf(marker, end);
+	}
+
+	if (literalStart < text.size()) {
+		mSegments << Segment{text.mid(literalStart), false};
+	}
+}
+
+bool Template::isNull() const
+{
+	return mIsNull;
+}
+
+const QString &Template::text() const
+{
+	return mText;
+}
+
+QString Template::render(const QHash<QString, QString> &values) const
+{
+	QVarLengthArray<const QString *, 16> parts;
+	int size = 0;
+	for (const Segment &segment : mSegments) {
+		const QString *part = &segment.text;
+		if (segment.isPlaceholder) {
+			const auto value = values.constFind(segment.text);
+			if (value != values.constEnd()) {
+				part = &value.value();
+			}
+		}
+
+		parts.append(part);
+		size += part->size();
+	}
+
+	QString result;
+	result.reserve(size);
+	for (const QString *part : parts) {
+		result += *part;
+	}
+
+	return result;
+}
+
+Template TemplateRegistry::find(const QString &fullPath)
+{
+	static QMutex mutex;
+	static QHash<QString, Template> templates;
+
+	QMutexLocker lock(&mutex);
+	const auto cached = templates.constFind(fullPath);
+	if (cached != templates.constEnd()) {
+		return *cached;
+	}
+
+	Template result;
+	if (QFile::exists(fullPath)) {
+		try {
+			result = Template(utils::InFile::readAll(fullPath));
+		} catch (const qReal::Exception &) {
+			// Unreadable template is reported by its readers just like a missing one.
+		}
+	}
+
+	templates.insert(fullPath, result);
+	return result;
+}
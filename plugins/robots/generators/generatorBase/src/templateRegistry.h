@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+namespace generatorBase {
+namespace details {
+
+/// Generator template split into literal text and "@@NAME@@" placeholders once, so that it can be filled with
+/// values in a single pass instead of a series of QString::replace() calls.
+class Template
+{
+public:
+	/// Creates null template, that is what registry returns for missing files.
+	Template();
+
+	explicit Template(const QString &text);
+
+	/// Returns true if template file could not be read.
+	bool isNull() const;
+
+	/// Returns raw template text.
+	const QString &text() const;
+
+	/// Returns template text with placeholders substituted by @p values. Keys of @p values are placeholders
+	/// with "@@" around them, placeholders without value are left as they are. Substituted values are not scanned
+	/// for placeholders again.
+	QString render(const QHash<QString, QString> &values) const;
+
+private:
+	struct Segment
+	{
+		QString text;
+		bool isPlaceholder;
+	};
+
+	bool mIsNull;
+	QString mText;
+	QVector<Segment> mSegments;
+};
+
+/// Process-wide cache of generator templates. Each template file is read and split into segments once and then
+/// shared by all generators, missing files are remembered too. Templates are embedded into generator plugins as
+/// resources, so they do not change while the program runs. Can be used from several threads.
+class TemplateRegistry
+{
+public:
+	/// Returns template with given full path, null template if there is no such file or it can not be read.
+	static Template find(const QString &fullPath);
+};
+
+}
+}
@@ -206,7 +206,7 @@ std::function<bool(const qReal::Id &, qReal::LogicalModelAssistInterface &)> Sav
 {
 	return [=] (const Id &block, LogicalModelAssistInterface &logicalApi) {
 		bool modificationsMade = false;
-		QMapIterator<QString, QVariant> iterator = logicalApi.logicalRepoApi().propertiesIterator(block);
+		qrRepo::PropertiesIterator iterator = logicalApi.logicalRepoApi().propertiesIterator(block);
 		while (iterator.hasNext()) {
 			iterator.next();
 			const QString name = iterator.key();
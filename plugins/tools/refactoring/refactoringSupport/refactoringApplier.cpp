@@ -269,7 +269,7 @@ QHash<QString, QVariant> RefactoringApplier::properties(Id const &id) const
 {
 	QHash<QString, QVariant> result;
 
-	QMapIterator<QString, QVariant> properties =
+	qrRepo::PropertiesIterator properties =
 			(mLogicalModelApi.isLogicalId(id))
 			? mLogicalModelApi.logicalRepoApi().propertiesIterator(id)
 			: mLogicalModelApi.logicalRepoApi().propertiesIterator(
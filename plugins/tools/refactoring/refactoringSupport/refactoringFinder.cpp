@@ -135,7 +135,12 @@ bool RefactoringFinder::compareElementTypesAndProperties(Id const &first,
 	return BaseGraphTransformationUnit::compareElementTypesAndProperties(first, second);
 }
 
-QMapIterator<QString, QVariant> RefactoringFinder::propertiesIterator(Id const &id) const
+bool RefactoringFinder::isWildcardInRule(Id const &element) const
+{
+	return element.element() == "Element" || element.element() == "Link";
+}
+
+qrRepo::PropertiesIterator RefactoringFinder::propertiesIterator(Id const &id) const
 {
 	return mRefactoringRepoApi->propertiesIterator(id);
 }
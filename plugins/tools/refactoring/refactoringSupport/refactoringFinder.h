@@ -33,12 +33,13 @@ private:
 
 	Id startElement() const;
 
-	QMapIterator<QString, QVariant> propertiesIterator(Id const &id) const;
+	qrRepo::PropertiesIterator propertiesIterator(Id const &id) const;
 	QVariant refactoringProperty(const Id &id, const QString &propertyName) const;
 	bool containElementWithID(const QString &idValue, const IdList &idList);
 
 	bool compareElements(Id const &first, Id const &second) const;
 	bool compareElementTypesAndProperties(Id const &first, Id const &second) const;
+	bool isWildcardInRule(Id const &element) const;
 
 	Id toInRule(Id const &id) const;
 	Id fromInRule(Id const &id) const;
@@ -11,26 +11,10 @@ QtScriptGenerator::QtScriptGenerator(LogicalModelAssistInterface &logicalModelAp
 
 QString QtScriptGenerator::createProperInitAndOutput(QString const &code, bool const isApplicationCondition) const
 {
-	QString init = "";
-	QString output = "''";
-	foreach (QString const &elemName, mPropertiesUsage.keys()) {
-		foreach (QString const &propertyName, *mPropertiesUsage.value(elemName)) {
-			QString const variable = elemName + delimeter + propertyName;
-			QString const curPropertyValue = property(mMatch.value(idByName(elemName)), propertyName);
-
-			bool isStringProp = isStringProperty(mMatch.value(idByName(elemName)), propertyName);
-			QString const propertyValue = isStringProp ? "'" + escape(curPropertyValue) + "'" : curPropertyValue;
-			QString const representationOfProperty = "'\\'' + String(" + variable + ") + '\\''";
-
-			init += variable + "=" + propertyValue + "; ";
-			output += " + '" + variable + "=' + " + representationOfProperty + " + ';'";
-		}
-	}
-	if (!isApplicationCondition) {
-		return init + "\n\n" + code + "\n\n" + output;
-	} else {
-		return init + "\n\n" + code;
-	}
+	Q_UNUSED(isApplicationCondition)
+	// Variables are bound to properties by QtScriptInterpreter right in the engine, so neither initialization
+	// nor output is needed.
+	return code;
 }
 
 QString QtScriptGenerator::createBehaviourFunction(QString const &elementName, QString const &propertyName) const
@@ -18,7 +18,7 @@ public:
 			, gui::MainWindowInterpretersInterface &interpretersInterface);
 
 protected:
-	/// Add to code correct initialization of new variables and create proper output for model update
+	/// Returns code as is, variables are bound to model properties by interpreter (see propertyBindings())
 	QString createProperInitAndOutput(QString const &code, bool const isApplicationCondition) const;
 
 	/// Create function definition from element property
@@ -1,46 +1,83 @@
 #include "qtScriptInterpreter.h"
-#include "textCodeGenerator.h"
 
 using namespace qReal;
 
+/// Scripts differ only when rules substitute properties with "@", so the cache is just dropped when it grows.
+int const maxCachedPrograms = 256;
+
 QtScriptInterpreter::QtScriptInterpreter(QObject *parent) : TextCodeInterpreter(parent)
 {
 }
 
 bool QtScriptInterpreter::interpret(QString const &code, CodeType const codeType)
 {
-	QString const output = mEngine.evaluate(code).toString();
+	return interpret(code, QList<TextCodeGenerator::PropertyBinding>(), codeType);
+}
+
+bool QtScriptInterpreter::interpret(QString const &code, QList<TextCodeGenerator::PropertyBinding> const &bindings
+		, CodeType const codeType)
+{
+	mChangedProperties.clear();
+
+	QScriptValue globalObject = mEngine.globalObject();
+	foreach (TextCodeGenerator::PropertyBinding const &binding, bindings) {
+		globalObject.setProperty(binding.variable, scriptValue(binding.value));
+	}
 
-	if (codeType != initialization) {
-		processOutput(output);
+	QScriptValue const result = mEngine.evaluate(program(code));
+	if (mEngine.hasUncaughtException()) {
+		mEngine.clearExceptions();
+		mErrorOccured = true;
+		emit readyReadErrOutput(result.toString());
+		return false;
 	}
 
+	mErrorOccured = false;
 	if (codeType == applicationCondition) {
-		return mApplicationConditionResult && !mErrorOccured;
-	} else {
-		return !mErrorOccured;
+		mApplicationConditionResult = result.toBool();
+		return mApplicationConditionResult;
+	}
+
+	foreach (TextCodeGenerator::PropertyBinding const &binding, bindings) {
+		QString const value = globalObject.property(binding.variable).toString();
+		if (value != binding.value.toString()) {
+			TextCodeGenerator::PropertyBinding changed = binding;
+			changed.value = value;
+			mChangedProperties << changed;
+		}
 	}
+
+	return true;
 }
 
-void QtScriptInterpreter::processOutput(QString const &outputString)
+QList<TextCodeGenerator::PropertyBinding> const &QtScriptInterpreter::changedProperties() const
 {
-	if (outputString.isEmpty() || outputString == "undefined") {
-		return;
+	return mChangedProperties;
+}
+
+QScriptValue QtScriptInterpreter::scriptValue(QVariant const &value)
+{
+	switch (value.type()) {
+	case QVariant::Bool:
+		return QScriptValue(value.toBool());
+	case QVariant::Int:
+		return QScriptValue(value.toInt());
+	case QVariant::Double:
+		return QScriptValue(value.toDouble());
+	default:
+		return QScriptValue(value.toString());
 	}
+}
 
-	mErrorOccured = false;
-	if (outputString == "true") {
-		mApplicationConditionResult = true;
-	} else if (outputString == "false") {
-		mApplicationConditionResult = false;
-	} else {
-		QHash<QPair<QString, QString>, QString> output = parseOutput(outputString);
-
-		if (!output.isEmpty()) {
-			emit readyReadStdOutput(output, TextCodeInterpreter::qtScript);
-		} else {
-			mErrorOccured = true;
-			emit readyReadErrOutput(outputString);
+QScriptProgram QtScriptInterpreter::program(QString const &code)
+{
+	if (!mPrograms.contains(code)) {
+		if (mPrograms.size() >= maxCachedPrograms) {
+			mPrograms.clear();
 		}
+
+		mPrograms.insert(code, QScriptProgram(code));
 	}
+
+	return mPrograms.value(code);
 }
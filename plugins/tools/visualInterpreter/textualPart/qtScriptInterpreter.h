@@ -3,12 +3,16 @@
 #include <QtCore/QPair>
 #include <QtCore/QHash>
 #include <QtScript/QScriptEngine>
+#include <QtScript/QScriptProgram>
 
 #include "textCodeInterpreter.h"
+#include "textCodeGenerator.h"
 
 namespace qReal {
 
-/// Interprets textual part of semantics written on QtScript, parses output and sends it to the main system
+/// Interprets textual part of semantics written on QtScript in the same persistent engine, so variables defined
+/// by initialization code are visible in rules. Model properties used by script are bound directly to engine
+/// variables, after reaction changed ones are collected to be written to the model at once.
 class QtScriptInterpreter : public TextCodeInterpreter
 {
 	Q_OBJECT
@@ -19,10 +23,26 @@ public:
 	/// Interpret QtScript script
 	bool interpret(QString const &code, CodeType const codeType);
 
+	/// Interpret QtScript script with given properties bound to script variables
+	bool interpret(QString const &code, QList<TextCodeGenerator::PropertyBinding> const &bindings
+			, CodeType const codeType);
+
+	/// Properties changed by the last reaction, with new values
+	QList<TextCodeGenerator::PropertyBinding> const &changedProperties() const;
+
 protected:
-	void processOutput(QString const &outputString);
+	/// Converts bound property value to script value of the same type
+	static QScriptValue scriptValue(QVariant const &value);
+
+	/// Returns compiled script, compiling it if it was not met before
+	QScriptProgram program(QString const &code);
 
 	QScriptEngine mEngine;
+
+	/// Compiled scripts, key is script code
+	QHash<QString, QScriptProgram> mPrograms;
+
+	QList<TextCodeGenerator::PropertyBinding> mChangedProperties;
 };
 
 }
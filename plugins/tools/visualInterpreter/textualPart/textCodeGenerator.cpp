@@ -1,5 +1,7 @@
 #include "textCodeGenerator.h"
 
+#include <QtCore/qnumeric.h>
+
 using namespace qReal;
 
 QString const TextCodeGenerator::delimeter = "_visint_";
@@ -27,6 +29,12 @@ void TextCodeGenerator::setMatch(QHash<Id, Id> const &match)
 
 QString TextCodeGenerator::generateScript(bool const isApplicationCondition)
 {
+	// Usage is kept after generation for propertyBindings().
+	qDeleteAll(mPropertiesUsage);
+	qDeleteAll(mMethodsInvocation);
+	mPropertiesUsage.clear();
+	mMethodsInvocation.clear();
+
 	QString code = property(mRule, isApplicationCondition ? "applicationCondition" : "procedure");
 	collectPropertiesUsageAndMethodsInvocation(code);
 
@@ -35,12 +43,7 @@ QString TextCodeGenerator::generateScript(bool const isApplicationCondition)
 
 	collectPropertiesUsageAndMethodsInvocation(code);
 
-	QString const script = createProperInitAndOutput(replacePropertiesUsage(code), isApplicationCondition);
-
-	mPropertiesUsage.clear();
-	mMethodsInvocation.clear();
-
-	return script;
+	return createProperInitAndOutput(replacePropertiesUsage(code), isApplicationCondition);
 }
 
 bool TextCodeGenerator::hasElementName(QString const &name) const
@@ -63,6 +66,25 @@ Id TextCodeGenerator::idByName(QString const &name) const
 	return Id::rootId();
 }
 
+QList<TextCodeGenerator::PropertyBinding> TextCodeGenerator::propertyBindings() const
+{
+	QList<PropertyBinding> result;
+	foreach (QString const &elemName, mPropertiesUsage.keys()) {
+		Id const element = mMatch.value(idByName(elemName));
+		foreach (QString const &propertyName, *mPropertiesUsage.value(elemName)) {
+			PropertyBinding const binding = {
+				elemName + delimeter + propertyName
+				, element
+				, propertyName
+				, typedProperty(element, propertyName)
+			};
+			result << binding;
+		}
+	}
+
+	return result;
+}
+
 bool TextCodeGenerator::hasProperty(Id const &element, QString const &propertyName) const
 {
 	if (mLogicalModelApi.isLogicalId(element)) {
@@ -86,6 +108,33 @@ QVariant TextCodeGenerator::propertyVariant(Id const &element, QString const &pr
 	return mLogicalModelApi.logicalRepoApi().property(mGraphicalModelApi.logicalId(element), propertyName);
 }
 
+QVariant TextCodeGenerator::typedProperty(Id const &element, QString const &propertyName) const
+{
+	return typedValue(propertyVariant(element, propertyName).toString());
+}
+
+QVariant TextCodeGenerator::typedValue(QString const &value)
+{
+	QString const lowerValue = value.toLower();
+	if (lowerValue == "true" || lowerValue == "false") {
+		return lowerValue == "true";
+	}
+
+	bool isInt = false;
+	int const intValue = value.toInt(&isInt);
+	if (isInt) {
+		return intValue;
+	}
+
+	bool isDouble = false;
+	double const doubleValue = value.toDouble(&isDouble);
+	if (isDouble && qIsFinite(doubleValue)) {
+		return doubleValue;
+	}
+
+	return value;
+}
+
 bool TextCodeGenerator::isStringProperty(Id const &element, QString const &propertyName) const
 {
 	QVariant result = propertyVariant(element, propertyName);
@@ -16,6 +16,18 @@ public:
 	/// Delimiter that will be inserted instead of '.' in each "elemName.propertyName" occurencce
 	static QString const delimeter;
 
+	/// Property of matched model element used by generated script as a variable
+	struct PropertyBinding
+	{
+		/// Name of script variable, "elemName" + delimeter + "propertyName"
+		QString variable;
+		/// Element in model
+		Id element;
+		QString property;
+		/// Property value: bool, int, double or string, see typedValue()
+		QVariant value;
+	};
+
 	TextCodeGenerator(LogicalModelAssistInterface &logicalModelApi
 			, GraphicalModelAssistInterface &graphicalModelApi
 			, gui::MainWindowInterpretersInterface &interpretersInterface);
@@ -32,6 +44,13 @@ public:
 	/// Returns element id by it's name (from single rule)
 	Id idByName(QString const &name) const;
 
+	/// Returns properties used by the last generated script with their current values in model
+	QList<PropertyBinding> propertyBindings() const;
+
+	/// Converts property value to the type it gets in scripts: only "true" and "false" become bool, integers become
+	/// int, other finite numbers become double and everything else stays a string
+	static QVariant typedValue(QString const &value);
+
 protected:
 	/// Checks if rule have element with given name
 	bool hasElementName(QString const &name) const;
@@ -40,6 +59,9 @@ protected:
 	virtual QString property(Id const &element, QString const &propertyName) const;
 	QVariant propertyVariant(Id const &element, QString const &propertyName) const;
 
+	/// Returns property value converted by typedValue()
+	QVariant typedProperty(Id const &element, QString const &propertyName) const;
+
 	/// Checks if property has string type
 	bool isStringProperty(Id const &element, QString const &propertyName) const;
 
@@ -0,0 +1,40 @@
+QT += xml script widgets
+
+INCLUDEPATH += \
+	$$PWD/../../.. \
+	$$PWD/../../../qrgui/ \
+	$$PWD/../../../qrtext/include/ \
+
+links(qrkernel qrutils qrgui-preferences-dialog)
+
+TRANSLATIONS = $$PWD/../../../qrtranslations/ru/plugins/visualInterpreter_ru.ts
+
+HEADERS += \
+	$$PWD/visualInterpreterPlugin.h \
+	$$PWD/visualInterpreterPreferencesPage.h \
+	$$PWD/visualInterpreterUnit.h \
+	$$PWD/textualPart/ruleParser.h \
+	$$PWD/textualPart/pythonInterpreter.h \
+	$$PWD/textualPart/pythonGenerator.h \
+	$$PWD/textualPart/textCodeGenerator.h \
+	$$PWD/textualPart/textCodeInterpreter.h \
+	$$PWD/textualPart/qtScriptGenerator.h \
+	$$PWD/textualPart/qtScriptInterpreter.h \
+
+SOURCES += \
+	$$PWD/visualInterpreterPlugin.cpp \
+	$$PWD/visualInterpreterPreferencesPage.cpp \
+	$$PWD/visualInterpreterUnit.cpp \
+	$$PWD/textualPart/ruleParser.cpp \
+	$$PWD/textualPart/pythonInterpreter.cpp \
+	$$PWD/textualPart/pythonGenerator.cpp \
+	$$PWD/textualPart/textCodeGenerator.cpp \
+	$$PWD/textualPart/textCodeInterpreter.cpp \
+	$$PWD/textualPart/qtScriptGenerator.cpp \
+	$$PWD/textualPart/qtScriptInterpreter.cpp \
+
+FORMS += \
+	$$PWD/visualInterpreterPreferencePage.ui \
+
+RESOURCES += \
+	$$PWD/visualInterpreter.qrc \
@@ -27,10 +27,6 @@ VisualInterpreterUnit::VisualInterpreterUnit(
 			, SLOT(processTextCodeInterpreterStdOutput(QHash<QPair<QString, QString>, QString>, TextCodeInterpreter::CodeLanguage)));
 	connect(mPythonInterpreter, SIGNAL(readyReadErrOutput(QString))
 			, this, SLOT(processTextCodeInterpreterErrOutput(QString)));
-	connect(mQtScriptInterpreter
-			, SIGNAL(readyReadStdOutput(QHash<QPair<QString, QString>, QString>, TextCodeInterpreter::CodeLanguage))
-			, this
-			, SLOT(processTextCodeInterpreterStdOutput(QHash<QPair<QString, QString>, QString>, TextCodeInterpreter::CodeLanguage)));
 	connect(mQtScriptInterpreter, SIGNAL(readyReadErrOutput(QString))
 			, this, SLOT(processTextCodeInterpreterErrOutput(QString)));
 }
@@ -339,7 +335,8 @@ bool VisualInterpreterUnit::checkApplicationConditionQtScript(QHash<Id, Id> cons
 	mQtScriptGenerator->setRule(mRules.value(ruleName));
 	mQtScriptGenerator->setMatch(match);
 
-	return mQtScriptInterpreter->interpret(mQtScriptGenerator->generateScript(true)
+	QString const script = mQtScriptGenerator->generateScript(true);
+	return mQtScriptInterpreter->interpret(script, mQtScriptGenerator->propertyBindings()
 			, TextCodeInterpreter::applicationCondition);
 }
 
@@ -590,7 +587,18 @@ bool VisualInterpreterUnit::interpretQtScriptReaction()
 	mQtScriptGenerator->setRule(mRules.value(mMatchedRuleName));
 	mQtScriptGenerator->setMatch(mMatches.first());
 
-	return mQtScriptInterpreter->interpret(mQtScriptGenerator->generateScript(false), TextCodeInterpreter::reaction);
+	QString const script = mQtScriptGenerator->generateScript(false);
+	if (!mQtScriptInterpreter->interpret(script, mQtScriptGenerator->propertyBindings()
+			, TextCodeInterpreter::reaction))
+	{
+		return false;
+	}
+
+	foreach (TextCodeGenerator::PropertyBinding const &change, mQtScriptInterpreter->changedProperties()) {
+		setProperty(change.element, change.property, change.value);
+	}
+
+	return true;
 }
 
 void VisualInterpreterUnit::copyProperties(Id const &elemInModel, Id const &elemInRule)
@@ -663,6 +671,11 @@ bool VisualInterpreterUnit::compareElementTypesAndProperties(Id const &first, Id
 	return BaseGraphTransformationUnit::compareElementTypesAndProperties(first, second);
 }
 
+bool VisualInterpreterUnit::isWildcardInRule(Id const &element) const
+{
+	return element.element() == "Wildcard";
+}
+
 Id VisualInterpreterUnit::nodeIdWithControlMark(Id const &controlMarkId) const
 {
 	IdList const outLinks = outgoingLinks(controlMarkId);
@@ -702,6 +715,10 @@ utils::ExpressionsParser* VisualInterpreterUnit::ruleParser()
 void VisualInterpreterUnit::processTextCodeInterpreterStdOutput(QHash<QPair<QString, QString>, QString> const &output
 		, TextCodeInterpreter::CodeLanguage const language)
 {
+	// Only python reports property changes through its output, QtScript ones are applied by
+	// interpretQtScriptReaction().
+	Q_UNUSED(language)
+
 	QPair<QString, QString> pair;
 	foreach (pair, output.keys()) {
 		QString const elemName = pair.first;
@@ -711,12 +728,7 @@ void VisualInterpreterUnit::processTextCodeInterpreterStdOutput(QHash<QPair<QStr
 			value = value.toLower();
 		}
 
-		Id elemId;
-		if (language == TextCodeInterpreter::python) {
-			elemId = mPythonGenerator->idByName(elemName);
-		} else {
-			elemId = mQtScriptGenerator->idByName(elemName);
-		}
+		Id const elemId = mPythonGenerator->idByName(elemName);
 		setProperty(mMatches.first().value(elemId), propName, QString::fromUtf8(value.toLatin1()));
 	}
 
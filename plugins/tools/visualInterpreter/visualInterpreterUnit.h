@@ -109,7 +109,7 @@ protected:
 	/// Interpret rule reaction written on python
 	bool interpretPythonReaction();
 
-	/// Interpret rule reaction written on QtScript
+	/// Interpret rule reaction written on QtScript in process and write changed properties to the model
 	bool interpretQtScriptReaction();
 
 	/// Arranges connections between newly created elements
@@ -139,6 +139,7 @@ protected:
 	/// Functions for test elements for equality
 	bool compareElements(Id const &first, Id const &second) const;
 	bool compareElementTypesAndProperties(Id const &first, Id const &second) const;
+	bool isWildcardInRule(Id const &element) const;
 
 	/// Logical repo api methods for more quick access
 	IdList linksInRule(Id const &id) const;
@@ -164,6 +164,27 @@ uint AbstractCommand::timestamp() const
 	return mTimestamp;
 }
 
+bool AbstractCommand::mergeWith(const QUndoCommand *other)
+{
+	const AbstractCommand * const command = dynamic_cast<const AbstractCommand *>(other);
+	if (!command || !mPreActions.isEmpty() || !mPostActions.isEmpty()
+			|| !command->mPreActions.isEmpty() || !command->mPostActions.isEmpty()
+			|| mDiagramBinded != command->mDiagramBinded
+			|| !absorb(*command))
+	{
+		return false;
+	}
+
+	mTimestamp = command->mTimestamp;
+	return true;
+}
+
+bool AbstractCommand::absorb(const AbstractCommand &other)
+{
+	Q_UNUSED(other)
+	return false;
+}
+
 void AbstractCommand::removeDuplicatesOn(QList<AbstractCommand *> &list)
 {
 	foreach (AbstractCommand * const command, list) {
@@ -58,6 +58,12 @@ public:
 	/// Returns time of this command creation in ms since epoch
 	uint timestamp() const;
 
+	/// Merges given command that was executed right after this one into this one, so they are undone in one step.
+	/// Only commands with the same id() are offered for merging, commands with pre- or post-actions or bound
+	/// to different diagrams are never merged. Merged command gets timestamp of the given one.
+	/// @returns true if commands were merged, given command is deleted by undo stack then.
+	bool mergeWith(const QUndoCommand *other) override;
+
 signals:
 	void redoComplete(bool success);
 	void undoComplete(bool success);
@@ -70,6 +76,11 @@ protected:
 	/// and return operation success
 	virtual bool restoreState() = 0;
 
+	/// Reimplement this method to let the command absorb changes made by a given command of the same kind,
+	/// as if this command made them itself. Default implementation refuses merging.
+	/// @returns true if changes were absorbed
+	virtual bool absorb(const AbstractCommand &other);
+
 private:
 	void executeDirect(QList<AbstractCommand *> const &list);
 	void executeReverse(QList<AbstractCommand *> const &list);
@@ -1,9 +1,13 @@
 #include "undoStack.h"
 
+#include <qrkernel/settingsManager.h>
+
 using namespace qReal;
 
 UndoStack::UndoStack()
 {
+	// Undo limit can be set only while the stack is empty. When it is exceeded, the oldest commands are deleted.
+	setUndoLimit(SettingsManager::value("undoLimit").toInt());
 }
 
 void UndoStack::execute(commands::AbstractCommand *command)
@@ -6,6 +6,8 @@
 
 namespace qReal {
 
+/// Undo stack keeping at most "undoLimit" setting commands (0 means no limit), consecutive commands that can
+/// be merged are merged into one, see AbstractCommand::mergeWith().
 class UndoStack : public QUndoStack
 {
 public:
@@ -18,6 +18,7 @@
 
 #include "editor/private/lineFactory.h"
 #include "editor/private/lineHandler.h"
+#include "editor/private/levelOfDetail.h"
 
 using namespace qReal;
 using namespace enums;
@@ -168,6 +169,15 @@ void EdgeElement::setToPort(const qreal toPort)
 
 void EdgeElement::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget*)
 {
+	if (LevelOfDetail::level(painter) != LevelOfDetail::Level::full) {
+		// Zoomed out: a plain cosmetic polyline without arrows, ports and pen styles.
+		painter->save();
+		painter->setPen(QPen(isSelected() ? Qt::blue : mColor, 0));
+		painter->drawPolyline(mLine);
+		painter->restore();
+		return;
+	}
+
 	if (SettingsManager::value("PaintOldEdgeMode").toBool() && mHandler->isReshapeStarted()) {
 		paintEdge(painter, option, true);
 	}
@@ -796,7 +806,7 @@ EdgeElement::NodeSide EdgeElement::defineNodePortSide(bool isStart) const
 
 void EdgeElement::adjustLink()
 {
-	mHandler->adjust();
+	mHandler->adjustIfChanged();
 }
 
 NodeElement *EdgeElement::src() const
@@ -1040,7 +1050,7 @@ QVariant EdgeElement::itemChange(GraphicsItemChange change, const QVariant &valu
 		updateLongestPart();
 		return value;
 	default:
-		return QGraphicsItem::itemChange(change, value);
+		return Element::itemChange(change, value);
 	}
 }
 
@@ -57,7 +57,8 @@ public:
 
 	bool isDividable();
 
-	/// Adjust link to make its' ends be placed exactly on corresponding ports
+	/// Adjust link to make its' ends be placed exactly on corresponding ports. Does nothing if neither the link nor
+	/// its' ends have changed since the last adjustment.
 	void adjustLink();
 
 	/// Reconnect, arrange links on linear ports and lay out the link depending on its' type
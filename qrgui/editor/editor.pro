@@ -58,6 +58,7 @@ HEADERS += \
 	$$PWD/private/curveLine.h \
 	$$PWD/private/lineFactory.h \
 	$$PWD/private/edgeArrangeCriteria.h \
+	$$PWD/private/levelOfDetail.h \
 	$$PWD/commands/elementCommand.h \
 	$$PWD/commands/nodeElementCommand.h \
 	$$PWD/commands/edgeElementCommand.h \
@@ -110,6 +111,7 @@ SOURCES += \
 	$$PWD/private/curveLine.cpp \
 	$$PWD/private/lineFactory.cpp \
 	$$PWD/private/edgeArrangeCriteria.cpp \
+	$$PWD/private/levelOfDetail.cpp \
 	$$PWD/commands/elementCommand.cpp \
 	$$PWD/commands/nodeElementCommand.cpp \
 	$$PWD/commands/edgeElementCommand.cpp \
@@ -43,6 +43,7 @@ EditorViewScene::EditorViewScene(const models::Models &models
 	, mHighlightNode(nullptr)
 	, mMouseMovementManager(mRootId, mEditorManager)
 	, mActionSignalMapper(new QSignalMapper(this))
+	, mPostponeLinksAdjustment(false)
 	, mTimer(new QTimer(this))
 	, mTimerForArrowButtons(new QTimer(this))
 	, mOffset(QPointF(0, 0))
@@ -100,9 +101,9 @@ void EditorViewScene::setEnabled(bool enabled)
 
 void EditorViewScene::clearScene()
 {
-	foreach (QGraphicsItem *item, items()) {
-		// looks really insane, but some elements were alreadt deleted together with their parent
-		if (items().contains(item) && !(item == mTopLeftCorner || item == mBottomRightCorner)) {
+	// Removing only top-level items since children are removed together with their parents.
+	for (QGraphicsItem * const item : items()) {
+		if (!item->parentItem() && item != mTopLeftCorner && item != mBottomRightCorner) {
 			removeItem(item);
 		}
 	}
@@ -121,16 +122,7 @@ Element *EditorViewScene::getElem(const qReal::Id &id) const
 		return nullptr;
 	}
 
-	// FIXME: SLOW!
-	QList < QGraphicsItem *> list = items();
-	for (QList < QGraphicsItem *>::Iterator it = list.begin(); it != list.end(); it++) {
-		if (Element *elem = dynamic_cast < Element *>(*it)) {
-			if (elem->id() == id) {
-				return elem;
-			}
-		}
-	}
-	return nullptr;
+	return mElements.value(id);
 }
 
 void EditorViewScene::dragEnterEvent(QGraphicsSceneDragDropEvent *event)
@@ -609,24 +601,12 @@ void EditorViewScene::arrangeNodeLinks(NodeElement* node) const
 
 NodeElement* EditorViewScene::getNodeById(const qReal::Id &itemId) const
 {
-	foreach (QGraphicsItem *item, items()) {
-		NodeElement *node = dynamic_cast<NodeElement*>(item);
-		if (node && node->id() == itemId) {
-			return node;
-		}
-	}
-	return nullptr;
+	return dynamic_cast<NodeElement *>(mElements.value(itemId));
 }
 
 EdgeElement* EditorViewScene::getEdgeById(const qReal::Id &itemId) const
 {
-	foreach (QGraphicsItem *item, items()) {
-		EdgeElement *edge = dynamic_cast<EdgeElement*>(item);
-		if (edge && edge->id() == itemId) {
-			return edge;
-		}
-	}
-	return nullptr;
+	return dynamic_cast<EdgeElement *>(mElements.value(itemId));
 }
 
 QList<NodeElement*> EditorViewScene::getCloseNodes(NodeElement *node) const
@@ -1171,6 +1151,10 @@ void EditorViewScene::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
 void EditorViewScene::mouseMoveEvent(QGraphicsSceneMouseEvent *event)
 {
 	mCurrentMousePos = event->scenePos();
+
+	// Moved nodes change their positions several times while aligning to grid, and a link may be connected to
+	// several moved nodes, so links are adjusted once after the whole move.
+	mPostponeLinksAdjustment = true;
 	if ((mLeftButtonPressed && !(event->buttons() & Qt::RightButton))) {
 		QGraphicsScene::mouseMoveEvent(event);
 	} else {
@@ -1185,6 +1169,9 @@ void EditorViewScene::mouseMoveEvent(QGraphicsSceneMouseEvent *event)
 			QGraphicsScene::mouseMoveEvent(event);
 		}
 	}
+
+	mPostponeLinksAdjustment = false;
+	adjustPostponedLinks();
 }
 
 QPointF EditorViewScene::getMousePos() const
@@ -1353,9 +1340,9 @@ void EditorViewScene::dehighlight(const Id &graphicalId)
 
 void EditorViewScene::dehighlight()
 {
-	foreach (Element *element, mHighlightedElements) {
-		if (items().contains(element))
-			element->setGraphicsEffect(nullptr);
+	// Elements that left the scene are removed from highlighted ones when they are unregistered.
+	for (Element * const element : mHighlightedElements) {
+		element->setGraphicsEffect(nullptr);
 	}
 
 	mHighlightedElements.clear();
@@ -1420,7 +1407,7 @@ void EditorViewScene::initializeActions()
 
 void EditorViewScene::updateEdgeElements()
 {
-	foreach (QGraphicsItem *item, items()) {
+	for (Element * const item : elements()) {
 		EdgeElement *const element = dynamic_cast<EdgeElement*>(item);
 		if (element) {
 			const enums::linkShape::LinkShape shape
@@ -1437,16 +1424,16 @@ void EditorViewScene::updateEdgeElements()
 
 void EditorViewScene::initNodes()
 {
-	foreach (QGraphicsItem *item, items()) {
+	for (Element * const item : elements()) {
 		NodeElement* node = dynamic_cast<NodeElement*>(item);
 		if (node) {
 			node->adjustLinks();
-			if (mModels.graphicalModelAssistApi().properties(node->id()).contains("expanded")
+			if (mModels.graphicalRepoApi().hasProperty(node->id(), "expanded")
 					&& mModels.graphicalRepoApi().property(
 							node->id(), "expanded").toString() == "true") {
 				node->changeExpanded();
 			}
-			if (mModels.graphicalModelAssistApi().properties(node->id()).contains("folded")
+			if (mModels.graphicalRepoApi().hasProperty(node->id(), "folded")
 					&& mModels.graphicalRepoApi().property(
 							node->id(), "folded").toString() == "true") {
 				node->changeFoldState();
@@ -1482,6 +1469,47 @@ void EditorViewScene::onElementDeleted(Element *element)
 	mHighlightedElements.remove(element);
 }
 
+QList<Element *> EditorViewScene::elements() const
+{
+	return mElements.values();
+}
+
+void EditorViewScene::registerElement(Element *element)
+{
+	mElements.insert(element->id(), element);
+}
+
+void EditorViewScene::unregisterElement(Element *element)
+{
+	const auto registered = mElements.find(element->id());
+	if (registered != mElements.end() && registered.value() == element) {
+		mElements.erase(registered);
+	}
+
+	mHighlightedElements.remove(element);
+}
+
+void EditorViewScene::adjustLink(EdgeElement *edge)
+{
+	if (mPostponeLinksAdjustment) {
+		mPostponedLinks.insert(edge->id());
+	} else {
+		edge->adjustLink();
+	}
+}
+
+void EditorViewScene::adjustPostponedLinks()
+{
+	const QSet<Id> links = mPostponedLinks;
+	mPostponedLinks.clear();
+	for (const Id &link : links) {
+		EdgeElement * const edge = getEdgeById(link);
+		if (edge) {
+			edge->adjustLink();
+		}
+	}
+}
+
 void EditorViewScene::deselectLabels()
 {
 	foreach (QGraphicsItem *item, items()) {
@@ -126,6 +126,20 @@ public:
 	/// Handles deletion of the element from scene.
 	void onElementDeleted(Element *element);
 
+	/// Returns all elements on this scene, including elements nested into other ones.
+	QList<Element *> elements() const;
+
+	/// Adds element to a registry of elements on this scene, called by an element when it is added to the scene.
+	void registerElement(Element *element);
+
+	/// Removes element from a registry of elements on this scene, called by an element when it is removed from
+	/// the scene or deleted.
+	void unregisterElement(Element *element);
+
+	/// Adjusts given link to its' nodes. While scene processes mouse move, link is only scheduled for adjustment
+	/// and is adjusted once when the move is processed, however many times its' nodes have moved meanwhile.
+	void adjustLink(EdgeElement *edge);
+
 public slots:
 	qReal::Id createElement(const QString &type);
 
@@ -215,6 +229,9 @@ private:
 	void moveEdges();
 	QPointF offsetByDirection(int direction);
 
+	/// Adjusts links scheduled for adjustment while mouse move was processed.
+	void adjustPostponedLinks();
+
 	const models::Models &mModels;
 	const EditorManagerInterface &mEditorManager;
 	Controller &mController;
@@ -248,6 +265,16 @@ private:
 	QSignalMapper *mActionSignalMapper;
 
 	QSet<Element *> mHighlightedElements;
+
+	/// Elements on this scene by their graphical ids, maintained by elements themselves.
+	QHash<Id, Element *> mElements;
+
+	/// True while scene processes mouse move, links adjustment is postponed till the end of processing.
+	bool mPostponeLinksAdjustment;
+
+	/// Ids of links to be adjusted when mouse move is processed. Ids are kept instead of pointers since a link may
+	/// be deleted in the middle of processing.
+	QSet<Id> mPostponedLinks;
 	QTimer *mTimer;
 
 	/** @brief timer for update moved elements without lags */
@@ -7,6 +7,8 @@
 
 #include "models/commands/changePropertyCommand.h"
 
+#include "editor/editorViewScene.h"
+
 using namespace qReal;
 
 const qreal disabledEffectStrength = 0.9;
@@ -33,6 +35,17 @@ Element::Element(ElementImpl *elementImpl
 	updateEnabledState();
 	setHideNonHardLabels(SettingsManager::value("hideNonHardLabels").toBool());
 	SettingsListener::listen("hideNonHardLabels", this, &Element::setHideNonHardLabels);
+	setPictureCaching(SettingsManager::value("cacheElementPictures").toBool());
+	SettingsListener::listen("cacheElementPictures", this, &Element::setPictureCaching);
+}
+
+Element::~Element()
+{
+	// Items do not get scene change notifications when they are deleted, so unregistering explicitly.
+	// The cast fails when the scene itself is being destroyed, then there is nothing to unregister from.
+	if (EditorViewScene * const editorScene = dynamic_cast<EditorViewScene *>(scene())) {
+		editorScene->unregisterElement(this);
+	}
 }
 
 Id Element::id() const
@@ -156,6 +169,11 @@ void Element::setHideNonHardLabels(bool hide)
 	}
 }
 
+void Element::setPictureCaching(bool enabled)
+{
+	setCacheMode(enabled ? DeviceCoordinateCache : NoCache);
+}
+
 void Element::keyPressEvent(QKeyEvent *event)
 {
 	if (event->key() == Qt::Key_F2) {
@@ -170,3 +188,23 @@ void Element::keyPressEvent(QKeyEvent *event)
 
 	QGraphicsItem::keyPressEvent(event);
 }
+
+QVariant Element::itemChange(GraphicsItemChange change, const QVariant &value)
+{
+	switch (change) {
+	case ItemSceneChange:
+		if (EditorViewScene * const editorScene = dynamic_cast<EditorViewScene *>(scene())) {
+			editorScene->unregisterElement(this);
+		}
+
+		return value;
+	case ItemSceneHasChanged:
+		if (EditorViewScene * const editorScene = dynamic_cast<EditorViewScene *>(scene())) {
+			editorScene->registerElement(this);
+		}
+
+		return value;
+	default:
+		return QGraphicsItem::itemChange(change, value);
+	}
+}
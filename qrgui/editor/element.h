@@ -40,7 +40,7 @@ public:
 			, models::LogicalModelAssistApi &logicalAssistApi
 			);
 
-	virtual ~Element() {}
+	~Element() override;
 
 	void initEmbeddedControls();
 
@@ -84,8 +84,15 @@ signals:
 protected:
 	void setHideNonHardLabels(bool visible);
 
+	/// Enables or disables caching of element picture in device coordinates. Cached picture is painted again only
+	/// when element is updated or zoom changes, this speeds up scrolling of large diagrams.
+	void setPictureCaching(bool enabled);
+
 	void keyPressEvent(QKeyEvent *event) override;
 
+	/// Registers element in a registry of EditorViewScene when element is added to it or removed from it.
+	QVariant itemChange(GraphicsItemChange change, const QVariant &value) override;
+
 	bool mMoving;
 	bool mEnabled;
 	const Id mId;
@@ -4,6 +4,7 @@
 
 #include "editor/nodeElement.h"
 #include "editor/edgeElement.h"
+#include "editor/private/levelOfDetail.h"
 #include "brandManager/brandManager.h"
 
 using namespace qReal;
@@ -347,6 +348,10 @@ void Label::startTextInteraction()
 
 void Label::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
+	if (LevelOfDetail::level(painter) != LevelOfDetail::Level::full) {
+		return;
+	}
+
 	QString text = toPlainText();
 
 	if (text.isEmpty() && !mParentIsSelected && !isSelected()) {
@@ -22,6 +22,7 @@
 
 #include "editor/private/resizeHandler.h"
 #include "editor/private/copyHandler.h"
+#include "editor/private/levelOfDetail.h"
 
 #include "editor/commands/resizeCommand.h"
 #include "editor/commands/foldCommand.h"
@@ -51,6 +52,7 @@ NodeElement::NodeElement(ElementImpl *impl
 	, mPlaceholder(nullptr)
 	, mHighlightedNode(nullptr)
 	, mRenderTimer(this)
+	, mCachedPictureScale(0)
 {
 	setAcceptHoverEvents(true);
 	setFlag(ItemClipsChildrenToShape, false);
@@ -104,6 +106,7 @@ NodeElement::~NodeElement()
 	qDeleteAll(mBonusContextMenuActions);
 	delete mGrid;
 	delete mPortHandler;
+	releaseCachedPicture();
 }
 
 void NodeElement::initPortsVisibility()
@@ -188,8 +191,13 @@ void NodeElement::setPos(qreal x, qreal y)
 
 void NodeElement::adjustLinks()
 {
+	EditorViewScene * const evScene = dynamic_cast<EditorViewScene *>(scene());
 	foreach (EdgeElement *edge, mEdgeList) {
-		edge->adjustLink();
+		if (evScene) {
+			evScene->adjustLink(edge);
+		} else {
+			edge->adjustLink();
+		}
 	}
 
 	foreach (QGraphicsItem *child, childItems()) {
@@ -743,7 +751,7 @@ QVariant NodeElement::itemChange(GraphicsItemChange change, const QVariant &valu
 		return value;
 
 	default:
-		return QGraphicsItem::itemChange(change, value);
+		return Element::itemChange(change, value);
 	}
 }
 
@@ -792,6 +800,7 @@ void NodeElement::updateData()
 	}
 	mElementImpl->updateData(this);
 	updateLabels();
+	releaseCachedPicture();
 	update();
 }
 
@@ -831,6 +840,24 @@ void NodeElement::setPortsVisible(const QStringList &types)
 
 void NodeElement::paint(QPainter *painter, const QStyleOptionGraphicsItem *style, QWidget *)
 {
+	const LevelOfDetail::Level level = LevelOfDetail::level(painter);
+	if (level != LevelOfDetail::Level::full) {
+		if (level == LevelOfDetail::Level::pixmap) {
+			paintCachedPicture(painter);
+		}
+
+		// Cosmetic pen keeps frames visible however small the zoom is.
+		painter->save();
+		painter->setPen(QPen(isSelected() ? Qt::blue : Qt::black, 0));
+		painter->setBrush(Qt::NoBrush);
+		if (level == LevelOfDetail::Level::box || isSelected()) {
+			painter->drawRect(mContents);
+		}
+
+		painter->restore();
+		return;
+	}
+
 	mElementImpl->paint(painter, mContents);
 	paint(painter, style);
 
@@ -891,6 +918,39 @@ void NodeElement::paint(QPainter *painter, const QStyleOptionGraphicsItem *optio
 	}
 }
 
+void NodeElement::paintCachedPicture(QPainter *painter)
+{
+	const qreal scale = LevelOfDetail::cacheScale(painter);
+	QPixmap picture;
+	// Picture may have been evicted from the cache to keep its size bounded, it is rendered again then.
+	if (mCachedPictureScale != scale || mCachedPictureSize != mContents.size()
+			|| !QPixmapCache::find(mCachedPictureKey, &picture))
+	{
+		picture = QPixmap((mContents.size() * scale).toSize().expandedTo(QSize(1, 1)));
+		picture.fill(Qt::transparent);
+		{
+			QPainter picturePainter(&picture);
+			picturePainter.setRenderHint(QPainter::Antialiasing);
+			picturePainter.scale(scale, scale);
+			picturePainter.translate(-mContents.topLeft());
+			mElementImpl->paint(&picturePainter, mContents);
+		}
+
+		releaseCachedPicture();
+		mCachedPictureKey = QPixmapCache::insert(picture);
+		mCachedPictureScale = scale;
+		mCachedPictureSize = mContents.size();
+	}
+
+	painter->drawPixmap(mContents, picture, QRectF(picture.rect()));
+}
+
+void NodeElement::releaseCachedPicture()
+{
+	QPixmapCache::remove(mCachedPictureKey);
+	mCachedPictureKey = QPixmapCache::Key();
+}
+
 void NodeElement::drawPorts(QPainter *painter, bool mouseOver)
 {
 	painter->save();
@@ -1077,7 +1137,7 @@ void NodeElement::updateByNewParent()
 void NodeElement::updateChildrenOrder()
 {
 	QStringList ids;
-	if (mGraphicalAssistApi.properties(mId).contains("childrenOrder")) {
+	if (mGraphicalAssistApi.graphicalRepoApi().hasProperty(mId, "childrenOrder")) {
 		ids = mGraphicalAssistApi.graphicalRepoApi().property(mId, "childrenOrder").toStringList();
 	}
 
@@ -1291,15 +1351,16 @@ AbstractCommand *NodeElement::changeParentCommand(const Id &newParent, const QPo
 	return result;
 }
 
-void NodeElement::updateShape(const QString &shape) const
+void NodeElement::updateShape(const QString &shape)
 {
 	mElementImpl->updateRendererContent(shape);
+	releaseCachedPicture();
 }
 
 IdList NodeElement::sortedChildren() const
 {
 	IdList result;
-	if (mGraphicalAssistApi.properties(mId).contains("childrenOrder")) {
+	if (mGraphicalAssistApi.graphicalRepoApi().hasProperty(mId, "childrenOrder")) {
 		foreach (const QString &id, mGraphicalAssistApi.graphicalRepoApi().property(mId, "childrenOrder")
 				.toStringList()) {
 			result << Id::loadFromString(id);
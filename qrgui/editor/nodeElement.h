@@ -5,6 +5,7 @@
 #pragma once
 
 #include <QtGui/QKeyEvent>
+#include <QtGui/QPixmapCache>
 #include <QtWidgets/QGraphicsScene>
 #include <QtWidgets/QGraphicsSceneMouseEvent>
 #include <QtWidgets/QGraphicsSceneHoverEvent>
@@ -156,7 +157,7 @@ public:
 	QList<NodeElement *> const childNodes() const;
 
 	void setVisibleEmbeddedLinkers(const bool show);
-	void updateShape(const QString &shape) const;
+	void updateShape(const QString &shape);
 
 	void changeFoldState();
 
@@ -242,6 +243,14 @@ private:
 	void paint(QPainter *p, const QStyleOptionGraphicsItem *opt);
 	void drawPorts(QPainter *painter, bool mouseOver);
 
+	/// Paints shape of the element from a pixmap that is rendered again only when zoom, size or data of the
+	/// element change. Used when a scene is zoomed out, see LevelOfDetail. Pixmaps are kept in QPixmapCache,
+	/// so memory used by pictures of all elements is bounded and they are evicted when not painted anymore.
+	void paintCachedPicture(QPainter *painter);
+
+	/// Removes cached picture of the element, so it is rendered again when needed.
+	void releaseCachedPicture();
+
 	/**
 	 * Recalculates mHighlightedNode according to current mouse scene position.
 	 * @param mouseScenePos Current mouse scene position.
@@ -311,6 +320,10 @@ private:
 
 	QImage mRenderedDiagram;
 	QTimer mRenderTimer;
+
+	QPixmapCache::Key mCachedPictureKey;
+	qreal mCachedPictureScale;
+	QSizeF mCachedPictureSize;
 };
 
 }
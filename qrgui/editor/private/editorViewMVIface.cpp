@@ -195,12 +195,9 @@ void EditorViewMViface::rowsInserted(const QModelIndex &parent, int start, int e
 			}
 
 			if (!isEdgeFromEmbeddedLinker) {
-				for (QGraphicsItem *item : scene()->items()) {
-					Element* element = dynamic_cast<Element*>(item);
-					if (element) {
-						element->setSelectionState(false);
-						element->select(false);
-					}
+				for (Element * const element : mScene->elements()) {
+					element->setSelectionState(false);
+					element->select(false);
 				}
 
 				elem->select(true);
@@ -235,8 +232,8 @@ void EditorViewMViface::rowsInserted(const QModelIndex &parent, int start, int e
 		}
 	}
 
-	foreach (QGraphicsItem *item, mScene->items()) {
-		NodeElement* node = dynamic_cast<NodeElement*>(item);
+	for (Element * const element : mScene->elements()) {
+		NodeElement* node = dynamic_cast<NodeElement*>(element);
 		if (node) {
 			node->adjustLinks();
 		}
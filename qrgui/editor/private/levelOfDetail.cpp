@@ -0,0 +1,44 @@
+#include "levelOfDetail.h"
+
+#include <QtCore/QtMath>
+#include <QtWidgets/QStyleOptionGraphicsItem>
+
+#include <qrkernel/settingsManager.h>
+#include <qrkernel/settingsListener.h>
+
+using namespace qReal;
+
+LevelOfDetail::LevelOfDetail()
+	: mPixmapZoom(SettingsManager::value("lodPixmapZoom").toReal())
+	, mBoxesZoom(SettingsManager::value("lodBoxesZoom").toReal())
+{
+	SettingsListener::listen("lodPixmapZoom", [this](qreal zoom) { mPixmapZoom = zoom; });
+	SettingsListener::listen("lodBoxesZoom", [this](qreal zoom) { mBoxesZoom = zoom; });
+}
+
+LevelOfDetail &LevelOfDetail::instance()
+{
+	static LevelOfDetail instance;
+	return instance;
+}
+
+LevelOfDetail::Level LevelOfDetail::level(const QPainter *painter)
+{
+	const qreal zoom = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+	const LevelOfDetail &thresholds = instance();
+	if (zoom >= thresholds.mPixmapZoom) {
+		return Level::full;
+	}
+
+	return zoom >= thresholds.mBoxesZoom ? Level::pixmap : Level::box;
+}
+
+qreal LevelOfDetail::cacheScale(const QPainter *painter)
+{
+	const qreal zoom = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+	if (zoom <= 0) {
+		return 1;
+	}
+
+	return qPow(2, qCeil(2 * qLn(zoom) / qLn(2)) / 2.0);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QtGui/QPainter>
+
+namespace qReal {
+
+/// Decides how detailed elements are painted depending on current zoom of a scene. When a diagram is zoomed out
+/// below "lodPixmapZoom" setting nodes are painted as cached pixmaps, edges as plain polylines and labels are not
+/// painted at all; below "lodBoxesZoom" nodes are painted as plain boxes. Thresholds are tracked by SettingsListener,
+/// so painting does not query settings manager for each item.
+class LevelOfDetail
+{
+public:
+	enum class Level
+	{
+		full
+		, pixmap
+		, box
+	};
+
+	/// Returns level of detail for painting with given painter.
+	static Level level(const QPainter *painter);
+
+	/// Returns scale of a cached picture for painting with given painter. Scales are rounded up to powers of sqrt(2),
+	/// so cached pictures are not rendered again on each zoom step.
+	static qreal cacheScale(const QPainter *painter);
+
+private:
+	LevelOfDetail();
+
+	static LevelOfDetail &instance();
+
+	qreal mPixmapZoom;
+	qreal mBoxesZoom;
+};
+
+}
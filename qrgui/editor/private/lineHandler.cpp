@@ -12,6 +12,7 @@ LineHandler::LineHandler(EdgeElement *edge)
 		, mNodeWithHighlightedPorts(nullptr)
 		, mReshapeCommand(nullptr)
 		, mReshapeStarted(false)
+		, mAdjustedState()
 {
 }
 
@@ -143,6 +144,41 @@ void LineHandler::adjust()
 	}
 }
 
+void LineHandler::adjustIfChanged()
+{
+	if (!mEdge->isLoop() && adjustmentState() == mAdjustedState) {
+		return;
+	}
+
+	adjust();
+	mAdjustedState = adjustmentState();
+}
+
+LineHandler::AdjustmentState LineHandler::adjustmentState() const
+{
+	const NodeElement * const src = mEdge->src();
+	const NodeElement * const dst = mEdge->dst();
+
+	AdjustmentState result;
+	result.line = mEdge->line();
+	result.position = mEdge->scenePos();
+	result.fromPort = mEdge->fromPort();
+	result.toPort = mEdge->toPort();
+	result.src = src;
+	result.dst = dst;
+	result.srcRect = src ? src->mapRectToScene(src->contentsRect()) : QRectF();
+	result.dstRect = dst ? dst->mapRectToScene(dst->contentsRect()) : QRectF();
+	return result;
+}
+
+bool LineHandler::AdjustmentState::operator ==(const AdjustmentState &other) const
+{
+	return line == other.line && position == other.position
+			&& fromPort == other.fromPort && toPort == other.toPort
+			&& src == other.src && dst == other.dst
+			&& srcRect == other.srcRect && dstRect == other.dstRect;
+}
+
 void LineHandler::layOut(bool needReconnect)
 {
 	connectAndArrange(needReconnect, needReconnect);
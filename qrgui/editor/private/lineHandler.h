@@ -32,6 +32,10 @@ public:
 	/// Adjust link to make its' ends be placed exactly on corresponding ports
 	virtual void adjust();
 
+	/// Adjust link only if its' configuration, ports or adjacent nodes have changed since the last adjustment.
+	/// Adjustment of unchanged link would produce the same configuration, so it is skipped.
+	void adjustIfChanged();
+
 	/// Align link to grid in accordance with its' type
 	virtual void alignToGrid();
 
@@ -78,6 +82,25 @@ protected slots:
 	void endReshape();
 
 protected:
+	/// Everything adjustment of a non-loop link depends on. Links are not routed around other items, so there is
+	/// no obstacle set to keep: a link is rerouted only when this state changes, i.e. when its' own nodes move.
+	struct AdjustmentState
+	{
+		QPolygonF line;
+		QPointF position;
+		qreal fromPort;
+		qreal toPort;
+		const NodeElement *src;
+		const NodeElement *dst;
+		QRectF srcRect;
+		QRectF dstRect;
+
+		bool operator ==(const AdjustmentState &other) const;
+	};
+
+	/// @return current state of the link and its' adjacent nodes in scene coordinates
+	AdjustmentState adjustmentState() const;
+
 	/// Reimplement this method in subclass to make type-dependent actions when lay out
 	/// Default implementation does nothing
 	virtual void improveAppearance();
@@ -131,6 +154,9 @@ protected:
 
 	commands::ReshapeEdgeCommand *mReshapeCommand;
 	bool mReshapeStarted;
+
+	/// State of the link right after the last adjustment made by adjustIfChanged().
+	AdjustmentState mAdjustedState;
 };
 
 }
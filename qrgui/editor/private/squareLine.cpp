@@ -38,18 +38,23 @@ void SquareLine::adjustEndSegments()
 {
 	if (mEdge->line().count() == 2) {
 		squarize();
-	} else {
-		adjustStart();
-		adjustEnd();
+		return;
 	}
-}
 
-void SquareLine::adjustStart()
-{
+	// Only end segments are straightened, so the rest of the route is kept as it is. Link is updated only if
+	// something has changed since it also updates model.
 	QPolygonF line = mEdge->line();
+	const bool startAdjusted = adjustStart(line);
+	const bool endAdjusted = adjustEnd(line);
+	if (startAdjusted || endAdjusted) {
+		mEdge->setLine(line);
+	}
+}
 
+bool SquareLine::adjustStart(QPolygonF &line) const
+{
 	if ((qAbs(line[0].x() - line[1].x()) < epsilon) || (qAbs(line[0].y() - line[1].y()) < epsilon)) {
-		return;
+		return false;
 	}
 
 	if ((line[1] == line[2]) && (line.count() > 3)) {
@@ -66,17 +71,15 @@ void SquareLine::adjustStart()
 		}
 	}
 
-	mEdge->setLine(line);
+	return true;
 }
 
-void SquareLine::adjustEnd()
+bool SquareLine::adjustEnd(QPolygonF &line) const
 {
-	QPolygonF line = mEdge->line();
-
 	if ((qAbs(line[line.count() - 1].x() - line[line.count() - 2].x()) < epsilon)
 			|| qAbs(line[line.count() - 1].y() - line[line.count() - 2].y()) < epsilon)
 	{
-		return;
+		return false;
 	}
 
 	if ((line[line.count() - 2] == line[line.count() - 3]) && (line.count() > 3)) {
@@ -97,7 +100,7 @@ void SquareLine::adjustEnd()
 		}
 	}
 
-	mEdge->setLine(line);
+	return true;
 }
 
 void SquareLine::moveSegment(const QPointF &oldPos, const QPointF &newPos)
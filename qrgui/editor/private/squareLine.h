@@ -50,11 +50,13 @@ protected:
 	/// Ensure that both end segments are strict
 	void adjustEndSegments();
 
-	/// Ensure that first segment is strict
-	void adjustStart();
+	/// Ensure that first segment of the given line is strict
+	/// @return true if the line was changed
+	bool adjustStart(QPolygonF &line) const;
 
-	/// Ensure that last segment is strict
-	void adjustEnd();
+	/// Ensure that last segment of the given line is strict
+	/// @return true if the line was changed
+	bool adjustEnd(QPolygonF &line) const;
 
 	/// Determine whether the link intersect src or dst
 	bool needCorrect() const;
@@ -425,18 +425,13 @@ void MainWindow::sceneSelectionChanged()
 	}
 
 	QList<Element*> selected;
-	QList<QGraphicsItem*> items = getCurrentTab()->scene()->items();
-
-	foreach (QGraphicsItem* item, items) {
-		Element* element = dynamic_cast<Element*>(item);
-		if (element) {
-			if (element->isSelected()) {
-				selected.append(element);
-				element->setSelectionState(true);
-			} else {
-				element->setSelectionState(false);
-				element->select(false);
-			}
+	for (Element * const element : getCurrentTab()->editorViewScene().elements()) {
+		if (element->isSelected()) {
+			selected.append(element);
+			element->setSelectionState(true);
+		} else {
+			element->setSelectionState(false);
+			element->select(false);
 		}
 	}
 
@@ -1977,10 +1972,8 @@ void MainWindow::endPaletteModification()
 	// Disabling elements on scene...
 	EditorViewScene * const scene = getCurrentTab() ? &getCurrentTab()->mutableScene() : nullptr;
 	if (scene) {
-		for (QGraphicsItem * const item : scene->items()) {
-			if (Element * const element = dynamic_cast<Element *>(item)) {
-				element->updateEnabledState();
-			}
+		for (Element * const element : scene->elements()) {
+			element->updateEnabledState();
 		}
 
 		scene->update();
@@ -2,6 +2,9 @@
 
 using namespace qReal::commands;
 
+/// Id of change property commands for undo stack, shall be unique among command classes.
+const int changePropertyCommandId = 1;
+
 ChangePropertyCommand::ChangePropertyCommand(models::LogicalModelAssistApi * const model
 		, const QString &property, const Id &id, const QVariant &newValue)
 	: mLogicalModel(model)
@@ -28,6 +31,11 @@ ChangePropertyCommand::ChangePropertyCommand(
 {
 }
 
+int ChangePropertyCommand::id() const
+{
+	return changePropertyCommandId;
+}
+
 bool ChangePropertyCommand::execute()
 {
 	return setProperty(mNewValue);
@@ -46,3 +54,24 @@ bool ChangePropertyCommand::setProperty(const QVariant &value)
 	mLogicalModel->setPropertyByRoleName(mId, value, mPropertyName);
 	return true;
 }
+
+bool ChangePropertyCommand::absorb(const AbstractCommand &other)
+{
+	const ChangePropertyCommand * const command = dynamic_cast<const ChangePropertyCommand *>(&other);
+	if (!command) {
+		return false;
+	}
+
+	// Property editor commands are not merged since they refer to a property of currently selected element
+	// by its row, which may belong to another element by now.
+	const bool sameProperty = !mPropertyEditorModel && !command->mPropertyEditorModel
+			&& command->mLogicalModel == mLogicalModel
+			&& command->mId == mId
+			&& command->mPropertyName == mPropertyName;
+	if (!sameProperty) {
+		return false;
+	}
+
+	mNewValue = command->mNewValue;
+	return true;
+}
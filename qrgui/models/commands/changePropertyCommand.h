@@ -27,10 +27,16 @@ public:
 		, const QVariant &newValue
 		, int role = Qt::EditRole);
 
+	/// Consecutive changes of the same property are merged, so they are undone in one step.
+	int id() const override;
+
 protected:
 	virtual bool execute();
 	virtual bool restoreState();
 
+	/// Absorbs change of the same property of the same element, keeping the value before both changes.
+	bool absorb(const AbstractCommand &other) override;
+
 private:
 	bool setProperty(const QVariant &value);
 
@@ -43,10 +43,14 @@ Id CreateRemoveCommandImplementation::create()
 		mGraphicalApi.setProperties(mId, mGraphicalPropertiesSnapshot);
 	}
 
+	// Logical snapshot keeps only values that differ from defaults, so it is applied on top of default values
+	// the element was just created with instead of replacing all its properties.
 	const Id logicalId = mGraphicalApi.logicalId(mId);
-	if (mLogicalApi.logicalRepoApi().exist(logicalId)
-			&& !mLogicalPropertiesSnapshot.isEmpty()) {
-		mGraphicalApi.setProperties(logicalId, mLogicalPropertiesSnapshot);
+	if (mLogicalApi.logicalRepoApi().exist(logicalId)) {
+		qrRepo::LogicalRepoApi &repo = mLogicalApi.mutableLogicalRepoApi();
+		for (const QString &property : mLogicalPropertiesSnapshot.keys()) {
+			repo.setProperty(logicalId, property, mLogicalPropertiesSnapshot.value(property));
+		}
 	}
 
 	refreshAllPalettes();
@@ -75,7 +79,7 @@ void CreateRemoveCommandImplementation::remove()
 		}
 
 		mOldLogicalId = logicalId;
-		mLogicalPropertiesSnapshot = mGraphicalApi.properties(logicalId);
+		mLogicalPropertiesSnapshot = nonDefaultProperties(logicalId, mGraphicalApi.properties(logicalId));
 		const IdList graphicalIds = mGraphicalApi.graphicalIdsByLogicalId(logicalId);
 		mGraphicalApi.removeElement(mId);
 		// Checking that the only graphical part is our element itself
@@ -106,6 +110,24 @@ void CreateRemoveCommandImplementation::setNewPosition(const QPointF &position)
 	mPosition = position;
 }
 
+QMap<QString, QVariant> CreateRemoveCommandImplementation::nonDefaultProperties(const Id &id
+		, const QMap<QString, QVariant> &properties) const
+{
+	const EditorManagerInterface &editorManager = mLogicalApi.editorManagerInterface();
+	QMap<QString, QVariant> result = properties;
+	for (const QString &property : editorManager.propertyNames(id.type())) {
+		const auto value = result.find(property);
+		// Only string values are dropped, creation would change type of other ones.
+		if (value != result.end() && value->userType() == QMetaType::QString
+				&& value->toString() == editorManager.defaultPropertyValue(id, property))
+		{
+			result.erase(value);
+		}
+	}
+
+	return result;
+}
+
 void CreateRemoveCommandImplementation::refreshAllPalettes()
 {
 	// Calling refreshing immideately may cause segfault because of deletting drag source
@@ -33,6 +33,10 @@ public:
 private:
 	void refreshAllPalettes();
 
+	/// Returns given logical properties of an element except ones that have default values, element creation
+	/// restores them anyway. Keeps snapshots of removed elements small.
+	QMap<QString, QVariant> nonDefaultProperties(const Id &id, const QMap<QString, QVariant> &properties) const;
+
 	models::LogicalModelAssistApi &mLogicalApi;
 	models::GraphicalModelAssistApi &mGraphicalApi;
 	const models::Exploser &mExploser;
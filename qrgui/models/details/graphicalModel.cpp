@@ -51,33 +51,47 @@ void GraphicalModel::loadSubtreeFromClient(GraphicalModelItem * const parent)
 	/// have this property.
 	/// Nodes need to be loaded before adges due to bugs in scene which connects edges to incorrect nodes or does
 	/// not connect edges at all. Proper fix for that shall possibly be in scene instead of this place.
+	IdList nodes;
+	IdList edges;
 	foreach (const Id &childId, mApi.children(parent->id())) {
-		if (mApi.isGraphicalElement(childId) && !mApi.hasProperty(childId, "from")) {
-			GraphicalModelItem * const child = loadElement(parent, childId);
-			loadSubtreeFromClient(child);
+		if (mApi.isGraphicalElement(childId)) {
+			if (mApi.hasProperty(childId, "from")) {
+				edges << childId;
+			} else {
+				nodes << childId;
+			}
 		}
 	}
 
-	foreach (const Id &childId, mApi.children(parent->id())) {
-		if (mApi.isGraphicalElement(childId) && mApi.hasProperty(childId, "from")) {
-			GraphicalModelItem * const child = loadElement(parent, childId);
-			loadSubtreeFromClient(child);
-		}
+	// Children are inserted all at once, and only then their subtrees are loaded, since rows insertion can not be
+	// nested.
+	foreach (GraphicalModelItem * const child, loadElements(parent, nodes + edges)) {
+		loadSubtreeFromClient(child);
 	}
 }
 
-GraphicalModelItem *GraphicalModel::loadElement(GraphicalModelItem *parentItem, const Id &id)
+QList<GraphicalModelItem *> GraphicalModel::loadElements(GraphicalModelItem *parentItem, const IdList &ids)
 {
-	int newRow = parentItem->children().size();
+	QList<GraphicalModelItem *> result;
+	if (ids.isEmpty()) {
+		return result;
+	}
+
+	const int firstRow = parentItem->children().size();
+
+	beginInsertRows(index(parentItem), firstRow, firstRow + ids.size() - 1);
+	result.reserve(ids.size());
+	for (const Id &id : ids) {
+		const Id logicalId = mApi.logicalId(id);
+		GraphicalModelItem *item = new GraphicalModelItem(id, logicalId, parentItem);
+		parentItem->addChild(item);
+		mModelItems.insert(id, item);
+		result << item;
+	}
 
-	beginInsertRows(index(parentItem), newRow, newRow);
-	const Id logicalId = mApi.logicalId(id);
-	GraphicalModelItem *item = new GraphicalModelItem(id, logicalId, parentItem);
-	parentItem->addChild(item);
-	mModelItems.insert(id, item);
 	endInsertRows();
 
-	return item;
+	return result;
 }
 
 void GraphicalModel::connectToLogicalModel(LogicalModel * const logicalModel)
@@ -55,8 +55,10 @@ private:
 
 	virtual void init();
 	void loadSubtreeFromClient(modelsImplementation::GraphicalModelItem * const parent);
-	modelsImplementation::GraphicalModelItem *loadElement(modelsImplementation::GraphicalModelItem *parentItem
-			, const Id &id);
+
+	/// Creates items for given elements as last children of given item, rows are inserted in one batch.
+	QList<modelsImplementation::GraphicalModelItem *> loadElements(
+			modelsImplementation::GraphicalModelItem *parentItem, const IdList &ids);
 
 	void setNewName(const Id &id, const QString newValue);
 	virtual modelsImplementation::AbstractModelItem *createModelItem(const Id &id
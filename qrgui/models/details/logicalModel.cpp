@@ -35,26 +35,42 @@ void LogicalModel::init()
 
 void LogicalModel::loadSubtreeFromClient(LogicalModelItem * const parent)
 {
-	foreach (Id childId, mApi.children(parent->id())) {
+	IdList children;
+	foreach (const Id &childId, mApi.children(parent->id())) {
 		if (mApi.isLogicalElement(childId)) {
-			LogicalModelItem *child = loadElement(parent, childId);
-			loadSubtreeFromClient(child);
+			children << childId;
 		}
 	}
+
+	// Children are inserted all at once, and only then their subtrees are loaded, since rows insertion can not be
+	// nested.
+	foreach (LogicalModelItem * const child, loadElements(parent, children)) {
+		loadSubtreeFromClient(child);
+	}
 }
 
-LogicalModelItem *LogicalModel::loadElement(LogicalModelItem *parentItem, const Id &id)
+QList<LogicalModelItem *> LogicalModel::loadElements(LogicalModelItem *parentItem, const IdList &ids)
 {
-	const int newRow = parentItem->children().size();
+	QList<LogicalModelItem *> result;
+	if (ids.isEmpty()) {
+		return result;
+	}
+
+	const int firstRow = parentItem->children().size();
+
+	beginInsertRows(index(parentItem), firstRow, firstRow + ids.size() - 1);
+	result.reserve(ids.size());
+	for (const Id &id : ids) {
+		LogicalModelItem *item = new LogicalModelItem(id, parentItem);
+		addInsufficientProperties(id);
+		parentItem->addChild(item);
+		mModelItems.insert(id, item);
+		result << item;
+	}
 
-	beginInsertRows(index(parentItem), newRow, newRow);
-	LogicalModelItem *item = new LogicalModelItem(id, parentItem);
-	addInsufficientProperties(id);
-	parentItem->addChild(item);
-	mModelItems.insert(id, item);
 	endInsertRows();
 
-	return item;
+	return result;
 }
 
 void LogicalModel::addInsufficientProperties(const Id &id, const QString &name)
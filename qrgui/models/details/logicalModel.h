@@ -46,8 +46,11 @@ public:
 private:
 	virtual void init();
 	void loadSubtreeFromClient(modelsImplementation::LogicalModelItem * const parent);
-	modelsImplementation::LogicalModelItem *loadElement(modelsImplementation::LogicalModelItem *parentItem
-			, const Id &id);
+
+	/// Creates items for given elements as last children of given item, rows are inserted in one batch.
+	QList<modelsImplementation::LogicalModelItem *> loadElements(modelsImplementation::LogicalModelItem *parentItem
+			, const IdList &ids);
+
 	void addInsufficientProperties(const Id &id, const QString &name = QString());
 
 	virtual modelsImplementation::AbstractModelItem *createModelItem(const Id &id
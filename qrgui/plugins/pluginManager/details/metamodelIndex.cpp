@@ -0,0 +1,152 @@
+#include "metamodelIndex.h"
+
+#include <qrrepo/repoApi.h>
+
+using namespace qReal;
+using namespace qReal::details;
+
+/// Remembers only the first value for a key, lookups of interpreted editors have always returned the first match.
+template<typename Key>
+static void insertFirst(QHash<Key, Id> &hash, const Key &key, const Id &value)
+{
+	if (!hash.contains(key)) {
+		hash.insert(key, value);
+	}
+}
+
+template<typename Value>
+static const Value &valueOrEmpty(const QHash<Id, Value> &hash, const Id &key)
+{
+	static const Value empty = Value();
+	const auto value = hash.constFind(key);
+	return value == hash.constEnd() ? empty : value.value();
+}
+
+MetamodelIndex::MetamodelIndex(const qrRepo::RepoApi &repo)
+{
+	for (const Id &editor : repo.elementsByType("MetamodelDiagram")) {
+		const QString editorName = repo.name(editor);
+		const bool isLogicalEditor = repo.isLogicalElement(editor);
+		if (isLogicalEditor) {
+			insertFirst(mEditors, editorName, editor);
+		}
+
+		for (const Id &diagram : repo.children(editor)) {
+			const QString diagramName = repo.name(diagram);
+			if (isLogicalEditor) {
+				insertFirst(mDiagramsByName, qMakePair(editorName, diagramName), diagram);
+				if (diagram.element() == "MetaEditorDiagramNode" && repo.isLogicalElement(diagram)) {
+					insertFirst(mDiagrams, qMakePair(editor, diagramName), diagram);
+				}
+			}
+
+			for (const Id &element : repo.children(diagram)) {
+				const QString elementName = repo.name(element);
+				if (isLogicalEditor) {
+					insertFirst(mElementsByName, qMakePair(editorName, elementName), element);
+				}
+
+				if (repo.isLogicalElement(element)) {
+					insertFirst(mElements, qMakePair(diagram, elementName), element);
+				}
+
+				insertFirst(mTypes, elementName, Id(editorName, diagramName, elementName));
+				if (mOwners.contains(element)) {
+					continue;
+				}
+
+				mOwners.insert(element, qMakePair(editor, diagram));
+
+				IdList &attributes = mAttributes[element];
+				for (const Id &child : repo.children(element)) {
+					if (child.element() == "MetaEntity_Attribute") {
+						attributes << child;
+					}
+				}
+
+				IdList &generalizations = mGeneralizations[element];
+				for (const Id &link : repo.incomingLinks(element)) {
+					if (link.element() == "Inheritance") {
+						generalizations << repo.otherEntityFromLink(link, element);
+					}
+				}
+
+				IdList &specializations = mSpecializations[element];
+				for (const Id &link : repo.outgoingLinks(element)) {
+					if (link.element() == "Inheritance") {
+						specializations << repo.otherEntityFromLink(link, element);
+					}
+				}
+			}
+		}
+	}
+
+	for (auto element = mGeneralizations.constBegin(); element != mGeneralizations.constEnd(); ++element) {
+		QSet<Id> &ancestors = mAncestors[element.key()];
+		const IdList *parents = &element.value();
+		while (!parents->isEmpty() && !ancestors.contains(parents->first())) {
+			ancestors.insert(parents->first());
+			parents = &valueOrEmpty(mGeneralizations, parents->first());
+		}
+	}
+}
+
+bool MetamodelIndex::hasEditor(const QString &editor) const
+{
+	return mEditors.contains(editor);
+}
+
+Id MetamodelIndex::metaId(const Id &id) const
+{
+	const Id editor = mEditors.value(id.editor());
+	if (id.diagram().isEmpty()) {
+		return editor;
+	}
+
+	const Id diagram = mDiagrams.value(qMakePair(editor, id.diagram()));
+	if (id.element().isEmpty() || diagram.isNull()) {
+		return diagram;
+	}
+
+	return mElements.value(qMakePair(diagram, id.element()));
+}
+
+Id MetamodelIndex::elementByName(const QString &editor, const QString &element) const
+{
+	return mElementsByName.value(qMakePair(editor, element));
+}
+
+Id MetamodelIndex::diagramByName(const QString &editor, const QString &diagram) const
+{
+	return mDiagramsByName.value(qMakePair(editor, diagram));
+}
+
+Id MetamodelIndex::typeByName(const QString &element) const
+{
+	return mTypes.value(element);
+}
+
+QPair<Id, Id> MetamodelIndex::editorAndDiagram(const Id &element) const
+{
+	return mOwners.value(element);
+}
+
+const IdList &MetamodelIndex::attributes(const Id &element) const
+{
+	return valueOrEmpty(mAttributes, element);
+}
+
+const IdList &MetamodelIndex::generalizations(const Id &element) const
+{
+	return valueOrEmpty(mGeneralizations, element);
+}
+
+const IdList &MetamodelIndex::specializations(const Id &element) const
+{
+	return valueOrEmpty(mSpecializations, element);
+}
+
+const QSet<Id> &MetamodelIndex::ancestors(const Id &element) const
+{
+	return valueOrEmpty(mAncestors, element);
+}
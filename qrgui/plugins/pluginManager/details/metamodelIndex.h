@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QPair>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+
+#include <qrkernel/ids.h>
+
+namespace qrRepo {
+class RepoApi;
+}
+
+namespace qReal {
+namespace details {
+
+/// Snapshot of metamodel structure stored in one repository of interpreted editors: which editors, diagrams and
+/// elements are there, which attributes elements have and how elements inherit each other. Repository is traversed
+/// once when snapshot is built, after that queries are hash lookups. Snapshot does not copy property values like
+/// displayed names or "isHidden" flags, they are still read from repository, so it must be rebuilt only when
+/// metamodel elements, attributes or links are added or removed. Snapshot is immutable.
+class MetamodelIndex
+{
+public:
+	explicit MetamodelIndex(const qrRepo::RepoApi &repo);
+
+	/// Returns true if repository has logical metamodel with given name.
+	bool hasEditor(const QString &editor) const;
+
+	/// Returns metamodel element (editor, diagram node or element) corresponding to given editor type id, Id() if
+	/// there is no such element. Only logical elements are looked up.
+	Id metaId(const Id &id) const;
+
+	/// Returns element with given name from any diagram of given logical metamodel.
+	Id elementByName(const QString &editor, const QString &element) const;
+
+	/// Returns child with given name of given logical metamodel.
+	Id diagramByName(const QString &editor, const QString &diagram) const;
+
+	/// Returns type id of element with given name from any metamodel, Id() if there is no such element.
+	Id typeByName(const QString &element) const;
+
+	/// Returns metamodel and diagram node that contain given metamodel element.
+	QPair<Id, Id> editorAndDiagram(const Id &element) const;
+
+	/// Returns attributes of given metamodel element in repository order.
+	const IdList &attributes(const Id &element) const;
+
+	/// Returns elements given element directly inherits, in the order of inheritance links.
+	const IdList &generalizations(const Id &element) const;
+
+	/// Returns elements directly inheriting given element, in the order of inheritance links.
+	const IdList &specializations(const Id &element) const;
+
+	/// Returns elements reached from given one by following its first inheritance link, then first inheritance
+	/// link of its parent and so on. Interpreted editors have always resolved "is parent of" questions this way.
+	const QSet<Id> &ancestors(const Id &element) const;
+
+private:
+	QHash<QString, Id> mEditors;
+	QHash<QPair<Id, QString>, Id> mDiagrams;
+	QHash<QPair<Id, QString>, Id> mElements;
+	QHash<QPair<QString, QString>, Id> mDiagramsByName;
+	QHash<QPair<QString, QString>, Id> mElementsByName;
+	QHash<QString, Id> mTypes;
+	QHash<Id, QPair<Id, Id>> mOwners;
+	QHash<Id, IdList> mAttributes;
+	QHash<Id, IdList> mGeneralizations;
+	QHash<Id, IdList> mSpecializations;
+	QHash<Id, QSet<Id>> mAncestors;
+};
+
+}
+}
@@ -0,0 +1,369 @@
+#include "sdfDisplayList.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QDebug>
+
+using namespace qReal::details;
+
+SdfDisplayList::SdfDisplayList(const QDomElement &picture)
+	: mWidth(picture.attribute("sizex").toInt())
+	, mHeight(picture.attribute("sizey").toInt())
+{
+	for (QDomElement element = picture.firstChildElement(); !element.isNull()
+			; element = element.nextSiblingElement())
+	{
+		compileElement(element);
+	}
+}
+
+int SdfDisplayList::width() const
+{
+	return mWidth;
+}
+
+int SdfDisplayList::height() const
+{
+	return mHeight;
+}
+
+const QList<SdfDisplayList::Primitive> &SdfDisplayList::primitives() const
+{
+	return mPrimitives;
+}
+
+void SdfDisplayList::compileElement(const QDomElement &element)
+{
+	static const QHash<QString, PrimitiveType> types = {
+		{ "line", PrimitiveType::line }
+		, { "ellipse", PrimitiveType::ellipse }
+		, { "arc", PrimitiveType::arc }
+		, { "background", PrimitiveType::background }
+		, { "text", PrimitiveType::text }
+		, { "rectangle", PrimitiveType::rectangle }
+		, { "polygon", PrimitiveType::polygon }
+		, { "point", PrimitiveType::point }
+		, { "path", PrimitiveType::path }
+		, { "curve", PrimitiveType::curve }
+		, { "image", PrimitiveType::image }
+	};
+
+	const QList<ShowCondition> conditions = showConditions(element);
+
+	if (element.tagName() == "stylus") {
+		for (QDomElement line = element.firstChildElement("line"); !line.isNull()
+				; line = line.nextSiblingElement("line"))
+		{
+			Primitive result = primitive(PrimitiveType::line, line);
+			result.showConditions = conditions;
+			mPrimitives << result;
+		}
+
+		return;
+	}
+
+	const auto type = types.constFind(element.tagName());
+	if (type == types.constEnd()) {
+		return;
+	}
+
+	Primitive result = primitive(*type, element);
+	result.showConditions = conditions;
+	mPrimitives << result;
+}
+
+SdfDisplayList::Primitive SdfDisplayList::primitive(PrimitiveType type, const QDomElement &element)
+{
+	Primitive result;
+	result.type = type;
+	result.style = style(element);
+
+	switch (type) {
+	case PrimitiveType::line:
+	case PrimitiveType::ellipse:
+	case PrimitiveType::arc:
+	case PrimitiveType::rectangle:
+	case PrimitiveType::image:
+		result.coordinates = {
+			coordinate(element.attribute("x1"))
+			, coordinate(element.attribute("y1"))
+			, coordinate(element.attribute("x2"))
+			, coordinate(element.attribute("y2"))
+		};
+		break;
+	case PrimitiveType::text:
+	case PrimitiveType::point:
+		result.coordinates = { coordinate(element.attribute("x1")), coordinate(element.attribute("y1")) };
+		break;
+	case PrimitiveType::polygon: {
+		const int count = element.attribute("n").toInt();
+		for (int i = 1; i <= count; ++i) {
+			result.coordinates << coordinate(element.attribute("x" + QString::number(i)))
+					<< coordinate(element.attribute("y" + QString::number(i)));
+		}
+
+		break;
+	}
+	default:
+		break;
+	}
+
+	switch (type) {
+	case PrimitiveType::arc:
+		result.startAngle = element.attribute("startAngle").toInt();
+		result.spanAngle = element.attribute("spanAngle").toInt();
+		break;
+	case PrimitiveType::text:
+		result.text = textLines(element);
+		break;
+	case PrimitiveType::image:
+		result.imageName = element.attribute("name", "default");
+		break;
+	case PrimitiveType::path:
+		result.path = path(element.attribute("d"));
+		break;
+	case PrimitiveType::curve:
+		result.curve = curve(element);
+		break;
+	default:
+		break;
+	}
+
+	return result;
+}
+
+SdfDisplayList::Style SdfDisplayList::style(const QDomElement &element)
+{
+	Style result;
+
+	if (element.hasAttribute("stroke-width")) {
+		result.hasStrokeWidth = true;
+		result.strokeWidth = element.attribute("stroke-width").toInt();
+	}
+
+	if (element.hasAttribute("fill")) {
+		result.hasFill = true;
+		result.fill = QColor(element.attribute("fill"));
+	}
+
+	if (element.hasAttribute("stroke")) {
+		result.hasStroke = true;
+		result.stroke = QColor(element.attribute("stroke"));
+	}
+
+	if (element.hasAttribute("stroke-style")) {
+		static const QHash<QString, Qt::PenStyle> penStyles = {
+			{ "solid", Qt::SolidLine }
+			, { "dot", Qt::DotLine }
+			, { "dash", Qt::DashLine }
+			, { "dashdot", Qt::DashDotLine }
+			, { "dashdotdot", Qt::DashDotDotLine }
+			, { "none", Qt::NoPen }
+		};
+
+		const auto penStyle = penStyles.constFind(element.attribute("stroke-style"));
+		if (penStyle != penStyles.constEnd()) {
+			result.hasStrokeStyle = true;
+			result.strokeStyle = *penStyle;
+		}
+	}
+
+	if (element.hasAttribute("fill-style")) {
+		const QString fillStyle = element.attribute("fill-style");
+		if (fillStyle == "none" || fillStyle == "solid") {
+			result.hasFillStyle = true;
+			result.fillStyle = fillStyle == "none" ? Qt::NoBrush : Qt::SolidPattern;
+		}
+	}
+
+	if (element.hasAttribute("font-fill")) {
+		result.hasFontFill = true;
+		result.fontFill = QColor(element.attribute("font-fill"));
+	}
+
+	if (element.hasAttribute("font-size")) {
+		// Font size is integral, so fractional part is dropped right away.
+		result.hasFontSize = true;
+		result.fontSize = coordinate(element.attribute("font-size"));
+		QString size = element.attribute("font-size");
+		if (result.fontSize.unit != Coordinate::Unit::scaled) {
+			size.chop(1);
+		}
+
+		result.fontSize.value = size.toInt();
+	}
+
+	if (element.hasAttribute("font-name")) {
+		result.hasFontName = true;
+		result.fontName = element.attribute("font-name");
+	}
+
+	if (element.hasAttribute("b")) {
+		result.hasBold = true;
+		result.bold = element.attribute("b").toInt();
+	}
+
+	if (element.hasAttribute("i")) {
+		result.hasItalic = true;
+		result.italic = element.attribute("i").toInt();
+	}
+
+	if (element.hasAttribute("u")) {
+		result.hasUnderline = true;
+		result.underline = element.attribute("u").toInt();
+	}
+
+	return result;
+}
+
+QList<SdfDisplayList::ShowCondition> SdfDisplayList::showConditions(const QDomElement &element)
+{
+	static const QHash<QString, ShowCondition::Sign> signs = {
+		{ "=~", ShowCondition::Sign::matches }
+		, { ">", ShowCondition::Sign::greater }
+		, { "<", ShowCondition::Sign::less }
+		, { ">=", ShowCondition::Sign::greaterOrEqual }
+		, { "<=", ShowCondition::Sign::lessOrEqual }
+		, { "!=", ShowCondition::Sign::notEqual }
+		, { "=", ShowCondition::Sign::equal }
+	};
+
+	QList<ShowCondition> result;
+	const QDomNodeList conditions = element.elementsByTagName("showIf");
+	for (int i = 0; i < conditions.length(); ++i) {
+		const QDomElement condition = conditions.at(i).toElement();
+		const QString sign = condition.attribute("sign");
+
+		ShowCondition showCondition;
+		showCondition.sign = signs.value(sign, ShowCondition::Sign::unsupported);
+		showCondition.property = condition.attribute("property");
+		showCondition.value = condition.attribute("value");
+		showCondition.intValue = showCondition.value.toInt();
+		if (showCondition.sign == ShowCondition::Sign::matches) {
+			showCondition.pattern = QRegExp(showCondition.value);
+		} else if (showCondition.sign == ShowCondition::Sign::unsupported) {
+			qDebug() << "Unsupported logical operator \"" + sign + "\"";
+		}
+
+		result << showCondition;
+	}
+
+	return result;
+}
+
+SdfDisplayList::Coordinate SdfDisplayList::coordinate(const QString &value)
+{
+	Coordinate result;
+	QString number = value;
+	if (number.endsWith("%")) {
+		result.unit = Coordinate::Unit::percent;
+		number.chop(1);
+	} else if (number.endsWith("a")) {
+		result.unit = Coordinate::Unit::absolute;
+		number.chop(1);
+	}
+
+	result.value = number.toFloat();
+	return result;
+}
+
+QStringList SdfDisplayList::textLines(const QDomElement &element)
+{
+	QString text = element.text();
+	if (text.startsWith('\n')) {
+		text.remove(0, 1);
+	}
+
+	if (text.endsWith('\n')) {
+		text.chop(1);
+	}
+
+	return text.split('\n');
+}
+
+QVector<SdfDisplayList::PathCommand> SdfDisplayList::path(const QString &description)
+{
+	auto isCommand = [](const QString &token) {
+		return token == "M" || token == "L" || token == "C" || token == "Z";
+	};
+
+	const QStringList tokens = description.split(' ', QString::SkipEmptyParts);
+	QVector<PathCommand> result;
+	PathCommand command;
+	int i = 0;
+	while (i < tokens.size()) {
+		const QString name = tokens[i];
+		++i;
+
+		QVector<float> numbers;
+		while (i < tokens.size() && !isCommand(tokens[i])) {
+			numbers << tokens[i].toFloat();
+			++i;
+		}
+
+		// When a command is followed by several points, only the last of them is used. Points that are not
+		// specified are kept from previous commands.
+		if (name == "M" || name == "L") {
+			command.type = name == "M" ? PathCommand::Type::moveTo : PathCommand::Type::lineTo;
+			for (int j = 0; j + 1 < numbers.size(); j += 2) {
+				command.end = QPointF(numbers[j], numbers[j + 1]);
+			}
+		} else if (name == "C") {
+			command.type = PathCommand::Type::cubicTo;
+			for (int j = 0; j + 5 < numbers.size(); j += 6) {
+				command.control1 = QPointF(numbers[j], numbers[j + 1]);
+				command.control2 = QPointF(numbers[j + 2], numbers[j + 3]);
+				command.end = QPointF(numbers[j + 4], numbers[j + 5]);
+			}
+		} else if (name == "Z") {
+			command.type = PathCommand::Type::closeSubpath;
+		} else {
+			continue;
+		}
+
+		result << command;
+	}
+
+	return result;
+}
+
+QVector<QPointF> SdfDisplayList::curve(const QDomElement &element)
+{
+	QPointF start;
+	QPointF control;
+	QPointF end;
+	for (QDomElement point = element.firstChildElement(); !point.isNull(); point = point.nextSiblingElement()) {
+		if (point.tagName() == "start") {
+			start = QPointF(point.attribute("startx").toDouble(), point.attribute("starty").toDouble());
+		} else if (point.tagName() == "end") {
+			end = QPointF(point.attribute("endx").toDouble(), point.attribute("endy").toDouble());
+		} else if (point.tagName() == "ctrl") {
+			control = QPointF(point.attribute("x").toDouble(), point.attribute("y").toDouble());
+		}
+	}
+
+	return { start, control, end };
+}
+
+bool SdfDisplayList::ShowCondition::holds(const QString &propertyValue) const
+{
+	switch (sign) {
+	case Sign::matches:
+		return pattern.exactMatch(propertyValue);
+	case Sign::greater:
+		return propertyValue.toInt() > intValue;
+	case Sign::less:
+		return propertyValue.toInt() < intValue;
+	case Sign::greaterOrEqual:
+		return propertyValue.toInt() >= intValue;
+	case Sign::lessOrEqual:
+		return propertyValue.toInt() <= intValue;
+	case Sign::notEqual:
+		return propertyValue != value;
+	case Sign::equal:
+		return propertyValue == value;
+	case Sign::unsupported:
+		return false;
+	}
+
+	return false;
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QVector>
+#include <QtCore/QPointF>
+#include <QtCore/QRegExp>
+#include <QtCore/QStringList>
+#include <QtGui/QColor>
+#include <QtXml/QDomElement>
+
+namespace qReal {
+namespace details {
+
+/// Sdf picture compiled into a list of typed drawing primitives. Attributes, styles and show conditions are parsed
+/// once when a picture is loaded, so rendering does not touch DOM at all. Coordinates are kept as they are written
+/// in the picture because they are mapped to element bounds only during rendering. Display list is immutable and
+/// is shared by all renderers of the same picture.
+class SdfDisplayList
+{
+public:
+	/// Coordinate or font size as it is written in sdf: in percents of element size, in absolute units or in
+	/// picture units scaled to element size.
+	struct Coordinate
+	{
+		enum class Unit
+		{
+			scaled
+			, percent
+			, absolute
+		};
+
+		Unit unit = Unit::scaled;
+		float value = 0;
+	};
+
+	/// Changes of pen, brush and font made by a primitive, only attributes present in sdf are applied, in the same
+	/// order as they were applied when style was parsed during rendering.
+	struct Style
+	{
+		bool hasStrokeWidth = false;
+		int strokeWidth = 1;
+		bool hasFill = false;
+		QColor fill;
+		bool hasStroke = false;
+		QColor stroke;
+		bool hasStrokeStyle = false;
+		Qt::PenStyle strokeStyle = Qt::SolidLine;
+		bool hasFillStyle = false;
+		Qt::BrushStyle fillStyle = Qt::NoBrush;
+		bool hasFontFill = false;
+		QColor fontFill;
+		bool hasFontSize = false;
+		Coordinate fontSize;
+		bool hasFontName = false;
+		QString fontName;
+		bool hasBold = false;
+		bool bold = false;
+		bool hasItalic = false;
+		bool italic = false;
+		bool hasUnderline = false;
+		bool underline = false;
+	};
+
+	/// "showIf" condition on a logical property of an element.
+	struct ShowCondition
+	{
+		enum class Sign
+		{
+			matches
+			, greater
+			, less
+			, greaterOrEqual
+			, lessOrEqual
+			, notEqual
+			, equal
+			, unsupported
+		};
+
+		Sign sign = Sign::unsupported;
+		QString property;
+		QString value;
+		int intValue = 0;
+		QRegExp pattern;
+
+		/// Returns true if condition holds for given value of the property.
+		bool holds(const QString &propertyValue) const;
+	};
+
+	/// Command of a "path" primitive, points are in picture units.
+	struct PathCommand
+	{
+		enum class Type
+		{
+			moveTo
+			, lineTo
+			, cubicTo
+			, closeSubpath
+		};
+
+		Type type = Type::closeSubpath;
+		QPointF control1;
+		QPointF control2;
+		QPointF end;
+	};
+
+	enum class PrimitiveType
+	{
+		line
+		, ellipse
+		, arc
+		, background
+		, text
+		, rectangle
+		, polygon
+		, point
+		, path
+		, curve
+		, image
+	};
+
+	struct Primitive
+	{
+		PrimitiveType type = PrimitiveType::line;
+		Style style;
+
+		/// Conditions from all "showIf" descendants of sdf element, primitive is drawn only if all of them hold.
+		QList<ShowCondition> showConditions;
+
+		/// Pairs of x and y coordinates: x1, y1, x2, y2 for shapes bounded by a rectangle, x1, y1 for points and
+		/// text, all vertices for polygons.
+		QVector<Coordinate> coordinates;
+
+		/// Angles of an arc, in 1/16th of a degree.
+		int startAngle = 0;
+		int spanAngle = 0;
+
+		/// Lines of a text.
+		QStringList text;
+
+		/// Name of an image file relative to images directory.
+		QString imageName;
+
+		QVector<PathCommand> path;
+
+		/// Start, control and end points of a curve, in picture units.
+		QVector<QPointF> curve;
+	};
+
+	/// Compiles given "picture" sdf element.
+	explicit SdfDisplayList(const QDomElement &picture);
+
+	/// Width of a picture in picture units.
+	int width() const;
+
+	/// Height of a picture in picture units.
+	int height() const;
+
+	const QList<Primitive> &primitives() const;
+
+private:
+	/// Compiles sdf element into primitives, "stylus" element is compiled into several lines.
+	void compileElement(const QDomElement &element);
+
+	static Primitive primitive(PrimitiveType type, const QDomElement &element);
+	static Style style(const QDomElement &element);
+	static QList<ShowCondition> showConditions(const QDomElement &element);
+	static Coordinate coordinate(const QString &value);
+	static QStringList textLines(const QDomElement &element);
+	static QVector<PathCommand> path(const QString &description);
+	static QVector<QPointF> curve(const QDomElement &element);
+
+	int mWidth;
+	int mHeight;
+	QList<Primitive> mPrimitives;
+};
+
+}
+}
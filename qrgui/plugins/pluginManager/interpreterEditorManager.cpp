@@ -12,6 +12,7 @@
 #include <qrutils/outFile.h>
 
 #include "details/interpreterElementImpl.h"
+#include "details/metamodelIndex.h"
 #include "editor/nodeElement.h"
 #include "editor/edgeElement.h"
 
@@ -33,46 +34,27 @@ InterpreterEditorManager::~InterpreterEditorManager()
 	}
 }
 
-Id InterpreterEditorManager::element(const Id &id, const qrRepo::RepoApi * const repo, const Id &diagram) const
+const details::MetamodelIndex &InterpreterEditorManager::index(const qrRepo::RepoApi * const repo) const
 {
-	foreach (const Id &element, repo->children(diagram)) {
-		if (id.element() == repo->name(element) && repo->isLogicalElement(element)) {
-			return element;
-		}
+	QSharedPointer<const details::MetamodelIndex> &snapshot = mIndexes[repo];
+	if (!snapshot) {
+		snapshot.reset(new details::MetamodelIndex(*repo));
 	}
 
-	return Id();
+	return *snapshot;
 }
 
-Id InterpreterEditorManager::diagramOrElement(const Id &id, const qrRepo::RepoApi * const repo, const Id &editor) const
+void InterpreterEditorManager::invalidateIndex(const qrRepo::RepoApi * const repo) const
 {
-	foreach (const Id &diagram, repo->children(editor)) {
-		if (diagram.element() == "MetaEditorDiagramNode"
-				&& id.diagram() == repo->name(diagram)
-				&& repo->isLogicalElement(diagram))
-		{
-			if (!id.element().isEmpty()) {
-				return element(id, repo, diagram);
-			} else {
-				return diagram;
-			}
-		}
-	}
-
-	return Id();
+	mIndexes.remove(repo);
 }
 
 QPair<qrRepo::RepoApi*, Id> InterpreterEditorManager::repoAndMetaId(const Id &id) const
 {
 	foreach (qrRepo::RepoApi *repo, mEditorRepoApi.values()) {
-		foreach (const Id &editor,  repo->elementsByType("MetamodelDiagram")) {
-			if (id.editor() == repo->name(editor) && repo->isLogicalElement(editor)) {
-				if (!id.diagram().isEmpty()) {
-					return qMakePair(repo, diagramOrElement(id, repo, editor));
-				} else {
-					return qMakePair(repo, editor);
-				}
-			}
+		const details::MetamodelIndex &metamodel = index(repo);
+		if (metamodel.hasEditor(id.editor())) {
+			return qMakePair(repo, metamodel.metaId(id));
 		}
 	}
 
@@ -203,35 +185,17 @@ QList<Explosion> InterpreterEditorManager::explosions(const Id &source) const
 
 bool InterpreterEditorManager::isParentOf(const Id &child, const Id &parent) const
 {
-	const qrRepo::RepoApi * const repoMetaModelChild = repoAndMetaId(child).first;
-	const Id repoChild = repoAndMetaId(child).second;
-
-	const qrRepo::RepoApi * const repoMetaModelParent = repoAndMetaId(parent).first;
-	const Id repoParent = repoAndMetaId(parent).second;
-
-	if (repoChild == repoParent && repoMetaModelChild == repoMetaModelParent) {
+	const QPair<qrRepo::RepoApi*, Id> repoAndMetaIdChild = repoAndMetaId(child);
+	const QPair<qrRepo::RepoApi*, Id> repoAndMetaIdParent = repoAndMetaId(parent);
+	if (repoAndMetaIdChild == repoAndMetaIdParent) {
 		return true;
 	}
 
-	if (repoMetaModelChild != repoMetaModelParent) {
+	if (repoAndMetaIdChild.first != repoAndMetaIdParent.first) {
 		return false;
 	}
 
-	foreach (const Id &link , repoMetaModelChild->incomingLinks(repoChild)) {
-		if (link.element() == "Inheritance") {
-			if (repoMetaModelChild->otherEntityFromLink(link, repoChild) == repoParent) {
-				return true;
-			} else {
-				Id metaChildParent = repoMetaModelChild->otherEntityFromLink(link, repoChild);
-				QPair<Id, Id> editorAndDiagramPair = editorAndDiagram(repoMetaModelChild, metaChildParent);
-				return isParentOf(Id(repoMetaModelChild->name(editorAndDiagramPair.first)
-						, repoMetaModelChild->name(editorAndDiagramPair.second)
-						, repoMetaModelChild->name(metaChildParent)), parent);
-			}
-		}
-	}
-
-	return false;
+	return index(repoAndMetaIdChild.first).ancestors(repoAndMetaIdChild.second).contains(repoAndMetaIdParent.second);
 }
 
 bool InterpreterEditorManager::isEditor(const Id &id) const
@@ -326,27 +290,24 @@ QStringList InterpreterEditorManager::propertiesFromParents(const Id &id
 	QPair<qrRepo::RepoApi*, Id> const repoAndMetaIdPair = repoAndMetaId(id);
 	qrRepo::RepoApi * const repo = repoAndMetaIdPair.first;
 	const Id &metaId = repoAndMetaIdPair.second;
-	foreach (const Id &link , repo->incomingLinks(metaId)) {
-		if (link.element() == "Inheritance") {
-			foreach (const Id &parentProperty, repo->children(repo->otherEntityFromLink(link, metaId))) {
-				if (!repo->hasProperty(parentProperty, "isHidden")) {
-					repo->setProperty(parentProperty, "isHidden", "false");
-				}
+	foreach (const Id &metaChildParent, index(repo).generalizations(metaId)) {
+		foreach (const Id &parentProperty, repo->children(metaChildParent)) {
+			if (!repo->hasProperty(parentProperty, "isHidden")) {
+				repo->setProperty(parentProperty, "isHidden", "false");
+			}
 
-				if (repo->stringProperty(parentProperty, "isHidden") == "false") {
-					const QString strProperty = checker.stringProperty(repo, parentProperty, propertyName);
-					if (!strProperty.isEmpty()) {
-						result << strProperty;
-					}
+			if (repo->stringProperty(parentProperty, "isHidden") == "false") {
+				const QString strProperty = checker.stringProperty(repo, parentProperty, propertyName);
+				if (!strProperty.isEmpty()) {
+					result << strProperty;
 				}
 			}
+		}
 
-			const Id metaChildParent = repo->otherEntityFromLink(link, metaId);
-			if (metaChildParent != Id::rootId()) {
-				QPair<Id, Id> const editorAndDiagramPair = editorAndDiagram(repo, metaChildParent);
-				result << propertiesFromParents(Id(repo->name(editorAndDiagramPair.first)
-						, repo->name(editorAndDiagramPair.second), repo->name(metaChildParent)), propertyName, checker);
-			}
+		if (metaChildParent != Id::rootId()) {
+			QPair<Id, Id> const editorAndDiagramPair = editorAndDiagram(repo, metaChildParent);
+			result << propertiesFromParents(Id(repo->name(editorAndDiagramPair.first)
+					, repo->name(editorAndDiagramPair.second), repo->name(metaChildParent)), propertyName, checker);
 		}
 	}
 
@@ -393,14 +354,9 @@ QString InterpreterEditorManager::typeName(const Id &id, const QString &name) co
 Id InterpreterEditorManager::findElementByType(const QString &type) const
 {
 	foreach (const qrRepo::RepoApi * const repo, mEditorRepoApi.values()) {
-		foreach (const Id &editor, repo->elementsByType("MetamodelDiagram")) {
-			foreach (const Id &diagram, repo->children(editor)) {
-				foreach (const Id &element, repo->children(diagram)) {
-					if (type == repo->name(element)) {
-						return Id(repo->name(editor), repo->name(diagram), repo->name(element));
-					}
-				}
-			}
+		const Id element = index(repo).typeByName(type);
+		if (!element.isNull()) {
+			return element;
 		}
 	}
 
@@ -533,15 +489,13 @@ QStringList InterpreterEditorManager::propertyNames(const Id &id) const
 		result << propertiesFromParentsList;
 	}
 
-	foreach (const Id &idProperty, repo->children(metaId)) {
-		if (idProperty.element() == "MetaEntity_Attribute") {
-			if (!repo->hasProperty(idProperty, "isHidden")) {
-				repo->setProperty(idProperty, "isHidden", "false");
-			}
+	foreach (const Id &idProperty, index(repo).attributes(metaId)) {
+		if (!repo->hasProperty(idProperty, "isHidden")) {
+			repo->setProperty(idProperty, "isHidden", "false");
+		}
 
-			if (repo->stringProperty(idProperty, "isHidden") != "true") {
-				result << repo->name(idProperty);
-			}
+		if (repo->stringProperty(idProperty, "isHidden") != "true") {
+			result << repo->name(idProperty);
 		}
 	}
 
@@ -609,18 +563,9 @@ QPair<qrRepo::RepoApi*, Id> InterpreterEditorManager::repoAndElement(const QStri
 		, const QString &element) const
 {
 	foreach (qrRepo::RepoApi * const repo, mEditorRepoApi.values()) {
-		foreach (const Id &edit,  repo->elementsByType("MetamodelDiagram")) {
-			if (editor != repo->name(edit) || !repo->isLogicalElement(edit)) {
-				continue;
-			}
-
-			foreach (const Id &diagram, repo->children(edit)) {
-				foreach (const Id &elem, repo->children(diagram)) {
-					if (element == repo->name(elem)) {
-						return qMakePair(repo, elem);
-					}
-				}
-			}
+		const Id elem = index(repo).elementByName(editor, element);
+		if (!elem.isNull()) {
+			return qMakePair(repo, elem);
 		}
 	}
 
@@ -631,16 +576,9 @@ QPair<qrRepo::RepoApi*, Id> InterpreterEditorManager::repoAndDiagram(const QStri
 		, const QString &diagram) const
 {
 	foreach (qrRepo::RepoApi * const repo, mEditorRepoApi.values()) {
-		foreach (const Id &edit, repo->elementsByType("MetamodelDiagram")) {
-			if (editor != repo->name(edit) || !repo->isLogicalElement(edit)) {
-				continue;
-			}
-
-			foreach (const Id &editChild, repo->children(edit)) {
-				if (diagram == repo->name(editChild)) {
-					return qMakePair(repo, editChild);
-				}
-			}
+		const Id diag = index(repo).diagramByName(editor, diagram);
+		if (!diag.isNull()) {
+			return qMakePair(repo, diag);
 		}
 	}
 
@@ -649,17 +587,7 @@ QPair<qrRepo::RepoApi*, Id> InterpreterEditorManager::repoAndDiagram(const QStri
 
 QPair<Id, Id> InterpreterEditorManager::editorAndDiagram(const qrRepo::RepoApi * const repo, const Id &element) const
 {
-	foreach (const Id &edit,  repo->elementsByType("MetamodelDiagram")) {
-		foreach (const Id &diagram, repo->children(edit)) {
-			foreach (const Id &elem, repo->children(diagram)) {
-				if (element == elem) {
-					return qMakePair(edit, diagram);
-				}
-			}
-		}
-	}
-
-	return QPair<Id, Id>();
+	return index(repo).editorAndDiagram(element);
 }
 
 QList<StringPossibleEdge> InterpreterEditorManager::possibleEdges(const QString &editor
@@ -780,6 +708,7 @@ void InterpreterEditorManager::addProperty(const Id &id, const QString &propDisp
 	propertyNames << propDisplayedName;
 	repoAndMetaIdPair.first->setProperty(newId, "maskedNames", propertyNames);
 	repoAndMetaIdPair.first->setProperty(newId, "isHidden", "false");
+	invalidateIndex(repoAndMetaIdPair.first);
 }
 
 IdList InterpreterEditorManager::elementsWithTheSameName(
@@ -979,15 +908,12 @@ IdList InterpreterEditorManager::children(const Id &parent) const {
 	QPair<qrRepo::RepoApi*, Id> const repoAndMetaIdPair = repoAndMetaId(parent);
 	const qrRepo::RepoApi * const repo = repoAndMetaIdPair.first;
 	const Id metaId = repoAndMetaIdPair.second;
-	foreach (const Id &link , repo->outgoingLinks(metaId)) {
-		if (link.element() == "Inheritance") {
-			const Id metaChild = repo->otherEntityFromLink(link, metaId);
-			QPair<Id, Id> const editorAndDiagramPair = editorAndDiagram(repo, metaChild);
-			const Id child = Id(repo->name(editorAndDiagramPair.first), repo->name(editorAndDiagramPair.second)
-					, repo->name(metaChild));
-			result << child;
-			result << children(child);
-		}
+	foreach (const Id &metaChild, index(repo).specializations(metaId)) {
+		QPair<Id, Id> const editorAndDiagramPair = editorAndDiagram(repo, metaChild);
+		const Id child = Id(repo->name(editorAndDiagramPair.first), repo->name(editorAndDiagramPair.second)
+				, repo->name(metaChild));
+		result << child;
+		result << children(child);
 	}
 
 	return result;
@@ -1116,6 +1042,8 @@ void InterpreterEditorManager::addNodeElement(const Id &diagram, const QString &
 			repo->setTo(containerLink, elem);
 		}
 	}
+
+	invalidateIndex(repo);
 }
 
 void InterpreterEditorManager::addEdgeElement(const Id &diagram, const QString &name
@@ -1142,6 +1070,7 @@ void InterpreterEditorManager::addEdgeElement(const Id &diagram, const QString &
 	repo->setProperty(associationId, "name", name + "Association");
 	repo->setProperty(associationId, "beginType", beginType);
 	repo->setProperty(associationId, "endType", endType);
+	invalidateIndex(repo);
 }
 
 QPair<Id, Id> InterpreterEditorManager::createEditorAndDiagram(const QString &name) const
@@ -1168,6 +1097,7 @@ QPair<Id, Id> InterpreterEditorManager::createEditorAndDiagram(const QString &na
 	setStandartConfigurations(repo, containerLink, Id::rootId(), "Container");
 	repo->setFrom(containerLink, nodeId);
 	repo->setTo(containerLink, nodeId);
+	invalidateIndex(repo);
 	return qMakePair(Id(repo->name(editor)), Id(repo->name(editor), repo->name(diagram)));
 }
 
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <QtCore/QDir>
+#include <QtCore/QHash>
 #include <QtCore/QStringList>
 #include <QtCore/QMap>
 #include <QtCore/QPluginLoader>
 #include <QtCore/QStringList>
 #include <QtCore/QPair>
+#include <QtCore/QSharedPointer>
 #include <QtGui/QIcon>
 
 #include <qrkernel/ids.h>
@@ -23,6 +25,10 @@ namespace qReal {
 
 class Element;
 
+namespace details {
+class MetamodelIndex;
+}
+
 class QRGUI_PLUGINS_MANAGER_EXPORT InterpreterEditorManager : public QObject, public EditorManagerInterface
 {
 	Q_OBJECT
@@ -151,9 +157,14 @@ private:
 	QMap<QString, qrRepo::RepoApi*> mEditorRepoApi;  // Has ownership.
 	QString mMetamodelFile;
 
+	/// Snapshots of metamodels structure, built on first query to a repository and dropped when this manager adds
+	/// something to it.
+	mutable QHash<const qrRepo::RepoApi *, QSharedPointer<const details::MetamodelIndex>> mIndexes;
+
+	const details::MetamodelIndex &index(const qrRepo::RepoApi * const repo) const;
+	void invalidateIndex(const qrRepo::RepoApi * const repo) const;
+
 	void setProperty(qrRepo::RepoApi* repo, const Id &id, const QString &property, const QVariant &propertyValue) const;
-	Id element(const Id &id, const qrRepo::RepoApi * const repo, const Id &diagram) const;
-	Id diagramOrElement(const Id &id, const qrRepo::RepoApi * const repo, const Id &editor) const;
 	void setStandartConfigurations(qrRepo::RepoApi *repo, const Id &id, const Id &parent, const QString &name) const;
 	QPair<qrRepo::RepoApi*, Id> repoAndMetaId(const Id &id) const;
 	QPair<qrRepo::RepoApi*, Id> repoAndElement(const QString &editor, const QString &element) const;
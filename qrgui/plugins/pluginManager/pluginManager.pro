@@ -29,6 +29,8 @@ HEADERS += \
 	$$PWD/details/patternParser.h \
 	$$PWD/details/interpreterElementImpl.h \
 	$$PWD/details/interpreterPortImpl.h \
+	$$PWD/details/sdfDisplayList.h \
+	$$PWD/details/metamodelIndex.h \
 
 SOURCES += \
 	$$PWD/editorManager.cpp \
@@ -43,6 +45,8 @@ SOURCES += \
 	$$PWD/details/patternParser.cpp \
 	$$PWD/details/interpreterElementImpl.cpp \
 	$$PWD/details/interpreterPortImpl.cpp \
+	$$PWD/details/sdfDisplayList.cpp \
+	$$PWD/details/metamodelIndex.cpp \
 
 RESOURCES += \
 	$$PWD/pluginManager.qrc \
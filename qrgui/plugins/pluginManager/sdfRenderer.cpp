@@ -6,20 +6,51 @@
 #include <QtCore/QRegExp>
 #include <QtCore/QFileInfo>
 #include <QtCore/QDir>
+#include <QtCore/QMutex>
 #include <QtWidgets/QApplication>
 #include <QtGui/QFont>
 #include <QtGui/QIcon>
 
 using namespace qReal;
+using namespace qReal::details;
+
+/// Returns display list of given sdf file, compiling it on first request. Display lists are kept for the whole
+/// lifetime of the application, so every element type parses its picture only once. Returns null pointer if file
+/// can not be loaded.
+static QSharedPointer<const SdfDisplayList> compiledDisplayList(const QString &filename)
+{
+	static QHash<QString, QSharedPointer<const SdfDisplayList>> displayLists;
+	static QMutex mutex;
+
+	QMutexLocker lock(&mutex);
+	const auto cached = displayLists.constFind(filename);
+	if (cached != displayLists.constEnd()) {
+		return *cached;
+	}
+
+	QFile file(filename);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		return QSharedPointer<const SdfDisplayList>();
+	}
+
+	QDomDocument document;
+	if (!document.setContent(&file)) {
+		return QSharedPointer<const SdfDisplayList>();
+	}
+
+	const QSharedPointer<const SdfDisplayList> result(new SdfDisplayList(document.documentElement()));
+	displayLists.insert(filename, result);
+	return result;
+}
 
 SdfRenderer::SdfRenderer()
-	: mStartX(0), mStartY(0), mNeedScale(true), mElementRepo(0)
+	: mStartX(0), mStartY(0), mPainter(nullptr), mNeedScale(true), mElementRepo(0)
 {
 	mWorkingDirName = SettingsManager::value("workingDir").toString();
 }
 
 SdfRenderer::SdfRenderer(const QString path)
-	: mStartX(0), mStartY(0), mNeedScale(true)
+	: mStartX(0), mStartY(0), mPainter(nullptr), mNeedScale(true), mElementRepo(0)
 {
 	if (!load(path))
 	{
@@ -34,32 +65,14 @@ SdfRenderer::~SdfRenderer()
 
 bool SdfRenderer::load(const QString &filename)
 {
-	QFile file(filename);
-
-	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-		return false;
-
-	if (!doc.setContent(&file))
-	{
-		file.close();
-		return false;
-	}
-	file.close();
-
-	QDomElement docElem = doc.documentElement();
-	first_size_x = docElem.attribute("sizex").toInt();
-	first_size_y = docElem.attribute("sizey").toInt();
-
-	return true;
+	mDisplayList = compiledDisplayList(filename);
+	return !mDisplayList.isNull();
 }
 
 bool SdfRenderer::load(const QDomDocument &document)
 {
-	doc = document;
-	const QDomElement docElem = doc.firstChildElement("picture");
-	first_size_x = docElem.attribute("sizex").toInt();
-	first_size_y = docElem.attribute("sizey").toInt();
-
+	// Documents are built by interpreted editors for each element separately, so they are not shared.
+	mDisplayList.reset(new SdfDisplayList(document.documentElement()));
 	return true;
 }
 
@@ -74,688 +87,292 @@ void SdfRenderer::invalidateSvgCache(double zoomFactor)
 
 void SdfRenderer::render(QPainter *painter, const QRectF &bounds, bool isIcon)
 {
-	current_size_x = static_cast<int>(bounds.width());
-	current_size_y = static_cast<int>(bounds.height());
+	if (!mDisplayList) {
+		return;
+	}
+
+	mCurrentWidth = static_cast<int>(bounds.width());
+	mCurrentHeight = static_cast<int>(bounds.height());
 	mStartX = static_cast<int>(bounds.x());
 	mStartY = static_cast<int>(bounds.y());
-	this->painter = painter;
-	QDomElement docElem = doc.documentElement();
-	QDomNode node = docElem.firstChild();
-	while(!node.isNull())
-	{
-		QDomElement elem = node.toElement();
-		if(!elem.isNull())
-		{
-			if (!checkShowConditions(elem, isIcon)) {
-				node = node.nextSibling();
-				continue;
-			}
-			if (elem.tagName()=="line")
-			{
-				line(elem);
-			}
-			else if(elem.tagName()=="ellipse")
-			{
-				ellipse(elem);
-			}
-			else if (elem.tagName() == "arc") {
-				arc(elem);
-			}
-			else if(elem.tagName()=="background")
-			{
-				background(elem);
-			}
-			else if(elem.tagName()=="text")
-			{
-				draw_text(elem);
-			}
-			else if (elem.tagName()=="rectangle")
-			{
-				rectangle(elem);
-			}
-			else if (elem.tagName()=="polygon")
-			{
-				polygon(elem);
-			}
-			else if (elem.tagName()=="point")
-			{
-				point(elem);
-			}
-			else if(elem.tagName()=="path")
-			{
-				path_draw(elem);
-			}
-			else if(elem.tagName()=="stylus")
-			{
-				stylus_draw(elem);
-			}
-			else if(elem.tagName()=="curve")
-			{
-				curve_draw(elem);
-			}
-			else if(elem.tagName()=="image")
-			{
-				image_draw(elem);
-			}
+	mPainter = painter;
+
+	for (const Primitive &primitive : mDisplayList->primitives()) {
+		if (checkShowConditions(primitive, isIcon)) {
+			draw(primitive);
 		}
-		node = node.nextSibling();
 	}
-	this->painter = 0;
+
+	mPainter = nullptr;
 }
 
-bool SdfRenderer::checkShowConditions(const QDomElement &element, bool isIcon) const
+bool SdfRenderer::checkShowConditions(const Primitive &primitive, bool isIcon) const
 {
-	QDomNodeList showConditions = element.elementsByTagName("showIf");
 	// a hack, need to be removed when there is another version of icons
-	if (!showConditions.isEmpty() && isIcon) {
+	if (!primitive.showConditions.isEmpty() && isIcon) {
 		return false;
 	}
-	if (showConditions.isEmpty() || !mElementRepo) {
+
+	if (!mElementRepo) {
 		return true;
 	}
-	for (int i = 0; i < showConditions.length(); ++i) {
-		if (!checkCondition(showConditions.at(i).toElement())) {
+
+	for (const SdfDisplayList::ShowCondition &condition : primitive.showConditions) {
+		if (!condition.holds(mElementRepo->logicalProperty(condition.property))) {
 			return false;
 		}
 	}
+
 	return true;
 }
 
-bool SdfRenderer::checkCondition(const QDomElement &condition) const
-{
-	QString sign = condition.attribute("sign");
-	QString realValue = mElementRepo->logicalProperty(condition.attribute("property"));
-	QString conditionValue = condition.attribute("value");
-
-	if (sign == "=~") {
-		return QRegExp(conditionValue).exactMatch(realValue);
-	} else if (sign == ">") {
-		return realValue.toInt() > conditionValue.toInt();
-	} else if (sign == "<") {
-		return realValue.toInt() < conditionValue.toInt();
-	} else if (sign == ">=") {
-		return realValue.toInt() >= conditionValue.toInt();
-	} else if (sign == "<=") {
-		return realValue.toInt() <= conditionValue.toInt();
-	} else if (sign == "!=") {
-		return realValue != conditionValue;
-	} else if (sign == "=") {
-		return realValue == conditionValue;
-	} else {
-		qDebug() << "Unsupported logical operator \"" + sign + "\"";
-		return false;
+void SdfRenderer::draw(const Primitive &primitive)
+{
+	const QVector<Coordinate> &coordinates = primitive.coordinates;
+
+	switch (primitive.type) {
+	case PrimitiveType::line:
+		applyStyle(primitive.style);
+		mPainter->drawLine(QLineF(mapX(coordinates[0]), mapY(coordinates[1])
+				, mapX(coordinates[2]), mapY(coordinates[3])));
+		break;
+	case PrimitiveType::ellipse:
+		applyStyle(primitive.style);
+		mPainter->drawEllipse(mapRect(primitive));
+		break;
+	case PrimitiveType::arc:
+		applyStyle(primitive.style);
+		mPainter->drawArc(mapRect(primitive), primitive.startAngle, primitive.spanAngle);
+		break;
+	case PrimitiveType::background:
+		applyStyle(primitive.style);
+		mPainter->setPen(mBrush.color());
+		mPainter->drawRect(mPainter->window());
+		defaultstyle();
+		break;
+	case PrimitiveType::text:
+		drawText(primitive);
+		break;
+	case PrimitiveType::rectangle:
+		applyStyle(primitive.style);
+		mPainter->drawRect(mapRect(primitive));
+		defaultstyle();
+		break;
+	case PrimitiveType::polygon:
+		drawPolygon(primitive);
+		break;
+	case PrimitiveType::point: {
+		applyStyle(primitive.style);
+		const QPointF point(mapX(coordinates[0]), mapY(coordinates[1]));
+		mPainter->drawLine(QPointF(point.x() - 0.1, point.y() - 0.1), QPointF(point.x() + 0.1, point.y() + 0.1));
+		defaultstyle();
+		break;
+	}
+	case PrimitiveType::path:
+		drawPath(primitive);
+		break;
+	case PrimitiveType::curve:
+		drawCurve(primitive);
+		break;
+	case PrimitiveType::image:
+		drawImage(primitive);
+		break;
 	}
 }
 
-void SdfRenderer::line(QDomElement &element)
+void SdfRenderer::drawText(const Primitive &primitive)
 {
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
-	QLineF line (x1,y1,x2,y2);
+	applyStyle(primitive.style);
+	mPen.setStyle(Qt::SolidLine);
+	mPainter->setPen(mPen);
+	const float x = mapX(primitive.coordinates[0]);
+	float y = mapY(primitive.coordinates[1]);
 
-	parsestyle(element);
-	painter->drawLine(line);
-}
-
-void SdfRenderer::ellipse(QDomElement &element)
-{
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
+	const QStringList &lines = primitive.text;
+	for (int i = 0; i < lines.size() - 1; ++i) {
+		mPainter->drawText(static_cast<int>(x), static_cast<int>(y), lines[i]);
+		y += mPainter->font().pixelSize();
+	}
 
-	QRectF rect(x1, y1, x2-x1, y2-y1);
-	parsestyle(element);
-	painter->drawEllipse(rect);
+	mPainter->drawText(QPointF(x, y), lines.last());
+	defaultstyle();
 }
 
-void SdfRenderer::arc(QDomElement &element)
+void SdfRenderer::drawPolygon(const Primitive &primitive)
 {
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
-	int startAngle = element.attribute("startAngle").toInt();
-	int spanAngle = element.attribute("spanAngle").toInt();
-
-	QRectF rect(x1, y1, x2-x1, y2-y1);
-	parsestyle(element);
-	painter->drawArc(rect, startAngle, spanAngle);
-}
+	applyStyle(primitive.style);
+	QVector<QPoint> points;
+	points.reserve(primitive.coordinates.size() / 2);
+	for (int i = 0; i + 1 < primitive.coordinates.size(); i += 2) {
+		points << QPoint(static_cast<int>(mapX(primitive.coordinates[i]))
+				, static_cast<int>(mapY(primitive.coordinates[i + 1])));
+	}
 
-void SdfRenderer::background(QDomElement &element)
-{
-	parsestyle(element);
-	painter->setPen(brush.color());
-	painter->drawRect(painter->window());
+	mPainter->drawConvexPolygon(points.constData(), points.size());
 	defaultstyle();
 }
 
-void SdfRenderer::draw_text(QDomElement &element)
+void SdfRenderer::drawPath(const Primitive &primitive)
 {
-	parsestyle(element);
-	pen.setStyle(Qt::SolidLine);
-	painter->setPen(pen);
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	QString str = element.text();
-
-	// delete "\n" from the beginning of the string
-	if (str[0] == '\n')
-		str.remove(0, 1);
-
-	// delete "\n" from the end of the string
-	if (str[str.length() - 1] == '\n')
-		str.remove(str.length() - 1, 1);
+	QPainterPath path;
+	for (const SdfDisplayList::PathCommand &command : primitive.path) {
+		switch (command.type) {
+		case SdfDisplayList::PathCommand::Type::moveTo:
+			path.moveTo(mapPoint(command.end));
+			break;
+		case SdfDisplayList::PathCommand::Type::lineTo:
+			path.lineTo(mapPoint(command.end));
+			break;
+		case SdfDisplayList::PathCommand::Type::cubicTo:
+			path.cubicTo(mapPoint(command.control1), mapPoint(command.control2), mapPoint(command.end));
+			break;
+		case SdfDisplayList::PathCommand::Type::closeSubpath:
+			path.closeSubpath();
+			break;
+		}
+	}
 
-	while (str.contains('\n'))
-	{
-		int i = str.indexOf('\n');
-		QString temp = str.left(i);
-		str.remove(0, i + 1);
-		painter->drawText(static_cast<int>(x1), static_cast<int>(y1), temp);
-		y1 += painter->font().pixelSize() ;
-	}
-	QPointF point(x1, y1);
-	painter->drawText(point, str);
-	defaultstyle();
+	applyStyle(primitive.style);
+	mPainter->drawPath(path);
 }
 
-void SdfRenderer::rectangle(QDomElement &element)
+void SdfRenderer::drawCurve(const Primitive &primitive)
 {
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
+	// Curves are not shifted to element position, and control point is rounded to integer coordinates.
+	const QPointF start(primitive.curve[0].x() * mCurrentWidth / pictureWidth()
+			, primitive.curve[0].y() * mCurrentHeight / pictureHeight());
+	const QPoint control(static_cast<int>(primitive.curve[1].x() * mCurrentWidth / pictureWidth())
+			, static_cast<int>(primitive.curve[1].y() * mCurrentHeight / pictureHeight()));
+	const QPointF end(primitive.curve[2].x() * mCurrentWidth / pictureWidth()
+			, primitive.curve[2].y() * mCurrentHeight / pictureHeight());
 
-	QRectF rect;
-	rect.adjust(x1, y1, x2, y2);
-	parsestyle(element);
-	painter->drawRect(rect);
-	defaultstyle();
+	QPainterPath path(start);
+	path.quadTo(control, end);
+	applyStyle(primitive.style);
+	mPainter->drawPath(path);
 }
 
-void SdfRenderer::polygon(QDomElement &element)
+void SdfRenderer::drawImage(const Primitive &primitive)
 {
-	parsestyle(element);
-	// FIXME: init points array here
-	QPoint *points = nullptr;
-	int n = element.attribute("n").toInt();
-	if (!element.isNull())
-	{
-		points = getpoints(element, n);
-	}
-	if (points != nullptr)
-	{
-		painter->drawConvexPolygon(points, n);
-		delete[] points;
-	}
-	defaultstyle();
+	const QRectF bounds = mapRect(primitive);
+	const QRect rect(static_cast<int>(bounds.x()), static_cast<int>(bounds.y())
+			, static_cast<int>(bounds.width()), static_cast<int>(bounds.height()));
+
+	const QString fileName = SettingsManager::value("pathToImages").toString() + "/" + primitive.imageName;
+	mImagesCache.drawImage(fileName, *mPainter, rect);
 }
 
-void SdfRenderer::image_draw(QDomElement &element)
+void SdfRenderer::applyStyle(const Style &style)
 {
-	float const x1 = x1_def(element);
-	float const y1 = y1_def(element);
-	float const x2 = x2_def(element);
-	float const y2 = y2_def(element);
+	if (style.hasStrokeWidth) {
+		// for painting icons. width of all lines should be set to 1
+		mPen.setWidth(mNeedScale ? style.strokeWidth : 1);
+	}
 
-	const QString fileName = SettingsManager::value("pathToImages").toString() + "/"
-			+ element.attribute("name", "default");
+	if (style.hasFill) {
+		mBrush.setStyle(Qt::SolidPattern);
+		mBrush.setColor(style.fill);
+	}
 
-	const QRect rect(x1, y1, x2 - x1, y2 - y1);
+	if (style.hasStroke) {
+		mPen.setColor(style.stroke);
+	}
 
-	mImagesCache.drawImage(fileName, *painter, rect);
-}
+	if (style.hasStrokeStyle) {
+		mPen.setStyle(style.strokeStyle);
+	}
 
-void SdfRenderer::point(QDomElement &element)
-{
-	parsestyle(element);
-	float x = x1_def(element);
-	float y = y1_def(element);
-	QPointF pointf(x,y);
-	painter->drawLine(QPointF(pointf.x()-0.1, pointf.y()-0.1), QPointF(pointf.x()+0.1, pointf.y()+0.1));
-	defaultstyle();
-}
+	if (style.hasFillStyle) {
+		mBrush.setStyle(style.fillStyle);
+	}
 
-QPoint *SdfRenderer::getpoints(QDomElement &element, int n)
-{
-	QPoint *array = new QPoint[n];
-	float x = 0;
-	float y = 0;
-	for (int i = 0; i < n; i++)
-	{
-		QString str;
-		str.setNum(i + 1);
-		QDomElement elem = element;
-		QString xnum = elem.attribute(QString("x").append(str));
-		if (xnum.endsWith("%"))
-		{
-			xnum.chop(1);
-			x = current_size_x * xnum.toFloat() / 100 + mStartX;
-		}
-		else if (xnum.endsWith("a") && mNeedScale)
-		{
-			xnum.chop(1);
-			x = xnum.toFloat() + mStartX;
-		}
-		else if (xnum.endsWith("a") && !mNeedScale)
-		{
-			xnum.chop(1);
-			x = xnum.toFloat() * current_size_x / first_size_x + mStartX;
-		}
-		else
-			x = xnum.toFloat() * current_size_x / first_size_x + mStartX;
-
-		QString ynum = elem.attribute(QString("y").append(str));
-		if (ynum.endsWith("%"))
-		{
-			ynum.chop(1);
-			y = current_size_y * ynum.toFloat() / 100 + mStartY;
-		}
-		else if (ynum.endsWith("a") && mNeedScale)
-		{
-			ynum.chop(1);
-			y = ynum.toFloat() + mStartY;
-		}
-		else if (ynum.endsWith("a") && !mNeedScale)
-		{
-			ynum.chop(1);
-			y = ynum.toFloat() * current_size_y / first_size_y + mStartY;
-		}
-		else
-			y = ynum.toFloat() * current_size_y / first_size_y + mStartY;
+	if (style.hasFontFill) {
+		mPen.setColor(style.fontFill);
+	}
 
-		array[i].setX(static_cast<int>(x));
-		array[i].setY(static_cast<int>(y));
+	if (style.hasFontSize) {
+		mFont.setPixelSize(fontPixelSize(style.fontSize));
 	}
-	return array;
-}
 
-void SdfRenderer::defaultstyle()
-{
-	pen.setColor(QColor(0,0,0));
-	brush.setColor(QColor(255,255,255));
-	pen.setStyle(Qt::SolidLine);
-	brush.setStyle(Qt::NoBrush);
-	pen.setWidth(1);
-}
+	if (style.hasFontName) {
+		mFont.setFamily(style.fontName);
+	}
 
-bool SdfRenderer::isNotLCMZ(QString str, int i)
-{
-	return (str[i] != 'L') && (str[i] != 'C') && (str[i] != 'M')
-		&& (str[i] != 'Z') && (i != str.length());
-}
+	if (style.hasBold) {
+		mFont.setBold(style.bold);
+	}
 
-void SdfRenderer::path_draw(QDomElement &element)
-{
-	QPointF end_point;
-	QPointF c1;
-	QPointF c2;
-	QDomElement elem = element;
-	QPainterPath path;
+	if (style.hasItalic) {
+		mFont.setItalic(style.italic);
+	}
 
-	if (!elem.isNull())
-	{
-		QString d_cont;
-		d_cont = elem.attribute("d").remove(0, 1);
-		d_cont.append(" Z");
-
-		for (i = 0; i < d_cont.length() - 1;)
-		{
-			if (d_cont[i] == 'M')
-			{
-				j = i + 2;
-				while (isNotLCMZ(d_cont, j))
-				{
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					++j;
-					s1.clear();
-				}
-
-				path.moveTo(end_point);
-				i = j;
-			}
-			else if (d_cont[i] == 'L')
-			{
-				j = i + 2;
-				while (isNotLCMZ(d_cont, j))
-				{
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-					end_point.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					++j;
-					s1.clear();
-				}
-
-				 path.lineTo(end_point);
-				 i = j;
-			}
-			 else if (d_cont[i] == 'C')
-			{
-				j = i + 2;
-				while(isNotLCMZ(d_cont, j))
-				{
-					while (!(d_cont[j] == ' '))
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c1.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c1.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c2.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c2.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					s1.clear();
-					++j;
-				}
-
-				path.cubicTo(c1, c2, end_point);
-				i = j;
-
-			} else if (d_cont[i] == 'Z')
-			{
-				path.closeSubpath();
-				logger ("loggerZ.txt", "DONE");
-			}
-		}
+	if (style.hasUnderline) {
+		mFont.setUnderline(style.underline);
 	}
 
-	parsestyle(element);
-	painter->drawPath(path);
+	mPainter->setFont(mFont);
+	mPainter->setPen(mPen);
+	mPainter->setBrush(mBrush);
 }
 
-void SdfRenderer::stylus_draw(QDomElement &element)
+void SdfRenderer::defaultstyle()
 {
-	QDomNode node = element.firstChild();
-	while(!node.isNull())
-	{
-		QDomElement elem = node.toElement();
-		if(!elem.isNull())
-		{
-			if (elem.tagName()=="line")
-			{
-				line(elem);
-			}
-		}
-		node = node.nextSibling();
-	}
+	mPen.setColor(QColor(0,0,0));
+	mBrush.setColor(QColor(255,255,255));
+	mPen.setStyle(Qt::SolidLine);
+	mBrush.setStyle(Qt::NoBrush);
+	mPen.setWidth(1);
 }
 
-void SdfRenderer::curve_draw(QDomElement &element)
+float SdfRenderer::mapCoordinate(const Coordinate &coordinate, int currentSize, int pictureSize) const
 {
-	QDomNode node = element.firstChild();
-	QPointF start(0, 0);
-	QPointF end(0, 0);
-	QPoint c1(0, 0);
-	while(!node.isNull())
-	{
-		QDomElement elem = node.toElement();
-		if(!elem.isNull())
-		{
-			if (elem.tagName() == "start")
-			{
-				start.setX(elem.attribute("startx").toDouble() * current_size_x / first_size_x);
-				start.setY(elem.attribute("starty").toDouble() * current_size_y / first_size_y);
-			}
-			else if (elem.tagName() == "end")
-			{
-				end.setX(elem.attribute("endx").toDouble() * current_size_x / first_size_x);
-				end.setY(elem.attribute("endy").toDouble() * current_size_y / first_size_y);
-			}
-			else if (elem.tagName() == "ctrl")
-			{
-				c1.setX(elem.attribute("x").toDouble() * current_size_x / first_size_x);
-				c1.setY(elem.attribute("y").toDouble() * current_size_y / first_size_y);
-			}
-		}
-		node = node.nextSibling();
+	switch (coordinate.unit) {
+	case Coordinate::Unit::percent:
+		return currentSize * coordinate.value / 100;
+	case Coordinate::Unit::absolute:
+		return mNeedScale ? coordinate.value : coordinate.value * currentSize / pictureSize;
+	case Coordinate::Unit::scaled:
+		return coordinate.value * currentSize / pictureSize;
 	}
 
-	QPainterPath path(start);
-	path.quadTo(c1, end);
-	parsestyle(element);
-	painter->drawPath(path);
+	return 0;
 }
 
-void SdfRenderer::parsestyle(QDomElement &element)
+float SdfRenderer::mapX(const Coordinate &coordinate) const
 {
-	QDomElement elem = element;
-	if(!elem.isNull())
-	{
-		if (elem.hasAttribute("stroke-width"))
-		{
-			if (mNeedScale)
-				pen.setWidth(elem.attribute("stroke-width").toInt());
-			else  // for painting icons. width of all lines should be set to 1
-				pen.setWidth(1);
-		}
-
-		if (elem.hasAttribute("fill"))
-		{
-			QColor color = elem.attribute("fill");
-			brush.setStyle(Qt::SolidPattern);
-			brush.setColor(color);
-		}
-
-		if (elem.hasAttribute("stroke"))
-		{
-			QColor color = elem.attribute("stroke");
-			pen.setColor(color);
-		}
-
-		if (elem.hasAttribute("stroke-style"))
-		{
-			if (elem.attribute("stroke-style") == "solid")
-				pen.setStyle(Qt::SolidLine);
-			if (elem.attribute("stroke-style") == "dot")
-				pen.setStyle(Qt::DotLine);
-			if (elem.attribute("stroke-style") == "dash")
-				pen.setStyle(Qt::DashLine);
-			if (elem.attribute("stroke-style") == "dashdot")
-				pen.setStyle(Qt::DashDotLine);
-			if (elem.attribute("stroke-style") == "dashdotdot")
-				pen.setStyle(Qt::DashDotDotLine);
-			if (elem.attribute("stroke-style") == "none")
-				pen.setStyle(Qt::NoPen);
-		}
-
-		if (elem.hasAttribute("fill-style"))
-		{
-			if (elem.attribute("fill-style")=="none")
-				brush.setStyle(Qt::NoBrush);
-			else if(elem.attribute("fill-style")=="solid")
-				brush.setStyle(Qt::SolidPattern);
-		}
-
-		if (elem.hasAttribute("font-fill"))
-		{
-			QColor color = elem.attribute("font-fill");
-			pen.setColor(color);
-		}
-
-		if (elem.hasAttribute("font-size"))
-		{
-			QString fontsize = elem.attribute("font-size");
-			if (fontsize.endsWith("%"))
-			{
-				fontsize.chop(1);
-				font.setPixelSize(current_size_y * fontsize.toInt() / 100);
-			}
-			else if (fontsize.endsWith("a") && mNeedScale)
-			{
-				fontsize.chop(1);
-				font.setPixelSize(fontsize.toInt());
-			}
-			else if (fontsize.endsWith("a") && !mNeedScale)
-			{
-				fontsize.chop(1);
-				font.setPixelSize(fontsize.toInt() * current_size_y / first_size_y);
-			}
-			else
-				font.setPixelSize(fontsize.toInt() * current_size_y / first_size_y);
-		}
-
-		if (elem.hasAttribute("font-name"))
-		{
-			font.setFamily(elem.attribute("font-name"));
-		}
-
-		if (elem.hasAttribute("b"))
-		{
-			font.setBold(elem.attribute("b").toInt());
-		}
-
-		if (elem.hasAttribute("i"))
-		{
-			font.setItalic(elem.attribute("i").toInt());
-		}
-
-		if (elem.hasAttribute("u"))
-		{
-			font.setUnderline(elem.attribute("u").toInt());
-		}
-
-		painter->setFont(font);
-	}
-	painter->setPen(pen);
-	painter->setBrush(brush);
-}
-
-float SdfRenderer::coord_def(QDomElement &element, QString coordName, int current_size, int first_size)
-{
-	float coord = 0;
-	QString coordStr = element.attribute(coordName);
-
-	if (coordStr.endsWith("%"))
-	{
-		coordStr.chop(1);
-		coord = current_size * coordStr.toFloat() / 100;
-		return coord;
-	}
-	else if (coordStr.endsWith("a") && mNeedScale)
-	{
-		coordStr.chop(1);
-		coord = coordStr.toFloat();
-		return coord;
-	}
-	else if (coordStr.endsWith("a") && !mNeedScale)
-	{
-		coordStr.chop(1);
-		coord = coordStr.toFloat() * current_size / first_size;
-		return coord;
-	}
-	else
-	{
-		coord = coordStr.toFloat() * current_size / first_size;
-		return coord;
-	}
+	return mapCoordinate(coordinate, mCurrentWidth, mDisplayList->width()) + mStartX;
 }
 
-float SdfRenderer::x1_def(QDomElement &element)
+float SdfRenderer::mapY(const Coordinate &coordinate) const
 {
-	return coord_def(element, "x1", current_size_x, first_size_x) + mStartX;
+	return mapCoordinate(coordinate, mCurrentHeight, mDisplayList->height()) + mStartY;
 }
 
-float SdfRenderer::y1_def(QDomElement &element)
+QPointF SdfRenderer::mapPoint(const QPointF &point) const
 {
-	return coord_def(element, "y1", current_size_y, first_size_y) + mStartY;
+	return QPointF(static_cast<float>(point.x()) * mCurrentWidth / mDisplayList->width() + mStartX
+			, static_cast<float>(point.y()) * mCurrentHeight / mDisplayList->height() + mStartY);
 }
 
-float SdfRenderer::x2_def(QDomElement &element)
+QRectF SdfRenderer::mapRect(const Primitive &primitive) const
 {
-	return coord_def(element, "x2", current_size_x, first_size_x) + mStartX;
+	return QRectF(QPointF(mapX(primitive.coordinates[0]), mapY(primitive.coordinates[1]))
+			, QPointF(mapX(primitive.coordinates[2]), mapY(primitive.coordinates[3])));
 }
 
-float SdfRenderer::y2_def(QDomElement &element)
+int SdfRenderer::fontPixelSize(const Coordinate &size) const
 {
-	return coord_def(element, "y2", current_size_y, first_size_y) + mStartY;
-}
+	const int value = static_cast<int>(size.value);
+	switch (size.unit) {
+	case Coordinate::Unit::percent:
+		return mCurrentHeight * value / 100;
+	case Coordinate::Unit::absolute:
+		return mNeedScale ? value : value * mCurrentHeight / mDisplayList->height();
+	case Coordinate::Unit::scaled:
+		return value * mCurrentHeight / mDisplayList->height();
+	}
 
-void SdfRenderer::logger(QString path, QString string)
-{	log.setFileName(path);
-	log.open(QIODevice::Append | QIODevice::Text);
-	logtext.setDevice(&log);
-	logtext << string << "\n";
-	log.close();
+	return 0;
 }
 
 void SdfRenderer::noScale()
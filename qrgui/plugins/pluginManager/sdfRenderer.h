@@ -19,6 +19,7 @@
 #include <plugins/editorPluginInterface/sdfRendererInterface.h>
 #include <plugins/editorPluginInterface/elementRepoInterface.h>
 #include "plugins/pluginManager/pluginsManagerDeclSpec.h"
+#include "plugins/pluginManager/details/sdfDisplayList.h"
 
 #include "pluginsManagerDeclSpec.h"
 
@@ -38,8 +39,8 @@ public:
 	void render(QPainter *painter, const QRectF &bounds, bool isIcon = false);
 	void noScale();
 
-	int pictureWidth() { return first_size_x; }
-	int pictureHeight() { return first_size_y; }
+	int pictureWidth() { return mDisplayList ? mDisplayList->width() : 0; }
+	int pictureHeight() { return mDisplayList ? mDisplayList->height() : 0; }
 
 	void setElementRepo(ElementRepoInterface *elementRepo);
 
@@ -87,29 +88,27 @@ private:
 		double mCurrentZoomFactor = 1;
 	};
 
+	typedef details::SdfDisplayList::Coordinate Coordinate;
+	typedef details::SdfDisplayList::Primitive Primitive;
+	typedef details::SdfDisplayList::PrimitiveType PrimitiveType;
+	typedef details::SdfDisplayList::Style Style;
+
 	QString mWorkingDirName;
 
 	/// Smart cache for images, to avoid loading image from disc on every paint() call.
 	ImagesCache mImagesCache;
 
-	int first_size_x;
-	int first_size_y;
-	int current_size_x;
-	int current_size_y;
+	/// Compiled picture, shared with all other renderers of the same sdf file.
+	QSharedPointer<const details::SdfDisplayList> mDisplayList;
+
+	int mCurrentWidth;
+	int mCurrentHeight;
 	int mStartX;
 	int mStartY;
-	int i;
-	int j;
-	int sep;
-	QPainter *painter;
-	QPen pen;
-	QBrush brush;
-	QString s1;
-	QString s2;
-	QFont font;
-	QFile log;
-	QTextStream logtext;
-	QDomDocument doc;
+	QPainter *mPainter;  // Doesn't have ownership.
+	QPen mPen;
+	QBrush mBrush;
+	QFont mFont;
 
 	/** @brief is false if we don't need to scale according to absolute
 	 * coords, is useful for rendering icons. default is true
@@ -117,34 +116,31 @@ private:
 	bool mNeedScale;
 	ElementRepoInterface *mElementRepo;
 
-	bool checkShowConditions(const QDomElement &element, bool isIcon) const;
-	bool checkCondition(const QDomElement &condition) const;
-
-	void line(QDomElement &element);
-	void ellipse(QDomElement &element);
-	void arc(QDomElement &element);
-	void parsestyle(QDomElement &element);
-	void background(QDomElement &element);
-	void draw_text(QDomElement &element);
-	void rectangle(QDomElement &element);
-	void polygon(QDomElement &element);
-	QPoint *getpoints(QDomElement &element, int n);
-	void point (QDomElement &element);
+	bool checkShowConditions(const Primitive &primitive, bool isIcon) const;
+
+	void draw(const Primitive &primitive);
+	void drawText(const Primitive &primitive);
+	void drawPolygon(const Primitive &primitive);
+	void drawPath(const Primitive &primitive);
+	void drawCurve(const Primitive &primitive);
+	void drawImage(const Primitive &primitive);
+
+	/// Applies style of a primitive to pen, brush and font and sets them to the painter.
+	void applyStyle(const Style &style);
 	void defaultstyle();
-	void path_draw(QDomElement &element);
-	void stylus_draw(QDomElement &element);
-	void curve_draw(QDomElement &element);
-	void image_draw(QDomElement &element);
-	float x1_def(QDomElement &element);
-	float y1_def(QDomElement &element);
-	float x2_def(QDomElement &element);
-	float y2_def(QDomElement &element);
-	float coord_def(QDomElement &element, QString coordName, int current_size, int first_size);
-	void logger(QString path, QString string);
-
-	/// checks that str[i] is not L, C, M or Z
-	/// @todo Not so helpful comment
-	bool isNotLCMZ(QString str, int i);
+
+	/// Maps coordinate of a picture to element bounds.
+	float mapCoordinate(const Coordinate &coordinate, int currentSize, int pictureSize) const;
+	float mapX(const Coordinate &coordinate) const;
+	float mapY(const Coordinate &coordinate) const;
+
+	/// Maps a point in picture units to element bounds.
+	QPointF mapPoint(const QPointF &point) const;
+
+	/// Maps rectangle given by first four coordinates of a primitive to element bounds.
+	QRectF mapRect(const Primitive &primitive) const;
+
+	int fontPixelSize(const Coordinate &size) const;
 };
 
 /// Constructs QIcon instance by a given sdf description
@@ -259,10 +259,15 @@ void ProjectManager::close()
 	emit closed();
 }
 
-void ProjectManager::saveTo(const QString &fileName)
+bool ProjectManager::saveTo(const QString &fileName)
 {
 	QLOG_INFO() << "Saving project into" << fileName;
-	mModels.repoControlApi().saveTo(fileName);
+	if (!mModels.repoControlApi().saveTo(fileName)) {
+		QLOG_ERROR() << "Could not save project into" << fileName;
+		return false;
+	}
+
+	return true;
 }
 
 void ProjectManager::save()
@@ -270,7 +275,11 @@ void ProjectManager::save()
 	// Do not change the method to saveAll - in the current implementation, an empty project in the repository is
 	// created to initialize the file name with an empty string, which allows the internal state of the file
 	// name = "" Attempt to save the project in this case result in
-	saveTo(mSaveFilePath);
+	if (!saveTo(mSaveFilePath)) {
+		saveFailedMessage(mSaveFilePath);
+		return;
+	}
+
 	mAutosaver.removeAutoSave();
 	refreshApplicationStateAfterSave();
 }
@@ -304,7 +313,11 @@ bool ProjectManager::saveAs(const QString &fileName)
 		return false;
 	}
 	mAutosaver.removeAutoSave();
-	mModels.repoControlApi().saveTo(workingFileName);
+	if (!saveTo(workingFileName)) {
+		saveFailedMessage(workingFileName);
+		return false;
+	}
+
 	setSaveFilePath(workingFileName);
 	refreshApplicationStateAfterSave();
 	return true;
@@ -337,3 +350,9 @@ void ProjectManager::fileNotFoundMessage(const QString &fileName) const
 {
 	showMessage(tr("File not found"), tr("File %1 not found. Try again").arg(fileName));
 }
+
+void ProjectManager::saveFailedMessage(const QString &fileName) const
+{
+	showMessage(tr("Can`t save project"), tr("Project could not be written to %1. Try to save it to another file")
+			.arg(fileName));
+}
@@ -34,7 +34,8 @@ public slots:
 	void setUnsavedIndicator(bool isUnsaved) override;
 
 	/// Saves current project into given file without refreshing application state after it
-	void saveTo(const QString &fileName);
+	/// @returns false if the file could not be written
+	bool saveTo(const QString &fileName);
 
 public:
 	bool openEmptyWithSuggestToSaveChanges() override;
@@ -78,6 +79,7 @@ protected:
 	virtual void showMessage(const QString &title, const QString &message) const;
 
 	void fileNotFoundMessage(const QString &fileName) const;
+	void saveFailedMessage(const QString &fileName) const;
 
 	models::Models &mModels;
 	Autosaver mAutosaver;
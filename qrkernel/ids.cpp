@@ -3,7 +3,62 @@
 #include <QtCore/QVariant>
 #include <QtCore/QUuid>
 
+#include <algorithm>
+
+#include "private/idAtoms.h"
+
 using namespace qReal;
+using namespace qReal::details;
+
+IdAtoms &IdAtoms::instance()
+{
+	static IdAtoms instance;
+	return instance;
+}
+
+IdAtoms::IdAtoms()
+	: mCount(1)
+{
+	mBlocks[0].storeRelease(new QString[blockSize]);
+}
+
+IdAtoms::~IdAtoms()
+{
+	for (int i = 0; i < maxBlocks; ++i) {
+		delete[] mBlocks[i].load();
+	}
+}
+
+quint32 IdAtoms::atom(const QString &string)
+{
+	if (string.isEmpty()) {
+		return 0;
+	}
+
+	QMutexLocker lock(&mMutex);
+	const QHash<QString, quint32>::const_iterator existing = mAtoms.constFind(string);
+	if (existing != mAtoms.constEnd()) {
+		return existing.value();
+	}
+
+	const quint32 result = mCount;
+	const quint32 block = result >> blockBits;
+	if (block >= static_cast<quint32>(maxBlocks)) {
+		qFatal("Too many distinct Id parts");
+	}
+
+	QString *blockData = mBlocks[block].load();
+	if (!blockData) {
+		blockData = new QString[blockSize];
+	}
+
+	blockData[result & (blockSize - 1)] = string;
+	// Publishing after the string is written, so readers that got this atom see complete data.
+	mBlocks[block].storeRelease(blockData);
+	mAtoms.insert(string, result);
+	++mCount;
+	return result;
+}
 
 Id Id::loadFromString(const QString &string)
 {
@@ -11,37 +66,46 @@ Id Id::loadFromString(const QString &string)
 	Q_ASSERT(path.count() > 0 && path.count() <= 5);
 	Q_ASSERT(path[0] == "qrm:");
 
+	IdAtoms &atoms = IdAtoms::instance();
 	Id result;
 	switch (path.count()) {
-	case 5: result.mId = path[4];
+	case 5: result.setIdPart(path[4]);
 		// Fall-thru
-	case 4: result.mElement = path[3];
+	case 4: result.mElement = atoms.atom(path[3]);
 		// Fall-thru
-	case 3: result.mDiagram = path[2];
+	case 3: result.mDiagram = atoms.atom(path[2]);
 		// Fall-thru
-	case 2: result.mEditor = path[1];
+	case 2: result.mEditor = atoms.atom(path[1]);
 		// Fall-thru
 	}
+
+	result.updateHash();
 	Q_ASSERT(string == result.toString());
 	return result;
 }
 
 Id Id::createElementId(const QString &editor, const QString &diagram, const QString &element)
 {
-	return Id(editor, diagram, element, QUuid::createUuid().toString());
+	Id result(editor, diagram, element);
+	result.mGuid = QUuid::createUuid();
+	result.updateHash();
+	return result;
 }
 
 Id Id::rootId()
 {
-	return Id("ROOT_ID", "ROOT_ID", "ROOT_ID", "ROOT_ID");
+	static const Id root("ROOT_ID", "ROOT_ID", "ROOT_ID", "ROOT_ID");
+	return root;
 }
 
 Id::Id(const QString &editor, QString  const &diagram, QString  const &element, QString  const &id)
-		: mEditor(editor)
-		, mDiagram(diagram)
-		, mElement(element)
-		, mId(id)
+		: mEditor(IdAtoms::instance().atom(editor))
+		, mDiagram(IdAtoms::instance().atom(diagram))
+		, mElement(IdAtoms::instance().atom(element))
+		, mHash(0)
 {
+	setIdPart(id);
+	updateHash();
 	Q_ASSERT(checkIntegrity());
 }
 
@@ -49,73 +113,105 @@ Id::Id(const Id &base, const QString &additional)
 		: mEditor(base.mEditor)
 		, mDiagram(base.mDiagram)
 		, mElement(base.mElement)
-		, mId(base.mId)
+		, mGuid(base.mGuid)
+		, mIdString(base.mIdString)
+		, mHash(0)
 {
 	const unsigned baseSize = base.idSize();
 	switch (baseSize) {
 	case 0:
-		mEditor = additional;
+		mEditor = IdAtoms::instance().atom(additional);
 		break;
 	case 1:
-		mDiagram = additional;
+		mDiagram = IdAtoms::instance().atom(additional);
 		break;
 	case 2:
-		mElement = additional;
+		mElement = IdAtoms::instance().atom(additional);
 		break;
 	case 3:
-		mId = additional;
+		setIdPart(additional);
 		break;
 	default:
 		Q_ASSERT(!"Can not add a part to Id, it will be too long");
 	}
+
+	updateHash();
 	Q_ASSERT(checkIntegrity());
 }
 
+void Id::setIdPart(const QString &id)
+{
+	// Only canonical form is stored as GUID, so that the part is converted back to exactly the same string.
+	const QUuid guid = id.length() == 38 && id[0] == '{' ? QUuid(id) : QUuid();
+	if (!guid.isNull() && guid.toString() == id) {
+		mGuid = guid;
+		mIdString.clear();
+	} else {
+		mGuid = QUuid();
+		mIdString = id;
+	}
+}
+
+void Id::updateHash()
+{
+	uint hash = mEditor;
+	hash = hash * 31 + mDiagram;
+	hash = hash * 31 + mElement;
+	mHash = hash * 31 + (mGuid.isNull() ? qHash(mIdString) : qHash(mGuid));
+}
+
 bool Id::isNull() const
 {
-	return mEditor.isEmpty() && mDiagram.isEmpty()
-			&& mElement.isEmpty() && mId.isEmpty();
+	return mEditor == 0 && mDiagram == 0 && mElement == 0 && mGuid.isNull() && mIdString.isEmpty();
 }
 
 QString Id::editor() const
 {
-	return mEditor;
+	return IdAtoms::instance().string(mEditor);
 }
 
 QString Id::diagram() const
 {
-	return mDiagram;
+	return IdAtoms::instance().string(mDiagram);
 }
 
 QString Id::element() const
 {
-	return mElement;
+	return IdAtoms::instance().string(mElement);
 }
 
 QString Id::id() const
 {
-	return mId;
+	return mGuid.isNull() ? mIdString : mGuid.toString();
 }
 
 Id Id::type() const
 {
-	return Id(mEditor, mDiagram, mElement);
+	Id result(*this);
+	result.mGuid = QUuid();
+	result.mIdString.clear();
+	result.updateHash();
+	return result;
 }
 
 Id Id::sameTypeId() const
 {
-	return Id(mEditor, mDiagram, mElement, QUuid::createUuid().toString());
+	Id result(*this);
+	result.mGuid = QUuid::createUuid();
+	result.mIdString.clear();
+	result.updateHash();
+	return result;
 }
 
 unsigned Id::idSize() const
 {
-	if (!mId.isEmpty()) {
+	if (!mGuid.isNull() || !mIdString.isEmpty()) {
 		return 4;
-	} if (!mElement.isEmpty()) {
+	} if (mElement != 0) {
 		return 3;
-	} if (!mDiagram.isEmpty()) {
+	} if (mDiagram != 0) {
 		return 2;
-	} if (!mEditor.isEmpty()) {
+	} if (mEditor != 0) {
 		return 1;
 	}
 	return 0;
@@ -128,13 +224,13 @@ QUrl Id::toUrl() const
 
 QString Id::toString() const
 {
-	QString path = "qrm:/" + mEditor;
-	if (mDiagram != "") {
-		path += "/" + mDiagram;
-	} if (mElement != "") {
-		path += "/" + mElement;
-	} if (mId != "") {
-		path += "/" + mId;
+	QString path = "qrm:/" + editor();
+	if (mDiagram != 0) {
+		path += "/" + diagram();
+	} if (mElement != 0) {
+		path += "/" + element();
+	} if (idSize() == 4) {
+		path += "/" + id();
 	}
 	return path;
 }
@@ -143,23 +239,23 @@ bool Id::checkIntegrity() const
 {
 	bool emptyPartsAllowed = true;
 
-	if (!mId.isEmpty()) {
+	if (idSize() == 4) {
 		emptyPartsAllowed = false;
 	}
 
-	if (!mElement.isEmpty()) {
+	if (mElement != 0) {
 		emptyPartsAllowed = false;
 	} else if (!emptyPartsAllowed) {
 		return false;
 	}
 
-	if (!mDiagram.isEmpty()) {
+	if (mDiagram != 0) {
 		emptyPartsAllowed = false;
 	} else if (!emptyPartsAllowed) {
 		return false;
 	}
 
-	if (mEditor.isEmpty() && !emptyPartsAllowed) {
+	if (mEditor == 0 && !emptyPartsAllowed) {
 		return false;
 	}
 
@@ -180,6 +276,35 @@ QVariant IdListHelper::toVariant(const IdList &list)
 	return v;
 }
 
+void IdListHelper::sortByString(IdList &list)
+{
+	std::sort(list.begin(), list.end(), [](const Id &first, const Id &second) {
+		return first.toString() < second.toString();
+	});
+}
+
+bool qReal::operator<(const Id &i1, const Id &i2)
+{
+	const IdAtoms &atoms = IdAtoms::instance();
+	if (i1.mEditor != i2.mEditor) {
+		return atoms.string(i1.mEditor) < atoms.string(i2.mEditor);
+	}
+
+	if (i1.mDiagram != i2.mDiagram) {
+		return atoms.string(i1.mDiagram) < atoms.string(i2.mDiagram);
+	}
+
+	if (i1.mElement != i2.mElement) {
+		return atoms.string(i1.mElement) < atoms.string(i2.mElement);
+	}
+
+	if (i1.mGuid.isNull() != i2.mGuid.isNull()) {
+		return i1.mGuid.isNull();
+	}
+
+	return i1.mGuid.isNull() ? i1.mIdString < i2.mIdString : i1.mGuid < i2.mGuid;
+}
+
 QDataStream& operator<< (QDataStream &out, const Id &id)
 {
 	out << id.toString();
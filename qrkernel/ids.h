@@ -3,6 +3,7 @@
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QUrl>
+#include <QtCore/QUuid>
 #include <QtCore/QHash>
 #include <QtCore/QMetaType>
 #include <QtCore/QDebug>
@@ -15,6 +16,9 @@ namespace qReal {
 /// editor (metamodel to which our element belongs to), diagram in that editor
 /// (a tab in palette where this element will appear), element (type of
 /// an element, actually), id (id of an element).
+/// Editor, diagram and element parts are interned in a process-wide table, there are few of them. Id part is
+/// stored as 128-bit GUID when it is one (as generated by createElementId()) and as a string otherwise, so
+/// comparison and hashing of Ids mostly do not touch strings. The hash is computed once on construction.
 class QRKERNEL_EXPORT Id
 {
 public:
@@ -85,22 +89,42 @@ public:
 
 	// default destructor and copy constuctor are OK
 private:
+	friend bool operator==(const Id &i1, const Id &i2);
+	friend QRKERNEL_EXPORT bool operator<(const Id &i1, const Id &i2);
+	friend uint qHash(const Id &key);
+
 	/// Used only for debug. Checks that Id is correct.
 	bool checkIntegrity() const;
 
-	QString mEditor;
-	QString mDiagram;
-	QString mElement;
-	QString mId;
+	/// Stores id part either as GUID or as a string if it is not a GUID in canonical QUuid form.
+	void setIdPart(const QString &id);
+
+	/// Recalculates cached hash, shall be called after every modification of Id parts.
+	void updateHash();
+
+	/// Atoms of editor, diagram and element parts, 0 means empty part.
+	quint32 mEditor;
+	quint32 mDiagram;
+	quint32 mElement;
+
+	/// Id part if it is a GUID, null otherwise.
+	QUuid mGuid;
+
+	/// Id part if it is not a GUID, empty otherwise.
+	QString mIdString;
+
+	uint mHash;
 };
 
 /// Id equality operator. Ids are equal when all their parts are equal.
 inline bool operator==(const Id &i1, const Id &i2)
 {
-	return i1.editor() == i2.editor()
-			&& i1.diagram() == i2.diagram()
-			&& i1.element() == i2.element()
-			&& i1.id() == i2.id();
+	return i1.mHash == i2.mHash
+			&& i1.mGuid == i2.mGuid
+			&& i1.mElement == i2.mElement
+			&& i1.mDiagram == i2.mDiagram
+			&& i1.mEditor == i2.mEditor
+			&& i1.mIdString == i2.mIdString;
 }
 
 /// Id inequality operator.
@@ -109,17 +133,16 @@ inline bool operator!=(const Id &i1, const Id &i2)
 	return !(i1 == i2);
 }
 
-/// Comparison operator for using Id in maps
-inline bool operator<(const Id &i1, const Id &i2)
-{
-	return i1.toString() < i2.toString();
-}
+/// Comparison operator for using Id in maps. Editor, diagram and element parts are compared as strings, GUID id
+/// parts are compared by value and go after other id parts, so the order does not depend on the order Ids were
+/// created or loaded in. It still differs from the order of string representations, use
+/// IdListHelper::sortByString() for that.
+QRKERNEL_EXPORT bool operator<(const Id &i1, const Id &i2);
 
 /// Hash function for Id for using it in QHash.
 inline uint qHash(const Id &key)
 {
-	return qHash(key.editor()) ^ qHash(key.diagram()) ^ qHash(key.element())
-			^ qHash(key.id());
+	return key.mHash;
 }
 
 /// Operator for printing Id in QDebug.
@@ -137,6 +160,9 @@ class QRKERNEL_EXPORT IdListHelper
 {
 public:
 	static QVariant toVariant(const IdList &list);
+
+	/// Sorts list in order of string representations of Ids.
+	static void sortByString(IdList &list);
 };
 
 typedef Id Metatype;
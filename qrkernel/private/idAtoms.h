@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QAtomicPointer>
+
+namespace qReal {
+namespace details {
+
+/// Process-wide intern table for editor, diagram and element parts of Ids, which come from metamodels and so
+/// form a small set. Each distinct string gets an integer atom, atom 0 is always an empty string. Atoms are never
+/// released, so id parts of elements must not be interned here. Strings are stored in fixed-size blocks which are never
+/// moved, so getting a string by atom does not require locking, only creation of new atoms does.
+class IdAtoms
+{
+public:
+	static IdAtoms &instance();
+
+	~IdAtoms();
+
+	/// Returns atom for a given string, creating it if needed. Thread-safe.
+	quint32 atom(const QString &string);
+
+	/// Returns string by atom previously returned by atom().
+	const QString &string(quint32 atom) const
+	{
+		return mBlocks[atom >> blockBits].loadAcquire()[atom & (blockSize - 1)];
+	}
+
+private:
+	static const int blockBits = 12;
+	static const quint32 blockSize = 1 << blockBits;
+	static const int maxBlocks = 1 << 12;
+
+	IdAtoms();
+	Q_DISABLE_COPY(IdAtoms)
+
+	QMutex mMutex;
+	QHash<QString, quint32> mAtoms;
+	QAtomicPointer<QString> mBlocks[maxBlocks];
+	quint32 mCount;
+};
+
+}
+}
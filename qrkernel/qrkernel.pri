@@ -13,6 +13,7 @@ HEADERS += \
 	$$PWD/logging.h \
 	$$PWD/platformInfo.h \
 	$$PWD/private/listeners.h \
+	$$PWD/private/idAtoms.h \
 
 SOURCES += \
 	$$PWD/ids.cpp \
@@ -2,6 +2,8 @@
 
 #include <qrkernel/roles.h>
 
+#include "propertiesIterator.h"
+
 namespace qrRepo {
 
 /// Common methods for graphical and logical repository parts.
@@ -77,7 +79,8 @@ public:
 	/// Check that property with given name exists in a given element.
 	virtual bool hasProperty(const qReal::Id &id, const QString &propertyName) const = 0;
 
-	virtual QMapIterator<QString, QVariant> propertiesIterator(const qReal::Id &id) const = 0;
+	/// Returns iterator over all properties of a given element, it does not copy properties.
+	virtual PropertiesIterator propertiesIterator(const qReal::Id &id) const = 0;
 
 	virtual void setBackReference(const qReal::Id &id, const qReal::Id &reference) const = 0;
 	virtual void removeBackReference(const qReal::Id &id, const qReal::Id &reference) const = 0;
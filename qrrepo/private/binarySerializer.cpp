@@ -0,0 +1,540 @@
+#include "binarySerializer.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QDataStream>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <qrkernel/exception/exception.h>
+
+#include "valuesSerializer.h"
+#include "classes/logicalObject.h"
+#include "classes/graphicalObject.h"
+
+using namespace qrRepo::details;
+using namespace qReal;
+
+namespace {
+
+/// "QRSB" in ASCII.
+const quint32 signature = 0x51525342;
+const quint32 formatVersion = 1;
+
+/// "QRSJ" in ASCII, marks journal sections appended by incremental saves. Signature is followed by size and
+/// checksum of the section, so a section torn by a crash during appending can be detected.
+const quint32 journalSignature = 0x5152534A;
+
+/// Size of journal section header: signature, section size and checksum.
+const int journalHeaderSize = sizeof(quint32) + sizeof(quint32) + sizeof(quint16);
+const QDataStream::Version streamVersion = QDataStream::Qt_5_0;
+
+const QString idListTypeName = "qReal::IdList";
+
+enum ObjectKind
+{
+	logicalObjectKind = 0
+	, graphicalObjectKind
+};
+
+/// Collects strings while records are written, so each distinct string is stored in a file only once.
+class StringTableWriter
+{
+public:
+	quint32 index(const QString &string)
+	{
+		const QHash<QString, quint32>::const_iterator it = mIndexes.constFind(string);
+		if (it != mIndexes.constEnd()) {
+			return it.value();
+		}
+
+		const quint32 result = mStrings.size();
+		mStrings << string;
+		mIndexes.insert(string, result);
+		return result;
+	}
+
+	const QStringList &strings() const
+	{
+		return mStrings;
+	}
+
+private:
+	QStringList mStrings;
+	QHash<QString, quint32> mIndexes;
+};
+
+class StringTableReader
+{
+public:
+	explicit StringTableReader(const QStringList &strings)
+		: mStrings(strings)
+	{
+	}
+
+	QString read(QDataStream &stream) const
+	{
+		quint32 index = 0;
+		stream >> index;
+		if (index >= static_cast<quint32>(mStrings.size())) {
+			throw Exception("Corrupted project file: string index out of range");
+		}
+
+		return mStrings.at(index);
+	}
+
+private:
+	const QStringList mStrings;
+};
+
+void writeId(QDataStream &stream, StringTableWriter &strings, const Id &id)
+{
+	stream << strings.index(id.editor()) << strings.index(id.diagram())
+			<< strings.index(id.element()) << strings.index(id.id());
+}
+
+Id readId(QDataStream &stream, const StringTableReader &strings)
+{
+	const QString editor = strings.read(stream);
+	const QString diagram = strings.read(stream);
+	const QString element = strings.read(stream);
+	const QString id = strings.read(stream);
+	return Id(editor, diagram, element, id);
+}
+
+void writeIdList(QDataStream &stream, StringTableWriter &strings, const IdList &ids)
+{
+	stream << static_cast<quint32>(ids.size());
+	for (const Id &id : ids) {
+		writeId(stream, strings, id);
+	}
+}
+
+IdList readIdList(QDataStream &stream, const StringTableReader &strings)
+{
+	quint32 count = 0;
+	stream >> count;
+	IdList result;
+	for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+		result << readId(stream, strings);
+	}
+
+	return result;
+}
+
+void writeValue(QDataStream &stream, StringTableWriter &strings, const QVariant &value)
+{
+	const QString typeName = value.typeName();
+	stream << strings.index(typeName);
+	if (typeName == idListTypeName) {
+		writeIdList(stream, strings, value.value<IdList>());
+	} else {
+		stream << ValuesSerializer::serializeQVariant(value);
+	}
+}
+
+QVariant readValue(QDataStream &stream, const StringTableReader &strings)
+{
+	const QString typeName = strings.read(stream);
+	if (typeName == idListTypeName) {
+		return IdListHelper::toVariant(readIdList(stream, strings));
+	}
+
+	QString valueString;
+	stream >> valueString;
+	return ValuesSerializer::deserializeQVariant(typeName, valueString);
+}
+
+void writeNamedVariantsMap(QDataStream &stream, StringTableWriter &strings, const QMap<QString, QVariant> &map)
+{
+	stream << static_cast<quint32>(map.size());
+	for (QMap<QString, QVariant>::const_iterator i = map.constBegin(); i != map.constEnd(); ++i) {
+		stream << strings.index(i.key());
+		writeValue(stream, strings, i.value());
+	}
+}
+
+void writeProperties(QDataStream &stream, StringTableWriter &strings, const Object &object)
+{
+	// Same layout as writeNamedVariantsMap(), but without building a map of properties.
+	const QStringList names = object.propertyNames();
+	stream << static_cast<quint32>(names.size());
+	qrRepo::PropertiesIterator iterator = object.propertiesIterator();
+	while (iterator.hasNext()) {
+		iterator.next();
+		stream << strings.index(iterator.key());
+		writeValue(stream, strings, iterator.value());
+	}
+}
+
+QMap<QString, QVariant> readNamedVariantsMap(QDataStream &stream, const StringTableReader &strings)
+{
+	quint32 count = 0;
+	stream >> count;
+	QMap<QString, QVariant> result;
+	for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+		const QString name = strings.read(stream);
+		result.insert(name, readValue(stream, strings));
+	}
+
+	return result;
+}
+
+void writeIndexEntry(QDataStream &stream, StringTableWriter &strings, const Object &object
+		, quint64 payloadOffset, quint32 payloadSize)
+{
+	const GraphicalObject * const graphicalObject = dynamic_cast<const GraphicalObject *>(&object);
+	stream << static_cast<quint8>(graphicalObject ? graphicalObjectKind : logicalObjectKind);
+	writeId(stream, strings, object.id());
+	writeId(stream, strings, object.parent());
+	writeIdList(stream, strings, object.children());
+	if (graphicalObject) {
+		writeId(stream, strings, graphicalObject->logicalId());
+	}
+
+	stream << payloadOffset << payloadSize;
+}
+
+/// Creates object from its index entry, properties are left empty. Returns offset and size of object payload
+/// in output parameters.
+Object *readIndexEntry(QDataStream &stream, const StringTableReader &strings
+		, quint64 &payloadOffset, quint32 &payloadSize)
+{
+	quint8 kind = logicalObjectKind;
+	stream >> kind;
+	if (kind != logicalObjectKind && kind != graphicalObjectKind) {
+		throw Exception("Corrupted project file: unknown object kind");
+	}
+
+	const Id id = readId(stream, strings);
+	const Id parent = readId(stream, strings);
+	const IdList children = readIdList(stream, strings);
+	const Id logicalId = kind == graphicalObjectKind ? readId(stream, strings) : Id();
+	stream >> payloadOffset >> payloadSize;
+
+	if (stream.status() != QDataStream::Ok || id.isNull()) {
+		throw Exception("Corrupted project file: incomplete object index entry");
+	}
+
+	Object * const result = kind == graphicalObjectKind
+			? static_cast<Object *>(new GraphicalObject(id, parent, logicalId))
+			: static_cast<Object *>(new LogicalObject(id));
+
+	result->setParent(parent);
+	for (const Id &child : children) {
+		result->addChild(child);
+	}
+
+	return result;
+}
+
+/// Payload of an object is everything that is not needed to build model tree: properties and graphical parts.
+QByteArray serializePayload(const Object &object, StringTableWriter &strings)
+{
+	QByteArray payload;
+	QDataStream stream(&payload, QIODevice::WriteOnly);
+	stream.setVersion(streamVersion);
+
+	writeProperties(stream, strings, object);
+
+	const GraphicalObject * const graphicalObject = dynamic_cast<const GraphicalObject *>(&object);
+	if (graphicalObject) {
+		const QList<int> parts = graphicalObject->graphicalParts();
+		stream << static_cast<quint32>(parts.size());
+		for (const int index : parts) {
+			stream << static_cast<qint32>(index);
+			writeNamedVariantsMap(stream, strings, graphicalObject->graphicalPartProperties(index));
+		}
+	}
+
+	return payload;
+}
+
+LazyProperties deserializePayload(const QByteArray &payload, const StringTableReader &strings
+		, bool withGraphicalParts)
+{
+	QDataStream stream(payload);
+	stream.setVersion(streamVersion);
+
+	// Properties are written in order of their names, so they can be passed to object as is.
+	LazyProperties result;
+	quint32 propertiesCount = 0;
+	stream >> propertiesCount;
+	for (quint32 i = 0; i < propertiesCount && stream.status() == QDataStream::Ok; ++i) {
+		result.names << strings.read(stream);
+		result.values << readValue(stream, strings);
+	}
+
+	if (withGraphicalParts) {
+		quint32 partsCount = 0;
+		stream >> partsCount;
+		for (quint32 i = 0; i < partsCount && stream.status() == QDataStream::Ok; ++i) {
+			qint32 index = 0;
+			stream >> index;
+			result.graphicalParts << qMakePair(static_cast<int>(index), readNamedVariantsMap(stream, strings));
+		}
+	}
+
+	if (stream.status() != QDataStream::Ok) {
+		throw Exception("Corrupted project file: incomplete object record");
+	}
+
+	return result;
+}
+
+/// Keeps payload section of a file in memory and deserializes payloads of lazily loaded objects on demand.
+class PayloadsSource : public LazyPropertiesSource
+{
+public:
+	PayloadsSource(const QByteArray &payloads, const StringTableReader &strings)
+		: mPayloads(payloads)
+		, mStrings(strings)
+	{
+	}
+
+	LazyProperties loadProperties(quint64 offset, quint32 size, bool withGraphicalParts) const override
+	{
+		return deserializePayload(QByteArray::fromRawData(mPayloads.constData() + offset, size), mStrings
+				, withGraphicalParts);
+	}
+
+private:
+	const QByteArray mPayloads;
+	const StringTableReader mStrings;
+};
+
+/// Serializes a section of a file: string table, meta-information, ids of removed objects, objects index
+/// and objects payloads. Project file consists of one base section and, possibly, journal sections
+/// appended to it, each of them overrides previous ones.
+QByteArray serializeSection(const QList<Object *> &objects, const IdList &removed
+		, const QHash<QString, QVariant> &metaInfo)
+{
+	StringTableWriter strings;
+
+	// Index and payloads are serialized first because the string table must precede them in a file.
+	QByteArray index;
+	QDataStream indexStream(&index, QIODevice::WriteOnly);
+	indexStream.setVersion(streamVersion);
+
+	indexStream << static_cast<quint32>(metaInfo.size());
+	for (QHash<QString, QVariant>::const_iterator i = metaInfo.constBegin(); i != metaInfo.constEnd(); ++i) {
+		indexStream << strings.index(i.key());
+		writeValue(indexStream, strings, i.value());
+	}
+
+	writeIdList(indexStream, strings, removed);
+
+	QByteArray payloads;
+	indexStream << static_cast<quint32>(objects.size());
+	for (const Object * const object : objects) {
+		const QByteArray payload = serializePayload(*object, strings);
+		writeIndexEntry(indexStream, strings, *object, payloads.size(), payload.size());
+		payloads.append(payload);
+	}
+
+	QByteArray section;
+	QDataStream stream(&section, QIODevice::WriteOnly);
+	stream.setVersion(streamVersion);
+	stream << strings.strings();
+	stream.writeRawData(index.constData(), index.size());
+	stream << payloads;
+	return section;
+}
+
+void readSection(QDataStream &stream, QHash<Id, Object *> &objectsHash, QHash<QString, QVariant> &metaInfo
+		, bool lazy)
+{
+	QStringList stringTable;
+	stream >> stringTable;
+	const StringTableReader strings(stringTable);
+
+	metaInfo.clear();
+	quint32 metaInfoCount = 0;
+	stream >> metaInfoCount;
+	for (quint32 i = 0; i < metaInfoCount && stream.status() == QDataStream::Ok; ++i) {
+		const QString key = strings.read(stream);
+		metaInfo.insert(key, readValue(stream, strings));
+	}
+
+	const IdList removed = readIdList(stream, strings);
+
+	quint32 objectsCount = 0;
+	stream >> objectsCount;
+	QList<QPair<Object *, QPair<quint64, quint32>>> loaded;
+	loaded.reserve(objectsCount);
+	try {
+		for (quint32 i = 0; i < objectsCount; ++i) {
+			quint64 payloadOffset = 0;
+			quint32 payloadSize = 0;
+			Object * const object = readIndexEntry(stream, strings, payloadOffset, payloadSize);
+			loaded << qMakePair(object, qMakePair(payloadOffset, payloadSize));
+		}
+
+		QByteArray payloads;
+		stream >> payloads;
+		if (stream.status() != QDataStream::Ok) {
+			throw Exception("Corrupted project file: unexpected end of file");
+		}
+
+		const QSharedPointer<const PayloadsSource> source(new PayloadsSource(payloads, strings));
+		for (const QPair<Object *, QPair<quint64, quint32>> &entry : loaded) {
+			const quint64 offset = entry.second.first;
+			const quint32 size = entry.second.second;
+			if (offset + size > static_cast<quint64>(payloads.size())) {
+				throw Exception("Corrupted project file: object payload out of range");
+			}
+
+			entry.first->setLazyProperties(source, offset, size);
+		}
+
+		if (!lazy) {
+			// Payloads are independent, so they are deserialized on worker threads. Exceptions can not leave
+			// a worker thread, so failure is only marked there and reported here.
+			QAtomicInt corrupted(0);
+			auto loadProperties = [&corrupted](QPair<Object *, QPair<quint64, quint32>> &entry) {
+				try {
+					entry.first->ensurePropertiesLoaded();
+				} catch (const Exception &) {
+					corrupted.storeRelease(1);
+				}
+			};
+
+			QtConcurrent::blockingMap(loaded, loadProperties);
+
+			if (corrupted.loadAcquire()) {
+				throw Exception("Corrupted project file: incomplete object record");
+			}
+		}
+	} catch (const Exception &) {
+		for (const QPair<Object *, QPair<quint64, quint32>> &entry : loaded) {
+			delete entry.first;
+		}
+
+		throw;
+	}
+
+	for (const Id &id : removed) {
+		delete objectsHash.take(id);
+	}
+
+	objectsHash.reserve(objectsHash.size() + loaded.size());
+	for (const QPair<Object *, QPair<quint64, quint32>> &entry : loaded) {
+		delete objectsHash.value(entry.first->id());
+		objectsHash.insert(entry.first->id(), entry.first);
+	}
+}
+
+}
+
+bool BinarySerializer::isBinaryFile(const QString &fileName)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return false;
+	}
+
+	QDataStream stream(&file);
+	quint32 fileSignature = 0;
+	stream >> fileSignature;
+	return stream.status() == QDataStream::Ok && fileSignature == signature;
+}
+
+bool BinarySerializer::save(const QString &fileName, const QList<Object *> &objects
+		, const QHash<QString, QVariant> &metaInfo)
+{
+	const QByteArray section = serializeSection(objects, IdList(), metaInfo);
+
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(streamVersion);
+	stream << signature << formatVersion;
+	stream.writeRawData(section.constData(), section.size());
+
+	return stream.status() == QDataStream::Ok;
+}
+
+bool BinarySerializer::appendChanges(const QString &fileName, const QList<Object *> &changed
+		, const IdList &removed, const QHash<QString, QVariant> &metaInfo)
+{
+	const QByteArray section = serializeSection(changed, removed, metaInfo);
+
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+		return false;
+	}
+
+	const qint64 previousSize = file.size();
+	QDataStream stream(&file);
+	stream.setVersion(streamVersion);
+	stream << journalSignature << static_cast<quint32>(section.size()) << qChecksum(section.constData()
+			, static_cast<uint>(section.size()));
+	stream.writeRawData(section.constData(), section.size());
+
+	if (stream.status() != QDataStream::Ok || !file.flush()) {
+		// Part of a section is dropped on load anyway, but a next section appended after it would be lost too.
+		file.resize(previousSize);
+		return false;
+	}
+
+	return true;
+}
+
+bool BinarySerializer::load(const QString &fileName, QHash<Id, Object *> &objectsHash
+		, QHash<QString, QVariant> &metaInfo, bool lazy)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(streamVersion);
+
+	quint32 fileSignature = 0;
+	quint32 version = 0;
+	stream >> fileSignature >> version;
+	if (fileSignature != signature) {
+		return false;
+	}
+
+	if (version > formatVersion) {
+		throw Exception("Project file was saved by a newer version of QReal");
+	}
+
+	readSection(stream, objectsHash, metaInfo, lazy);
+
+	while (!stream.atEnd()) {
+		if (file.bytesAvailable() < journalHeaderSize) {
+			// Header of the last section was not written completely, changes in it are lost.
+			break;
+		}
+
+		quint32 sectionSignature = 0;
+		quint32 sectionSize = 0;
+		quint16 checksum = 0;
+		stream >> sectionSignature >> sectionSize >> checksum;
+		if (sectionSignature != journalSignature) {
+			throw Exception("Corrupted project file: unknown section");
+		}
+
+		const QByteArray section = file.read(sectionSize);
+		const bool isComplete = section.size() == static_cast<int>(sectionSize)
+				&& qChecksum(section.constData(), static_cast<uint>(section.size())) == checksum;
+		if (!isComplete) {
+			if (!file.atEnd()) {
+				throw Exception("Corrupted project file: damaged journal section");
+			}
+
+			// Saving was interrupted while the last section was written, changes in it are lost.
+			break;
+		}
+
+		QDataStream sectionStream(section);
+		sectionStream.setVersion(streamVersion);
+		readSection(sectionStream, objectsHash, metaInfo, lazy);
+	}
+
+	return true;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QVariant>
+
+#include <qrkernel/ids.h>
+
+#include "classes/object.h"
+
+namespace qrRepo {
+namespace details {
+
+/// Saves and loads repository contents in a versioned binary single-file .qrs format.
+/// File layout: magic number and format version, a table of all strings used as property names, type names
+/// and Id parts, meta-information, an index of objects and a section with object payloads. Index entry
+/// contains everything needed to build model tree (object kind, id, parent, children and logical id) and
+/// the offset of object payload, payload contains properties and graphical parts. Values are encoded as
+/// a type name and a string produced by ValuesSerializer, so every value that can be saved in XML format
+/// can be saved here too. Incremental saves append journal sections with changed objects and ids of removed
+/// ones, they are applied in order on load.
+class BinarySerializer
+{
+public:
+	/// Returns true if the given file starts with binary format signature.
+	static bool isBinaryFile(const QString &fileName);
+
+	/// Writes given objects and meta-information into the given file, overwriting it.
+	/// @returns true if operation was successful.
+	static bool save(const QString &fileName, const QList<Object *> &objects
+			, const QHash<QString, QVariant> &metaInfo);
+
+	/// Appends a journal section with changed objects, removed object ids and current meta-information
+	/// to the end of an existing binary file.
+	/// @returns true if operation was successful.
+	static bool appendChanges(const QString &fileName, const QList<Object *> &changed
+			, const qReal::IdList &removed, const QHash<QString, QVariant> &metaInfo);
+
+	/// Reads objects and meta-information from the given file. Loaded objects are added to objectsHash,
+	/// ownership is transferred to caller. Throws qReal::Exception if file is corrupted or was saved
+	/// with a newer format version.
+	/// @param lazy - if true, only the index is parsed, properties of each object are deserialized
+	///        on first access to them.
+	/// @returns false if file can not be opened or is not in binary format.
+	static bool load(const QString &fileName, QHash<qReal::Id, Object *> &objectsHash
+			, QHash<QString, QVariant> &metaInfo, bool lazy = false);
+
+private:
+	/// Creating is prohibited, utility class instances can not be created.
+	BinarySerializer();
+};
+
+}
+}
@@ -44,6 +44,8 @@ GraphicalObject::~GraphicalObject()
 
 QDomElement GraphicalObject::serialize(QDomDocument &document) const
 {
+	ensurePropertiesLoaded();
+
 	QDomElement result = Object::serialize(document);
 	result.setAttribute("logicalId", mLogicalId.toString());
 
@@ -61,8 +63,26 @@ QDomElement GraphicalObject::serialize(QDomDocument &document) const
 	return result;
 }
 
+void GraphicalObject::setLazyGraphicalParts(const QList<QPair<int, QMap<QString, QVariant>>> &parts) const
+{
+	for (const QPair<int, QMap<QString, QVariant>> &part : parts) {
+		GraphicalPart * const graphicalPart = new GraphicalPart();
+		for (QMap<QString, QVariant>::const_iterator property = part.second.constBegin()
+				; property != part.second.constEnd()
+				; ++property)
+		{
+			graphicalPart->setProperty(property.key(), property.value());
+		}
+
+		delete mGraphicalParts.value(part.first);
+		mGraphicalParts.insert(part.first, graphicalPart);
+	}
+}
+
 void GraphicalObject::createGraphicalPart(int index)
 {
+	ensurePropertiesLoaded();
+
 	if (mGraphicalParts.contains(index)) {
 		throw Exception("Part with that index already exists");
 	}
@@ -73,11 +93,15 @@ void GraphicalObject::createGraphicalPart(int index)
 
 QList<int> GraphicalObject::graphicalParts() const
 {
+	ensurePropertiesLoaded();
+
 	return mGraphicalParts.keys();
 }
 
 QVariant GraphicalObject::graphicalPartProperty(int index, const QString &name) const
 {
+	ensurePropertiesLoaded();
+
 	if (!mGraphicalParts.contains(index)) {
 		throw Exception("Tryng to get property of non-existing graphical part");
 	}
@@ -85,8 +109,21 @@ QVariant GraphicalObject::graphicalPartProperty(int index, const QString &name)
 	return mGraphicalParts[index]->property(name);
 }
 
+QMap<QString, QVariant> GraphicalObject::graphicalPartProperties(int index) const
+{
+	ensurePropertiesLoaded();
+
+	if (!mGraphicalParts.contains(index)) {
+		throw Exception("Tryng to get properties of non-existing graphical part");
+	}
+
+	return mGraphicalParts[index]->properties();
+}
+
 void GraphicalObject::setGraphicalPartProperty(int index, const QString &name, const QVariant &value)
 {
+	ensurePropertiesLoaded();
+
 	if (!mGraphicalParts.contains(index)) {
 		throw Exception("Tryng to set property of non-existing graphical part");
 	}
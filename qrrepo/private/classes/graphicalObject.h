@@ -45,6 +45,9 @@ public:
 	/// @param name - name of a property which value we want to get.
 	QVariant graphicalPartProperty(int index, const QString &name) const;
 
+	/// Returns all properties of graphical part with given index.
+	QMap<QString, QVariant> graphicalPartProperties(int index) const;
+
 	/// Sets the value of graphical part property. If a property already exists, its value will be overwritten,
 	/// otherwise new property will be created with given value.
 	/// @param index - index of a graphical part.
@@ -56,12 +59,15 @@ protected:
 	// Override.
 	virtual Object *createClone() const;
 
+	// Override.
+	void setLazyGraphicalParts(const QList<QPair<int, QMap<QString, QVariant>>> &parts) const override;
+
 private:
 	/// Id of logical object corresponding to this graphical object.
 	qReal::Id mLogicalId;
 
-	/// A list of graphical parts with their indexes.
-	QHash<int, GraphicalPart *> mGraphicalParts;  // Has ownership.
+	/// A list of graphical parts with their indexes. Mutable because parts are loaded lazily with properties.
+	mutable QHash<int, GraphicalPart *> mGraphicalParts;  // Has ownership.
 };
 
 }
@@ -30,6 +30,11 @@ void GraphicalPart::setProperty(const QString &name, const QVariant &value)
 	mProperties.insert(name, value);
 }
 
+QMap<QString, QVariant> GraphicalPart::properties() const
+{
+	return mProperties;
+}
+
 GraphicalPart *GraphicalPart::clone() const
 {
 	GraphicalPart * const result = new GraphicalPart();
@@ -26,6 +26,9 @@ public:
 	/// otherwise new property will be created with given value.
 	void setProperty(const QString &name, const QVariant &value);
 
+	/// Returns all properties of this part.
+	QMap<QString, QVariant> properties() const;
+
 	/// Creates deep copy of object.
 	GraphicalPart *clone() const;
 
@@ -14,11 +14,17 @@ using namespace qReal;
 
 Object::Object(const Id &id)
 	: mId(id)
+	, mSchema(PropertySchema::empty())
+	, mLazyOffset(0)
+	, mLazySize(0)
 {
 }
 
 Object::Object(const QDomElement &element)
 	: mId(Id::loadFromString(element.attribute("id", "")))
+	, mSchema(PropertySchema::empty())
+	, mLazyOffset(0)
+	, mLazySize(0)
 {
 	if (mId.isNull()) {
 		throw Exception("Id deserialization failed");
@@ -35,8 +41,9 @@ Object::Object(const QDomElement &element)
 		throw Exception("Incorrect element: children list must appear once");
 	}
 
-	QDomElement properties = propertiesList.at(0).toElement();
-	ValuesSerializer::deserializeNamedVariantsMap(mProperties, properties);
+	QMap<QString, QVariant> properties;
+	ValuesSerializer::deserializeNamedVariantsMap(properties, propertiesList.at(0).toElement());
+	setProperties(properties);
 }
 
 Object::~Object()
@@ -45,15 +52,19 @@ Object::~Object()
 
 void Object::replaceProperties(const QString value, const QString &newValue)
 {
-	foreach (const QVariant &val, mProperties.values()) {
+	ensurePropertiesLoaded();
+
+	for (QVariant &val : mValues) {
 		if (val.toString().contains(value)) {
-			mProperties[mProperties.key(val)] = newValue;
+			val = newValue;
 		}
 	}
 }
 
 Object *Object::clone(QHash<Id, Object*> &objHash) const
 {
+	ensurePropertiesLoaded();
+
 	Object * const result = createClone();
 	objHash.insert(result->id(), result);
 
@@ -65,8 +76,9 @@ Object *Object::clone(QHash<Id, Object*> &objHash) const
 		result->addChild(child->id());
 	}
 
-	// Using copy constructor.
-	result->mProperties = mProperties;
+	// Values are implicitly shared until one of objects changes them.
+	result->mSchema = mSchema;
+	result->mValues = mValues;
 
 	return result;
 }
@@ -96,7 +108,10 @@ void Object::removeChild(const Id &child)
 
 void Object::copyPropertiesFrom(const Object &src)
 {
-	mProperties = src.mProperties;
+	ensurePropertiesLoaded();
+	src.ensurePropertiesLoaded();
+	mSchema = src.mSchema;
+	mValues = src.mValues;
 }
 
 IdList Object::children() const
@@ -129,24 +144,44 @@ Id Object::parent() const
 
 void Object::setProperty(const QString &name, const QVariant &value)
 {
+	ensurePropertiesLoaded();
+
 	if (value == QVariant()) {
 		qDebug() << "Empty QVariant set as a property for " << id().toString();
 		qDebug() << ", property name " << name;
 		Q_ASSERT(!"Empty QVariant set as a property");
 	}
 
-	mProperties.insert(name,value);
+	const int slot = mSchema->slot(name);
+	if (slot != -1) {
+		mValues[slot] = value;
+	} else {
+		mSchema = mSchema->withProperty(name);
+		mValues.insert(mSchema->slot(name), value);
+	}
 }
 
 void Object::setProperties(QMap<QString, QVariant> const &properties)
 {
-	mProperties = properties;
+	setProperties(properties.keys(), properties.values().toVector());
+}
+
+void Object::setProperties(const QStringList &sortedNames, const QVector<QVariant> &values)
+{
+	Q_ASSERT(sortedNames.size() == values.size());
+	ensurePropertiesLoaded();
+
+	mSchema = PropertySchema::forNames(sortedNames);
+	mValues = values;
 }
 
 QVariant Object::property(const QString &name) const
 {
-	if (mProperties.contains(name)) {
-		return mProperties[name];
+	ensurePropertiesLoaded();
+
+	const int slot = mSchema->slot(name);
+	if (slot != -1) {
+		return mValues[slot];
 	} else if (name == "backReferences") {
 		return QVariant();
 	} else {
@@ -157,24 +192,28 @@ QVariant Object::property(const QString &name) const
 
 void Object::setBackReference(const qReal::Id &reference)
 {
-	IdList references = mProperties["backReferences"].value<IdList>();
+	ensurePropertiesLoaded();
+
+	IdList references = property("backReferences").value<IdList>();
 	references << reference;
-	mProperties.insert("backReferences", qReal::IdListHelper::toVariant(references));
+	setProperty("backReferences", qReal::IdListHelper::toVariant(references));
 }
 
 void Object::removeBackReference(const qReal::Id &reference)
 {
-	if (!mProperties.contains("backReferences")) {
+	ensurePropertiesLoaded();
+
+	if (mSchema->slot("backReferences") == -1) {
 		throw Exception("Object " + mId.toString() + ": removing nonexsistent reference " + reference.toString());
 	}
 
-	IdList references = mProperties["backReferences"].value<IdList>();
+	IdList references = property("backReferences").value<IdList>();
 	if (!references.contains(reference)) {
 		throw Exception("Object " + mId.toString() + ": removing nonexsistent reference " + reference.toString());
 	}
 
 	references.removeOne(reference);
-	mProperties.insert("backReferences", qReal::IdListHelper::toVariant(references));
+	setProperty("backReferences", qReal::IdListHelper::toVariant(references));
 }
 
 void Object::setTemporaryRemovedLinks(const QString &direction, const qReal::IdList &listValue)
@@ -194,8 +233,10 @@ IdList Object::temporaryRemovedLinks() const
 
 void Object::removeTemporaryRemovedLinksAt(const QString &direction)
 {
-	if (mTemporaryRemovedLinks.contains(direction)) {
-		mProperties.remove(direction);
+	ensurePropertiesLoaded();
+
+	if (mTemporaryRemovedLinks.contains(direction) && mSchema->slot(direction) != -1) {
+		removeProperty(direction);
 	}
 }
 
@@ -208,7 +249,16 @@ void Object::removeTemporaryRemovedLinks()
 
 bool Object::hasProperty(const QString &name, bool sensitivity, bool regExpression) const
 {
-	QStringList properties = mProperties.keys();
+	ensurePropertiesLoaded();
+
+	// Exact name is found by schema lookup, names list is scanned only for case insensitive or regexp search.
+	if (!regExpression && mSchema->slot(name) != -1) {
+		return true;
+	} else if (!regExpression && sensitivity) {
+		return false;
+	}
+
+	const QStringList &properties = mSchema->names();
 	Qt::CaseSensitivity caseSensitivity;
 
 	if (sensitivity) {
@@ -227,8 +277,12 @@ bool Object::hasProperty(const QString &name, bool sensitivity, bool regExpressi
 
 void Object::removeProperty(const QString &name)
 {
-	if (mProperties.contains(name)) {
-		mProperties.remove(name);
+	ensurePropertiesLoaded();
+
+	const int slot = mSchema->slot(name);
+	if (slot != -1) {
+		mSchema = mSchema->withoutProperty(name);
+		mValues.remove(slot);
 	} else {
 		throw Exception("Object " + mId.toString() + ": removing nonexistent property " + name);
 	}
@@ -239,22 +293,78 @@ Id Object::id() const
 	return mId;
 }
 
-QMapIterator<QString, QVariant> Object::propertiesIterator() const
+PropertiesIterator Object::propertiesIterator() const
 {
-	return QMapIterator<QString, QVariant>(mProperties);
+	ensurePropertiesLoaded();
+
+	return PropertiesIterator(mSchema->names(), mValues);
+}
+
+QStringList Object::propertyNames() const
+{
+	ensurePropertiesLoaded();
+
+	return mSchema->names();
 }
 
 QMap<QString, QVariant> Object::properties() const
 {
-	return mProperties;
+	ensurePropertiesLoaded();
+
+	QMap<QString, QVariant> result;
+	for (int i = 0; i < mValues.size(); ++i) {
+		result.insert(mSchema->names()[i], mValues[i]);
+	}
+
+	return result;
 }
 
 QDomElement Object::serialize(QDomDocument &document) const
 {
+	ensurePropertiesLoaded();
+
 	QDomElement result = document.createElement("object");
 	result.setAttribute("id", id().toString());
 	result.setAttribute("parent", parent().toString());
 	result.appendChild(ValuesSerializer::serializeIdList("children", children(), document));
-	result.appendChild(ValuesSerializer::serializeNamedVariantsMap("properties", mProperties, document));
+	result.appendChild(ValuesSerializer::serializeNamedVariantsMap("properties", properties(), document));
 	return result;
 }
+
+void Object::setLazyProperties(const QSharedPointer<const LazyPropertiesSource> &source, quint64 offset
+		, quint32 size)
+{
+	mLazySource = source;
+	mLazyOffset = offset;
+	mLazySize = size;
+}
+
+bool Object::arePropertiesLoaded() const
+{
+	return mLazySource.isNull();
+}
+
+void Object::ensurePropertiesLoaded() const
+{
+	if (mLazySource.isNull()) {
+		return;
+	}
+
+	LazyProperties loaded;
+	try {
+		loaded = mLazySource->loadProperties(mLazyOffset, mLazySize, !isLogicalObject());
+	} catch (const Exception &exception) {
+		throw Exception("Object " + mId.toString() + ": can not load properties, " + exception.message());
+	}
+
+	// Source is released only when its data is taken, so properties of a corrupted object are not lost.
+	mSchema = PropertySchema::forNames(loaded.names);
+	mValues = loaded.values;
+	setLazyGraphicalParts(loaded.graphicalParts);
+	mLazySource.clear();
+}
+
+void Object::setLazyGraphicalParts(const QList<QPair<int, QMap<QString, QVariant>>> &parts) const
+{
+	Q_UNUSED(parts)
+}
@@ -1,18 +1,49 @@
 #pragma once
 
 #include <qrkernel/ids.h>
+#include <qrrepo/propertiesIterator.h>
 
 #include <QtCore/QMap>
 #include <QtCore/QVariant>
+#include <QtCore/QVector>
+#include <QtCore/QStringList>
 #include <QtCore/QString>
+#include <QtCore/QSharedPointer>
 #include <QtXml/QDomDocument>
 #include <QtXml/QDomElement>
 
+#include "propertySchema.h"
+
 namespace qrRepo {
 namespace details {
 
+/// Properties and graphical parts of an object deserialized from a lazy source, not yet given to the object.
+struct LazyProperties
+{
+	/// Names of properties in sorted order.
+	QStringList names;
+	QVector<QVariant> values;
+	QList<QPair<int, QMap<QString, QVariant>>> graphicalParts;
+};
+
+/// Source of object properties which are deserialized only on first access to them (when project is loaded
+/// lazily). One source is usually shared by all objects loaded from the same file.
+class LazyPropertiesSource
+{
+public:
+	virtual ~LazyPropertiesSource() {}
+
+	/// Deserializes properties (and graphical parts, if requested) of an object, throws an exception if
+	/// object data is corrupted.
+	/// @param offset - location of object data inside the source.
+	/// @param size - size of object data.
+	/// @param withGraphicalParts - true if object data contains graphical parts.
+	virtual LazyProperties loadProperties(quint64 offset, quint32 size, bool withGraphicalParts) const = 0;
+};
+
 /// Abstract class, general object in repository. Has id, parent, children and properties, able to
-/// serialize/deserialize and clone itself.
+/// serialize/deserialize and clone itself. Property names are kept in a schema shared with other objects
+/// having the same set of properties, object itself stores only values.
 class Object
 {
 public:
@@ -53,10 +84,22 @@ public:
 	void removeBackReference(const qReal::Id &reference);
 
 	void setProperties(QMap<QString, QVariant> const &properties);
+
+	/// Replaces all properties of an object.
+	/// @param sortedNames - names of new properties, shall be sorted and unique.
+	/// @param values - values of properties in the same order as names.
+	void setProperties(const QStringList &sortedNames, const QVector<QVariant> &values);
+
 	void copyPropertiesFrom(const Object &src);
-	// TODO: omg
+
+	/// Returns all properties as a new map, propertiesIterator() or propertyNames() are cheaper.
 	QMap<QString, QVariant> properties() const;
-	QMapIterator<QString, QVariant> propertiesIterator() const;
+
+	/// Returns iterator over properties in order of their names, does not copy properties.
+	PropertiesIterator propertiesIterator() const;
+
+	/// Returns sorted names of all properties, does not copy them.
+	QStringList propertyNames() const;
 
 	qReal::Id id() const;
 
@@ -72,15 +115,41 @@ public:
 	/// Returns true, if it is logical object, false, if graphical.
 	virtual bool isLogicalObject() const = 0;
 
+	/// Defers loading of properties until the first access to them. Properties will be requested from
+	/// a given source, after that the object will release it.
+	void setLazyProperties(const QSharedPointer<const LazyPropertiesSource> &source, quint64 offset, quint32 size);
+
+	/// Returns true if properties of this object are already deserialized.
+	bool arePropertiesLoaded() const;
+
+	/// Loads properties from lazy source if they were not loaded yet. Shall be called before any access
+	/// to properties or other deferred data. Throws an exception if object data in the source is corrupted,
+	/// the source is kept then, so nothing is lost if the object is saved.
+	void ensurePropertiesLoaded() const;
+
 protected:
+	/// Takes graphical parts loaded from lazy source. Called before properties are marked as loaded.
+	virtual void setLazyGraphicalParts(const QList<QPair<int, QMap<QString, QVariant>>> &parts) const;
+
 	/// Implemented in derived classes to create a clone and init it with specific fields.
 	virtual Object *createClone() const = 0;
 
 	const qReal::Id mId;
 	qReal::Id mParent;
 	qReal::IdList mChildren;
-	QMap<QString, QVariant> mProperties;
 	QMap<QString, qReal::IdList> mTemporaryRemovedLinks;
+
+private:
+	/// Names of properties, shared with other objects. Mutable, as well as values and lazy source, because
+	/// properties are loaded on first access, which may be a const one.
+	mutable const PropertySchema *mSchema;
+
+	/// Values of properties indexed by slots of their names in schema.
+	mutable QVector<QVariant> mValues;
+
+	mutable QSharedPointer<const LazyPropertiesSource> mLazySource;
+	quint64 mLazyOffset;
+	quint32 mLazySize;
 };
 
 }
@@ -0,0 +1,101 @@
+#include "propertySchema.h"
+
+#include <algorithm>
+
+#include <QtCore/QMutex>
+
+using namespace qrRepo::details;
+
+namespace {
+
+QMutex &registryMutex()
+{
+	static QMutex mutex;
+	return mutex;
+}
+
+/// Key for schema registry. Count of names is a part of a key to distinguish empty schema and a schema
+/// with one property with empty name.
+QString registryKey(const QStringList &names)
+{
+	return QString::number(names.size()) + QChar(0) + names.join(QChar(0));
+}
+
+}
+
+PropertySchema::PropertySchema(const QStringList &sortedNames)
+	: mNames(sortedNames)
+{
+	mSlots.reserve(mNames.size());
+	for (int i = 0; i < mNames.size(); ++i) {
+		mSlots.insert(mNames[i], i);
+	}
+}
+
+const PropertySchema *PropertySchema::intern(const QStringList &sortedNames)
+{
+	static QHash<QString, const PropertySchema *> schemas;
+	const PropertySchema *&schema = schemas[registryKey(sortedNames)];
+	if (!schema) {
+		schema = new PropertySchema(sortedNames);
+	}
+
+	return schema;
+}
+
+const PropertySchema *PropertySchema::empty()
+{
+	static const PropertySchema * const emptySchema = forNames(QStringList());
+	return emptySchema;
+}
+
+const PropertySchema *PropertySchema::forNames(const QStringList &sortedNames)
+{
+	QMutexLocker lock(&registryMutex());
+	return intern(sortedNames);
+}
+
+const QStringList &PropertySchema::names() const
+{
+	return mNames;
+}
+
+int PropertySchema::size() const
+{
+	return mNames.size();
+}
+
+int PropertySchema::slot(const QString &name) const
+{
+	return mSlots.value(name, -1);
+}
+
+const PropertySchema *PropertySchema::withProperty(const QString &name) const
+{
+	Q_ASSERT(slot(name) == -1);
+
+	QMutexLocker lock(&registryMutex());
+	const PropertySchema *&result = mAdditions[name];
+	if (!result) {
+		QStringList names = mNames;
+		names.insert(std::lower_bound(names.begin(), names.end(), name), name);
+		result = intern(names);
+	}
+
+	return result;
+}
+
+const PropertySchema *PropertySchema::withoutProperty(const QString &name) const
+{
+	Q_ASSERT(slot(name) != -1);
+
+	QMutexLocker lock(&registryMutex());
+	const PropertySchema *&result = mRemovals[name];
+	if (!result) {
+		QStringList names = mNames;
+		names.removeAt(slot(name));
+		result = intern(names);
+	}
+
+	return result;
+}
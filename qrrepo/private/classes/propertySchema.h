@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
+
+namespace qrRepo {
+namespace details {
+
+/// Sorted set of property names shared by all objects having exactly these properties, which usually means
+/// all objects of one type. Objects keep only a pointer to a schema and a vector of values indexed by slot
+/// of a property name in it, so property names are stored once per schema instead of once per object.
+/// Schemas are immutable and interned process-wide, adding or removing a property moves an object to
+/// another schema, these transitions are cached. Schemas are never released.
+class PropertySchema
+{
+public:
+	/// Returns schema without properties.
+	static const PropertySchema *empty();
+
+	/// Returns schema with given property names, they shall be sorted and unique.
+	static const PropertySchema *forNames(const QStringList &sortedNames);
+
+	/// Returns sorted property names.
+	const QStringList &names() const;
+
+	/// Returns number of properties in schema.
+	int size() const;
+
+	/// Returns index of a given property in value vectors or -1 if there is no such property.
+	int slot(const QString &name) const;
+
+	/// Returns schema with all properties of this one and a given one, which shall not be in this schema.
+	/// Slots of properties after a new one are shifted by one.
+	const PropertySchema *withProperty(const QString &name) const;
+
+	/// Returns schema with all properties of this one except a given one, which shall be in this schema.
+	/// Slots of properties after a removed one are shifted by one back.
+	const PropertySchema *withoutProperty(const QString &name) const;
+
+private:
+	explicit PropertySchema(const QStringList &sortedNames);
+	Q_DISABLE_COPY(PropertySchema)
+
+	/// Returns existing schema with given names or creates a new one. Shall be called with registry lock held.
+	static const PropertySchema *intern(const QStringList &sortedNames);
+
+	const QStringList mNames;
+	QHash<QString, int> mSlots;
+
+	/// Cached results of withProperty() and withoutProperty(), guarded by registry lock.
+	mutable QHash<QString, const PropertySchema *> mAdditions;
+	mutable QHash<QString, const PropertySchema *> mRemovals;
+};
+
+}
+}
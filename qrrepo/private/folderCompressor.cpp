@@ -1,108 +1,288 @@
 #include "folderCompressor.h"
 
-bool FolderCompressor::compressFolder(const QString &sourceFolder, const QString &destinationFile)
+#include <QtCore/QDataStream>
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVector>
+
+namespace {
+
+/// Number of entries processed at once per each worker thread. Bounds memory consumed by compressor
+/// while keeping threads busy when file sizes differ.
+const int entriesPerThread = 4;
+
+/// Files larger than that are split into several entries, so a large file is compressed by several threads
+/// and is never kept in memory as a whole.
+const qint64 chunkSize = 1024 * 1024;
+
+/// Contents of the header entry with empty name which starts chunked archives. Readers that do not know about
+/// chunks fail on it trying to write a file with empty name, instead of silently restoring files from
+/// their first chunks only.
+const QByteArray formatMarker = "QReal chunked archive 2";
+
+/// Result of qCompress() for empty data, qUncompress() returns empty array for it, same as for broken data.
+const QByteArray compressedEmptyData(4, '\0');
+
+/// One chunk of a file of an archive being processed.
+struct Entry
 {
-	if (!QDir(sourceFolder).exists()) {
-		return false;
+	/// Name of a file relative to archived folder.
+	QString name;
+
+	/// Path of a file on disk, used only when compressing.
+	QString path;
+
+	/// Location of a chunk inside a file, used only when compressing.
+	qint64 offset;
+	qint64 size;
+
+	/// Compressed or uncompressed contents, depending on processing stage.
+	QByteArray data;
+
+	bool success;
+};
+
+/// Reads a chunk of a file and compresses it in a worker thread.
+class CompressTask : public QRunnable
+{
+public:
+	explicit CompressTask(Entry &entry)
+		: mEntry(entry)
+	{
 	}
 
-	QFile file(destinationFile);
-	if (!file.open(QIODevice::WriteOnly)) {
-		return false;
+	void run() override
+	{
+		QFile file(mEntry.path);
+		mEntry.success = file.open(QIODevice::ReadOnly) && file.seek(mEntry.offset);
+		if (mEntry.success) {
+			const QByteArray chunk = file.read(mEntry.size);
+			mEntry.success = chunk.size() == mEntry.size;
+			mEntry.data = qCompress(chunk);
+		}
 	}
 
-	QDataStream dataStream(&file);
+private:
+	Entry &mEntry;
+};
 
-	const bool result = compress(sourceFolder, "", dataStream);
-	file.close();
+/// Uncompresses contents of an entry in a worker thread.
+class UncompressTask : public QRunnable
+{
+public:
+	explicit UncompressTask(Entry &entry)
+		: mEntry(entry)
+	{
+	}
 
-	return result;
-}
+	void run() override
+	{
+		const bool isEmpty = mEntry.data == compressedEmptyData;
+		mEntry.data = qUncompress(mEntry.data);
+		mEntry.success = !mEntry.data.isEmpty() || isEmpty;
+	}
+
+private:
+	Entry &mEntry;
+};
 
-bool FolderCompressor::compress(const QString &sourceFolder, const QString &prefix, QDataStream &dataStream)
+/// Lists chunks of files inside a given folder recursively: files of subfolders first, then own files.
+bool collectFiles(const QString &sourceFolder, const QString &prefix, QList<Entry> &entries)
 {
 	QDir dir(sourceFolder);
 	if (!dir.exists()) {
 		return false;
 	}
 
-	// 1 - list all folders inside the current folder
 	dir.setFilter(QDir::NoDotAndDotDot | QDir::Dirs);
-	QFileInfoList foldersList = dir.entryInfoList();
-
-	// 2 - For each folder in list: call the same function with folders' paths
-	foreach (const QFileInfo &folder, foldersList) {
-		QString folderName = folder.fileName();
-		QString folderPath = dir.absolutePath() + "/" + folderName;
-		QString newPrefix = prefix + "/" + folderName;
-		compress(folderPath, newPrefix, dataStream);
+	for (const QFileInfo &folder : dir.entryInfoList()) {
+		collectFiles(dir.absolutePath() + "/" + folder.fileName(), prefix + "/" + folder.fileName(), entries);
 	}
 
-	// 3 - List all files inside the current folder
 	dir.setFilter(QDir::NoDotAndDotDot | QDir::Files);
-	QFileInfoList filesList = dir.entryInfoList();
+	for (const QFileInfo &fileInfo : dir.entryInfoList()) {
+		// Empty file still needs one entry to be restored.
+		qint64 offset = 0;
+		do {
+			Entry entry;
+			entry.name = prefix + "/" + fileInfo.fileName();
+			entry.path = dir.absolutePath() + "/" + fileInfo.fileName();
+			entry.offset = offset;
+			entry.size = qMin(chunkSize, fileInfo.size() - offset);
+			entry.success = false;
+			entries << entry;
+			offset += chunkSize;
+		} while (offset < fileInfo.size());
+	}
 
-	// 4- For each mFile in list: add mFile path and compressed binary data
-	foreach (const QFileInfo &fileInfo, filesList) {
-		QFile file(dir.absolutePath() + "/" + fileInfo.fileName());
-		if (!file.open(QIODevice::ReadOnly)) { // couldn't open file
-			return false;
+	return true;
+}
+
+int batchSize(const QThreadPool &pool)
+{
+	return qMax(1, pool.maxThreadCount()) * entriesPerThread;
+}
+
+}
+
+bool FolderCompressor::compressFolder(const QString &sourceFolder, const QString &destinationFile)
+{
+	QList<Entry> files;
+	if (!collectFiles(sourceFolder, "", files)) {
+		return false;
+	}
+
+	QFile file(destinationFile);
+	if (!file.open(QIODevice::WriteOnly)) {
+		return false;
+	}
+
+	QDataStream dataStream(&file);
+	dataStream << QString() << formatMarker;
+
+	QThreadPool pool;
+	const int size = batchSize(pool);
+
+	for (int batchStart = 0; batchStart < files.size(); batchStart += size) {
+		// Batch is not resized while tasks are running, so references to its elements stay valid.
+		QVector<Entry> batch = files.mid(batchStart, size).toVector();
+		for (Entry &entry : batch) {
+			pool.start(new CompressTask(entry));
 		}
 
-		dataStream << QString(prefix + "/" + fileInfo.fileName());
-		dataStream << qCompress(file.readAll());
+		pool.waitForDone();
 
-		file.close();
+		for (const Entry &entry : batch) {
+			if (!entry.success) {
+				return false;
+			}
+
+			dataStream << entry.name << entry.data;
+		}
 	}
 
-	return true;
+	return dataStream.status() == QDataStream::Ok;
 }
 
 bool FolderCompressor::decompressFolder(const QString &sourceFile, const QString &destinationFolder)
 {
-	if (!QFile(sourceFile).exists()) { // mFile not found, to handle later
+	if (!QFile(sourceFile).exists()) {
 		return false;
 	}
 
 	QDir dir;
-	if (!dir.mkpath(destinationFolder)) { // could not create folder
+	if (!dir.mkpath(destinationFolder)) {
 		return false;
 	}
 
+	QFile outFile;
+	return readEntries(sourceFile, [&dir, &destinationFolder, &outFile](const QString &fileName
+			, const QByteArray &data, bool isFirstChunk)
+	{
+		if (isFirstChunk) {
+			const int lastSeparator = qMax(fileName.lastIndexOf('/'), fileName.lastIndexOf('\\'));
+			if (lastSeparator > 0) {
+				dir.mkpath(destinationFolder + "/" + fileName.left(lastSeparator));
+			}
+
+			outFile.close();
+			outFile.setFileName(destinationFolder + "/" + fileName);
+			if (!outFile.open(QIODevice::WriteOnly)) {
+				return false;
+			}
+		}
+
+		return outFile.write(data) == data.size();
+	});
+}
+
+bool FolderCompressor::readArchive(const QString &sourceFile
+		, const std::function<bool(const QString &, const QByteArray &)> &consumer)
+{
+	QString currentName;
+	QByteArray currentData;
+	const bool success = readEntries(sourceFile, [&consumer, &currentName, &currentData](const QString &fileName
+			, const QByteArray &data, bool isFirstChunk)
+	{
+		if (!isFirstChunk) {
+			currentData.append(data);
+			return true;
+		}
+
+		if (!currentName.isNull() && !consumer(currentName, currentData)) {
+			return false;
+		}
+
+		currentName = fileName;
+		currentData = data;
+		return true;
+	});
+
+	return success && (currentName.isNull() || consumer(currentName, currentData));
+}
+
+bool FolderCompressor::readEntries(const QString &sourceFile
+		, const std::function<bool(const QString &, const QByteArray &, bool)> &consumer)
+{
 	QFile file(sourceFile);
 	if (!file.open(QIODevice::ReadOnly)) {
 		return false;
 	}
 
 	QDataStream dataStream(&file);
+	QThreadPool pool;
+	const int size = batchSize(pool);
+	QString previousName;
+	QVector<Entry> batch;
 
-	while (!dataStream.atEnd()) {
-		QString fileName;
-		QByteArray data;
+	if (!dataStream.atEnd()) {
+		Entry first;
+		dataStream >> first.name >> first.data;
+		if (dataStream.status() != QDataStream::Ok) {
+			return false;
+		}
 
-		dataStream >> fileName >> data; // extract file name and data in order
+		if (first.name.isEmpty()) {
+			if (first.data != formatMarker) {
+				// Written by a newer version in a format we do not know.
+				return false;
+			}
+		} else {
+			// Archives written before chunks were introduced have no header and one entry per file.
+			first.success = false;
+			batch << first;
+		}
+	}
 
-		QString subfolder; // create any needed folder
-		for (int i = fileName.length() - 1; i > 0; i--) {
-			if((QString(fileName.at(i)) == QString("\\"))
-					|| (QString(fileName.at(i)) == QString("/")))
-			{
-				subfolder = fileName.left(i);
-				dir.mkpath(destinationFolder+"/"+subfolder);
-				break;
+	while (!batch.isEmpty() || !dataStream.atEnd()) {
+		batch.reserve(size);
+		while (batch.size() < size && !dataStream.atEnd()) {
+			Entry entry;
+			dataStream >> entry.name >> entry.data;
+			if (dataStream.status() != QDataStream::Ok) {
+				return false;
 			}
+
+			entry.success = false;
+			batch << entry;
 		}
 
-		QFile outFile(destinationFolder + "/" + fileName);
-		if (!outFile.open(QIODevice::WriteOnly)) {
-			file.close();
-			return false;
+		for (Entry &entry : batch) {
+			pool.start(new UncompressTask(entry));
+		}
+
+		pool.waitForDone();
+
+		for (const Entry &entry : batch) {
+			if (!entry.success || !consumer(entry.name, entry.data, entry.name != previousName)) {
+				return false;
+			}
+
+			previousName = entry.name;
 		}
-		outFile.write(qUncompress(data));
-		outFile.close();
+
+		batch.clear();
 	}
 
-	file.close();
 	return true;
 }
-
@@ -1,9 +1,17 @@
 #pragma once
 
+#include <functional>
+
 #include <QtCore/QFile>
 #include <QtCore/QDir>
 
-/// Utility to compress and decompress folder uzing qCompress function.
+/// Utility to compress and decompress folder uzing qCompress function. Archive is a sequence of entries,
+/// each one is a file name relative to archived folder and its compressed contents. Files larger than 1 MB
+/// are split into several consecutive entries with the same name. Such archives start with a header entry
+/// with empty name and a format marker, so older versions reject them; archives without a header, with one
+/// entry per file, are still read. Entries are independent, so they are
+/// compressed and decompressed in parallel by a thread pool, in bounded batches to keep memory consumption
+/// small regardless of the size of archived data.
 class FolderCompressor
 {
 public:
@@ -18,12 +26,22 @@ public:
 	/// @returns true if operation was successful.
 	static bool decompressFolder(const QString &sourceFile, const QString &destinationFolder);
 
+	/// Reads files of the compressed file one by one without writing them to disk, only the current batch
+	/// of entries is kept in memory.
+	/// @param consumer - gets name of each file relative to archived folder, like "/dir/file", and its
+	///        uncompressed contents, in archive order. Reading stops if it returns false.
+	/// @returns true if all files were read and consumed successfully.
+	static bool readArchive(const QString &sourceFile
+			, const std::function<bool(const QString &, const QByteArray &)> &consumer);
+
 private:
 	/// Creating is prohibited, utility class instances can not be created.
 	FolderCompressor();
 
-	static bool compress(const QString &sourceFolder, const QString &prefix, QDataStream &dataStream);
+	/// Reads entries of the compressed file, decompressing them in parallel, and passes them in order
+	/// to a given consumer along with a flag that is false for continuation chunks of the same file.
+	/// Stops if consumer returns false or an entry is corrupted.
+	/// @returns true if all entries were read, uncompressed and consumed successfully.
+	static bool readEntries(const QString &sourceFile
+			, const std::function<bool(const QString &, const QByteArray &, bool)> &consumer);
 };
-
-
-
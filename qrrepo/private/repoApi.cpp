@@ -389,22 +389,24 @@ void RepoApi::exportToXml(const QString &targetFile) const
 	mRepository.exportToXml(targetFile);
 }
 
-void RepoApi::saveAll() const
+bool RepoApi::saveAll() const
 {
-	mRepository.saveAll();
+	return mRepository.saveAll();
 }
 
-void RepoApi::saveTo(const QString &workingFile)
+bool RepoApi::saveTo(const QString &workingFile)
 {
-	if (!mIgnoreAutosave) {
-		mRepository.setWorkingFile(workingFile);
-		mRepository.saveAll();
+	if (mIgnoreAutosave) {
+		return true;
 	}
+
+	mRepository.setWorkingFile(workingFile);
+	return mRepository.saveAll();
 }
 
-void RepoApi::saveDiagramsById(QHash<QString, IdList> const &diagramIds)
+bool RepoApi::saveDiagramsById(QHash<QString, IdList> const &diagramIds)
 {
-	mRepository.saveDiagramsById(diagramIds);
+	return mRepository.saveDiagramsById(diagramIds);
 }
 
 void RepoApi::importFromDisk(const QString &importedFile)
@@ -412,9 +414,9 @@ void RepoApi::importFromDisk(const QString &importedFile)
 	mRepository.importFromDisk(importedFile);
 }
 
-void RepoApi::save(const qReal::IdList &list) const
+bool RepoApi::save(const qReal::IdList &list) const
 {
-	mRepository.save(list);
+	return mRepository.save(list);
 }
 
 QString RepoApi::workingFile() const
@@ -483,10 +485,16 @@ IdList RepoApi::logicalElements(const Id &type) const
 	Q_ASSERT(type.idSize() == 3);
 
 	IdList result;
-	foreach (Id id, mRepository.elements()) {
-		if (id.element() == type.element() && mRepository.isLogicalId(id))
-			result.append(id);
+	for (const Id &elementType : mRepository.types()) {
+		if (elementType.element() == type.element()) {
+			for (const Id &id : mRepository.elementsOfType(elementType)) {
+				if (mRepository.isLogicalId(id)) {
+					result.append(id);
+				}
+			}
+		}
 	}
+
 	return result;
 }
 
@@ -495,37 +503,42 @@ IdList RepoApi::graphicalElements(const Id &type) const
 	Q_ASSERT(type.idSize() == 3);
 
 	IdList result;
-	foreach (Id id, mRepository.elements()) {
-		if (id.element() == type.element() && !mRepository.isLogicalId(id))
-			result.append(id);
+	for (const Id &elementType : mRepository.types()) {
+		if (elementType.element() == type.element()) {
+			for (const Id &id : mRepository.elementsOfType(elementType)) {
+				if (!mRepository.isLogicalId(id)) {
+					result.append(id);
+				}
+			}
+		}
 	}
+
 	return result;
 }
 
 IdList RepoApi::elementsByType(const QString &type, bool sensitivity, bool regExpression) const
 {
 	const Qt::CaseSensitivity caseSensitivity = sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive;
-
-	QRegExp *regExp = new QRegExp(type,caseSensitivity);
+	const QRegExp regExp(type, caseSensitivity);
 
 	IdList result;
-
-	if (regExpression) {
-		foreach (const Id &id, mRepository.elements()) {
-			if (id.element().contains(*regExp)) {
-				result.append(id);
-			}
-		}
-	} else {
-		foreach (const Id &id, mRepository.elements()) {
-			if (id.element().contains(type, caseSensitivity)) {
-				result.append(id);
-			}
+	for (const Id &elementType : mRepository.types()) {
+		const bool matches = regExpression
+				? elementType.element().contains(regExp)
+				: elementType.element().contains(type, caseSensitivity);
+		if (matches) {
+			result << mRepository.elementsOfType(elementType);
 		}
 	}
+
 	return result;
 }
 
+IdList RepoApi::elementsOfType(const Id &type) const
+{
+	return mRepository.elementsOfType(type);
+}
+
 qReal::IdList RepoApi::elementsByProperty(const QString &property, bool sensitivity, bool regExpression) const
 {
 	return mRepository.elementsByProperty(property, sensitivity, regExpression);
@@ -556,7 +569,7 @@ void RepoApi::removeTemporaryRemovedLinks(const Id &id)
 	mRepository.removeTemporaryRemovedLinks(id);
 }
 
-QMapIterator<QString, QVariant> RepoApi::propertiesIterator(const qReal::Id &id) const
+PropertiesIterator RepoApi::propertiesIterator(const qReal::Id &id) const
 {
 	return mRepository.propertiesIterator(id);
 }
@@ -9,6 +9,9 @@ using namespace qReal;
 using namespace qrRepo;
 using namespace qrRepo::details;
 
+/// Number of incremental saves after which a file is completely rewritten to compact its journal.
+const int maxJournalSections = 32;
+
 Repository::Repository(const QString &workingFile)
 		: mWorkingFile(workingFile)
 		, mSerializer(workingFile)
@@ -33,22 +36,21 @@ Repository::~Repository()
 IdList Repository::findElementsByName(const QString &name, bool sensitivity, bool regExpression) const
 {
 	const Qt::CaseSensitivity caseSensitivity = sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive;
-
-	const QRegExp regExp(name, caseSensitivity);
+	mIndex.ensurePropertiesIndexed(mObjects);
+	const QHash<Id, QString> &names = mIndex.names();
 	IdList result;
 
-	if (regExpression){
-		foreach (Object * const element, mObjects.values()) {
-			if (element->property("name").toString().contains(regExp)
-					&& !isLogicalId(mObjects.key(element))) {
-				result.append(mObjects.key(element));
+	if (regExpression) {
+		const QRegExp regExp(name, caseSensitivity);
+		for (QHash<Id, QString>::const_iterator it = names.constBegin(); it != names.constEnd(); ++it) {
+			if (it.value().contains(regExp) && !isLogicalId(it.key())) {
+				result.append(it.key());
 			}
 		}
 	} else {
-		foreach (Object * const element, mObjects.values()) {
-			if (element->property("name").toString().contains(name, caseSensitivity)
-					&& !isLogicalId(mObjects.key(element))) {
-				result.append(mObjects.key(element));
+		for (const Id &candidate : mIndex.nameCandidates(name)) {
+			if (names.value(candidate).contains(name, caseSensitivity) && !isLogicalId(candidate)) {
+				result.append(candidate);
 			}
 		}
 	}
@@ -59,12 +61,29 @@ IdList Repository::findElementsByName(const QString &name, bool sensitivity, boo
 qReal::IdList Repository::elementsByProperty(const QString &property, bool sensitivity
 		, bool regExpression) const
 {
-	IdList result;
+	const Qt::CaseSensitivity caseSensitivity = sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive;
+	mIndex.ensurePropertiesIndexed(mObjects);
+
+	// Distinct property names are few, so matching them instead of properties of each object.
+	QSet<Id> found;
+	if (regExpression) {
+		for (const QString &propertyName : mIndex.propertyNames().filter(QRegExp(property, caseSensitivity))) {
+			found.unite(mIndex.elementsWithProperty(propertyName));
+		}
+	} else if (sensitivity) {
+		found = mIndex.elementsWithProperty(property);
+	} else {
+		for (const QString &propertyName : mIndex.propertyNames()) {
+			if (propertyName.compare(property, Qt::CaseInsensitive) == 0) {
+				found.unite(mIndex.elementsWithProperty(propertyName));
+			}
+		}
+	}
 
-	foreach (Object *element, mObjects.values()) {
-		if ((element->hasProperty(property, sensitivity, regExpression))
-				&& (!isLogicalId(mObjects.key(element)))) {
-			result.append(mObjects.key(element));
+	IdList result;
+	for (const Id &id : found) {
+		if (!isLogicalId(id)) {
+			result.append(id);
 		}
 	}
 
@@ -79,21 +98,13 @@ qReal::IdList Repository::elementsByPropertyContent(const QString &propertyValue
 	const QRegExp regExp(propertyValue, caseSensitivity);
 	IdList result;
 
-	foreach (Object * const element, mObjects.values()) {
-		QMapIterator<QString, QVariant> iterator = element->propertiesIterator();
-		if (regExpression) {
-			while (iterator.hasNext()) {
-				if (iterator.next().value().toString().contains(regExp)) {
-					result.append(mObjects.key(element));
-					break;
-				}
-			}
-		} else {
-			while (iterator.hasNext()) {
-				if (iterator.next().value().toString().contains(propertyValue, caseSensitivity)) {
-					result.append(mObjects.key(element));
-					break;
-				}
+	for (QHash<Id, Object *>::const_iterator it = mObjects.constBegin(); it != mObjects.constEnd(); ++it) {
+		PropertiesIterator iterator = it.value()->propertiesIterator();
+		while (iterator.hasNext()) {
+			const QString value = iterator.next().value().toString();
+			if (regExpression ? value.contains(regExp) : value.contains(propertyValue, caseSensitivity)) {
+				result.append(it.key());
+				break;
 			}
 		}
 	}
@@ -101,10 +112,24 @@ qReal::IdList Repository::elementsByPropertyContent(const QString &propertyValue
 	return result;
 }
 
+qReal::IdList Repository::elementsOfType(const qReal::Id &type) const
+{
+	mIndex.ensureTypesIndexed(mObjects);
+	return mIndex.elementsOfType(type).toList();
+}
+
+qReal::IdList Repository::types() const
+{
+	mIndex.ensureTypesIndexed(mObjects);
+	return mIndex.types();
+}
+
 void Repository::replaceProperties(const qReal::IdList &toReplace, const QString value, const QString newValue)
 {
 	foreach (const qReal::Id &currentId, toReplace) {
 		mObjects[currentId]->replaceProperties(value, newValue);
+		markChanged(currentId);
+		updateIndex(currentId);
 	}
 }
 
@@ -129,6 +154,11 @@ Id Repository::parent(const Id &id) const
 Id Repository::cloneObject(const qReal::Id &id)
 {
 	const Object * const result = mObjects[id]->clone(mObjects);
+	for (const Id &clonedId : idsOfAllChildrenOf(result->id())) {
+		markChanged(clonedId);
+		updateIndex(clonedId);
+	}
+
 	return result->id();
 }
 
@@ -139,6 +169,9 @@ void Repository::setParent(const Id &id, const Id &parent)
 			mObjects[id]->setParent(parent);
 			if (!mObjects[parent]->children().contains(id))
 				mObjects[parent]->addChild(id);
+
+			markChanged(id);
+			markChanged(parent);
 		} else {
 			throw Exception("Repository: Adding nonexistent parent " + parent.toString()
 					+ " to  object " + id.toString());
@@ -171,6 +204,10 @@ void Repository::addChild(const Id &id, const Id &child, const Id &logicalId)
 
 			mObjects.insert(child, object);
 		}
+
+		markChanged(id);
+		markChanged(child);
+		updateIndex(child);
 	} else {
 		throw Exception("Repository: Adding child " + child.toString() + " to nonexistent object " + id.toString());
 	}
@@ -190,6 +227,7 @@ void Repository::stackBefore(const qReal::Id &id, const qReal::Id &child, const
 	}
 
 	mObjects[id]->stackBefore(child, sibling);
+	markChanged(id);
 }
 
 void Repository::removeParent(const Id &id)
@@ -199,6 +237,8 @@ void Repository::removeParent(const Id &id)
 		if (mObjects.contains(parent)) {
 			mObjects[id]->setParent(Id());
 			mObjects[parent]->removeChild(id);
+			markChanged(id);
+			markChanged(parent);
 		} else {
 			throw Exception("Repository: Removing nonexistent parent " + parent.toString()
 					+ " from object " + id.toString());
@@ -213,6 +253,7 @@ void Repository::removeChild(const Id &id, const Id &child)
 	if (mObjects.contains(id)) {
 		if (mObjects.contains(child)) {
 			mObjects[id]->removeChild(child);
+			markChanged(id);
 		} else {
 			throw Exception("Repository: removing nonexistent child " + child.toString()
 					+ " from object " + id.toString());
@@ -230,6 +271,8 @@ void Repository::setProperty(const Id &id, const QString &name, const QVariant &
 //				 ? mObjects[id]->property(name).userType() == value.userType()
 //				 : true);
 		mObjects[id]->setProperty(name, value);
+		markChanged(id);
+		mIndex.propertySet(*mObjects[id], name);
 	} else {
 		throw Exception("Repository: Setting property of nonexistent object " + id.toString());
 	}
@@ -238,6 +281,8 @@ void Repository::setProperty(const Id &id, const QString &name, const QVariant &
 void Repository::copyProperties(const Id &dest, const Id &src)
 {
 	mObjects[dest]->copyPropertiesFrom(*mObjects[src]);
+	markChanged(dest);
+	updateIndex(dest);
 }
 
 QMap<QString, QVariant> Repository::properties(const Id &id)
@@ -248,6 +293,8 @@ QMap<QString, QVariant> Repository::properties(const Id &id)
 void Repository::setProperties(const Id &id, QMap<QString, QVariant> const &properties)
 {
 	mObjects[id]->setProperties(properties);
+	markChanged(id);
+	updateIndex(id);
 }
 
 QVariant Repository::property( const Id &id, const QString &name ) const
@@ -262,7 +309,9 @@ QVariant Repository::property( const Id &id, const QString &name ) const
 void Repository::removeProperty( const Id &id, const QString &name )
 {
 	if (mObjects.contains(id)) {
-		return mObjects[id]->removeProperty(name);
+		mObjects[id]->removeProperty(name);
+		markChanged(id);
+		updateIndex(id);
 	} else {
 		throw Exception("Repository: Removing property of nonexistent object " + id.toString());
 	}
@@ -283,6 +332,8 @@ void Repository::setBackReference(const Id &id, const Id &reference) const
 	if (mObjects.contains(id)) {
 		if (mObjects.contains(reference)) {
 			mObjects[id]->setBackReference(reference);
+			markChanged(id);
+			mIndex.propertySet(*mObjects[id], "backReferences");
 		} else {
 			throw Exception("Repository: setting nonexistent back reference " + reference.toString()
 							+ " to object " + id.toString());
@@ -297,6 +348,7 @@ void Repository::removeBackReference(const Id &id, const Id &reference) const
 	if (mObjects.contains(id)) {
 		if (mObjects.contains(reference)) {
 			mObjects[id]->removeBackReference(reference);
+			markChanged(id);
 		} else {
 			throw Exception("Repository: removing nonexistent back reference " + reference.toString()
 							+ " of object " + id.toString());
@@ -310,6 +362,7 @@ void Repository::setTemporaryRemovedLinks(const Id &id, const QString &direction
 {
 	if (mObjects.contains(id)) {
 		mObjects[id]->setTemporaryRemovedLinks(direction, linkIdList);
+		markChanged(id);
 	} else {
 		throw Exception("Repository: Setting temporaryRemovedLinks of nonexistent object " + id.toString());
 	}
@@ -336,7 +389,9 @@ IdList Repository::temporaryRemovedLinks(const Id &id) const
 void Repository::removeTemporaryRemovedLinks(const Id &id)
 {
 	if (mObjects.contains(id)) {
-		return mObjects[id]->removeTemporaryRemovedLinks();
+		mObjects[id]->removeTemporaryRemovedLinks();
+		markChanged(id);
+		updateIndex(id);
 	} else {
 		throw Exception("Repository: Removing temporaryRemovedLinks of nonexistent object " + id.toString());
 	}
@@ -346,6 +401,8 @@ void Repository::loadFromDisk()
 {
 	mSerializer.loadFromDisk(mObjects, mMetaInfo);
 	addChildrenToRootObject();
+	resetChangesTracking();
+	mIndex.clear();
 }
 
 void Repository::importFromDisk(const QString &importedFile)
@@ -376,6 +433,36 @@ IdList Repository::idsOfAllChildrenOf(Id id) const
 	return result;
 }
 
+void Repository::markChanged(const Id &id) const
+{
+	for (PendingChanges &changes : mPendingChanges) {
+		changes.changed.insert(id);
+	}
+}
+
+void Repository::markRemoved(const Id &id) const
+{
+	for (PendingChanges &changes : mPendingChanges) {
+		changes.changed.remove(id);
+		changes.removed.insert(id);
+	}
+}
+
+void Repository::resetChangesTracking()
+{
+	mPendingChanges.clear();
+}
+
+void Repository::updateIndex(const Id &id) const
+{
+	const Object * const object = mObjects.value(id);
+	if (object) {
+		mIndex.update(*object);
+	} else {
+		mIndex.remove(id);
+	}
+}
+
 QList<Object*> Repository::allChildrenOf(Id id) const
 {
 	QList<Object*> result;
@@ -403,33 +490,62 @@ bool Repository::exist(const Id &id) const
 	return (mObjects[id] != nullptr);
 }
 
-void Repository::saveAll() const
+bool Repository::saveAll() const
 {
-	mSerializer.saveToDisk(mObjects.values(), mMetaInfo);
+	const bool tracked = mPendingChanges.contains(mWorkingFile);
+	PendingChanges &changes = mPendingChanges[mWorkingFile];
+	if (tracked && changes.journalSections < maxJournalSections && changes.changed.size() < mObjects.size() / 2) {
+		QList<Object *> changed;
+		for (const Id &id : changes.changed) {
+			if (Object * const object = mObjects.value(id)) {
+				changed << object;
+			}
+		}
+
+		if (mSerializer.appendChangesToDisk(changed, changes.removed.toList(), mMetaInfo)) {
+			++changes.journalSections;
+			changes.changed.clear();
+			changes.removed.clear();
+			return true;
+		}
+	}
+
+	if (!mSerializer.saveToDisk(mObjects.values(), mMetaInfo)) {
+		// Nothing is known about the file contents now, so the next save will be a full one.
+		mPendingChanges.remove(mWorkingFile);
+		return false;
+	}
+
+	changes = PendingChanges();
+	return true;
 }
 
-void Repository::save(const IdList &list) const
+bool Repository::save(const IdList &list) const
 {
 	QList<Object*> toSave;
 	for (const Id &id : list) {
 		toSave.append(allChildrenOf(id));
 	}
 
-	mSerializer.saveToDisk(toSave, mMetaInfo);
+	// File will contain only a part of the model, so it can not be updated incrementally.
+	mPendingChanges.remove(mWorkingFile);
+	return mSerializer.saveToDisk(toSave, mMetaInfo);
 }
 
-void Repository::saveWithLogicalId(const qReal::IdList &list) const
+bool Repository::saveWithLogicalId(const qReal::IdList &list) const
 {
 	QList<Object*> toSave;
 	for (const Id &id : list) {
 		toSave << allChildrenOfWithLogicalId(id);
 	}
 
-	mSerializer.saveToDisk(toSave, mMetaInfo);
+	mPendingChanges.remove(mWorkingFile);
+	return mSerializer.saveToDisk(toSave, mMetaInfo);
 }
 
-void Repository::saveDiagramsById(QHash<QString, IdList> const &diagramIds)
+bool Repository::saveDiagramsById(QHash<QString, IdList> const &diagramIds)
 {
+	bool result = true;
 	const QString currentWorkingFile = mWorkingFile;
 	for (const QString &savePath : diagramIds.keys()) {
 		const qReal::IdList diagrams = diagramIds[savePath];
@@ -443,10 +559,11 @@ void Repository::saveDiagramsById(QHash<QString, IdList> const &diagramIds)
 			elementsToSave += logicalId(id);
 		}
 
-		saveWithLogicalId(elementsToSave);
+		result &= saveWithLogicalId(elementsToSave);
 	}
 
 	setWorkingFile(currentWorkingFile);
+	return result;
 }
 
 void Repository::remove(const IdList &list) const
@@ -462,6 +579,8 @@ void Repository::remove(const qReal::Id &id)
 	if (mObjects.contains(id)) {
 		delete mObjects[id];
 		mObjects.remove(id);
+		markRemoved(id);
+		mIndex.remove(id);
 	} else {
 		throw Exception("Repository: Trying to remove nonexistent object " + id.toString());
 	}
@@ -507,12 +626,15 @@ void Repository::exterminate()
 	}
 
 	init();
+	resetChangesTracking();
+	mIndex.clear();
 	printDebug();
 }
 
 void Repository::open(const QString &saveFile)
 {
 	mObjects.clear();
+	mIndex.clear();
 	init();
 	mSerializer.setWorkingFile(saveFile);
 	loadFromDisk();
@@ -538,7 +660,7 @@ qReal::Id Repository::logicalId(const qReal::Id &elem) const
 	return graphicalObject->logicalId();
 }
 
-QMapIterator<QString, QVariant> Repository::propertiesIterator(const qReal::Id &id) const
+PropertiesIterator Repository::propertiesIterator(const qReal::Id &id) const
 {
 	return mObjects[id]->propertiesIterator();
 }
@@ -551,6 +673,7 @@ void Repository::createGraphicalPart(const qReal::Id &id, int partIndex)
 	}
 
 	graphicalObject->createGraphicalPart(partIndex);
+	markChanged(id);
 }
 
 QList<int> Repository::graphicalParts(const qReal::Id &id) const
@@ -586,6 +709,7 @@ void Repository::setGraphicalPartProperty(
 	}
 
 	graphicalObject->setGraphicalPartProperty(partIndex, propertyName, value);
+	markChanged(id);
 }
 
 QStringList Repository::metaInformationKeys() const
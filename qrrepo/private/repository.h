@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QtCore/QHash>
+#include <QtCore/QSet>
 
 #include <qrkernel/definitions.h>
 #include <qrkernel/ids.h>
@@ -8,6 +9,7 @@
 #include "classes/graphicalObject.h"
 #include "classes/logicalObject.h"
 #include "qrRepoGlobal.h"
+#include "repositoryIndex.h"
 #include "serializer.h"
 
 namespace qrRepo {
@@ -38,6 +40,12 @@ public:
 	/// @param name - string that should be contained by names of elements that have input property content
 	qReal::IdList elementsByPropertyContent(const QString &property, bool sensitivity, bool regExpression) const;
 
+	/// Returns all elements whose type() is equal to given type.
+	qReal::IdList elementsOfType(const qReal::Id &type) const;
+
+	/// Returns types of all elements in repository.
+	qReal::IdList types() const;
+
 	qReal::IdList children(const qReal::Id &id) const;
 	qReal::Id parent(const qReal::Id &id) const;
 	/**
@@ -63,7 +71,7 @@ public:
 	bool hasProperty(const qReal::Id &id, const QString &name, bool sensitivity = false
 			, bool regExpression = false) const;
 	void removeProperty(const qReal::Id &id, const QString &name);
-	QMapIterator<QString, QVariant> propertiesIterator(const qReal::Id &id) const;
+	PropertiesIterator propertiesIterator(const qReal::Id &id) const;
 
 	void setBackReference(const qReal::Id &id, const qReal::Id &reference) const;
 	void removeBackReference(const qReal::Id &id, const qReal::Id &reference) const;
@@ -88,10 +96,14 @@ public:
 	/// @param importedFile - name of file to be imported
 	void importFromDisk(const QString &importedFile);
 
-	void saveAll() const;
-	void save(const qReal::IdList &list) const;
-	void saveWithLogicalId(const qReal::IdList &list) const;
-	void saveDiagramsById(QHash<QString, qReal::IdList> const &diagramIds);
+	/// Saves all objects to working file. If the working file was written by previous saveAll() call and
+	/// was not changed since, only objects modified after that are appended to it as a journal section;
+	/// the file is rewritten completely after a number of such incremental saves.
+	/// Save methods return false if some file could not be written.
+	bool saveAll() const;
+	bool save(const qReal::IdList &list) const;
+	bool saveWithLogicalId(const qReal::IdList &list) const;
+	bool saveDiagramsById(QHash<QString, qReal::IdList> const &diagramIds);
 	void remove(const qReal::IdList &list) const;
 	void setWorkingFile(const QString &workingDir);
 	void exportToXml(const QString &targetFile) const;
@@ -141,6 +153,18 @@ private:
 	void loadFromDisk();
 	void addChildrenToRootObject();
 
+	/// Remembers that given object was created or modified, so it shall be written by next incremental save.
+	void markChanged(const qReal::Id &id) const;
+
+	/// Remembers that given object was removed, so next incremental save shall record its removal.
+	void markRemoved(const qReal::Id &id) const;
+
+	/// Forgets all tracked changes, so next save to any file will be a full one.
+	void resetChangesTracking();
+
+	/// Reindexes given object (or removes it from indexes if it does not exist anymore) after its change.
+	void updateIndex(const qReal::Id &id) const;
+
 	qReal::IdList idsOfAllChildrenOf(qReal::Id id) const;
 	QList<Object*> allChildrenOf(qReal::Id id) const;
 	QList<Object*> allChildrenOfWithLogicalId(qReal::Id id) const;
@@ -151,6 +175,24 @@ private:
 	/// Name of the current save file for project.
 	QString mWorkingFile;
 	Serializer mSerializer;
+
+	/// Changes made since the last saveAll() to some file.
+	struct PendingChanges
+	{
+		PendingChanges() : journalSections(0) {}
+
+		QSet<qReal::Id> changed;
+		QSet<qReal::Id> removed;
+
+		/// Number of journal sections appended to a file since it was completely rewritten last time.
+		int journalSections;
+	};
+
+	/// Pending changes for each file written by saveAll(), keyed by working file name.
+	mutable QHash<QString, PendingChanges> mPendingChanges;
+
+	/// Indexes for search queries, built on first query. Mutable since queries are const.
+	mutable RepositoryIndex mIndex;
 };
 
 }
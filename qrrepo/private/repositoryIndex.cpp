@@ -0,0 +1,208 @@
+#include "repositoryIndex.h"
+
+#include <algorithm>
+
+using namespace qReal;
+using namespace qrRepo::details;
+
+/// Length of substrings by which names are indexed.
+const int trigramLength = 3;
+
+RepositoryIndex::RepositoryIndex()
+	: mTypesIndexed(false)
+	, mPropertiesIndexed(false)
+{
+}
+
+void RepositoryIndex::clear()
+{
+	mTypesIndexed = false;
+	mPropertiesIndexed = false;
+	mElementsByProperty.clear();
+	mPropertiesOfElement.clear();
+	mElementsByTrigram.clear();
+	mNames.clear();
+	mElementsByType.clear();
+}
+
+void RepositoryIndex::ensureTypesIndexed(const QHash<Id, Object *> &objects)
+{
+	if (mTypesIndexed) {
+		return;
+	}
+
+	for (QHash<Id, Object *>::const_iterator it = objects.constBegin(); it != objects.constEnd(); ++it) {
+		mElementsByType[it.key().type()].insert(it.key());
+	}
+
+	mTypesIndexed = true;
+}
+
+void RepositoryIndex::ensurePropertiesIndexed(const QHash<Id, Object *> &objects)
+{
+	if (mPropertiesIndexed) {
+		return;
+	}
+
+	for (const Object * const object : objects) {
+		addProperties(*object);
+	}
+
+	mPropertiesIndexed = true;
+}
+
+void RepositoryIndex::update(const Object &object)
+{
+	if (mTypesIndexed) {
+		mElementsByType[object.id().type()].insert(object.id());
+	}
+
+	if (mPropertiesIndexed) {
+		removeProperties(object.id());
+		addProperties(object);
+	}
+}
+
+void RepositoryIndex::propertySet(const Object &object, const QString &name)
+{
+	if (!mPropertiesIndexed) {
+		return;
+	}
+
+	const Id id = object.id();
+	QStringList &properties = mPropertiesOfElement[id];
+	if (!properties.contains(name)) {
+		properties << name;
+		mElementsByProperty[name].insert(id);
+	}
+
+	if (name == "name") {
+		removeName(id);
+		addName(id, object.property(name).toString());
+	}
+}
+
+void RepositoryIndex::remove(const Id &id)
+{
+	if (mTypesIndexed) {
+		const Id type = id.type();
+		QSet<Id> &ofType = mElementsByType[type];
+		ofType.remove(id);
+		if (ofType.isEmpty()) {
+			mElementsByType.remove(type);
+		}
+	}
+
+	if (mPropertiesIndexed) {
+		removeProperties(id);
+	}
+}
+
+QStringList RepositoryIndex::propertyNames() const
+{
+	return mElementsByProperty.keys();
+}
+
+QSet<Id> RepositoryIndex::elementsWithProperty(const QString &name) const
+{
+	return mElementsByProperty.value(name);
+}
+
+QSet<Id> RepositoryIndex::nameCandidates(const QString &substring) const
+{
+	if (substring.length() < trigramLength) {
+		return mNames.keys().toSet();
+	}
+
+	// Intersecting starting from the rarest trigram keeps intermediate sets small.
+	QList<const QSet<Id> *> sets;
+	for (const QString &trigram : trigrams(substring)) {
+		const QHash<QString, QSet<Id>>::const_iterator found = mElementsByTrigram.constFind(trigram);
+		if (found == mElementsByTrigram.constEnd()) {
+			return QSet<Id>();
+		}
+
+		sets << &found.value();
+	}
+
+	std::sort(sets.begin(), sets.end(), [](const QSet<Id> *first, const QSet<Id> *second) {
+		return first->size() < second->size();
+	});
+
+	QSet<Id> result = *sets.first();
+	for (int i = 1; i < sets.size() && !result.isEmpty(); ++i) {
+		result.intersect(*sets[i]);
+	}
+
+	return result;
+}
+
+const QHash<Id, QString> &RepositoryIndex::names() const
+{
+	return mNames;
+}
+
+QList<Id> RepositoryIndex::types() const
+{
+	return mElementsByType.keys();
+}
+
+QSet<Id> RepositoryIndex::elementsOfType(const Id &type) const
+{
+	return mElementsByType.value(type);
+}
+
+void RepositoryIndex::addProperties(const Object &object)
+{
+	const Id id = object.id();
+	const QStringList properties = object.propertyNames();
+	for (const QString &property : properties) {
+		mElementsByProperty[property].insert(id);
+	}
+
+	mPropertiesOfElement.insert(id, properties);
+	addName(id, object.property("name").toString());
+}
+
+void RepositoryIndex::removeProperties(const Id &id)
+{
+	for (const QString &property : mPropertiesOfElement.take(id)) {
+		QSet<Id> &withProperty = mElementsByProperty[property];
+		withProperty.remove(id);
+		if (withProperty.isEmpty()) {
+			mElementsByProperty.remove(property);
+		}
+	}
+
+	removeName(id);
+}
+
+void RepositoryIndex::addName(const Id &id, const QString &name)
+{
+	mNames.insert(id, name);
+	for (const QString &trigram : trigrams(name)) {
+		mElementsByTrigram[trigram].insert(id);
+	}
+}
+
+void RepositoryIndex::removeName(const Id &id)
+{
+	for (const QString &trigram : trigrams(mNames.take(id))) {
+		QSet<Id> &withTrigram = mElementsByTrigram[trigram];
+		withTrigram.remove(id);
+		if (withTrigram.isEmpty()) {
+			mElementsByTrigram.remove(trigram);
+		}
+	}
+}
+
+QSet<QString> RepositoryIndex::trigrams(const QString &string)
+{
+	const QString lowerCase = string.toLower();
+	QSet<QString> result;
+	for (int i = 0; i + trigramLength <= lowerCase.length(); ++i) {
+		result.insert(lowerCase.mid(i, trigramLength));
+	}
+
+	return result;
+}
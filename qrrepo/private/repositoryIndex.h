@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+
+#include <qrkernel/ids.h>
+
+#include "classes/object.h"
+
+namespace qrRepo {
+namespace details {
+
+/// Secondary indexes over repository objects used by search queries: property name to objects having it,
+/// lower-case trigrams of "name" property to objects and type to objects. Indexes are built on first query
+/// (so lazily loaded projects do not deserialize properties until something is searched) and then kept
+/// up to date by repository after each modification of an object.
+class RepositoryIndex
+{
+public:
+	RepositoryIndex();
+
+	/// Drops all indexes, they will be rebuilt by next ensure...() call.
+	void clear();
+
+	/// Builds type index from given objects if it is not built yet.
+	void ensureTypesIndexed(const QHash<qReal::Id, Object *> &objects);
+
+	/// Builds property name and name trigram indexes from given objects if they are not built yet.
+	void ensurePropertiesIndexed(const QHash<qReal::Id, Object *> &objects);
+
+	/// Reindexes given object after arbitrary change of its properties or after its creation.
+	void update(const Object &object);
+
+	/// Reindexes given object after one of its properties was set, cheaper than update().
+	void propertySet(const Object &object, const QString &name);
+
+	/// Removes given object from all indexes.
+	void remove(const qReal::Id &id);
+
+	/// Returns names of all properties of all objects.
+	QStringList propertyNames() const;
+
+	/// Returns objects that have property with given name.
+	QSet<qReal::Id> elementsWithProperty(const QString &name) const;
+
+	/// Returns objects which "name" property may contain given substring ignoring case. Candidates
+	/// are selected by trigrams, so the result still has to be checked, and if substring is shorter than
+	/// a trigram all objects are returned.
+	QSet<qReal::Id> nameCandidates(const QString &substring) const;
+
+	/// Returns values of "name" property of all indexed objects.
+	const QHash<qReal::Id, QString> &names() const;
+
+	/// Returns all types of objects in repository.
+	QList<qReal::Id> types() const;
+
+	/// Returns objects whose type() is equal to given type.
+	QSet<qReal::Id> elementsOfType(const qReal::Id &type) const;
+
+private:
+	void addProperties(const Object &object);
+	void removeProperties(const qReal::Id &id);
+	void addName(const qReal::Id &id, const QString &name);
+	void removeName(const qReal::Id &id);
+
+	static QSet<QString> trigrams(const QString &string);
+
+	bool mTypesIndexed;
+	bool mPropertiesIndexed;
+
+	QHash<QString, QSet<qReal::Id>> mElementsByProperty;
+	QHash<qReal::Id, QStringList> mPropertiesOfElement;
+	QHash<QString, QSet<qReal::Id>> mElementsByTrigram;
+	QHash<qReal::Id, QString> mNames;
+	QHash<qReal::Id, QSet<qReal::Id>> mElementsByType;
+};
+
+}
+}
@@ -5,6 +5,7 @@
 #include <QtCore/QPointF>
 #include <QtCore/QCoreApplication>
 #include <QtGui/QPolygon>
+#include <QtConcurrent/QtConcurrentMap>
 
 #include <qrkernel/settingsManager.h>
 #include <qrkernel/exception/exception.h>
@@ -13,6 +14,7 @@
 #include <qrutils/fileSystemUtils.h>
 
 #include "folderCompressor.h"
+#include "binarySerializer.h"
 #include "classes/logicalObject.h"
 #include "classes/graphicalObject.h"
 
@@ -26,6 +28,7 @@ const QString unsavedDir = "unsaved";
 Serializer::Serializer(const QString& saveDirName)
 	: mWorkingDir(QCoreApplication::applicationDirPath() + "/" + unsavedDir)
 	, mWorkingFile(saveDirName)
+	, mFormat(Format::binary)
 {
 	clearWorkingDir();
 	/// @todo: throw away this legacy piece of sh.t
@@ -52,29 +55,20 @@ void Serializer::setWorkingFile(const QString &workingFile)
 	mWorkingFile = workingFile;
 }
 
-void Serializer::saveToDisk(QList<Object *> const &objects, QHash<QString, QVariant> const &metaInfo) const
+void Serializer::setFormat(Format format)
+{
+	mFormat = format;
+}
+
+bool Serializer::saveToDisk(QList<Object *> const &objects, QHash<QString, QVariant> const &metaInfo) const
 {
 	Q_ASSERT_X(!mWorkingFile.isEmpty()
 		, "Serializer::saveToDisk(...)"
 		, "may be Repository of RepoApi (see Models constructor also) has been initialised with empty filename?");
 
-	foreach (const Object * const object, objects) {
-		const QString filePath = createDirectory(object->id(), object->isLogicalObject());
-
-		QDomDocument doc;
-		QDomElement root = object->serialize(doc);
-		doc.appendChild(root);
-
-		OutFile out(filePath);
-		doc.save(out(), 2);
-	}
-
-	saveMetaInfo(metaInfo);
-
 	QFileInfo fileInfo(mWorkingFile);
 	QString fileName = fileInfo.baseName();
 
-	QDir compressDir(SettingsManager::value("temp").toString());
 	QDir dir = fileInfo.absolutePath();
 
 	QFile previousSave(dir.absolutePath() + "/" + fileName +".qrs");
@@ -82,8 +76,19 @@ void Serializer::saveToDisk(QList<Object *> const &objects, QHash<QString, QVari
 		previousSave.remove();
 	}
 
-	const QString filePath = fileInfo.absolutePath() + "/" + fileName + ".qrs";
-	FolderCompressor::compressFolder(compressDir.absolutePath(), filePath);
+	const QString filePath = projectFilePath();
+	mWrittenFileSizes.remove(filePath);
+	bool saved = false;
+	if (mFormat == Format::binary) {
+		saved = BinarySerializer::save(filePath, objects, metaInfo);
+		if (saved) {
+			mWrittenFileSizes[filePath] = QFileInfo(filePath).size();
+		}
+	} else {
+		saveToFolder(objects, metaInfo);
+		QDir compressDir(SettingsManager::value("temp").toString());
+		saved = FolderCompressor::compressFolder(compressDir.absolutePath(), filePath);
+	}
 
 	// Hiding autosaved files
 	if (fileName.contains("~")) {
@@ -91,50 +96,196 @@ void Serializer::saveToDisk(QList<Object *> const &objects, QHash<QString, QVari
 	}
 
 	clearDir(mWorkingDir);
+	return saved;
+}
+
+bool Serializer::appendChangesToDisk(const QList<Object *> &changed, const IdList &removed
+		, const QHash<QString, QVariant> &metaInfo) const
+{
+	const QString filePath = projectFilePath();
+	if (mFormat != Format::binary || !mWrittenFileSizes.contains(filePath)
+			|| QFileInfo(filePath).size() != mWrittenFileSizes[filePath])
+	{
+		return false;
+	}
+
+	if (!BinarySerializer::appendChanges(filePath, changed, removed, metaInfo)) {
+		mWrittenFileSizes.remove(filePath);
+		return false;
+	}
+
+	mWrittenFileSizes[filePath] = QFileInfo(filePath).size();
+	return true;
 }
 
 void Serializer::loadFromDisk(QHash<qReal::Id, Object*> &objectsHash, QHash<QString, QVariant> &metaInfo)
 {
 	clearWorkingDir();
-	if (!mWorkingFile.isEmpty()) {
-		decompressFile(mWorkingFile);
+	const bool lazy = SettingsManager::value("LazyProjectLoading").toBool();
+	if (!mWorkingFile.isEmpty() && BinarySerializer::load(mWorkingFile, objectsHash, metaInfo, lazy)) {
+		return;
+	}
+
+	if (!mWorkingFile.isEmpty() && loadFromArchive(mWorkingFile, objectsHash, metaInfo)) {
+		return;
 	}
 
 	loadFromDisk(SettingsManager::value("temp").toString(), objectsHash);
 	loadMetaInfo(metaInfo);
 }
 
+bool Serializer::loadFromArchive(const QString &fileName, QHash<Id, Object *> &objectsHash
+		, QHash<QString, QVariant> &metaInfo) const
+{
+	// Documents are parsed in batches while the archive is read, so only one batch of them is kept in memory.
+	const int batchSize = 1024;
+	QList<QByteArray> objectDocuments;
+	QList<Object *> objects;
+	QHash<QString, QVariant> loadedMetaInfo;
+	bool success = false;
+	try {
+		success = FolderCompressor::readArchive(fileName, [&](const QString &name, const QByteArray &data) {
+			if (name == "/metaInfo.xml") {
+				QDomDocument document;
+				if (document.setContent(data)) {
+					loadMetaInfo(document, loadedMetaInfo);
+				}
+			} else if (name.startsWith("/tree/logical/") || name.startsWith("/tree/graphical/")) {
+				objectDocuments << data;
+				if (objectDocuments.size() == batchSize) {
+					objects << parseObjects(objectDocuments);
+					objectDocuments.clear();
+				}
+			}
+
+			return true;
+		});
+
+		objects << parseObjects(objectDocuments);
+	} catch (const Exception &) {
+		qDeleteAll(objects);
+		throw;
+	}
+
+	if (!success) {
+		qDeleteAll(objects);
+		if (QFileInfo(fileName).exists()) {
+			throw Exception("Corrupted project file: damaged archive entry");
+		}
+
+		return false;
+	}
+
+	metaInfo = loadedMetaInfo;
+	for (Object * const object : objects) {
+		objectsHash.insert(object->id(), object);
+	}
+
+	return true;
+}
+
 void Serializer::loadFromDisk(const QString &currentPath, QHash<qReal::Id, Object*> &objectsHash)
 {
 	QDir dir(currentPath + "/tree");
 	if (dir.cd("logical")) {
-		loadModel(dir, objectsHash);
+		QList<QByteArray> documents;
+		readFiles(dir, documents);
 		dir.cdUp();
 		dir.cd("graphical");
-		loadModel(dir, objectsHash);
+		readFiles(dir, documents);
+
+		for (Object * const object : parseObjects(documents)) {
+			objectsHash.insert(object->id(), object);
+		}
 	}
 }
 
-void Serializer::loadModel(const QDir &dir, QHash<qReal::Id, Object*> &objectsHash)
+void Serializer::readFiles(const QDir &dir, QList<QByteArray> &contents)
 {
 	foreach (const QFileInfo &fileInfo, dir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot)) {
 		const QString path = fileInfo.filePath();
 		if (fileInfo.isDir()) {
-			loadModel(path, objectsHash);
+			readFiles(path, contents);
 		} else if (fileInfo.isFile()) {
-			QDomDocument doc = xmlUtils::loadDocument(path);
-			const QDomElement element = doc.documentElement();
+			QFile file(path);
+			if (file.open(QIODevice::ReadOnly)) {
+				contents << file.readAll();
+			} else {
+				qDebug() << "cannot open file " << path;
+			}
+		}
+	}
+}
 
-			// To ensure backwards compatibility. Replace this by separate tag names when save updating mechanism
-			// will be implemented.
-			Object * const object = element.hasAttribute("logicalId") && element.attribute("logicalId") != "qrm:/"
-					? dynamic_cast<Object *>(new GraphicalObject(element))
-					: dynamic_cast<Object *>(new LogicalObject(element))
-					;
+Object *Serializer::parseObject(const QDomElement &element)
+{
+	// To ensure backwards compatibility. Replace this by separate tag names when save updating mechanism
+	// will be implemented.
+	return element.hasAttribute("logicalId") && element.attribute("logicalId") != "qrm:/"
+			? dynamic_cast<Object *>(new GraphicalObject(element))
+			: dynamic_cast<Object *>(new LogicalObject(element))
+			;
+}
 
-			objectsHash.insert(object->id(), object);
+QList<Object *> Serializer::parseObjects(const QList<QByteArray> &documents)
+{
+	struct Entry
+	{
+		QByteArray document;
+		Object *object;
+		/// Message of an exception thrown while parsing, exceptions can not leave a worker thread.
+		QString error;
+	};
+
+	QVector<Entry> parsed;
+	parsed.reserve(documents.size());
+	for (const QByteArray &document : documents) {
+		parsed << Entry{document, nullptr, QString()};
+	}
+
+	QtConcurrent::blockingMap(parsed, [](Entry &entry) {
+		QDomDocument document;
+		if (document.setContent(entry.document)) {
+			try {
+				entry.object = parseObject(document.documentElement());
+			} catch (const Exception &exception) {
+				entry.error = exception.message();
+			}
+		}
+	});
+
+	QList<Object *> result;
+	QString error;
+	for (const Entry &entry : parsed) {
+		if (entry.object) {
+			result << entry.object;
+		} else if (error.isEmpty()) {
+			error = entry.error;
 		}
 	}
+
+	if (!error.isEmpty()) {
+		qDeleteAll(result);
+		throw Exception(error);
+	}
+
+	return result;
+}
+
+void Serializer::saveToFolder(const QList<Object *> &objects, const QHash<QString, QVariant> &metaInfo) const
+{
+	foreach (const Object * const object, objects) {
+		const QString filePath = createDirectory(object->id(), object->isLogicalObject());
+
+		QDomDocument doc;
+		QDomElement root = object->serialize(doc);
+		doc.appendChild(root);
+
+		OutFile out(filePath);
+		doc.save(out(), 2);
+	}
+
+	saveMetaInfo(metaInfo);
 }
 
 void Serializer::saveMetaInfo(QHash<QString, QVariant> const &metaInfo) const
@@ -164,7 +315,11 @@ void Serializer::loadMetaInfo(QHash<QString, QVariant> &metaInfo) const
 		return;
 	}
 
-	const QDomDocument document = xmlUtils::loadDocument(filePath);
+	loadMetaInfo(xmlUtils::loadDocument(filePath), metaInfo);
+}
+
+void Serializer::loadMetaInfo(const QDomDocument &document, QHash<QString, QVariant> &metaInfo)
+{
 	for (QDomElement child = document.documentElement().firstChildElement("info")
 			; !child.isNull()
 			; child = child.nextSiblingElement("info"))
@@ -195,6 +350,12 @@ void Serializer::clearDir(const QString &path)
 	}
 }
 
+QString Serializer::projectFilePath() const
+{
+	const QFileInfo fileInfo(mWorkingFile);
+	return fileInfo.absolutePath() + "/" + fileInfo.baseName() + ".qrs";
+}
+
 QString Serializer::pathToElement(const Id &id) const
 {
 	QString dirName = mWorkingDir;
@@ -228,5 +389,14 @@ QString Serializer::createDirectory(const Id &id, bool logical) const
 
 void Serializer::decompressFile(const QString &fileName)
 {
-	FolderCompressor::decompressFolder(fileName, mWorkingDir);
+	if (!BinarySerializer::isBinaryFile(fileName)) {
+		FolderCompressor::decompressFolder(fileName, mWorkingDir);
+		return;
+	}
+
+	QHash<Id, Object *> objects;
+	QHash<QString, QVariant> metaInfo;
+	BinarySerializer::load(fileName, objects, metaInfo);
+	saveToFolder(objects.values(), metaInfo);
+	qDeleteAll(objects);
 }
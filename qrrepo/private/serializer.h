@@ -1,48 +1,103 @@
-#pragma once
-
-#include <QtXml/QDomDocument>
-#include <QtCore/QVariant>
-#include <QtCore/QFile>
-#include <QtCore/QDir>
-
-#include <qrkernel/roles.h>
-
-#include "classes/object.h"
-#include "valuesSerializer.h"
-
-namespace qrRepo {
-namespace details {
-
-/// Class that is responsible for saving repository contents to disk as .qrs file.
-class Serializer
-{
-public:
-	Serializer(const QString &saveDirName);
-
-	void clearWorkingDir() const;
-	void setWorkingFile(const QString &workingFile);
-
-	void removeFromDisk(const qReal::Id &id) const;
-	void saveToDisk(QList<Object *> const &objects, QHash<QString, QVariant> const &metaInfo) const;
-	void loadFromDisk(QHash<qReal::Id, Object *> &objectsHash, QHash<QString, QVariant> &metaInfo);
-
-	void decompressFile(const QString &fileName);
-
-private:
-	static void clearDir(const QString &path);
-
-	void loadFromDisk(const QString &currentPath, QHash<qReal::Id, Object *> &objectsHash);
-	void loadModel(const QDir &dir, QHash<qReal::Id, Object *> &objectsHash);
-
-	void saveMetaInfo(QHash<QString, QVariant> const &metaInfo) const;
-	void loadMetaInfo(QHash<QString, QVariant> &metaInfo) const;
-
-	QString pathToElement(const qReal::Id &id) const;
-	QString createDirectory(const qReal::Id &id, bool logical) const;
-
-	QString mWorkingDir;
-	QString mWorkingFile;
-};
-
-}
-}
+#pragma once
+
+#include <QtXml/QDomDocument>
+#include <QtCore/QVariant>
+#include <QtCore/QFile>
+#include <QtCore/QDir>
+
+#include <qrkernel/roles.h>
+
+#include "classes/object.h"
+#include "valuesSerializer.h"
+
+namespace qrRepo {
+namespace details {
+
+/// Class that is responsible for saving repository contents to disk as .qrs file.
+/// Projects are saved in a single-file binary format (see BinarySerializer), legacy projects stored as
+/// compressed folders with XML file per object are still readable. If "LazyProjectLoading" setting is on,
+/// binary projects are loaded lazily: only model tree is built on load, properties of each object are
+/// deserialized on first access.
+class Serializer
+{
+public:
+	/// Formats in which project can be saved.
+	enum class Format
+	{
+		/// Single-file binary format, default one.
+		binary
+		/// Compressed folder with XML file per object, readable by older versions of QReal.
+		, xmlTree
+	};
+
+	Serializer(const QString &saveDirName);
+
+	void clearWorkingDir() const;
+	void setWorkingFile(const QString &workingFile);
+
+	/// Sets format in which subsequent saveToDisk() calls will write project. Loading detects format automatically.
+	void setFormat(Format format);
+
+	void removeFromDisk(const qReal::Id &id) const;
+
+	/// Writes given objects to the project file.
+	/// @returns false if the file could not be written.
+	bool saveToDisk(QList<Object *> const &objects, QHash<QString, QVariant> const &metaInfo) const;
+
+	/// Appends changed objects and ids of removed ones to the project file written by previous saveToDisk()
+	/// or appendChangesToDisk() call, without rewriting the rest of it.
+	/// @returns false if the file was not written by this serializer in binary format or was modified since,
+	///          full saveToDisk() is needed then.
+	bool appendChangesToDisk(const QList<Object *> &changed, const qReal::IdList &removed
+			, const QHash<QString, QVariant> &metaInfo) const;
+	void loadFromDisk(QHash<qReal::Id, Object *> &objectsHash, QHash<QString, QVariant> &metaInfo);
+
+	/// Unpacks given project file into working directory as a tree of XML files, one per object.
+	void decompressFile(const QString &fileName);
+
+private:
+	static void clearDir(const QString &path);
+
+	void loadFromDisk(const QString &currentPath, QHash<qReal::Id, Object *> &objectsHash);
+
+	/// Reads contents of all files in a given directory and its subdirectories.
+	static void readFiles(const QDir &dir, QList<QByteArray> &contents);
+
+	/// Loads project in legacy format (compressed folder with XML files) directly from memory, without
+	/// unpacking it into working directory.
+	/// @returns false if the file does not exist.
+	/// @throws qReal::Exception if the file is damaged or written in a newer archive format.
+	bool loadFromArchive(const QString &fileName, QHash<qReal::Id, Object *> &objectsHash
+			, QHash<QString, QVariant> &metaInfo) const;
+
+	/// Creates logical or graphical object from its XML representation.
+	static Object *parseObject(const QDomElement &element);
+
+	/// Creates objects from their serialized XML documents. Documents are independent, so they are parsed on
+	/// worker threads. Documents that are not well-formed are skipped.
+	/// @throws qReal::Exception if some document has invalid contents, no objects are created then.
+	static QList<Object *> parseObjects(const QList<QByteArray> &documents);
+
+	void saveToFolder(const QList<Object *> &objects, const QHash<QString, QVariant> &metaInfo) const;
+
+	void saveMetaInfo(QHash<QString, QVariant> const &metaInfo) const;
+	void loadMetaInfo(QHash<QString, QVariant> &metaInfo) const;
+	static void loadMetaInfo(const QDomDocument &document, QHash<QString, QVariant> &metaInfo);
+
+	/// Returns path to .qrs file corresponding to current working file.
+	QString projectFilePath() const;
+
+	QString pathToElement(const qReal::Id &id) const;
+	QString createDirectory(const qReal::Id &id, bool logical) const;
+
+	QString mWorkingDir;
+	QString mWorkingFile;
+	Format mFormat;
+
+	/// Sizes of binary project files right after they were written by this serializer, used to check that
+	/// a file was not modified by someone else before appending changes to it.
+	mutable QHash<QString, qint64> mWrittenFileSizes;
+};
+
+}
+}
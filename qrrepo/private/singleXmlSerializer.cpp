@@ -42,7 +42,7 @@ void SingleXmlSerializer::exportDiagram(const Id &diagramId, QDomDocument &doc,
 	}
 
 	diagram.setAttribute("graphical_id", diagramId.toString());
-	diagram.setAttribute("name", objects[diagramId]->properties()["name"].toString());
+	diagram.setAttribute("name", objects[diagramId]->property("name").toString());
 	exportProperties(diagramId, doc, diagram, objects);
 
 	QDomElement elements = doc.createElement("elements");
@@ -60,7 +60,7 @@ void SingleXmlSerializer::exportElement(const Id &id, QDomDocument &doc, QDomEle
 		, QHash<qReal::Id, Object*> const &objects)
 {
 	QDomElement element = doc.createElement("element");
-	element.setAttribute("name", objects[id]->properties()["name"].toString());
+	element.setAttribute("name", objects[id]->property("name").toString());
 	element.setAttribute("graphical_id", id.toString());
 
 	const GraphicalObject * const graphicalObject = dynamic_cast<const GraphicalObject *>(objects[id]);
@@ -104,7 +104,7 @@ void SingleXmlSerializer::exportProperties(const Id&id, QDomDocument &doc, QDomE
 
 	QMap<QString, QVariant> properties;
 
-	QMapIterator<QString, QVariant> i = logicalObject->propertiesIterator();
+	qrRepo::PropertiesIterator i = logicalObject->propertiesIterator();
 	while (i.hasNext()) {
 		i.next();
 		properties[i.key()] = i.value();
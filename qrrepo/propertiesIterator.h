@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+
+namespace qrRepo {
+
+/// Java-style iterator over properties of a repository element, in order of property names. Holds implicitly
+/// shared snapshots of names and values of an element, so creating and copying it does not copy properties,
+/// and later modifications of an element do not affect iteration.
+class PropertiesIterator
+{
+public:
+	PropertiesIterator(const QStringList &names, const QVector<QVariant> &values)
+		: mNames(names)
+		, mValues(values)
+		, mPosition(-1)
+	{
+	}
+
+	/// Returns true if there is at least one property after current one.
+	bool hasNext() const
+	{
+		return mPosition + 1 < mNames.size();
+	}
+
+	/// Advances iterator to the next property, returns iterator itself, so key and value of new current
+	/// property can be obtained like this: iterator.next().value().
+	PropertiesIterator &next()
+	{
+		++mPosition;
+		return *this;
+	}
+
+	/// Moves iterator to the front, before the first property.
+	void toFront()
+	{
+		mPosition = -1;
+	}
+
+	/// Returns name of current property.
+	const QString &key() const
+	{
+		return mNames.at(mPosition);
+	}
+
+	/// Returns value of current property.
+	const QVariant &value() const
+	{
+		return mValues.at(mPosition);
+	}
+
+private:
+	QStringList mNames;
+	QVector<QVariant> mValues;
+	int mPosition;
+};
+
+}
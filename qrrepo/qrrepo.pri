@@ -2,27 +2,33 @@ links(qrkernel qrutils)
 
 HEADERS += \
 	$$PWD/private/repository.h \
+	$$PWD/private/repositoryIndex.h \
 	$$PWD/private/folderCompressor.h \
 	$$PWD/private/qrRepoGlobal.h \
 	$$PWD/private/serializer.h \
+	$$PWD/private/binarySerializer.h \
 	$$PWD/private/singleXmlSerializer.h \
 	$$PWD/private/valuesSerializer.h \
 	$$PWD/private/classes/object.h \
 	$$PWD/private/classes/logicalObject.h \
 	$$PWD/private/classes/graphicalObject.h \
 	$$PWD/private/classes/graphicalPart.h \
+	$$PWD/private/classes/propertySchema.h \
 
 SOURCES += \
 	$$PWD/private/repository.cpp \
+	$$PWD/private/repositoryIndex.cpp \
 	$$PWD/private/folderCompressor.cpp \
 	$$PWD/private/repoApi.cpp \
 	$$PWD/private/serializer.cpp \
+	$$PWD/private/binarySerializer.cpp \
 	$$PWD/private/singleXmlSerializer.cpp \
 	$$PWD/private/valuesSerializer.cpp \
 	$$PWD/private/classes/object.cpp \
 	$$PWD/private/classes/logicalObject.cpp \
 	$$PWD/private/classes/graphicalObject.cpp \
 	$$PWD/private/classes/graphicalPart.cpp \
+	$$PWD/private/classes/propertySchema.cpp \
 
 # repo API
 HEADERS += \
@@ -31,7 +37,8 @@ HEADERS += \
 	$$PWD/logicalRepoApi.h \
 	$$PWD/repoControlInterface.h \
 	$$PWD/commonRepoApi.h \
+	$$PWD/propertiesIterator.h \
 
 DEFINES += QRREPO_LIBRARY
 
-QT += xml
+QT += xml concurrent
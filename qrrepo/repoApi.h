@@ -79,7 +79,7 @@ public:
 	QMap<QString, QVariant> properties(const qReal::Id &id) override;
 	void setProperties(const qReal::Id &id, QMap<QString, QVariant> const &properties) override;
 	bool hasProperty(const qReal::Id &id, const QString &propertyName) const override;
-	QMapIterator<QString, QVariant> propertiesIterator(const qReal::Id &id) const override;
+	PropertiesIterator propertiesIterator(const qReal::Id &id) const override;
 
 	void setBackReference(const qReal::Id &id, const qReal::Id &reference) const override;
 	void removeBackReference(const qReal::Id &id, const qReal::Id &reference) const override;
@@ -116,10 +116,10 @@ public:
 	/// RepoApi's wrapper for Repository.importFromDisk
 	/// @param importedFile - file to be imported
 	void importFromDisk(const QString &importedFile) override;
-	void saveAll() const override;
-	void save(const qReal::IdList &list) const override;
-	void saveTo(const QString &workingFile) override;
-	void saveDiagramsById(QHash<QString, qReal::IdList> const &diagramIds) override;
+	bool saveAll() const override;
+	bool save(const qReal::IdList &list) const override;
+	bool saveTo(const QString &workingFile) override;
+	bool saveDiagramsById(QHash<QString, qReal::IdList> const &diagramIds) override;
 	void open(const QString &saveFile) override;
 	void exportToXml(const QString &targetFile) const override;
 
@@ -135,6 +135,10 @@ public:
 
 	/// Returns all elements with .element() == type
 	qReal::IdList elementsByType(const QString &type, bool sensitivity = false, bool regExpression = false) const;
+
+	/// Returns all elements whose type() is exactly the given type. Uses repository type index, so works
+	/// in time proportional to the size of the result.
+	qReal::IdList elementsOfType(const qReal::Id &type) const;
 	int elementsCount() const;
 
 	bool exist(const qReal::Id &id) const override;
@@ -28,9 +28,11 @@ public:
 	/// virtual, for import *.qrs file into current project
 	/// @param importedFile - file to be imported
 	virtual void importFromDisk(const QString &importedFile) = 0;
-	virtual void saveAll() const = 0;
-	virtual void save(const qReal::IdList &list) const = 0;
-	virtual void saveTo(const QString &workingFile) = 0;
+
+	/// Save methods return false if project file could not be written.
+	virtual bool saveAll() const = 0;
+	virtual bool save(const qReal::IdList &list) const = 0;
+	virtual bool saveTo(const QString &workingFile) = 0;
 
 	/// exports repo contents to a single XML file
 	virtual void exportToXml(const QString &targetFile) const = 0;
@@ -38,7 +40,7 @@ public:
 	/// saves choosen diagrams to target directory and file
 	/// @param diagramIds - map of the following structure:
 	/// key is a file path to save into, value is a list of diagrams to save
-	virtual void saveDiagramsById(QHash<QString, qReal::IdList> const &diagramIds) = 0;
+	virtual bool saveDiagramsById(QHash<QString, qReal::IdList> const &diagramIds) = 0;
 
 	virtual void open(const QString &workingFile) = 0;
 
@@ -2,4 +2,5 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
 	blockDiagramTests \
+	toolsTests \
 #	robotsTests \
@@ -0,0 +1,100 @@
+#include "floorCacheTests.h"
+
+#include <QtCore/QScopedPointer>
+
+#include <src/engine/items/ellipseItem.h>
+
+using namespace qrTest::robotsTests::commonTwoDModelTests;
+using namespace twoDModel;
+
+namespace {
+
+/// Reports a change each time it is painted, like walls recalculating their borders.
+class SelfChangingEllipse : public items::EllipseItem
+{
+public:
+	SelfChangingEllipse(const QPointF &begin, const QPointF &end)
+		: items::EllipseItem(begin, end)
+		, mPaintsCount(0)
+	{
+	}
+
+	void drawItem(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override
+	{
+		++mPaintsCount;
+		emit changed(this);
+		items::EllipseItem::drawItem(painter, option, widget);
+	}
+
+	int paintsCount() const
+	{
+		return mPaintsCount;
+	}
+
+private:
+	int mPaintsCount;
+};
+
+}
+
+int FloorCacheTests::countPixels(const QRect &rect, QRgb color) const
+{
+	int result = 0;
+	mFloor.forEachPixel(rect, [&result, color](uint pixel) {
+		if (pixel == color) {
+			++result;
+		}
+	});
+
+	return result;
+}
+
+TEST_F(FloorCacheTests, emptyFloorTest)
+{
+	ASSERT_EQ(countPixels(QRect(-10, -10, 20, 20), qRgb(255, 255, 255)), 400);
+	ASSERT_EQ(countPixels(QRect(1000, 1000, 0, 0), qRgb(255, 255, 255)), 0);
+}
+
+TEST_F(FloorCacheTests, itemChangesTest)
+{
+	QScopedPointer<items::EllipseItem> ellipse(new items::EllipseItem(QPointF(0, 0), QPointF(200, 200)));
+	ellipse->setBrush(QBrush(Qt::black));
+	mFloor.addItem(ellipse.data());
+
+	// Sensor footprint crossing tile borders.
+	const QRect center(95, 95, 10, 10);
+	const QRect moved(595, 95, 10, 10);
+	ASSERT_EQ(countPixels(center, qRgb(0, 0, 0)), 100);
+	ASSERT_EQ(countPixels(moved, qRgb(255, 255, 255)), 100);
+
+	ellipse->setPos(500, 0);
+	ASSERT_EQ(countPixels(center, qRgb(255, 255, 255)), 100);
+	ASSERT_EQ(countPixels(moved, qRgb(0, 0, 0)), 100);
+
+	ellipse->setBrush(QBrush(Qt::red));
+	ASSERT_EQ(countPixels(moved, qRgb(255, 0, 0)), 100);
+
+	// Stretched to the left of its position, so it covers the center again.
+	ASSERT_EQ(countPixels(center, qRgb(255, 255, 255)), 100);
+	ellipse->setCoordinates(QRectF(-500, 0, 700, 200));
+	ASSERT_EQ(countPixels(center, qRgb(255, 0, 0)), 100);
+
+	mFloor.removeItem(ellipse.data());
+	ASSERT_EQ(countPixels(moved, qRgb(255, 255, 255)), 100);
+}
+
+TEST_F(FloorCacheTests, changesWhilePaintingTest)
+{
+	QScopedPointer<SelfChangingEllipse> ellipse(new SelfChangingEllipse(QPointF(0, 0), QPointF(200, 200)));
+	ellipse->setBrush(QBrush(Qt::black));
+	mFloor.addItem(ellipse.data());
+
+	// Four tiles around (128, 128), each one painted once and kept despite changes reported while painting.
+	const QRect corner(123, 123, 10, 10);
+	ASSERT_EQ(countPixels(corner, qRgb(0, 0, 0)), 100);
+	ASSERT_EQ(ellipse->paintsCount(), 4);
+	ASSERT_EQ(countPixels(corner, qRgb(0, 0, 0)), 100);
+	ASSERT_EQ(ellipse->paintsCount(), 4);
+
+	mFloor.removeItem(ellipse.data());
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <src/engine/model/floorCache.h>
+
+namespace qrTest {
+namespace robotsTests {
+namespace commonTwoDModelTests {
+
+/// Tests for FloorCache.
+class FloorCacheTests : public testing::Test
+{
+protected:
+	/// Returns the number of pixels of given color inside given rectangle of the floor.
+	int countPixels(const QRect &rect, QRgb color) const;
+
+	twoDModel::model::FloorCache mFloor;
+};
+
+}
+}
+}
@@ -0,0 +1,122 @@
+#include <QtCore/QDebug>
+
+#include <QtXml/QDomDocument>
+
+#include <gtest/gtest.h>
+
+#include <twoDModel/engine/twoDModelEngineInterface.h>
+#include <src/engine/model/headlessSimulator.h>
+#include <src/engine/model/model.h>
+
+using namespace twoDModel::model;
+using namespace kitBase::robotModel;
+
+namespace {
+
+SimulationTask task(const QString &constraints, quint64 timeLimit)
+{
+	SimulationTask result;
+	result.worldXml = "<root><world><walls><wall begin=\"0:0\" end=\"100:0\"/></walls></world><robots/>"
+			+ constraints + "</root>";
+	result.timeLimit = timeLimit;
+	return result;
+}
+
+}
+
+TEST(HeadlessSimulatorTest, timeoutTest)
+{
+	int controllerCalls = 0;
+	SimulationTask simulation = task(QString(), 1000);
+	simulation.controller = [&controllerCalls](Model &model, twoDModel::engine::TwoDModelEngineInterface &engine
+			, quint64 timestamp)
+	{
+		Q_UNUSED(model)
+		Q_UNUSED(engine)
+		ASSERT_EQ(timestamp, static_cast<quint64>(controllerCalls * Timeline::timeInterval));
+		++controllerCalls;
+	};
+
+	const SimulationResult result = HeadlessSimulator::simulate(simulation);
+	ASSERT_EQ(result.verdict, SimulationResult::Verdict::timeout);
+	ASSERT_EQ(result.modelTime, 1000u);
+	ASSERT_EQ(controllerCalls, 1000 / Timeline::timeInterval);
+	ASSERT_TRUE(result.errors.isEmpty());
+}
+
+TEST(HeadlessSimulatorTest, sensorsWithoutViewTest)
+{
+	SimulationTask simulation;
+	simulation.worldXml = "<root><world/><robots><robot id=\"robot\" position=\"100:50\" direction=\"90\">"
+			"<startPosition startPosX=\"10\" startPosY=\"20\" direction=\"30\"/></robot></robots></root>";
+	simulation.timeLimit = Timeline::timeInterval;
+	bool controllerCalled = false;
+	simulation.controller = [&controllerCalled](Model &model, twoDModel::engine::TwoDModelEngineInterface &engine
+			, quint64 timestamp)
+	{
+		Q_UNUSED(timestamp)
+		controllerCalled = true;
+		ASSERT_EQ(engine.display(), nullptr);
+		ASSERT_EQ(model.robotModels().size(), 1);
+
+		// Sensor at the middle of the right side of a robot turned by 90 degrees clockwise looks down.
+		RobotModel &robot = *model.robotModels()[0];
+		const PortInfo port("A", input);
+		robot.configuration().setPosition(port, QPointF(50, 25));
+		const QPair<QPointF, qreal> sensor = robot.sensorPositionAndDirection(port);
+		EXPECT_NEAR(sensor.first.x(), 125, 1e-6);
+		EXPECT_NEAR(sensor.first.y(), 100, 1e-6);
+		EXPECT_NEAR(sensor.second, 90, 1e-6);
+
+		// Start position is kept by model itself, marker item is not created.
+		QDomDocument document;
+		const QDomElement startPosition = robot.serialize(document).firstChildElement("startPosition");
+		EXPECT_EQ(startPosition.attribute("startPosX"), "10");
+		EXPECT_EQ(startPosition.attribute("startPosY"), "20");
+		EXPECT_EQ(startPosition.attribute("direction"), "30");
+	};
+
+	HeadlessSimulator::simulate(simulation);
+	ASSERT_TRUE(controllerCalled);
+}
+
+TEST(HeadlessSimulatorTest, constraintsTest)
+{
+	const SimulationResult result = HeadlessSimulator::simulate(
+			task("<constraints><timelimit value=\"500\"/></constraints>", 10000));
+	ASSERT_EQ(result.verdict, SimulationResult::Verdict::fail);
+	ASSERT_LE(result.modelTime, 600u);
+
+	const SimulationResult wrongConstraints = HeadlessSimulator::simulate(task("<constraints/>", 1000));
+	ASSERT_EQ(wrongConstraints.verdict, SimulationResult::Verdict::checkerError);
+}
+
+TEST(HeadlessSimulatorTest, batchTest)
+{
+	QList<SimulationTask> tasks;
+	for (int i = 0; i < 16; ++i) {
+		tasks << task(QString("<constraints><timelimit value=\"%1\"/></constraints>").arg(100 * (i + 1)), 5000);
+	}
+
+	HeadlessSimulator simulator(4);
+	const QList<SimulationResult> results = simulator.simulate(tasks);
+	ASSERT_EQ(results.size(), tasks.size());
+	for (int i = 0; i < results.size(); ++i) {
+		ASSERT_EQ(results[i].verdict, SimulationResult::Verdict::fail);
+		ASSERT_EQ(results[i].modelTime, HeadlessSimulator::simulate(tasks[i]).modelTime);
+	}
+
+	ASSERT_GT(simulator.lastBatchSpeed(), 0);
+}
+
+TEST(HeadlessSimulatorTest, DISABLED_speedBenchmark)
+{
+	QList<SimulationTask> tasks;
+	for (int i = 0; i < 64; ++i) {
+		tasks << task(QString(), 60 * 1000);
+	}
+
+	HeadlessSimulator simulator;
+	simulator.simulate(tasks);
+	qDebug() << "Simulated seconds per real second:" << simulator.lastBatchSpeed();
+}
@@ -0,0 +1,161 @@
+#include "worldModelTests.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QDebug>
+#include <QtCore/QtMath>
+
+#include <src/engine/items/wallItem.h>
+#include <src/engine/model/constants.h>
+
+using namespace qrTest::robotsTests::commonTwoDModelTests;
+using namespace twoDModel;
+
+void WorldModelTests::TearDown()
+{
+	mWorldModel.clear();
+	qDeleteAll(mWalls);
+	mWalls.clear();
+}
+
+items::WallItem *WorldModelTests::addWall(const QPointF &begin, const QPointF &end)
+{
+	items::WallItem * const wall = new items::WallItem(begin, end);
+	mWalls << wall;
+	mWorldModel.addWall(wall);
+	return wall;
+}
+
+int WorldModelTests::referenceSonarReading(const QPointF &position, qreal direction) const
+{
+	QPainterPath wallPath;
+	for (const items::WallItem * const wall : mWalls) {
+		wallPath.addPath(wall->path());
+	}
+
+	int min = 0;
+	int max = 255;
+	if (!mWorldModel.sonarScanningRegion(position, direction, max).intersects(wallPath)) {
+		return max;
+	}
+
+	while (min < max) {
+		const int current = (min + max) / 2;
+		if (mWorldModel.sonarScanningRegion(position, direction, current).intersects(wallPath)) {
+			max = current;
+		} else {
+			min = current + 1;
+		}
+	}
+
+	return min;
+}
+
+TEST_F(WorldModelTests, sonarReadingTest)
+{
+	ASSERT_EQ(mWorldModel.sonarReading(QPointF(0, 0), 0), 255);
+
+	addWall(QPointF(300, -200), QPointF(300, 200));
+	addWall(QPointF(-100, 150), QPointF(100, 150));
+	addWall(QPointF(-400, -400), QPointF(-200, -300));
+
+	// Straight at the wall: 300 pixels minus half of wall borders width.
+	ASSERT_EQ(mWorldModel.sonarReading(QPointF(0, 0), 0), qCeil((300 - 7.5) / pixelsInCm));
+
+	// Looking away from all walls.
+	ASSERT_EQ(mWorldModel.sonarReading(QPointF(0, 0), 180), 255);
+
+	// Inside a wall.
+	ASSERT_EQ(mWorldModel.sonarReading(QPointF(300, 0), 45), 0);
+
+	for (int x = -500; x <= 500; x += 125) {
+		for (int y = -500; y <= 500; y += 125) {
+			for (int direction = -180; direction < 360; direction += 15) {
+				const int expected = referenceSonarReading(QPointF(x, y), direction);
+				const int actual = mWorldModel.sonarReading(QPointF(x, y), direction);
+
+				// Reference reading is found on integer grid of scanning regions, so it may differ by 1 cm.
+				ASSERT_LE(qAbs(expected - actual), 1) << x << " " << y << " " << direction;
+			}
+		}
+	}
+}
+
+TEST_F(WorldModelTests, sonarReadingDirectionOutOfRangeTest)
+{
+	// Short wall straight ahead near the end of sonar range, lies beyond both ends of sonar arc.
+	const qreal range = 255 * pixelsInCm;
+	addWall(QPointF(range - 2, -10), QPointF(range - 2, 10));
+	addWall(QPointF(-100, 150), QPointF(100, 150));
+
+	const int straight = mWorldModel.sonarReading(QPointF(0, 0), 0);
+	ASSERT_LT(straight, 255);
+	ASSERT_EQ(mWorldModel.sonarReading(QPointF(0, 0), 720), straight);
+	ASSERT_EQ(mWorldModel.sonarReading(QPointF(0, 0), 360), straight);
+	ASSERT_EQ(mWorldModel.sonarReading(QPointF(0, 0), -1080), straight);
+
+	// Robot and sensor rotations are summed, so direction may get far beyond 360 degrees.
+	for (int direction = 0; direction < 360; direction += 15) {
+		const int expected = mWorldModel.sonarReading(QPointF(0, 0), direction);
+		ASSERT_EQ(mWorldModel.sonarReading(QPointF(0, 0), direction + 720), expected) << direction;
+		ASSERT_EQ(mWorldModel.sonarReading(QPointF(0, 0), direction - 1440), expected) << direction;
+	}
+}
+
+TEST_F(WorldModelTests, collisionTest)
+{
+	items::WallItem * const wall = addWall(QPointF(0, 0), QPointF(200, 0));
+
+	QPainterPath robot;
+	robot.addRect(QRectF(50, 20, 50, 50));
+	ASSERT_FALSE(mWorldModel.checkCollision(robot));
+
+	robot = QPainterPath();
+	robot.addRect(QRectF(50, -20, 50, 50));
+	ASSERT_TRUE(mWorldModel.checkCollision(robot));
+	ASSERT_EQ(mWorldModel.wallsNear(robot.boundingRect()), QList<items::WallItem *>() << wall);
+
+	// Moved walls shall be reindexed.
+	wall->setPos(0, 1000);
+	wall->recalculateBorders();
+	ASSERT_FALSE(mWorldModel.checkCollision(robot));
+	ASSERT_TRUE(mWorldModel.wallsNear(robot.boundingRect()).isEmpty());
+
+	mWorldModel.removeWall(wall);
+	robot = QPainterPath();
+	robot.addRect(QRectF(50, 980, 50, 50));
+	ASSERT_FALSE(mWorldModel.checkCollision(robot));
+}
+
+TEST_F(WorldModelTests, DISABLED_sonarAndCollisionBenchmark)
+{
+	// Maze of 1000 walls, 10 pixels apart.
+	for (int i = 0; i < 1000; ++i) {
+		const qreal x = (i % 40) * 150;
+		const qreal y = (i / 40) * 150;
+		if (i % 2) {
+			addWall(QPointF(x, y), QPointF(x + 140, y));
+		} else {
+			addWall(QPointF(x, y), QPointF(x, y + 140));
+		}
+	}
+
+	const int iterations = 1000;
+	QElapsedTimer timer;
+	timer.start();
+	int sum = 0;
+	for (int i = 0; i < iterations; ++i) {
+		sum += mWorldModel.sonarReading(QPointF(75 + (i % 40) * 150, 75 + (i % 25) * 150), i * 7);
+	}
+
+	qDebug() << "Sonar reading:" << timer.nsecsElapsed() / iterations / 1000 << "us," << sum;
+
+	timer.restart();
+	int collisions = 0;
+	for (int i = 0; i < iterations; ++i) {
+		QPainterPath robot;
+		robot.addRect(QRectF(50 + (i % 40) * 150, 50 + (i % 25) * 150, 50, 50));
+		collisions += mWorldModel.checkCollision(robot) ? 1 : 0;
+	}
+
+	qDebug() << "Collision check:" << timer.nsecsElapsed() / iterations / 1000 << "us," << collisions;
+}
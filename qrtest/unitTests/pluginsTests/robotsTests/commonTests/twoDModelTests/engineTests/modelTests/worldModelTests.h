@@ -0,0 +1,29 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <src/engine/model/worldModel.h>
+
+namespace qrTest {
+namespace robotsTests {
+namespace commonTwoDModelTests {
+
+/// Tests for WorldModel.
+class WorldModelTests : public testing::Test
+{
+protected:
+	void TearDown() override;
+
+	/// Adds to the model a new wall with given ends.
+	twoDModel::items::WallItem *addWall(const QPointF &begin, const QPointF &end);
+
+	/// Sonar reading computed without walls index, by binary search on growing scanning regions.
+	int referenceSonarReading(const QPointF &position, qreal direction) const;
+
+	twoDModel::model::WorldModel mWorldModel;
+	QList<twoDModel::items::WallItem *> mWalls;
+};
+
+}
+}
+}
@@ -13,9 +13,14 @@ INCLUDEPATH += \
 # Tests
 HEADERS += \
 	$$PWD/engineTests/constrasTests/constraintsParserTests.h \
+	$$PWD/engineTests/modelTests/floorCacheTests.h \
+	$$PWD/engineTests/modelTests/worldModelTests.h \
 
 SOURCES += \
 	$$PWD/engineTests/constraintsTests/constraintsParserTests.cpp \
+	$$PWD/engineTests/modelTests/floorCacheTests.cpp \
+	$$PWD/engineTests/modelTests/headlessSimulatorTests.cpp \
+	$$PWD/engineTests/modelTests/worldModelTests.cpp \
 
 # Support classes
 HEADERS += \
@@ -0,0 +1,20 @@
+TARGET = robots_generatorBase_unittests
+
+include(../../../../common.pri)
+
+include(../../../../../../plugins/robots/generators/generatorBase/generatorBase.pri)
+
+links(qslog)
+
+INCLUDEPATH += \
+	../../../../../../plugins/robots/generators/generatorBase \
+	../../../../../../plugins/robots/generators/generatorBase/include \
+
+# Bundled templates for benchmarks
+RESOURCES += \
+	../../../../../../plugins/robots/generators/trik/trikQtsGenerator/templates.qrc \
+	../../../../../../plugins/robots/generators/nxt/nxtOsekCGenerator/templates.qrc \
+
+# Tests
+SOURCES += \
+	$$PWD/templateParametrizedEntityTest.cpp \
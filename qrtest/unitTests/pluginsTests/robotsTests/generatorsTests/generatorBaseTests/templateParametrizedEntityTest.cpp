@@ -0,0 +1,120 @@
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QDebug>
+
+#include <qrutils/inFile.h>
+#include <generatorBase/templateParametrizedEntity.h>
+
+#include "gtest/gtest.h"
+
+using namespace generatorBase;
+
+namespace {
+
+/// Gives access to templates reading methods.
+class TemplateReader : public TemplateParametrizedEntity
+{
+public:
+	explicit TemplateReader(const QString &pathToTemplates)
+		: TemplateParametrizedEntity(pathToTemplates)
+	{
+	}
+
+	using TemplateParametrizedEntity::readTemplate;
+	using TemplateParametrizedEntity::readTemplateIfExists;
+	using TemplateParametrizedEntity::renderTemplate;
+};
+
+void writeFile(const QString &fileName, const QByteArray &contents)
+{
+	QFile file(fileName);
+	file.open(QIODevice::WriteOnly);
+	file.write(contents);
+	file.close();
+}
+
+}
+
+TEST(TemplateParametrizedEntityTest, renderTemplateTest)
+{
+	QDir().mkpath("templatesTest");
+	writeFile("templatesTest/render.t", "@@LEFT@@ + @@RIGHT@@; @@@NAME@@ @@ @@UNKNOWN@@");
+
+	const TemplateReader reader("templatesTest");
+	const QString result = reader.renderTemplate("render.t"
+			, { { "@@LEFT@@", "@@RIGHT@@" }, { "@@RIGHT@@", "b" }, { "@@NAME@@", "x" } });
+
+	EXPECT_EQ("@@RIGHT@@ + b; @x @@ @@UNKNOWN@@", result);
+	EXPECT_EQ("@@LEFT@@ + @@RIGHT@@; @@@NAME@@ @@ @@UNKNOWN@@", reader.readTemplate("render.t"));
+
+	QDir("templatesTest").removeRecursively();
+}
+
+TEST(TemplateParametrizedEntityTest, templatesAreReadOnceTest)
+{
+	QDir().mkpath("templatesTest");
+	writeFile("templatesTest/cached.t", "first");
+
+	EXPECT_EQ("first", TemplateReader("templatesTest").readTemplate("cached.t"));
+	writeFile("templatesTest/cached.t", "second");
+	EXPECT_EQ("first", TemplateReader("templatesTest").readTemplate("cached.t"));
+
+	QDir("templatesTest").removeRecursively();
+}
+
+TEST(TemplateParametrizedEntityTest, missingTemplateTest)
+{
+	const TemplateReader reader("templatesTest");
+	EXPECT_EQ("fallback", reader.readTemplateIfExists("missing.t", "fallback"));
+	EXPECT_EQ(QString(), reader.readTemplate("missing.t"));
+}
+
+TEST(TemplateParametrizedEntityTest, DISABLED_bundledTemplatesBenchmark)
+{
+	const int passes = 200;
+	const QHash<QString, QString> values = {
+		{ "@@PORT@@", "1" }
+		, { "@@NAME@@", "name" }
+		, { "@@VALUE@@", "value" }
+		, { "@@LEFT@@", "left" }
+		, { "@@RIGHT@@", "right" }
+		, { "@@BODY@@", "body" }
+	};
+
+	for (const QString &root : { ":/trikQts/templates", ":/nxtOsekC/templates" }) {
+		QStringList templates;
+		QDirIterator iterator(root, { "*.t" }, QDir::Files, QDirIterator::Subdirectories);
+		while (iterator.hasNext()) {
+			templates << iterator.next().mid(root.size() + 1);
+		}
+
+		ASSERT_FALSE(templates.isEmpty());
+
+		QElapsedTimer timer;
+		timer.start();
+		for (int i = 0; i < passes; ++i) {
+			for (const QString &path : templates) {
+				QString result = utils::InFile::readAll(root + '/' + path);
+				for (auto value = values.constBegin(); value != values.constEnd(); ++value) {
+					result.replace(value.key(), value.value());
+				}
+			}
+		}
+
+		const qint64 readingTime = timer.restart();
+
+		const TemplateReader reader(root);
+		for (int i = 0; i < passes; ++i) {
+			for (const QString &path : templates) {
+				reader.renderTemplate(path, values);
+			}
+		}
+
+		const qint64 renderingTime = timer.elapsed();
+
+		qDebug() << root << templates.size() << "templates," << passes << "passes, ms: reading and replacing"
+				<< readingTime << "rendering cached templates" << renderingTime;
+	}
+}
@@ -0,0 +1,107 @@
+#include "qtScriptInterpreterTest.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+
+using namespace qReal;
+using namespace qrTest;
+
+void QtScriptInterpreterTest::SetUp() {
+	mInterpreter = new QtScriptInterpreter(nullptr);
+	QObject::connect(mInterpreter, &TextCodeInterpreter::readyReadErrOutput, [this](QString const &output) {
+		mErrors << output;
+	});
+}
+
+void QtScriptInterpreterTest::TearDown() {
+	delete mInterpreter;
+}
+
+TextCodeGenerator::PropertyBinding QtScriptInterpreterTest::binding(QString const &property, QVariant const &value)
+{
+	TextCodeGenerator::PropertyBinding const result = {
+		"a" + TextCodeGenerator::delimeter + property
+		, Id("editor", "diagram", "element", "a")
+		, property
+		, value
+	};
+
+	return result;
+}
+
+TEST_F(QtScriptInterpreterTest, bindingTypesTest) {
+	QList<TextCodeGenerator::PropertyBinding> const bindings = {
+		binding("flag", true)
+		, binding("count", 3)
+		, binding("ratio", 0.5)
+		, binding("name", "0.5x")
+	};
+
+	QString const condition = "typeof a_visint_flag == 'boolean' && a_visint_flag"
+			" && typeof a_visint_count == 'number' && a_visint_count + 1 == 4"
+			" && typeof a_visint_ratio == 'number' && a_visint_ratio * 2 == 1"
+			" && typeof a_visint_name == 'string' && a_visint_name + 1 == '0.5x1'";
+
+	EXPECT_TRUE(mInterpreter->interpret(condition, bindings, TextCodeInterpreter::applicationCondition));
+	EXPECT_TRUE(mErrors.isEmpty());
+}
+
+TEST_F(QtScriptInterpreterTest, changedPropertiesTest) {
+	QList<TextCodeGenerator::PropertyBinding> const bindings = {
+		binding("flag", true)
+		, binding("count", 3)
+		, binding("ratio", 0.5)
+		, binding("name", "old")
+	};
+
+	ASSERT_TRUE(mInterpreter->interpret("a_visint_count = a_visint_count + 1; a_visint_ratio = a_visint_ratio * 1;"
+			" a_visint_name = 'new';", bindings, TextCodeInterpreter::reaction));
+
+	QList<TextCodeGenerator::PropertyBinding> const changed = mInterpreter->changedProperties();
+	ASSERT_EQ(changed.size(), 2);
+	EXPECT_EQ(changed[0].property, "count");
+	EXPECT_EQ(changed[0].value.toString(), "4");
+	EXPECT_EQ(changed[1].property, "name");
+	EXPECT_EQ(changed[1].value.toString(), "new");
+
+	ASSERT_TRUE(mInterpreter->interpret("", bindings, TextCodeInterpreter::reaction));
+	EXPECT_TRUE(mInterpreter->changedProperties().isEmpty());
+}
+
+TEST_F(QtScriptInterpreterTest, errorReportingTest) {
+	EXPECT_FALSE(mInterpreter->interpret("undefinedFunction();", TextCodeInterpreter::initialization));
+	ASSERT_EQ(mErrors.size(), 1);
+	EXPECT_TRUE(mErrors[0].contains("undefinedFunction"));
+
+	QList<TextCodeGenerator::PropertyBinding> const bindings = { binding("count", 3) };
+	EXPECT_FALSE(mInterpreter->interpret("a_visint_count = ;", bindings, TextCodeInterpreter::reaction));
+	EXPECT_EQ(mErrors.size(), 2);
+	EXPECT_TRUE(mInterpreter->changedProperties().isEmpty());
+
+	// Engine stays usable after an exception, variables of initialization code are kept.
+	ASSERT_TRUE(mInterpreter->interpret("var limit = 5;", TextCodeInterpreter::initialization));
+	EXPECT_TRUE(mInterpreter->interpret("a_visint_count < limit", bindings, TextCodeInterpreter::applicationCondition));
+	EXPECT_EQ(mErrors.size(), 2);
+}
+
+TEST_F(QtScriptInterpreterTest, DISABLED_ruleApplicationsBenchmark) {
+	int const applications = 100000;
+	QString const condition = "a_visint_count >= 0 && a_visint_name != ''";
+	QString const reaction = "a_visint_count = a_visint_count + 1; a_visint_name = 'step ' + a_visint_count;";
+
+	QElapsedTimer timer;
+	timer.start();
+	for (int i = 0; i < applications; ++i) {
+		QList<TextCodeGenerator::PropertyBinding> const bindings = {
+			binding("count", i)
+			, binding("name", "step")
+		};
+
+		ASSERT_TRUE(mInterpreter->interpret(condition, bindings, TextCodeInterpreter::applicationCondition));
+		ASSERT_TRUE(mInterpreter->interpret(reaction, bindings, TextCodeInterpreter::reaction));
+		ASSERT_EQ(mInterpreter->changedProperties().size(), 2);
+	}
+
+	qint64 const elapsed = qMax<qint64>(1, timer.elapsed());
+	qDebug() << "QtScript rule applications per second:" << applications * 1000.0 / elapsed;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QtCore/QStringList>
+
+#include <plugins/tools/visualInterpreter/textualPart/qtScriptInterpreter.h>
+
+#include <gtest/gtest.h>
+
+namespace qrTest {
+
+class QtScriptInterpreterTest : public testing::Test {
+
+protected:
+	virtual void SetUp();
+
+	virtual void TearDown();
+
+	/// Returns binding of a property of element "a" with given value
+	static qReal::TextCodeGenerator::PropertyBinding binding(QString const &property, QVariant const &value);
+
+	qReal::QtScriptInterpreter *mInterpreter;
+
+	/// Error output reported by interpreter
+	QStringList mErrors;
+};
+
+}
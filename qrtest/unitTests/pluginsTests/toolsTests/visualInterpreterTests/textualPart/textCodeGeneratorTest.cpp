@@ -0,0 +1,18 @@
+#include <plugins/tools/visualInterpreter/textualPart/textCodeGenerator.h>
+
+#include <gtest/gtest.h>
+
+using namespace qReal;
+
+TEST(TextCodeGeneratorTest, typedValueTest) {
+	EXPECT_EQ(TextCodeGenerator::typedValue("true"), QVariant(true));
+	EXPECT_EQ(TextCodeGenerator::typedValue("False"), QVariant(false));
+	EXPECT_EQ(TextCodeGenerator::typedValue("42"), QVariant(42));
+	EXPECT_EQ(TextCodeGenerator::typedValue("-7"), QVariant(-7));
+	EXPECT_EQ(TextCodeGenerator::typedValue("0.5"), QVariant(0.5));
+	EXPECT_EQ(TextCodeGenerator::typedValue("1e3"), QVariant(1000.0));
+	EXPECT_EQ(TextCodeGenerator::typedValue("inf"), QVariant(QString("inf")));
+	EXPECT_EQ(TextCodeGenerator::typedValue("0.5x"), QVariant(QString("0.5x")));
+	EXPECT_EQ(TextCodeGenerator::typedValue("yes"), QVariant(QString("yes")));
+	EXPECT_EQ(TextCodeGenerator::typedValue(""), QVariant(QString("")));
+}
@@ -0,0 +1,12 @@
+TARGET = visualInterpreter_unittests
+
+include(../../../common.pri)
+
+include(../../../../../plugins/tools/visualInterpreter/visualInterpreter.pri)
+
+SOURCES += \
+	textualPart/qtScriptInterpreterTest.cpp \
+	textualPart/textCodeGeneratorTest.cpp \
+
+HEADERS += \
+	textualPart/qtScriptInterpreterTest.h \
@@ -0,0 +1,174 @@
+#include <QtCore/QFile>
+#include <QtCore/QDebug>
+
+#include <gtest/gtest.h>
+
+#include <qrkernel/settingsManager.h>
+#include <qrgui/controller/undoStack.h>
+#include <qrgui/models/models.h>
+#include <qrgui/models/commands/changePropertyCommand.h>
+#include <qrgui/plugins/pluginManager/editorManager.h>
+
+using namespace qReal;
+
+namespace {
+
+/// Adds a value to a counter, consecutive additions to the same counter are merged.
+class AddCommand : public commands::AbstractCommand
+{
+public:
+	AddCommand(int &counter, int value)
+		: mCounter(counter)
+		, mValue(value)
+	{
+	}
+
+	int id() const override
+	{
+		return 1;
+	}
+
+protected:
+	bool execute() override
+	{
+		mCounter += mValue;
+		return true;
+	}
+
+	bool restoreState() override
+	{
+		mCounter -= mValue;
+		return true;
+	}
+
+	bool absorb(const AbstractCommand &other) override
+	{
+		const AddCommand * const command = dynamic_cast<const AddCommand *>(&other);
+		if (!command || &command->mCounter != &mCounter) {
+			return false;
+		}
+
+		mValue += command->mValue;
+		return true;
+	}
+
+private:
+	int &mCounter;
+	int mValue;
+};
+
+/// Returns resident memory of current process in kilobytes, or 0 if it can not be determined.
+int residentMemoryKb()
+{
+	QFile status("/proc/self/status");
+	if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		return 0;
+	}
+
+	for (QString line = status.readLine(); !line.isEmpty(); line = status.readLine()) {
+		if (line.startsWith("VmRSS:")) {
+			return line.section(':', 1).trimmed().section(' ', 0, 0).toInt();
+		}
+	}
+
+	return 0;
+}
+
+}
+
+TEST(UndoStackTest, consecutiveCommandsMergeTest)
+{
+	int first = 0;
+	int second = 0;
+	UndoStack stack;
+	stack.execute(new AddCommand(first, 1));
+	stack.execute(new AddCommand(first, 2));
+	stack.execute(new AddCommand(second, 3));
+	stack.execute(new AddCommand(first, 4));
+
+	ASSERT_EQ(7, first);
+	ASSERT_EQ(3, second);
+	ASSERT_EQ(3, stack.count());
+
+	stack.undo();
+	ASSERT_EQ(3, first);
+	stack.undo();
+	ASSERT_EQ(0, second);
+	stack.undo();
+	ASSERT_EQ(0, first);
+
+	stack.redo();
+	ASSERT_EQ(3, first);
+}
+
+TEST(UndoStackTest, commandsWithPostActionsAreNotMergedTest)
+{
+	int counter = 0;
+	int postActionCounter = 0;
+	UndoStack stack;
+	stack.execute(new AddCommand(counter, 1));
+	AddCommand * const command = new AddCommand(counter, 2);
+	command->addPostAction(new AddCommand(postActionCounter, 1));
+	stack.execute(command);
+
+	ASSERT_EQ(2, stack.count());
+	stack.undo();
+	ASSERT_EQ(1, counter);
+	ASSERT_EQ(0, postActionCounter);
+}
+
+TEST(UndoStackTest, undoLimitTest)
+{
+	const QVariant oldLimit = SettingsManager::value("undoLimit");
+	SettingsManager::setValue("undoLimit", 5);
+
+	QList<int> counters;
+	for (int i = 0; i < 10; ++i) {
+		counters << 0;
+	}
+
+	UndoStack stack;
+	for (int &counter : counters) {
+		stack.execute(new AddCommand(counter, 1));
+	}
+
+	SettingsManager::setValue("undoLimit", oldLimit);
+
+	ASSERT_EQ(5, stack.count());
+	while (stack.canUndo()) {
+		stack.undo();
+	}
+
+	ASSERT_EQ(1, counters[4]);
+	ASSERT_EQ(0, counters[5]);
+}
+
+/// Needs robots metamodel plugin to be built into plugins/editors.
+TEST(UndoStackTest, DISABLED_propertyEditsMemoryBenchmark)
+{
+	const int editsCount = 100000;
+	const int elementsCount = 100;
+	const Id timerType("RobotsMetamodel", "RobotsDiagram", "Timer");
+
+	EditorManager editorManager;
+	models::Models models("undoStackTest.qrs", editorManager);
+	models::LogicalModelAssistApi &logicalApi = models.logicalModelAssistApi();
+	IdList elements;
+	for (int i = 0; i < elementsCount; ++i) {
+		elements << logicalApi.createElement(Id::rootId(), timerType);
+	}
+
+	// Typing into one property produces mergeable edits, bulk edits touch a different element each time.
+	for (const bool bulk : { false, true }) {
+		UndoStack stack;
+		const int memoryBefore = residentMemoryKb();
+		for (int i = 0; i < editsCount; ++i) {
+			const Id &element = bulk ? elements[i % elementsCount] : elements.first();
+			stack.execute(new commands::ChangePropertyCommand(&logicalApi, "Delay", element, QString::number(i)));
+		}
+
+		qDebug() << (bulk ? "Bulk edits:" : "Edits of one property:") << editsCount << "edits,"
+				<< stack.count() << "commands in history, resident memory growth"
+				<< residentMemoryKb() - memoryBefore << "kB";
+	}
+}
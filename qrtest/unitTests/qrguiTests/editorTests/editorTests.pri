@@ -0,0 +1,5 @@
+HEADERS += \
+	$$PWD/editorViewSceneTest.h \
+
+SOURCES += \
+	$$PWD/editorViewSceneTest.cpp \
@@ -0,0 +1,406 @@
+#include "editorViewSceneTest.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QDebug>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QGraphicsSceneMouseEvent>
+
+#include <gtest/gtest.h>
+
+#include <qrkernel/settingsManager.h>
+#include <qrgui/models/models.h>
+#include <qrgui/controller/controller.h>
+#include <qrgui/plugins/pluginManager/editorManager.h>
+#include <qrgui/editor/editorView.h>
+#include <qrgui/editor/nodeElement.h>
+#include <qrgui/editor/edgeElement.h>
+#include <qrgui/editor/sceneCustomizer.h>
+
+using namespace qReal;
+using namespace qrguiTests;
+
+namespace {
+
+/// Element without implementation and metamodel, enough for the scene to keep track of it.
+class TestElement : public Element
+{
+public:
+	TestElement(const Id &id, models::GraphicalModelAssistApi &graphicalApi
+			, models::LogicalModelAssistApi &logicalApi)
+		: Element(nullptr, id, graphicalApi, logicalApi)
+	{
+	}
+
+	QRectF boundingRect() const override
+	{
+		return QRectF(0, 0, 10, 10);
+	}
+
+	void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override
+	{
+		Q_UNUSED(painter)
+		Q_UNUSED(option)
+		Q_UNUSED(widget)
+	}
+
+	bool initPossibleEdges() override
+	{
+		return false;
+	}
+
+	void setColorRect(bool bl) override
+	{
+		Q_UNUSED(bl)
+	}
+};
+
+/// Diagram of robots blocks laid out in a grid, opened in an editor. Needs robots metamodel plugin to be built
+/// into plugins/editors.
+class LargeDiagram
+{
+public:
+	explicit LargeDiagram(int elementsCount)
+		: mModels("editorViewSceneTest.qrs", mEditorManager)
+	{
+		const Id diagramType("RobotsMetamodel", "RobotsDiagram", "RobotsDiagramNode");
+		const Id blockType("RobotsMetamodel", "RobotsDiagram", "FinalNode");
+
+		models::GraphicalModelAssistApi &graphicalApi = mModels.graphicalModelAssistApi();
+		open(graphicalApi.createElement(Id::rootId(), diagramType.sameTypeId(), false, "diagram", QPointF()));
+
+		for (int i = 0; i < elementsCount; ++i) {
+			mElements << graphicalApi.createElement(mDiagram, blockType.sameTypeId(), false, "block"
+					, QPointF(i % columns * step, i / columns * step));
+		}
+	}
+
+	/// Loads given project and opens its first diagram, like main window does after opening a project.
+	explicit LargeDiagram(const QString &projectFile)
+		: mModels(projectFile, mEditorManager)
+	{
+		models::GraphicalModelAssistApi &graphicalApi = mModels.graphicalModelAssistApi();
+		open(graphicalApi.children(Id::rootId()).first());
+		mElements = graphicalApi.children(mDiagram);
+	}
+
+	/// Connects two blocks of the diagram with a link.
+	void connect(const Id &from, const Id &to)
+	{
+		const Id linkType("RobotsMetamodel", "RobotsDiagram", "ControlFlow");
+		models::GraphicalModelAssistApi &graphicalApi = mModels.graphicalModelAssistApi();
+		const Id link = graphicalApi.createElement(mDiagram, linkType.sameTypeId(), false, "link", QPointF());
+		graphicalApi.setFrom(link, from);
+		graphicalApi.setTo(link, to);
+		graphicalApi.setFromPort(link, 0);
+		graphicalApi.setToPort(link, 1);
+		scene().getEdgeById(link)->adjustLink();
+	}
+
+	EditorViewScene &scene()
+	{
+		return mView->mutableScene();
+	}
+
+	const IdList &elements() const
+	{
+		return mElements;
+	}
+
+	void save(const QString &projectFile)
+	{
+		mModels.repoControlApi().saveTo(projectFile);
+	}
+
+	static const int columns = 100;
+	static const int step = 60;
+
+private:
+	void open(const Id &diagram)
+	{
+		models::GraphicalModelAssistApi &graphicalApi = mModels.graphicalModelAssistApi();
+		mDiagram = diagram;
+		mView.reset(new EditorView(mModels, mController, mCustomizer, mDiagram));
+		mView->mutableMvIface().configure(graphicalApi, mModels.logicalModelAssistApi(), mModels.exploser());
+		mView->mutableMvIface().setModel(mModels.graphicalModel());
+		mView->mutableMvIface().setLogicalModel(mModels.logicalModel());
+		mView->mutableMvIface().setRootIndex(graphicalApi.indexById(mDiagram));
+	}
+
+	EditorManager mEditorManager;
+	models::Models mModels;
+	Controller mController;
+	SceneCustomizer mCustomizer;
+	QScopedPointer<EditorView> mView;
+	Id mDiagram;
+	IdList mElements;
+};
+
+/// Renders frames of a scene into an image while panning over it with given zoom, returns frames per second.
+qreal panningFramesPerSecond(QGraphicsScene &scene, qreal zoom)
+{
+	const int frames = 100;
+	QImage frame(1280, 800, QImage::Format_ARGB32_Premultiplied);
+	const QSizeF visibleArea(frame.width() / zoom, frame.height() / zoom);
+	const qreal panStep = (scene.sceneRect().width() - visibleArea.width()) / frames;
+
+	QElapsedTimer timer;
+	timer.start();
+	for (int i = 0; i < frames; ++i) {
+		frame.fill(Qt::white);
+		QPainter painter(&frame);
+		painter.setRenderHint(QPainter::Antialiasing);
+		scene.render(&painter, frame.rect(), QRectF(QPointF(i * qMax<qreal>(0, panStep), 0), visibleArea));
+	}
+
+	return frames * 1000.0 / qMax<qint64>(1, timer.elapsed());
+}
+
+/// Sends mouse event with left button to a scene like a view does.
+void sendMouseEvent(QGraphicsScene &scene, QEvent::Type type, const QPointF &scenePos, const QPointF &lastScenePos
+		, const QPointF &buttonDownScenePos)
+{
+	QGraphicsSceneMouseEvent event(type);
+	event.setScenePos(scenePos);
+	event.setLastScenePos(lastScenePos);
+	event.setButtonDownScenePos(Qt::LeftButton, buttonDownScenePos);
+	event.setButton(type == QEvent::GraphicsSceneMouseMove ? Qt::NoButton : Qt::LeftButton);
+	event.setButtons(Qt::LeftButton);
+	QApplication::sendEvent(&scene, &event);
+}
+
+}
+
+TEST(EditorViewSceneTest, DISABLED_largeDiagramBenchmark)
+{
+	const int elementsCount = 10000;
+
+	QElapsedTimer timer;
+	timer.start();
+	LargeDiagram diagram(elementsCount);
+	const qint64 openTime = timer.restart();
+
+	EditorViewScene &scene = diagram.scene();
+	for (const Id &element : diagram.elements()) {
+		ASSERT_NE(nullptr, scene.getElem(element));
+		scene.highlight(element, false);
+	}
+
+	scene.dehighlight();
+	const qint64 highlightTime = timer.restart();
+
+	scene.clearScene();
+	const qint64 clearTime = timer.elapsed();
+
+	ASSERT_EQ(nullptr, scene.getElem(diagram.elements().first()));
+	qDebug() << "Opening" << elementsCount << "elements, ms:" << openTime;
+	qDebug() << "Highlighting and dehighlighting, ms:" << highlightTime;
+	qDebug() << "Clearing scene, ms:" << clearTime;
+}
+
+TEST(EditorViewSceneTest, DISABLED_projectOpeningBenchmark)
+{
+	const int elementsCount = 20000;
+	const QString projectFile = "editorViewSceneTestProject.qrs";
+	LargeDiagram(elementsCount).save(projectFile);
+
+	QElapsedTimer timer;
+	timer.start();
+	LargeDiagram diagram(projectFile);
+	const qint64 openTime = timer.elapsed();
+
+	EXPECT_EQ(elementsCount, diagram.elements().size());
+	EXPECT_EQ(elementsCount, diagram.scene().elements().size());
+	qDebug() << "Opening project with" << elementsCount << "elements and showing its diagram, ms:" << openTime;
+	QFile::remove(projectFile);
+}
+
+TEST(EditorViewSceneTest, DISABLED_panningBenchmark)
+{
+	LargeDiagram diagram(20000);
+	EditorViewScene &scene = diagram.scene();
+	scene.setSceneRect(scene.itemsBoundingRect());
+
+	for (const bool caching : { false, true }) {
+		SettingsManager::setValue("cacheElementPictures", caching);
+		for (const qreal zoom : { 1.0, 0.4, 0.2 }) {
+			qDebug() << "Picture caching:" << caching << "zoom:" << zoom
+					<< "frames per second:" << panningFramesPerSecond(scene, zoom);
+		}
+	}
+
+	SettingsManager::setValue("cacheElementPictures", false);
+}
+
+TEST(EditorViewSceneTest, DISABLED_hubDraggingBenchmark)
+{
+	const int linksCount = 200;
+	const int moves = 100;
+
+	LargeDiagram diagram(linksCount + 1);
+	const Id hub = diagram.elements().first();
+	for (int i = 1; i <= linksCount; ++i) {
+		if (i % 2) {
+			diagram.connect(hub, diagram.elements()[i]);
+		} else {
+			diagram.connect(diagram.elements()[i], hub);
+		}
+	}
+
+	EditorViewScene &scene = diagram.scene();
+	NodeElement * const hubNode = scene.getNodeById(hub);
+	ASSERT_NE(nullptr, hubNode);
+	ASSERT_EQ(linksCount, hubNode->getEdges().size());
+
+	const QPointF start = hubNode->sceneBoundingRect().center();
+	sendMouseEvent(scene, QEvent::GraphicsSceneMousePress, start, start, start);
+
+	QElapsedTimer timer;
+	timer.start();
+	QPointF last = start;
+	for (int i = 1; i <= moves; ++i) {
+		const QPointF current = start + QPointF(i * 7, i * 3);
+		sendMouseEvent(scene, QEvent::GraphicsSceneMouseMove, current, last, start);
+		last = current;
+	}
+
+	const qint64 elapsed = timer.elapsed();
+
+	qDebug() << "Dragging a node with" << linksCount << "links, ms per move:" << static_cast<qreal>(elapsed) / moves;
+}
+
+void EditorViewSceneRegistryTest::SetUp()
+{
+	mEditorManager.reset(new InterpreterEditorManager("editorViewSceneRegistryTestMetamodel.qrs"));
+	mModels.reset(new models::Models("editorViewSceneRegistryTest.qrs", *mEditorManager));
+	mController.reset(new Controller());
+	mCustomizer.reset(new SceneCustomizer());
+	mScene.reset(new EditorViewScene(*mModels, *mController, *mCustomizer, Id::rootId()));
+}
+
+void EditorViewSceneRegistryTest::TearDown()
+{
+	mScene.reset();
+	mCustomizer.reset();
+	mController.reset();
+	mModels.reset();
+	mEditorManager.reset();
+}
+
+Element *EditorViewSceneRegistryTest::createElement(const QString &id)
+{
+	return new TestElement(Id("TestEditor", "TestDiagram", "TestElement", id)
+			, mModels->graphicalModelAssistApi(), mModels->logicalModelAssistApi());
+}
+
+TEST_F(EditorViewSceneRegistryTest, addTest)
+{
+	Element * const element = createElement("element");
+	ASSERT_EQ(nullptr, mScene->getElem(element->id()));
+
+	mScene->addItem(element);
+	EXPECT_EQ(element, mScene->getElem(element->id()));
+	EXPECT_EQ(QList<Element *>({ element }), mScene->elements());
+	EXPECT_EQ(nullptr, mScene->getNodeById(element->id()));
+	EXPECT_EQ(nullptr, mScene->getEdgeById(element->id()));
+}
+
+TEST_F(EditorViewSceneRegistryTest, removeTest)
+{
+	QScopedPointer<Element> element(createElement("element"));
+	mScene->addItem(element.data());
+
+	mScene->removeItem(element.data());
+	EXPECT_EQ(nullptr, mScene->getElem(element->id()));
+	EXPECT_TRUE(mScene->elements().isEmpty());
+
+	mScene->addItem(element.data());
+	EXPECT_EQ(element.data(), mScene->getElem(element->id()));
+	mScene->removeItem(element.data());
+}
+
+TEST_F(EditorViewSceneRegistryTest, deleteTest)
+{
+	Element * const parent = createElement("parent");
+	Element * const child = createElement("child");
+	child->setParentItem(parent);
+	mScene->addItem(parent);
+	const Id parentId = parent->id();
+	const Id childId = child->id();
+	ASSERT_EQ(child, mScene->getElem(childId));
+
+	delete child;
+	EXPECT_EQ(nullptr, mScene->getElem(childId));
+	EXPECT_EQ(parent, mScene->getElem(parentId));
+
+	delete parent;
+	EXPECT_EQ(nullptr, mScene->getElem(parentId));
+	EXPECT_TRUE(mScene->elements().isEmpty());
+}
+
+TEST_F(EditorViewSceneRegistryTest, clearTest)
+{
+	QScopedPointer<Element> parent(createElement("parent"));
+	Element * const child = createElement("child");
+	child->setParentItem(parent.data());
+	QScopedPointer<Element> other(createElement("other"));
+	mScene->addItem(parent.data());
+	mScene->addItem(other.data());
+	ASSERT_EQ(3, mScene->elements().size());
+
+	mScene->clearScene();
+	EXPECT_EQ(nullptr, mScene->getElem(parent->id()));
+	EXPECT_EQ(nullptr, mScene->getElem(child->id()));
+	EXPECT_EQ(nullptr, mScene->getElem(other->id()));
+	EXPECT_TRUE(mScene->elements().isEmpty());
+}
+
+TEST_F(EditorViewSceneRegistryTest, reparentTest)
+{
+	QScopedPointer<Element> parent(createElement("parent"));
+	Element * const child = createElement("child");
+	mScene->addItem(child);
+	ASSERT_EQ(child, mScene->getElem(child->id()));
+
+	// Child leaves the scene together with a parent that is not on it.
+	child->setParentItem(parent.data());
+	EXPECT_EQ(nullptr, mScene->getElem(child->id()));
+
+	mScene->addItem(parent.data());
+	EXPECT_EQ(parent.data(), mScene->getElem(parent->id()));
+	EXPECT_EQ(child, mScene->getElem(child->id()));
+
+	// Child stays on the scene when it is taken out of its parent.
+	child->setParentItem(nullptr);
+	EXPECT_EQ(child, mScene->getElem(child->id()));
+
+	child->setParentItem(parent.data());
+	mScene->removeItem(parent.data());
+	EXPECT_EQ(nullptr, mScene->getElem(parent->id()));
+	EXPECT_EQ(nullptr, mScene->getElem(child->id()));
+}
+
+TEST_F(EditorViewSceneRegistryTest, dehighlightRemovedElementsTest)
+{
+	Element * const deleted = createElement("deleted");
+	QScopedPointer<Element> removed(createElement("removed"));
+	Element * const kept = createElement("kept");
+	mScene->addItem(deleted);
+	mScene->addItem(removed.data());
+	mScene->addItem(kept);
+	mScene->highlight(deleted->id(), false);
+	mScene->highlight(removed->id(), false);
+	mScene->highlight(kept->id(), false);
+	ASSERT_NE(nullptr, removed->graphicsEffect());
+	ASSERT_NE(nullptr, kept->graphicsEffect());
+
+	delete deleted;
+	mScene->removeItem(removed.data());
+
+	// Elements that left the scene are forgotten, so only the one on the scene is dehighlighted.
+	mScene->dehighlight();
+	EXPECT_EQ(nullptr, kept->graphicsEffect());
+	EXPECT_NE(nullptr, removed->graphicsEffect());
+}
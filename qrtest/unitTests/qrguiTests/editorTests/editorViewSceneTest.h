@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QtCore/QScopedPointer>
+
+#include <gtest/gtest.h>
+
+#include <qrgui/plugins/pluginManager/interpreterEditorManager.h>
+#include <qrgui/models/models.h>
+#include <qrgui/controller/controller.h>
+#include <qrgui/editor/editorViewScene.h>
+#include <qrgui/editor/sceneCustomizer.h>
+
+namespace qrguiTests {
+
+/// Tests for a registry of elements by ids maintained by EditorViewScene.
+class EditorViewSceneRegistryTest : public testing::Test
+{
+protected:
+	void SetUp() override;
+	void TearDown() override;
+
+	/// Creates element that is not added to any scene. Caller takes ownership.
+	qReal::Element *createElement(const QString &id);
+
+	QScopedPointer<qReal::InterpreterEditorManager> mEditorManager;
+	QScopedPointer<qReal::models::Models> mModels;
+	QScopedPointer<qReal::Controller> mController;
+	QScopedPointer<qReal::SceneCustomizer> mCustomizer;
+	QScopedPointer<qReal::EditorViewScene> mScene;
+};
+
+}
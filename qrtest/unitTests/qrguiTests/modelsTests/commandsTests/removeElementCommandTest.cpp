@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <qrgui/models/models.h>
+#include <qrgui/models/commands/removeElementCommand.h>
+#include <qrgui/plugins/pluginManager/interpreterEditorManager.h>
+
+using namespace qReal;
+
+TEST(RemoveElementCommandTest, undoRestoresPropertiesTest)
+{
+	InterpreterEditorManager editorManager("removeElementCommandTestMetamodel.qrs");
+	const Id diagram = editorManager.createEditorAndDiagram("TestEditor").second;
+	const Id block(diagram.editor(), diagram.diagram(), "Block");
+	editorManager.addNodeElement(diagram, "Block", "Block", false);
+	editorManager.addProperty(block, "speed");
+	editorManager.updateProperties(block, "speed", "int", "10", "speed");
+	editorManager.addProperty(block, "mode");
+	editorManager.updateProperties(block, "mode", "string", "fast", "mode");
+
+	models::Models models("removeElementCommandTest.qrs", editorManager);
+	models::GraphicalModelAssistApi &graphicalApi = models.graphicalModelAssistApi();
+	models::LogicalModelAssistApi &logicalApi = models.logicalModelAssistApi();
+	const Id element = graphicalApi.createElement(Id::rootId(), block);
+	const Id logicalElement = graphicalApi.logicalId(element);
+	logicalApi.mutableLogicalRepoApi().setProperty(logicalElement, "speed", "20");
+	graphicalApi.setPosition(element, QPointF(100, 50));
+
+	commands::RemoveElementCommand command(logicalApi, graphicalApi, models.exploser(), Id::rootId(), Id::rootId()
+			, element, false, "Block", QPointF(100, 50));
+	command.redo();
+	ASSERT_FALSE(graphicalApi.graphicalRepoApi().exist(element));
+	ASSERT_FALSE(logicalApi.logicalRepoApi().exist(logicalElement));
+
+	command.undo();
+	const Id restored = command.elementId();
+	ASSERT_TRUE(graphicalApi.graphicalRepoApi().exist(restored));
+	ASSERT_EQ(logicalElement, graphicalApi.logicalId(restored));
+
+	const qrRepo::LogicalRepoApi &repo = logicalApi.logicalRepoApi();
+	EXPECT_EQ("20", repo.property(logicalElement, "speed").toString());
+	EXPECT_EQ("fast", repo.property(logicalElement, "mode").toString());
+	EXPECT_TRUE(repo.hasProperty(logicalElement, "links"));
+	EXPECT_EQ(QPointF(100, 50), graphicalApi.position(restored));
+}
@@ -5,4 +5,5 @@ HEADERS += \
 	$$PWD/detailsTests/graphicalPartModelTest.h \
 
 SOURCES += \
+	$$PWD/commandsTests/removeElementCommandTest.cpp \
 	$$PWD/detailsTests/graphicalPartModelTest.cpp \
@@ -0,0 +1,75 @@
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QDebug>
+
+#include <gtest/gtest.h>
+
+#include <qrkernel/exception/exception.h>
+#include <qrgui/plugins/pluginManager/interpreterEditorManager.h>
+
+using namespace qReal;
+
+TEST(InterpreterEditorManagerTest, metamodelChangesAreVisibleTest)
+{
+	InterpreterEditorManager manager("interpreterEditorManagerTest.qrs");
+	const Id diagram = manager.createEditorAndDiagram("TestEditor").second;
+	const Id abstractNode(diagram.editor(), diagram.diagram(), "AbstractNode");
+	const Id block(diagram.editor(), diagram.diagram(), "Block");
+
+	EXPECT_EQ(abstractNode, manager.findElementByType("AbstractNode"));
+	EXPECT_THROW(manager.findElementByType("Block"), Exception);
+
+	manager.addNodeElement(diagram, "Block", "Block", false);
+	EXPECT_EQ(block, manager.findElementByType("Block"));
+	EXPECT_EQ(1, manager.isNodeOrEdge(diagram.editor(), "Block"));
+	EXPECT_TRUE(manager.isParentOf(block, abstractNode));
+	EXPECT_FALSE(manager.isParentOf(abstractNode, block));
+	EXPECT_TRUE(manager.children(abstractNode).contains(block));
+	EXPECT_TRUE(manager.propertyNames(block).isEmpty());
+
+	manager.addProperty(block, "speed");
+	EXPECT_EQ(QStringList("speed"), manager.propertyNames(block));
+
+	manager.deleteProperty("speed");
+	EXPECT_TRUE(manager.propertyNames(block).isEmpty());
+}
+
+TEST(InterpreterEditorManagerTest, DISABLED_metamodelQueriesBenchmark)
+{
+	const int elementsCount = 200;
+	const int propertiesCount = 10;
+	const int passes = 20;
+
+	InterpreterEditorManager manager("interpreterEditorManagerTest.qrs");
+	const Id diagram = manager.createEditorAndDiagram("BenchmarkEditor").second;
+	const Id abstractNode(diagram.editor(), diagram.diagram(), "AbstractNode");
+	IdList elements;
+	for (int i = 0; i < elementsCount; ++i) {
+		const QString name = QString("Block%1").arg(i);
+		manager.addNodeElement(diagram, name, name, false);
+		elements << Id(diagram.editor(), diagram.diagram(), name);
+		for (int j = 0; j < propertiesCount; ++j) {
+			manager.addProperty(elements.last(), QString("property%1").arg(j));
+		}
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+	int queries = 0;
+	for (int i = 0; i < passes; ++i) {
+		for (const Id &element : elements) {
+			manager.friendlyName(element);
+			manager.isParentOf(element, abstractNode);
+			manager.isNodeOrEdge(element.editor(), element.element());
+			for (const QString &property : manager.propertyNames(element)) {
+				manager.typeName(element, property);
+			}
+
+			queries += 3 + propertiesCount;
+		}
+	}
+
+	const qint64 elapsed = timer.elapsed();
+
+	qDebug() << elementsCount << "elements," << queries << "queries, microseconds per query:"
+			<< elapsed * 1000.0 / queries;
+}
@@ -0,0 +1,2 @@
+SOURCES += \
+	$$PWD/interpreterEditorManagerTest.cpp \
@@ -2,7 +2,8 @@ TARGET = qrgui_unittests
 
 include(../common.pri)
 
-links(qrkernel qslog qrutils qrrepo qrgui-models qrgui-controller qrgui-plugin-manager qrgui-tool-plugin-interface)
+links(qrkernel qslog qrutils qrrepo qrgui-models qrgui-controller qrgui-plugin-manager qrgui-tool-plugin-interface \
+		qrgui-editor)
 
 INCLUDEPATH += \
 	# A little hack to make .ui files happy. They include other files by relative path based on qrgui/.ui \
@@ -11,4 +12,10 @@ INCLUDEPATH += \
 
 include(modelsTests/modelsTests.pri)
 
+include(editorTests/editorTests.pri)
+
+include(controllerTests/controllerTests.pri)
+
+include(pluginManagerTests/pluginManagerTests.pri)
+
 include(helpers/helpers.pri)
@@ -2,6 +2,7 @@
 #include <QtCore/QVariant>
 
 #include <qrkernel/ids.h>
+#include <qrkernel/timeMeasurer.h>
 
 #include "gtest/gtest.h"
 
@@ -147,3 +148,97 @@ TEST(IdsTest, idInputOutputStreamTest) {
 
 	EXPECT_EQ(in, out);
 }
+
+TEST(IdsTest, idPartRoundTripTest) {
+	Id const id = Id::createElementId("editor", "diagram", "element");
+	Id const loaded = Id::loadFromString(id.toString());
+
+	EXPECT_EQ(loaded, id);
+	EXPECT_EQ(qHash(loaded), qHash(id));
+	EXPECT_EQ(loaded.id(), id.id());
+	EXPECT_EQ(loaded.toString(), id.toString());
+
+	Id const nonCanonical("editor", "diagram", "element", id.id().toUpper());
+	EXPECT_EQ(nonCanonical.id(), id.id().toUpper());
+	EXPECT_EQ(nonCanonical.idSize(), (uint) 4);
+	EXPECT_NE(nonCanonical, id);
+
+	Id const plain("editor", "diagram", "element", "id");
+	EXPECT_EQ(Id::loadFromString(plain.toString()), plain);
+	EXPECT_EQ(Id(plain.type(), "id"), plain);
+}
+
+TEST(IdsTest, orderingTest) {
+	// Parts are created in reverse order, so that order of creation differs from order of values.
+	Id const third("editor", "diagram", "element", "{10000000-0000-0000-0000-000000000000}");
+	Id const second("editor", "diagram", "element", "{00000000-0000-0000-0000-00000000000a}");
+	Id const first("editor", "diagram", "element", "{00000000-0000-0000-0000-000000000001}");
+	Id const plain("editor", "diagram", "element", "plain");
+	Id const laterEditor("orderingTestEditorZ", "diagram", "element", "plain");
+	Id const earlierEditor("orderingTestEditorA", "diagram", "element", "plain");
+
+	EXPECT_TRUE(first < second);
+	EXPECT_TRUE(second < third);
+	EXPECT_FALSE(first < first);
+	EXPECT_TRUE(first.type() < first);
+	EXPECT_TRUE(plain < first);
+	EXPECT_TRUE(earlierEditor < laterEditor);
+	EXPECT_FALSE(laterEditor < earlierEditor);
+
+	IdList ids;
+	ids << third << first << second;
+	IdListHelper::sortByString(ids);
+	ASSERT_EQ(ids.size(), 3);
+	EXPECT_EQ(ids[0], first);
+	EXPECT_EQ(ids[1], second);
+	EXPECT_EQ(ids[2], third);
+}
+
+TEST(IdsTest, generatedIdPartTest) {
+	Id const id = Id::createElementId("editor", "diagram", "element");
+	EXPECT_EQ(id.sameTypeId().type(), id.type());
+	EXPECT_NE(id.sameTypeId().id(), id.id());
+	EXPECT_NE(id.sameTypeId(), id);
+	EXPECT_EQ(Id(id.type(), id.id()), id);
+}
+
+// Measures hash map lookups and sorting of 1000000 Ids.
+// Disabled by default, run with --gtest_also_run_disabled_tests to see results.
+TEST(IdsTest, DISABLED_lookupAndSortBenchmark) {
+	const int count = 1000000;
+	IdList ids;
+	ids.reserve(count);
+	for (int i = 0; i < count; ++i) {
+		ids << Id::createElementId("editor", "diagram", "element" + QString::number(i % 100));
+	}
+
+	QHash<Id, int> hash;
+	{
+		TimeMeasurer measurer("QHash insertion of 1000000 Ids");
+		measurer.doNothing();
+		for (int i = 0; i < count; ++i) {
+			hash.insert(ids[i], i);
+		}
+	}
+
+	int found = 0;
+	{
+		TimeMeasurer measurer("QHash lookup of 1000000 Ids");
+		measurer.doNothing();
+		for (const Id &id : ids) {
+			found += hash.contains(id) ? 1 : 0;
+		}
+	}
+
+	EXPECT_EQ(count, found);
+
+	{
+		TimeMeasurer measurer("Sorting of 1000000 Ids");
+		measurer.doNothing();
+		qSort(ids);
+	}
+
+	for (int i = 1; i < count; ++i) {
+		ASSERT_FALSE(ids[i] < ids[i - 1]);
+	}
+}
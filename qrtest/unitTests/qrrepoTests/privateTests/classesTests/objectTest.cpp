@@ -79,6 +79,7 @@ TEST(ObjectTest, propertiesHasAndSetOperationsTest)
 
 	ASSERT_TRUE(obj.hasProperty("property1"));
 	EXPECT_TRUE(obj.hasProperty("pRoPeRty1"));
+	EXPECT_TRUE(obj.hasProperty("property1", true));
 	EXPECT_FALSE(obj.hasProperty("pRoPeRty1", true));
 	EXPECT_TRUE(obj.hasProperty("proper.*", false, true));
 	EXPECT_FALSE(obj.hasProperty("proper.*cc", false, true));
@@ -134,7 +135,7 @@ TEST(ObjectTest, propertiesGetAndRemoveTest)
 	EXPECT_EQ(properties.value("property3").toString(), "value3");
 
 	obj.removeProperty("property3");
-	QMapIterator<QString, QVariant> iterator = obj.propertiesIterator();
+	qrRepo::PropertiesIterator iterator = obj.propertiesIterator();
 	iterator.next();
 	EXPECT_EQ(iterator.key(), "property1");
 	EXPECT_EQ(iterator.value(), "value1");
@@ -361,3 +362,40 @@ TEST(ObjectTest, replacePropertiesTest)
 	EXPECT_EQ(obj.property("property_test2").toString(), "replace_value");
 	EXPECT_EQ(obj.property("property").toString(), "val");
 }
+
+TEST(ObjectTest, propertySchemaSharingTest)
+{
+	qrRepo::details::LogicalObject obj1(Id("editor", "diagram", "element", "id1"));
+	qrRepo::details::LogicalObject obj2(Id("editor", "diagram", "element", "id2"));
+
+	obj1.setProperty("property1", "value1");
+	obj1.setProperty("property2", "value2");
+	obj2.setProperty("property2", "value3");
+	obj2.setProperty("property1", "value4");
+
+	// Objects with the same properties share one list of names.
+	EXPECT_EQ(obj1.propertyNames(), QStringList() << "property1" << "property2");
+	EXPECT_TRUE(obj1.propertyNames().isSharedWith(obj2.propertyNames()));
+	EXPECT_EQ(obj2.property("property1").toString(), "value4");
+	EXPECT_EQ(obj2.property("property2").toString(), "value3");
+
+	obj2.removeProperty("property1");
+	EXPECT_EQ(obj2.propertyNames(), QStringList() << "property2");
+	EXPECT_EQ(obj2.property("property2").toString(), "value3");
+	EXPECT_EQ(obj1.property("property1").toString(), "value1");
+	EXPECT_EQ(obj1.property("property2").toString(), "value2");
+
+	obj2.setProperty("property0", "value5");
+	EXPECT_EQ(obj2.propertyNames(), QStringList() << "property0" << "property2");
+	EXPECT_EQ(obj2.property("property0").toString(), "value5");
+	EXPECT_EQ(obj2.property("property2").toString(), "value3");
+
+	// Iterator is a snapshot, later changes do not affect it.
+	qrRepo::PropertiesIterator iterator = obj1.propertiesIterator();
+	obj1.setProperty("property1", "changed");
+	ASSERT_TRUE(iterator.hasNext());
+	EXPECT_EQ(iterator.next().value().toString(), "value1");
+	ASSERT_TRUE(iterator.hasNext());
+	EXPECT_EQ(iterator.next().key(), "property2");
+	EXPECT_FALSE(iterator.hasNext());
+}
@@ -1,9 +1,22 @@
 #include <QtCore/QFile>
 #include <QtCore/QDir>
+#include <QtCore/QHash>
+#include <QtCore/QDataStream>
 
 #include "folderCompressorTest.h"
+#include "../../../qrkernel/timeMeasurer.h"
 
 using namespace qrTest;
+using namespace qReal;
+
+/// Reads all files of an archive into a given hash.
+static bool readArchive(const QString &fileName, QHash<QString, QByteArray> &entries)
+{
+	return FolderCompressor::readArchive(fileName, [&entries](const QString &name, const QByteArray &data) {
+		entries.insert(name, data);
+		return true;
+	});
+}
 
 void FolderCompressorTest::removeDirectory(QString const &dirName)
 {
@@ -69,3 +82,144 @@ TEST_F(FolderCompressorTest, decompressTest) {
 	EXPECT_EQ(line2, "text2");
 	EXPECT_EQ(line3, "text3");
 }
+
+TEST_F(FolderCompressorTest, readArchiveTest) {
+	ASSERT_TRUE(FolderCompressor::compressFolder("temp", "compressed"));
+
+	QHash<QString, QByteArray> entries;
+	ASSERT_TRUE(readArchive("compressed", entries));
+
+	EXPECT_EQ(entries.size(), 3);
+	EXPECT_EQ(entries["/file1"], QByteArray("text1"));
+	EXPECT_EQ(entries["/dir1/dir2/file2"], QByteArray("text2"));
+	EXPECT_EQ(entries["/dir3/file3"], QByteArray("text3"));
+
+	EXPECT_FALSE(QDir("temp_decompessed").exists());
+	EXPECT_FALSE(readArchive("notExistingFile", entries));
+}
+
+TEST_F(FolderCompressorTest, largeFileTest) {
+	// Large enough to be split into several chunks, last of them incomplete.
+	QByteArray contents;
+	for (int i = 0; contents.size() < 3 * 1024 * 1024 + 100; ++i) {
+		contents += QByteArray::number(i * 7919) + "\n";
+	}
+
+	QFile file("temp/dir3/large");
+	ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+	file.write(contents);
+	file.close();
+	QFile("temp/empty").open(QIODevice::WriteOnly);
+
+	ASSERT_TRUE(FolderCompressor::compressFolder("temp", "compressed"));
+
+	QHash<QString, QByteArray> entries;
+	ASSERT_TRUE(readArchive("compressed", entries));
+	EXPECT_EQ(entries.size(), 5);
+	EXPECT_EQ(entries["/dir3/large"], contents);
+	EXPECT_EQ(entries["/dir3/file3"], QByteArray("text3"));
+	EXPECT_TRUE(entries.contains("/empty"));
+	EXPECT_TRUE(entries["/empty"].isEmpty());
+
+	ASSERT_TRUE(FolderCompressor::decompressFolder("compressed", "temp_decompessed"));
+	QFile decompressed("temp_decompessed/dir3/large");
+	ASSERT_TRUE(decompressed.open(QIODevice::ReadOnly));
+	EXPECT_EQ(decompressed.readAll(), contents);
+	EXPECT_TRUE(QFile::exists("temp_decompessed/empty"));
+}
+
+TEST_F(FolderCompressorTest, formatMarkerTest) {
+	ASSERT_TRUE(FolderCompressor::compressFolder("temp", "compressed"));
+
+	// Older versions read entries one by one and write each of them into a file with entry name, so empty name
+	// makes them fail instead of restoring only first chunks of large files.
+	QFile file("compressed");
+	ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+	QDataStream stream(&file);
+	QString name;
+	QByteArray data;
+	stream >> name >> data;
+	EXPECT_TRUE(name.isEmpty());
+	EXPECT_FALSE(data.isEmpty());
+}
+
+TEST_F(FolderCompressorTest, legacyArchiveTest) {
+	// Archive without header and chunks, as written by older versions.
+	QFile file("compressed");
+	ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+	QDataStream stream(&file);
+	stream << QString("/file1") << qCompress("text1") << QString("/dir3/file3") << qCompress("text3");
+	file.close();
+
+	QHash<QString, QByteArray> entries;
+	ASSERT_TRUE(readArchive("compressed", entries));
+	EXPECT_EQ(entries.size(), 2);
+	EXPECT_EQ(entries["/file1"], QByteArray("text1"));
+	EXPECT_EQ(entries["/dir3/file3"], QByteArray("text3"));
+}
+
+TEST_F(FolderCompressorTest, corruptedEntryTest) {
+	QFile file("compressed");
+	ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+	QDataStream stream(&file);
+	QByteArray corrupted = qCompress("text3");
+	corrupted.truncate(corrupted.size() / 2);
+	stream << QString("/file1") << qCompress("text1") << QString("/dir3/file3") << corrupted;
+	file.close();
+
+	QHash<QString, QByteArray> entries;
+	EXPECT_FALSE(readArchive("compressed", entries));
+	EXPECT_FALSE(entries.contains("/dir3/file3"));
+	EXPECT_FALSE(FolderCompressor::decompressFolder("compressed", "temp_decompessed"));
+
+	ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+	stream.setDevice(&file);
+	stream << QString() << QByteArray("Unknown archive format");
+	file.close();
+	EXPECT_FALSE(readArchive("compressed", entries));
+}
+
+TEST_F(FolderCompressorTest, DISABLED_throughputBenchmark) {
+	// 1 GB of XML-like data in files of typical size for a saved project.
+	const int filesCount = 16 * 1024;
+	const int fileSize = 64 * 1024;
+
+	QByteArray contents;
+	for (int i = 0; contents.size() < fileSize; ++i) {
+		contents += "<property name=\"property" + QByteArray::number(i % 100) + "\" value=\""
+				+ QByteArray::number(i * 7919) + "\"/>\n";
+	}
+
+	contents.truncate(fileSize);
+	for (int i = 0; i < filesCount; ++i) {
+		const QString dir = "temp/big/" + QString::number(i % 64);
+		QDir().mkpath(dir);
+		QFile file(dir + "/" + QString::number(i));
+		file.open(QIODevice::WriteOnly);
+		file.write(contents);
+	}
+
+	{
+		TimeMeasurer measurer("Compression of 1 GB");
+		measurer.doNothing();
+		ASSERT_TRUE(FolderCompressor::compressFolder("temp", "compressed"));
+	}
+
+	{
+		TimeMeasurer measurer("Decompression of 1 GB to folder");
+		measurer.doNothing();
+		ASSERT_TRUE(FolderCompressor::decompressFolder("compressed", "temp_decompessed"));
+	}
+
+	int entriesCount = 0;
+	{
+		TimeMeasurer measurer("Reading of 1 GB into memory");
+		measurer.doNothing();
+		ASSERT_TRUE(FolderCompressor::readArchive("compressed", [&entriesCount](const QString &, const QByteArray &) {
+			++entriesCount;
+			return true;
+		}));
+	}
+
+	EXPECT_EQ(entriesCount, filesCount + 3);
+}
@@ -1,10 +1,12 @@
 #include <QtCore/QFile>
 #include <QtCore/QDir>
+#include <QtCore/QFileInfo>
 
 #include "repositoryTest.h"
 #include "../../../qrrepo/private/classes/logicalObject.h"
 #include "../../../qrkernel/exception/exception.h"
 #include "../../../qrkernel/settingsManager.h"
+#include "../../../qrkernel/timeMeasurer.h"
 
 using namespace qrRepo;
 using namespace details;
@@ -225,6 +227,106 @@ TEST_F(RepositoryTest, elementsByPropertyContentTest) {
 	EXPECT_TRUE(list.contains(root));
 }
 
+TEST_F(RepositoryTest, searchIndexesUpdateTest) {
+	// First queries build indexes, next ones shall see changes made after that.
+	EXPECT_EQ(mRepository->findElementsByName("renamed", false, false).size(), 0);
+	EXPECT_EQ(mRepository->elementsByProperty("property4", false, false).size(), 0);
+
+	mRepository->setProperty(child1, "name", "Renamed child");
+	mRepository->setProperty(child1_child, "property4", "value4");
+
+	IdList list = mRepository->findElementsByName("renamed", false, false);
+	EXPECT_EQ(list.size(), 1);
+	EXPECT_TRUE(list.contains(child1));
+	list = mRepository->findElementsByName("child1", false, false);
+	EXPECT_EQ(list.size(), 1);
+	EXPECT_TRUE(list.contains(child1_child));
+
+	list = mRepository->elementsByProperty("property4", false, false);
+	EXPECT_EQ(list.size(), 1);
+	EXPECT_TRUE(list.contains(child1_child));
+
+	mRepository->removeProperty(child1_child, "property4");
+	EXPECT_EQ(mRepository->elementsByProperty("property4", false, false).size(), 0);
+
+	mRepository->addChild(root, newId1, parent);
+	mRepository->setProperty(newId1, "name", "renamed too");
+	EXPECT_EQ(mRepository->findElementsByName("renamed", false, false).size(), 2);
+
+	mRepository->remove(child1);
+	list = mRepository->findElementsByName("renamed", false, false);
+	EXPECT_EQ(list.size(), 1);
+	EXPECT_TRUE(list.contains(newId1));
+}
+
+TEST_F(RepositoryTest, elementsOfTypeTest) {
+	IdList list = mRepository->elementsOfType(child1.type());
+	EXPECT_EQ(list.size(), 2);
+	EXPECT_TRUE(list.contains(child1));
+	EXPECT_TRUE(list.contains(child2));
+
+	EXPECT_TRUE(mRepository->types().contains(child3.type()));
+	EXPECT_EQ(mRepository->elementsOfType(newId1.type()).size(), 0);
+
+	mRepository->addChild(root, newId1);
+	EXPECT_EQ(mRepository->elementsOfType(newId1.type()), IdList() << newId1);
+
+	mRepository->remove(child1);
+	EXPECT_EQ(mRepository->elementsOfType(child1.type()), IdList() << child2);
+}
+
+TEST_F(RepositoryTest, DISABLED_searchBenchmark) {
+	const int elementsCount = 100000;
+	for (int i = 0; i < elementsCount; ++i) {
+		const Id id("editor", "diagram", i % 2 ? "element" : "otherElement", QString::number(i));
+		mRepository->addChild(root, id, parent);
+		mRepository->setProperty(id, "name", "element " + QString::number(i));
+		mRepository->setProperty(id, i % 100 ? "property" : "rareProperty", i);
+	}
+
+	// Linear scans, as queries were implemented before indexes.
+	IdList linearByName;
+	IdList linearByProperty;
+	{
+		TimeMeasurer measurer("linear scan by name and property");
+		measurer.doNothing();
+		for (const Id &id : mRepository->elements()) {
+			if (mRepository->isLogicalId(id)) {
+				continue;
+			}
+
+			if (mRepository->property(id, "name").toString().contains("element 4242", Qt::CaseInsensitive)) {
+				linearByName << id;
+			}
+
+			if (mRepository->hasProperty(id, "rareProperty")) {
+				linearByProperty << id;
+			}
+		}
+	}
+
+	IdList indexedByName;
+	IdList indexedByProperty;
+	{
+		TimeMeasurer measurer("building indexes and first search");
+		measurer.doNothing();
+		indexedByName = mRepository->findElementsByName("element 4242", false, false);
+		indexedByProperty = mRepository->elementsByProperty("rareProperty", false, false);
+	}
+
+	{
+		TimeMeasurer measurer("1000 indexed searches by name and property");
+		measurer.doNothing();
+		for (int i = 0; i < 1000; ++i) {
+			indexedByName = mRepository->findElementsByName("element 4242", false, false);
+			indexedByProperty = mRepository->elementsByProperty("rareProperty", false, false);
+		}
+	}
+
+	EXPECT_EQ(linearByName.toSet(), indexedByName.toSet());
+	EXPECT_EQ(linearByProperty.toSet(), indexedByProperty.toSet());
+}
+
 TEST_F(RepositoryTest, parentOperationsTest) {
 	EXPECT_EQ(mRepository->parent(child1), root);
 	EXPECT_EQ(mRepository->parent(child2), root);
@@ -486,7 +588,7 @@ TEST_F(RepositoryTest, multiplePropertiesOperationsTest) {
 	EXPECT_EQ(properties.value("name").toString(), "root");
 
 	mRepository->removeProperty(child2, "name");
-	QMapIterator<QString, QVariant> iterator = mRepository->propertiesIterator(child2);
+	PropertiesIterator iterator = mRepository->propertiesIterator(child2);
 	//EXPECT_THROW(mRepository->propertiesIterator(notExistingId), Exception);
 	iterator.next();
 	EXPECT_EQ(iterator.key(), "property3");
@@ -593,6 +695,44 @@ TEST_F(RepositoryTest, saveAllTest) {
 	EXPECT_TRUE(mRepository->exist(child3_child));
 }
 
+TEST_F(RepositoryTest, incrementalSaveTest) {
+	mRepository->saveAll();
+	const qint64 fullSize = QFileInfo("saveFile.qrs").size();
+
+	mRepository->setProperty(child1, "name", "renamed");
+	mRepository->remove(child3_child);
+	mRepository->saveAll();
+	const qint64 journalSize = QFileInfo("saveFile.qrs").size() - fullSize;
+
+	EXPECT_GT(journalSize, 0);
+	EXPECT_LT(journalSize, fullSize);
+
+	mRepository->open("saveFile.qrs");
+
+	EXPECT_EQ(mRepository->property(child1, "name").toString(), "renamed");
+	EXPECT_FALSE(mRepository->exist(child3_child));
+	EXPECT_TRUE(mRepository->exist(child2_child));
+	EXPECT_EQ(mRepository->property(child2, "property3").toString(), "val3");
+}
+
+TEST_F(RepositoryTest, interruptedIncrementalSaveTest) {
+	mRepository->saveAll();
+
+	mRepository->setProperty(child1, "name", "renamed");
+	mRepository->remove(child3_child);
+	mRepository->saveAll();
+
+	// Simulates a crash while the journal section was written.
+	QFile file("saveFile.qrs");
+	ASSERT_TRUE(file.resize(file.size() - 1));
+
+	mRepository->open("saveFile.qrs");
+
+	EXPECT_NE(mRepository->property(child1, "name").toString(), "renamed");
+	EXPECT_TRUE(mRepository->exist(child3_child));
+	EXPECT_EQ(mRepository->property(child2, "property3").toString(), "val3");
+}
+
 TEST_F(RepositoryTest, saveTest) {
 	IdList toSave;
 	toSave << child1 << child2 << child3;
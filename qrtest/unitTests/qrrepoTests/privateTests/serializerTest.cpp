@@ -1,17 +1,52 @@
 #include <QtCore/QFile>
 #include <QtCore/QDir>
 #include <QtCore/QPointF>
+#include <QtCore/QElapsedTimer>
 
 #include "serializerTest.h"
 #include "../../../qrrepo/private/classes/logicalObject.h"
 #include "../../../qrrepo/private/classes/graphicalObject.h"
+#include "../../../qrrepo/private/binarySerializer.h"
+#include "../../../qrrepo/private/folderCompressor.h"
 #include "../../../qrkernel/settingsManager.h"
+#include "../../../qrkernel/timeMeasurer.h"
+#include "../../../qrkernel/exception/exception.h"
 
 using namespace qrRepo;
 using namespace details;
 using namespace qReal;
 using namespace qrTest;
 
+/// Lazy properties source that fails to deserialize any object, as a source with a corrupted object would.
+class CorruptedPropertiesSource : public LazyPropertiesSource
+{
+public:
+	LazyProperties loadProperties(quint64 offset, quint32 size, bool withGraphicalParts) const override
+	{
+		Q_UNUSED(offset)
+		Q_UNUSED(size)
+		Q_UNUSED(withGraphicalParts)
+		throw Exception("Corrupted project file: incomplete object record");
+	}
+};
+
+/// Returns resident memory of current process in kilobytes, or 0 if it can not be determined.
+static int residentMemoryKb()
+{
+	QFile status("/proc/self/status");
+	if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		return 0;
+	}
+
+	for (QString line = status.readLine(); !line.isEmpty(); line = status.readLine()) {
+		if (line.startsWith("VmRSS:")) {
+			return line.section(':', 1).trimmed().section(' ', 0, 0).toInt();
+		}
+	}
+
+	return 0;
+}
+
 void SerializerTest::removeDirectory(QString const &dirName)
 {
 	QDir const dir(dirName);
@@ -67,7 +102,7 @@ TEST_F(SerializerTest, saveAndLoadFromDiskTest)
 	list.push_back(&obj1);
 	list.push_back(&obj2);
 
-	mSerializer->saveToDisk(list, metaInfo);
+	EXPECT_TRUE(mSerializer->saveToDisk(list, metaInfo));
 
 	QHash<Id, Object *> map;
 	mSerializer->setWorkingFile("saveFile.qrs");
@@ -87,6 +122,17 @@ TEST_F(SerializerTest, saveAndLoadFromDiskTest)
 	ASSERT_EQ(metaInfo["key2"], 2);
 }
 
+TEST_F(SerializerTest, saveToUnwritableFileTest)
+{
+	LogicalObject object(Id("editor1", "diagram1", "element1", "id1"));
+	QList<Object *> list;
+	list.push_back(&object);
+
+	mSerializer->setWorkingFile("nonexistentFolder/saveFile.qrs");
+	EXPECT_FALSE(mSerializer->saveToDisk(list, QHash<QString, QVariant>()));
+	EXPECT_FALSE(QFile::exists("nonexistentFolder/saveFile.qrs"));
+}
+
 // Decomment EXPECT_FALSE and delete EXPECT_TRUE(true) when removeFromDisk will be fixed. pathToElement(id) returns
 // path without parent folder /tree and /logical or /graphical according to id type.
 TEST_F(SerializerTest, removeFromDiskTest)
@@ -142,3 +188,299 @@ TEST_F(SerializerTest, saveAndLoadGraphicalPartsTest)
 
 	ASSERT_EQ(QPointF(10, 20), deserializedGraphicalObject->graphicalPartProperty(0, "Coord"));
 }
+
+TEST_F(SerializerTest, saveAndLoadStructureTest)
+{
+	Id const parent("editor", "diagram", "element", "parent");
+	LogicalObject parentObj(parent);
+	Id const child("editor", "diagram", "element", "child");
+	LogicalObject childObj(child);
+
+	parentObj.addChild(child);
+	childObj.setParent(parent);
+	childObj.setProperty("links", IdListHelper::toVariant(IdList() << parent << child));
+	childObj.setProperty("flag", true);
+
+	QList<Object *> list;
+	list.push_back(&parentObj);
+	list.push_back(&childObj);
+
+	mSerializer->saveToDisk(list, QHash<QString, QVariant>());
+	ASSERT_TRUE(BinarySerializer::isBinaryFile("saveFile.qrs"));
+
+	QHash<Id, Object *> map;
+	QHash<QString, QVariant> metaInfo;
+	mSerializer->setWorkingFile("saveFile.qrs");
+	mSerializer->loadFromDisk(map, metaInfo);
+
+	ASSERT_TRUE(map.contains(parent));
+	ASSERT_TRUE(map.contains(child));
+	EXPECT_EQ(IdList() << child, map.value(parent)->children());
+	EXPECT_EQ(parent, map.value(child)->parent());
+	EXPECT_EQ(IdList() << parent << child, map.value(child)->property("links").value<IdList>());
+	EXPECT_TRUE(map.value(child)->property("flag").toBool());
+
+	qDeleteAll(map);
+}
+
+TEST_F(SerializerTest, loadLegacyXmlFormatTest)
+{
+	Id const id("editor1", "diagram1", "element1", "id1");
+	LogicalObject obj(id);
+	obj.setProperty("property1", "value1");
+
+	QList<Object *> list;
+	list.push_back(&obj);
+
+	QHash<QString, QVariant> metaInfo;
+	metaInfo["key"] = "info";
+
+	mSerializer->setFormat(Serializer::Format::xmlTree);
+	mSerializer->saveToDisk(list, metaInfo);
+	ASSERT_FALSE(BinarySerializer::isBinaryFile("saveFile.qrs"));
+
+	QHash<Id, Object *> map;
+	metaInfo.clear();
+	mSerializer->setWorkingFile("saveFile.qrs");
+	mSerializer->loadFromDisk(map, metaInfo);
+
+	ASSERT_TRUE(map.contains(id));
+	EXPECT_EQ("value1", map.value(id)->property("property1").toString());
+	EXPECT_EQ("info", metaInfo["key"].toString());
+
+	qDeleteAll(map);
+}
+
+TEST_F(SerializerTest, loadCorruptedXmlFormatTest)
+{
+	LogicalObject obj(Id("editor1", "diagram1", "element1", "id1"));
+	obj.setProperty("property1", "value1");
+
+	QDomDocument document;
+	document.appendChild(obj.serialize(document));
+	document.elementsByTagName("QString").at(0).toElement().removeAttribute("key");
+
+	QDir().mkpath("corruptedProject/tree/logical");
+	QFile file("corruptedProject/tree/logical/id1");
+	ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+	file.write(document.toByteArray());
+	file.close();
+	ASSERT_TRUE(FolderCompressor::compressFolder("corruptedProject", "corruptedProject.qrs"));
+
+	// Parsing error on a worker thread is reported to the caller as for binary projects.
+	QHash<Id, Object *> map;
+	QHash<QString, QVariant> metaInfo;
+	mSerializer->setWorkingFile("corruptedProject.qrs");
+	EXPECT_THROW(mSerializer->loadFromDisk(map, metaInfo), Exception);
+	EXPECT_TRUE(map.isEmpty());
+
+	removeDirectory("corruptedProject");
+	QFile::remove("corruptedProject.qrs");
+}
+
+// Compares save and load times of binary and XML formats on a synthetic model with 50000 elements.
+// Disabled by default, run with --gtest_also_run_disabled_tests to see results.
+TEST_F(SerializerTest, DISABLED_formatsBenchmark)
+{
+	const int elementsCount = 25000;
+	QList<Object *> objects;
+	for (int i = 0; i < elementsCount; ++i) {
+		LogicalObject * const logicalObject = new LogicalObject(Id("editor", "diagram", "element", QString::number(i)));
+		logicalObject->setProperty("name", "element " + QString::number(i));
+		logicalObject->setProperty("value", i);
+		objects << logicalObject;
+
+		GraphicalObject * const graphicalObject = new GraphicalObject(
+				Id("editor", "diagram", "element", "g" + QString::number(i)), Id::rootId(), logicalObject->id());
+		graphicalObject->setProperty("position", QPointF(i, i));
+		graphicalObject->createGraphicalPart(0);
+		graphicalObject->setGraphicalPartProperty(0, "Coord", QPointF(10, 20));
+		objects << graphicalObject;
+	}
+
+	for (const Serializer::Format format : { Serializer::Format::binary, Serializer::Format::xmlTree }) {
+		const QString formatName = format == Serializer::Format::binary ? "binary" : "xml";
+		mSerializer->setFormat(format);
+		mSerializer->setWorkingFile("saveFile.qrs");
+		{
+			TimeMeasurer measurer("save in " + formatName + " format");
+			measurer.doNothing();
+			mSerializer->saveToDisk(objects, QHash<QString, QVariant>());
+		}
+
+		QHash<Id, Object *> map;
+		QHash<QString, QVariant> metaInfo;
+		{
+			TimeMeasurer measurer("load in " + formatName + " format");
+			measurer.doNothing();
+			mSerializer->loadFromDisk(map, metaInfo);
+		}
+
+		EXPECT_EQ(objects.size(), map.size());
+		qDeleteAll(map);
+	}
+
+	qDeleteAll(objects);
+}
+
+TEST_F(SerializerTest, lazyLoadingTest)
+{
+	Id const element("editor", "diagram", "element", "id");
+	LogicalObject logicalObj(element);
+	logicalObj.setProperty("name", "logical");
+
+	Id const graphicalElement("editor", "diagram", "element", "graphicalId");
+	GraphicalObject graphicalObj(graphicalElement, Id::rootId(), element);
+	graphicalObj.createGraphicalPart(0);
+	graphicalObj.setGraphicalPartProperty(0, "Coord", QPointF(10, 20));
+
+	QList<Object *> list;
+	list.push_back(&logicalObj);
+	list.push_back(&graphicalObj);
+
+	mSerializer->saveToDisk(list, QHash<QString, QVariant>());
+
+	const QVariant oldLazyLoading = SettingsManager::value("LazyProjectLoading");
+	SettingsManager::setValue("LazyProjectLoading", true);
+
+	QHash<Id, Object *> map;
+	QHash<QString, QVariant> metaInfo;
+	mSerializer->setWorkingFile("saveFile.qrs");
+	mSerializer->loadFromDisk(map, metaInfo);
+
+	SettingsManager::setValue("LazyProjectLoading", oldLazyLoading);
+
+	ASSERT_TRUE(map.contains(element));
+	ASSERT_TRUE(map.contains(graphicalElement));
+	EXPECT_FALSE(map.value(element)->arePropertiesLoaded());
+	EXPECT_EQ(Id::rootId(), map.value(graphicalElement)->parent());
+
+	EXPECT_EQ("logical", map.value(element)->property("name").toString());
+	EXPECT_TRUE(map.value(element)->arePropertiesLoaded());
+	EXPECT_FALSE(map.value(graphicalElement)->arePropertiesLoaded());
+
+	GraphicalObject const * const deserializedGraphicalObject
+			= dynamic_cast<GraphicalObject const *>(map.value(graphicalElement));
+	EXPECT_EQ(QPointF(10, 20), deserializedGraphicalObject->graphicalPartProperty(0, "Coord"));
+
+	qDeleteAll(map);
+}
+
+TEST_F(SerializerTest, lazyLoadingCorruptedObjectTest)
+{
+	LogicalObject object(Id("editor", "diagram", "element", "id"));
+	object.setLazyProperties(QSharedPointer<const LazyPropertiesSource>(new CorruptedPropertiesSource()), 0, 0);
+
+	EXPECT_THROW(object.property("name"), Exception);
+	EXPECT_FALSE(object.arePropertiesLoaded());
+	EXPECT_THROW(object.setProperty("name", "value"), Exception);
+	EXPECT_FALSE(object.arePropertiesLoaded());
+}
+
+// Measures time to first diagram and resident memory after eager and lazy loading of a project with
+// 100000 elements in 100 diagrams. Disabled by default, run with --gtest_also_run_disabled_tests.
+TEST_F(SerializerTest, DISABLED_lazyLoadingBenchmark)
+{
+	const int diagramsCount = 100;
+	const int elementsPerDiagram = 500;
+	QList<Object *> objects;
+	QList<Id> firstDiagramElements;
+	for (int diagram = 0; diagram < diagramsCount; ++diagram) {
+		GraphicalObject * const diagramObject = new GraphicalObject(
+				Id("editor", "diagram", "diagramNode", QString::number(diagram)), Id::rootId(), Id::rootId());
+		objects << diagramObject;
+		for (int i = 0; i < elementsPerDiagram; ++i) {
+			const QString suffix = QString::number(diagram) + "_" + QString::number(i);
+			LogicalObject * const logicalObject = new LogicalObject(Id("editor", "diagram", "element", suffix));
+			logicalObject->setProperty("name", "element " + suffix);
+			logicalObject->setProperty("description", QString(100, 'x'));
+			objects << logicalObject;
+
+			GraphicalObject * const graphicalObject = new GraphicalObject(
+					Id("editor", "diagram", "element", "g" + suffix), diagramObject->id(), logicalObject->id());
+			graphicalObject->setProperty("position", QPointF(i, diagram));
+			graphicalObject->setProperty("name", "element " + suffix);
+			diagramObject->addChild(graphicalObject->id());
+			objects << graphicalObject;
+			if (diagram == 0) {
+				firstDiagramElements << graphicalObject->id();
+			}
+		}
+	}
+
+	mSerializer->saveToDisk(objects, QHash<QString, QVariant>());
+	qDeleteAll(objects);
+	mSerializer->setWorkingFile("saveFile.qrs");
+
+	const QVariant oldLazyLoading = SettingsManager::value("LazyProjectLoading");
+	for (const bool lazy : { false, true }) {
+		SettingsManager::setValue("LazyProjectLoading", lazy);
+		const int memoryBefore = residentMemoryKb();
+
+		QElapsedTimer timer;
+		timer.start();
+		QHash<Id, Object *> map;
+		QHash<QString, QVariant> metaInfo;
+		mSerializer->loadFromDisk(map, metaInfo);
+		for (const Id &id : firstDiagramElements) {
+			map.value(id)->property("position");
+		}
+
+		qDebug() << (lazy ? "Lazy" : "Eager") << "loading: time to first diagram" << timer.elapsed() << "ms,"
+				<< "resident memory growth" << residentMemoryKb() - memoryBefore << "kB";
+
+		EXPECT_EQ(diagramsCount * (2 * elementsPerDiagram + 1), map.size());
+		qDeleteAll(map);
+	}
+
+	SettingsManager::setValue("LazyProjectLoading", oldLazyLoading);
+}
+
+TEST_F(SerializerTest, DISABLED_propertiesMemoryBenchmark)
+{
+	const int elementsCount = 100000;
+	QList<Object *> objects;
+	for (int i = 0; i < elementsCount; ++i) {
+		LogicalObject * const object = new LogicalObject(Id("editor", "diagram", "element", QString::number(i)));
+		for (int property = 0; property < 10; ++property) {
+			object->setProperty("property" + QString::number(property), i);
+		}
+
+		object->setProperty("name", "element " + QString::number(i));
+		objects << object;
+	}
+
+	mSerializer->setFormat(Serializer::Format::xmlTree);
+	mSerializer->setWorkingFile("saveFile.qrs");
+	mSerializer->saveToDisk(objects, QHash<QString, QVariant>());
+	qDeleteAll(objects);
+
+	// XML loading creates separate strings for property names of each object, like binary loading
+	// did before property schemas were introduced.
+	int memoryBefore = residentMemoryKb();
+	QHash<Id, Object *> map;
+	QHash<QString, QVariant> metaInfo;
+	mSerializer->loadFromDisk(map, metaInfo);
+	qDebug() << "Loaded objects with shared property schemas, resident memory growth"
+			<< residentMemoryKb() - memoryBefore << "kB";
+
+	// The same properties kept in a map per object, as they were stored before.
+	memoryBefore = residentMemoryKb();
+	QList<QMap<QString, QVariant>> maps;
+	for (const Object * const object : map) {
+		QMap<QString, QVariant> copy;
+		qrRepo::PropertiesIterator iterator = object->propertiesIterator();
+		while (iterator.hasNext()) {
+			iterator.next();
+			copy.insert(QString(iterator.key().constData(), iterator.key().size()), iterator.value());
+		}
+
+		maps << copy;
+	}
+
+	qDebug() << "Properties in a map per object, resident memory growth"
+			<< residentMemoryKb() - memoryBefore << "kB";
+
+	EXPECT_EQ(elementsCount, maps.size());
+	qDeleteAll(map);
+}
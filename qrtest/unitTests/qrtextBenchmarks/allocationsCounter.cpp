@@ -0,0 +1,32 @@
+#include "allocationsCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<qint64> allocations(0);
+
+}
+
+void *operator new(size_t size)
+{
+	++allocations;
+	void * const result = std::malloc(size > 0 ? size : 1);
+	if (!result) {
+		throw std::bad_alloc();
+	}
+
+	return result;
+}
+
+void operator delete(void *pointer) noexcept
+{
+	std::free(pointer);
+}
+
+qint64 qrTest::allocationsCount()
+{
+	return allocations;
+}
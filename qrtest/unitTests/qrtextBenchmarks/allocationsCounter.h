@@ -0,0 +1,11 @@
+#pragma once
+
+#include <QtCore/QtGlobal>
+
+namespace qrTest {
+
+/// Returns the number of heap allocations made by benchmarks process so far. Counted by global operator new
+/// replaced in this binary.
+qint64 allocationsCount();
+
+}
@@ -0,0 +1,79 @@
+#include "luaInterpreterBenchmark.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+
+#include "gtest/gtest.h"
+
+#include "qrtext/lua/types/function.h"
+#include "qrtext/lua/types/integer.h"
+
+#include "allocationsCounter.h"
+
+using namespace qrTest;
+using namespace qrtext;
+using namespace qrtext::lua;
+using namespace qrtext::lua::details;
+
+void LuaInterpreterBenchmark::SetUp()
+{
+	mAnalyzer.reset(new LuaSemanticAnalyzer(mErrors));
+	mParser.reset(new LuaParser(mErrors));
+	mLexer.reset(new LuaLexer(mErrors));
+	mInterpreter.reset(new LuaInterpreter(mErrors));
+}
+
+QSharedPointer<qrtext::core::ast::Node> LuaInterpreterBenchmark::parseAndAnalyze(const QString &code)
+{
+	return mAnalyzer->analyze(mParser->parse(mLexer->tokenize(code), mLexer->userFriendlyTokenNames()));
+}
+
+TEST_F(LuaInterpreterBenchmark, DISABLED_evaluationBenchmark)
+{
+	mAnalyzer->addIntrinsicFunction("sensor", QSharedPointer<types::Function>(new types::Function(
+			QSharedPointer<core::types::TypeExpression>(new types::Integer()),
+			{QSharedPointer<core::types::TypeExpression>(new types::Integer())}
+			)));
+
+	mInterpreter->addIntrinsicFunction("sensor", [](QList<QVariant> params) {
+			return params[0].toInt() * 10;
+			});
+
+	interpret<int>("speed = 0.0; distance = 0; values = {0, 0, 0, 0}; a = {239}");
+
+	// Sensor polling loop body and expressions from the tests above.
+	const QStringList scenarios = {
+			"distance = sensor(1) + sensor(2) * 2; "
+					"speed = (distance - 30) * 0.5 + speed / 2; "
+					"values[distance % 4] = distance; "
+					"speed > 0 and distance < 100 or speed == -1"
+			, "5.2 + 2.4 * 6 - 5 / 2"
+			, "5 // 2 + 5 % 2 + (2 & 3) + (6 | 3) + (1 << 3) + (6 >> 1) + ~2"
+			, "1 < 2 and 1 <= 2 or 1 > 2 and 1 >= 2"
+			, "1 ~= 2 and 'asd' == 'asd'"
+			, "'ab' .. 'cd'"
+			, "not false and -(1.5) < 0"
+			, "a[0] + #'asdf'"
+			};
+
+	QList<QSharedPointer<qrtext::core::ast::Node>> trees;
+	for (const QString &scenario : scenarios) {
+		trees << parseAndAnalyze(scenario);
+	}
+
+	ASSERT_TRUE(mErrors.isEmpty());
+
+	const int evaluations = 1000000;
+	const qint64 allocationsBefore = allocationsCount();
+	QElapsedTimer timer;
+	timer.start();
+	for (int i = 0; i < evaluations; ++i) {
+		mInterpreter->interpret(trees[i % trees.size()], *mAnalyzer);
+	}
+
+	const qint64 elapsed = qMax<qint64>(1, timer.elapsed());
+	const qint64 allocations = allocationsCount() - allocationsBefore;
+	ASSERT_TRUE(mErrors.isEmpty());
+	qDebug() << "Evaluations per second:" << evaluations * 1000 / elapsed;
+	qDebug() << "Heap allocations per evaluation:" << static_cast<qreal>(allocations) / evaluations;
+}
@@ -0,0 +1,21 @@
+# Benchmarks of text languages toolbox. They are built into a separate binary since they replace global
+# operator new to count heap allocations, that must not affect ordinary tests.
+# Run with --gtest_also_run_disabled_tests.
+
+TARGET = qrtext_benchmarks
+
+include(../common.pri)
+
+include(../../../qrtext/qrtext.pri)
+
+links(qslog)
+
+INCLUDEPATH += ../../../qrtext/include
+
+HEADERS += \
+	allocationsCounter.h \
+	luaInterpreterBenchmark.h \
+
+SOURCES += \
+	allocationsCounter.cpp \
+	luaInterpreterBenchmark.cpp \
@@ -400,3 +400,47 @@ TEST_F(LuaInterpreterTest, operatorsTest)
 	ASSERT_TRUE(mErrors.isEmpty());
 	EXPECT_EQ(4, intResult);
 }
+
+TEST_F(LuaInterpreterTest, repeatedInterpretation)
+{
+	interpret<int>("a = 0; t = {}");
+	const auto ast = parseAndAnalyze("a = a + 1; t[a] = a * 2");
+	ASSERT_TRUE(mErrors.isEmpty());
+
+	for (int i = 1; i <= 10; ++i) {
+		mInterpreter->interpret(ast, *mAnalyzer);
+		ASSERT_TRUE(mErrors.isEmpty());
+		EXPECT_EQ(i, mInterpreter->value("a").toInt());
+		EXPECT_EQ(QString::number(i * 2), mInterpreter->value("t").toStringList()[i]);
+	}
+
+	mInterpreter->clear();
+	EXPECT_TRUE(mInterpreter->identifiers().isEmpty());
+	mInterpreter->setVariableValue("a", 41);
+	mInterpreter->interpret(ast, *mAnalyzer);
+	EXPECT_EQ(42, mInterpreter->value("a").toInt());
+	EXPECT_EQ("84", mInterpreter->value("t").toStringList()[42]);
+}
+
+TEST_F(LuaInterpreterTest, assignedValueIsEvaluatedOnce)
+{
+	mAnalyzer->addIntrinsicFunction("f", QSharedPointer<types::Function>(new types::Function(
+			QSharedPointer<core::types::TypeExpression>(new types::Integer()),
+			{}
+			)));
+
+	int calls = 0;
+	mInterpreter->addIntrinsicFunction("f", [&calls](QList<QVariant> params) {
+			Q_UNUSED(params)
+			return ++calls;
+			});
+
+	interpret<int>("a = {}; a[1] = f()");
+	ASSERT_TRUE(mErrors.isEmpty());
+	EXPECT_EQ(1, calls);
+
+	const bool result = interpret<bool>("false and f()");
+	ASSERT_TRUE(mErrors.isEmpty());
+	EXPECT_FALSE(result);
+	EXPECT_EQ(1, calls);
+}
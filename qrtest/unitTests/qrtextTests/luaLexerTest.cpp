@@ -1,7 +1,12 @@
 #include "luaLexerTest.h"
 
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+
 #include "gtest/gtest.h"
 
+#include "qrtext/core/lexer/tokenAutomaton.h"
+
 using namespace qrtext::lua::details;
 using namespace qrtext::core;
 using namespace qrTest;
@@ -349,3 +354,65 @@ TEST_F(LuaLexerTest, comments)
 	EXPECT_EQ(Connection(57, 3, 0), comments[2].range().start());
 	EXPECT_EQ(Connection(58, 3, 1), comments[2].range().end());
 }
+
+TEST_F(LuaLexerTest, automatonMatchesRegexps)
+{
+	const QStringList patterns = {
+			R"(("[^"\\]*(\\(.|\n)[^"\\]*)*"))"
+			, "(0[xX][0-9a-fA-F]+)|([0-9]+)"
+			, "[0-9]+((\\.[0-9]+)[eE](([+-][0-9]+)|([0-9]*))|(\\.[0-9]+)|([eE](([+-][0-9]+)|([0-9]*))))"
+			, R"([\p{L}_][\p{L}0-9_]*)"
+			, "--.*"
+			, "\\.\\.?"
+			};
+
+	const QStringList inputs = {"\"a\\\"b\"c", "\"a\\\nb\"", "\"abc", "0x1F", "0xz", "314.16e-2", "1e+", "1.5"
+			, "_идентификатор1 x", "-- comment\nx", "...", "--", "?"};
+
+	TokenAutomaton automaton(patterns);
+	ASSERT_TRUE(automaton.isValid());
+
+	for (const QString &input : inputs) {
+		int expectedLength = 0;
+		int expectedPattern = -1;
+		for (int i = 0; i < patterns.size(); ++i) {
+			const auto match = QRegularExpression(patterns[i]).match(input, 0, QRegularExpression::NormalMatch
+					, QRegularExpression::AnchoredMatchOption);
+			if (match.capturedLength() > expectedLength) {
+				expectedLength = match.capturedLength();
+				expectedPattern = i;
+			}
+		}
+
+		int pattern = -1;
+		EXPECT_EQ(expectedLength, automaton.match(input, 0, pattern)) << input.toStdString();
+		EXPECT_EQ(expectedPattern, pattern) << input.toStdString();
+	}
+
+	EXPECT_FALSE(TokenAutomaton({"a{2}"}).isValid());
+	EXPECT_FALSE(TokenAutomaton({"a*?"}).isValid());
+	EXPECT_FALSE(TokenAutomaton({"^a"}).isValid());
+}
+
+TEST_F(LuaLexerTest, DISABLED_throughputBenchmark)
+{
+	const QString line = "x = 0x1F + sensor(1) * 2.5e-1 -- reading\n"
+			"if x >= 10 and not done then message = 'distance: ' .. x end\n";
+
+	QString input;
+	while (input.size() < 1024 * 1024) {
+		input += line;
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+	const auto result = mLexer->tokenize(input);
+	const qint64 elapsed = qMax<qint64>(1, timer.elapsed());
+
+	ASSERT_TRUE(mErrors.isEmpty());
+	ASSERT_FALSE(result.isEmpty());
+
+	// Input is measured in bytes of its UTF-16 representation.
+	const qreal megabytes = input.size() * sizeof(QChar) / (1024.0 * 1024.0);
+	qDebug() << "Lexer throughput, MB/s:" << megabytes * 1000 / elapsed;
+}
@@ -0,0 +1,171 @@
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QDebug>
+
+#include "../../../../qrutils/graphUtils/subgraphMatcher.h"
+
+#include "gtest/gtest.h"
+
+using namespace utils;
+
+namespace {
+
+/// Returns number of matches left in matcher.
+int matchesCount(SubgraphMatcher &matcher)
+{
+	int result = 0;
+	while (matcher.next()) {
+		++result;
+	}
+
+	return result;
+}
+
+/// Returns pattern of given number of nodes of given type connected into directed chain.
+SubgraphMatcher::Graph chain(int length, int nodeType, int linkType)
+{
+	SubgraphMatcher::Graph result;
+	for (int i = 0; i < length; ++i) {
+		result.addNode(nodeType);
+		if (i > 0) {
+			result.addLink(i - 1, i, linkType);
+		}
+	}
+
+	return result;
+}
+
+}
+
+TEST(SubgraphMatcherTest, directedCycleTest)
+{
+	SubgraphMatcher::Graph host = chain(3, 0, 0);
+	host.addLink(2, 0, 0);
+	host.addNode(0);
+	host.addLink(1, 3, 0);
+
+	SubgraphMatcher::Graph pattern = chain(3, 0, 0);
+	const int closingLink = pattern.addLink(2, 0, 0);
+
+	SubgraphMatcher matcher(pattern, host, 0);
+	int matches = 0;
+	while (matcher.next()) {
+		++matches;
+		const QVector<int> &nodes = matcher.nodeMatch();
+		EXPECT_NE(3, nodes[0]);
+		EXPECT_NE(3, nodes[1]);
+		EXPECT_NE(3, nodes[2]);
+		const int hostLink = matcher.linkMatch()[closingLink];
+		EXPECT_EQ(nodes[2], host.from(hostLink));
+		EXPECT_EQ(nodes[0], host.to(hostLink));
+	}
+
+	EXPECT_EQ(3, matches);
+	EXPECT_FALSE(matcher.next());
+}
+
+TEST(SubgraphMatcherTest, typesAndDirectionsTest)
+{
+	SubgraphMatcher::Graph host;
+	host.addNode(0);
+	host.addNode(1);
+	host.addNode(1);
+	host.addLink(0, 1, 0);
+	host.addLink(2, 0, 0);
+	host.addLink(0, 2, 1);
+
+	SubgraphMatcher::Graph pattern = chain(2, 0, 0);
+	SubgraphMatcher typed(pattern, host, 0);
+	EXPECT_EQ(0, matchesCount(typed));
+
+	SubgraphMatcher::Graph anyTarget;
+	anyTarget.addNode(0);
+	anyTarget.addNode(SubgraphMatcher::anyType);
+	anyTarget.addLink(0, 1, 0);
+	SubgraphMatcher wildcard(anyTarget, host, 1);
+	ASSERT_TRUE(wildcard.next());
+	EXPECT_EQ(1, wildcard.nodeMatch()[1]);
+	EXPECT_FALSE(wildcard.next());
+
+	SubgraphMatcher::Graph anyLink;
+	anyLink.addNode(0);
+	anyLink.addNode(1);
+	anyLink.addLink(0, 1, SubgraphMatcher::anyType);
+	SubgraphMatcher untypedLink(anyLink, host, 0);
+	EXPECT_EQ(2, matchesCount(untypedLink));
+
+	SubgraphMatcher filtered(anyLink, host, 0, [](int, int hostNode) { return hostNode != 2; });
+	EXPECT_EQ(1, matchesCount(filtered));
+}
+
+TEST(SubgraphMatcherTest, startCandidatesTest)
+{
+	const SubgraphMatcher::Graph host = chain(10, 0, 0);
+	const SubgraphMatcher::Graph pattern = chain(3, 0, 0);
+
+	SubgraphMatcher unrestricted(pattern, host, 0);
+	EXPECT_EQ(8, matchesCount(unrestricted));
+
+	SubgraphMatcher restricted(pattern, host, 1);
+	restricted.setStartCandidates({ 0, 5, 5, 9 });
+	ASSERT_TRUE(restricted.next());
+	EXPECT_EQ(QVector<int>({ 4, 5, 6 }), restricted.nodeMatch());
+	EXPECT_FALSE(restricted.next());
+}
+
+TEST(SubgraphMatcherTest, DISABLED_largeGraphBenchmark)
+{
+	const int nodesCount = 10000;
+	const int linksPerNode = 2;
+	const int nodeTypes = 4;
+	const int linkTypes = 2;
+
+	// Deterministic pseudo-random sparse graph, similar to a big diagram with a few kinds of blocks and links.
+	SubgraphMatcher::Graph host;
+	uint seed = 1;
+	const auto nextRandom = [&seed](int bound) {
+		seed = seed * 1103515245 + 12345;
+		return static_cast<int>((seed >> 16) % bound);
+	};
+
+	for (int i = 0; i < nodesCount; ++i) {
+		host.addNode(nextRandom(nodeTypes));
+	}
+
+	for (int i = 0; i < nodesCount * linksPerNode; ++i) {
+		host.addLink(nextRandom(nodesCount), nextRandom(nodesCount), nextRandom(linkTypes));
+	}
+
+	SubgraphMatcher::Graph star;
+	star.addNode(0);
+	for (int i = 1; i <= 3; ++i) {
+		star.addNode(i);
+		star.addLink(0, i, 0);
+	}
+
+	SubgraphMatcher::Graph diamond;
+	for (int i = 0; i < 4; ++i) {
+		diamond.addNode(SubgraphMatcher::anyType);
+	}
+
+	diamond.addLink(0, 1, 0);
+	diamond.addLink(0, 2, 1);
+	diamond.addLink(1, 3, SubgraphMatcher::anyType);
+	diamond.addLink(2, 3, SubgraphMatcher::anyType);
+
+	const QList<QPair<QString, SubgraphMatcher::Graph>> rules = {
+		qMakePair(QString("chain of 5"), chain(5, 1, 0))
+		, qMakePair(QString("star of 4"), star)
+		, qMakePair(QString("untyped diamond"), diamond)
+	};
+
+	for (const auto &rule : rules) {
+		QElapsedTimer timer;
+		timer.start();
+		SubgraphMatcher matcher(rule.second, host, 0);
+		const bool found = matcher.next();
+		const qint64 firstMatchTime = timer.elapsed();
+		const int matches = found ? 1 + matchesCount(matcher) : 0;
+		qDebug() << rule.first << "in graph of" << nodesCount << "nodes:" << matches << "matches, ms: first match"
+				<< firstMatchTime << "all matches" << timer.elapsed();
+	}
+}
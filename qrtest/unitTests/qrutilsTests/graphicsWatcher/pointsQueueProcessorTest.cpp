@@ -0,0 +1,94 @@
+#include "../../../../qrutils/graphicsWatcher/pointsQueueProcessor.h"
+
+#include "gtest/gtest.h"
+
+using namespace utils::sensorsGraph;
+
+TEST(PointsQueueProcessorTest, valuesInOneFrameTest)
+{
+	PointsQueueProcessor processor(100, -10);
+	QVector<QLineF> lines;
+
+	processor.makeShiftLeft(2);
+	processor.plotLines(lines);
+	EXPECT_TRUE(lines.isEmpty());
+
+	processor.addNewValue(1);
+	processor.addNewValue(5);
+	processor.addNewValue(3);
+	processor.plotLines(lines);
+	ASSERT_EQ(1, lines.size());
+	EXPECT_EQ(QLineF(0, processor.absoluteValueToPoint(1), 0, processor.absoluteValueToPoint(5)), lines[0]);
+
+	processor.makeShiftLeft(2);
+	processor.addNewValue(4);
+	processor.plotLines(lines);
+	ASSERT_EQ(2, lines.size());
+	EXPECT_EQ(QLineF(-2, processor.absoluteValueToPoint(1), -2, processor.absoluteValueToPoint(5)), lines[0]);
+	EXPECT_EQ(QLineF(-2, processor.absoluteValueToPoint(3), 0, processor.absoluteValueToPoint(4)), lines[1]);
+	EXPECT_DOUBLE_EQ(4, processor.latestValue());
+}
+
+TEST(PointsQueueProcessorTest, ringBufferTest)
+{
+	// Columns at x = 0, -2, ..., -10 fit into the view.
+	PointsQueueProcessor processor(100, -10);
+	for (int i = 0; i < 100; ++i) {
+		processor.addNewValue(i);
+		processor.makeShiftLeft(2);
+	}
+
+	QVector<QLineF> lines;
+	processor.plotLines(lines);
+	ASSERT_EQ(5, lines.size());
+	EXPECT_DOUBLE_EQ(-10, lines.first().x1());
+	EXPECT_EQ(QPointF(0, processor.absoluteValueToPoint(99)), lines.last().p2());
+
+	processor.checkPeaks();
+	EXPECT_DOUBLE_EQ(95, processor.minLimit());
+	EXPECT_DOUBLE_EQ(99, processor.maxLimit());
+
+	const QPointF pivot = processor.pointOfVerticalIntersection(QPointF(-5.2, 0));
+	EXPECT_DOUBLE_EQ(-6, pivot.x());
+	EXPECT_NEAR(97, processor.pointToAbsoluteValue(pivot.y()), 1e-9);
+
+	processor.setViewParams(100, -4);
+	processor.plotLines(lines);
+	EXPECT_EQ(2, lines.size());
+}
+
+TEST(PointsQueueProcessorTest, resizeBufferTest)
+{
+	PointsQueueProcessor processor(100, -10);
+	for (int i = 0; i < 4; ++i) {
+		processor.addNewValue(i);
+		processor.makeShiftLeft(2);
+	}
+
+	processor.addNewValue(4);
+
+	// Wider view keeps all columns.
+	processor.setViewParams(100, -20);
+	QVector<QLineF> lines;
+	processor.plotLines(lines);
+	ASSERT_EQ(4, lines.size());
+	EXPECT_EQ(QPointF(-8, processor.absoluteValueToPoint(0)), lines.first().p1());
+	EXPECT_EQ(QPointF(0, processor.absoluteValueToPoint(4)), lines.last().p2());
+
+	// Larger step makes columns wider, they still fit.
+	processor.makeShiftLeft(4);
+	processor.addNewValue(5);
+	processor.plotLines(lines);
+	ASSERT_EQ(5, lines.size());
+	EXPECT_EQ(QPointF(-20, processor.absoluteValueToPoint(0)), lines.first().p1());
+	EXPECT_EQ(QPointF(0, processor.absoluteValueToPoint(5)), lines.last().p2());
+
+	// Only three columns fit with even larger step, the newest ones are kept.
+	processor.makeShiftLeft(10);
+	processor.plotLines(lines);
+	ASSERT_EQ(2, lines.size());
+	EXPECT_EQ(QPointF(-20, processor.absoluteValueToPoint(4)), lines.first().p1());
+	EXPECT_EQ(QPointF(-10, processor.absoluteValueToPoint(5)), lines.first().p2());
+	EXPECT_EQ(QPointF(0, processor.absoluteValueToPoint(5)), lines.last().p2());
+	EXPECT_DOUBLE_EQ(5, processor.latestValue());
+}
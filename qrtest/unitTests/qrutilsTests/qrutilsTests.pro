@@ -19,3 +19,5 @@ SOURCES += \
 	inFileTest.cpp \
 	outFileTest.cpp \
 	xmlUtilsTest.cpp \
+	graphUtils/subgraphMatcherTest.cpp \
+	graphicsWatcher/pointsQueueProcessorTest.cpp \
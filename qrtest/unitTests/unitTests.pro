@@ -8,3 +8,4 @@ SUBDIRS = \
 	qrrepoTests \
 	qrutilsTests \
 	qrtextTests \
+	qrtextBenchmarks \
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtCore/QString>
 #include <QtCore/QSet>
 
 #include "qrtext/core/lexer/token.h"
 #include "qrtext/core/error.h"
+#include "qrtext/core/lexer/tokenAutomaton.h"
 #include "qrtext/core/lexer/tokenPatterns.h"
 
 namespace qrtext {
@@ -20,8 +22,9 @@ namespace core {
 /// and newlines to output token stream, but does use them for connection and error recovery, so it is recommended to
 /// not fiddle with them much.
 /// In case of error skips symbols until next whitespace or newline and reports error.
-/// Can be quite slow due to use of regexp matching with every regexp in patterns list, so do not use this lexer
-/// on really large files.
+/// Patterns are compiled into one TokenAutomaton, so input is scanned once, with longest match among all patterns
+/// chosen. If some pattern uses regexp syntax that automaton does not support, lexer falls back to matching
+/// every regexp at every position, which is much slower.
 ///
 /// It is parameterized by TokenType --- enum class with all token types of a language. Token types may be arbitrary,
 /// but shall always contain TokenType::whitespace, TokenType::newline, TokenType::comment, TokenType::string,
@@ -39,9 +42,17 @@ public:
 	{
 		// Doing syntax check of lexeme regexps and searching for whitespace and newline definitions, they will be
 		// needed later for error recovery.
+		QStringList automatonPatterns;
+		bool automatonSupportsPatterns = true;
 		for (const TokenType tokenType : mPatterns.allPatterns()) {
 			const QRegularExpression &regExp = mPatterns.tokenPattern(tokenType);
+			mTokenTypes << tokenType;
+			automatonPatterns << regExp.pattern();
+			automatonSupportsPatterns = automatonSupportsPatterns
+					&& regExp.patternOptions() == QRegularExpression::NoPatternOption;
+
 			if (!regExp.isValid()) {
+				automatonSupportsPatterns = false;
 				qDebug() << "Invalid regexp: " + regExp.pattern();
 				mErrors << Error(Connection(), QObject::tr("Invalid regexp: ") + regExp.pattern()
 						, ErrorType::lexicalError, Severity::internalError);
@@ -53,6 +64,14 @@ public:
 				}
 			}
 		}
+
+		if (automatonSupportsPatterns) {
+			mAutomaton = TokenAutomaton(automatonPatterns);
+		}
+
+		for (const TokenType keyword : mPatterns.allKeywords()) {
+			mKeywords.insert(mPatterns.keywordPattern(keyword), keyword);
+		}
 	}
 
 	/// Tokenizes input string, returns list of detected tokens, list of errors and separate list of comments.
@@ -71,19 +90,21 @@ public:
 		while (absolutePosition < input.length()) {
 			CandidateMatch bestMatch = findBestMatch(input, absolutePosition);
 
-			if (bestMatch.match.hasMatch()) {
+			if (bestMatch.length > 0) {
 				int tokenEndLine = line;
 				int tokenEndColumn = column;
+				const int absoluteTokenEnd = absolutePosition + bestMatch.length - 1;
 
 				if (bestMatch.candidate != TokenType::whitespace
 						&& bestMatch.candidate != TokenType::newline
 						&& bestMatch.candidate != TokenType::comment)
 				{
+					const QString lexeme = input.mid(absolutePosition, bestMatch.length);
+
 					// Determining connection of the lexeme. String is the only token that can span multiple lines so
 					// special care is needed to maintain connection.
 					if (bestMatch.candidate == TokenType::string) {
-						QRegularExpressionMatchIterator matchIterator = mNewLineRegexp.globalMatch(
-								bestMatch.match.captured());
+						QRegularExpressionMatchIterator matchIterator = mNewLineRegexp.globalMatch(lexeme);
 
 						QRegularExpressionMatch match;
 
@@ -95,34 +116,31 @@ public:
 						if (match.hasMatch()) {
 							const int relativeLastNewLineOffset = match.capturedEnd() - 1;
 							const int absoluteLastNewLineOffset = absolutePosition + relativeLastNewLineOffset;
-							const int absoluteTokenEnd = bestMatch.match.capturedEnd() - 1;
 							tokenEndColumn = absoluteTokenEnd - absoluteLastNewLineOffset - 1;
 						} else {
-							tokenEndColumn += bestMatch.match.capturedLength() - 1;
+							tokenEndColumn += bestMatch.length - 1;
 						}
 					} else {
-						tokenEndColumn += bestMatch.match.capturedLength() - 1;
+						tokenEndColumn += bestMatch.length - 1;
 					}
 
-					const Range range(Connection(bestMatch.match.capturedStart(), line, column)
-							, Connection(bestMatch.match.capturedEnd() - 1, tokenEndLine, tokenEndColumn));
+					const Range range(Connection(absolutePosition, line, column)
+							, Connection(absoluteTokenEnd, tokenEndLine, tokenEndColumn));
 
 					if (bestMatch.candidate == TokenType::identifier) {
 						// Keyword is an identifier which is separate lexeme.
-						bestMatch.candidate = checkForKeyword(bestMatch.match.captured());
+						bestMatch.candidate = mKeywords.value(lexeme, TokenType::identifier);
 					}
 
-					result << Token<TokenType>(bestMatch.candidate
-							, range
-							, bestMatch.match.captured());
+					result << Token<TokenType>(bestMatch.candidate, range, lexeme);
 				} else if (bestMatch.candidate == TokenType::comment) {
-					tokenEndColumn += bestMatch.match.capturedLength() - 1;
-					const Range range(Connection(bestMatch.match.capturedStart(), line, column)
-							, Connection(bestMatch.match.capturedEnd() - 1, tokenEndLine, tokenEndColumn));
+					tokenEndColumn += bestMatch.length - 1;
+					const Range range(Connection(absolutePosition, line, column)
+							, Connection(absoluteTokenEnd, tokenEndLine, tokenEndColumn));
 
 					mComments << Token<TokenType>(bestMatch.candidate
 							, range
-							, bestMatch.match.captured());
+							, input.mid(absolutePosition, bestMatch.length));
 				}
 
 				// Keeping connection updated.
@@ -130,13 +148,13 @@ public:
 					++line;
 					column = 0;
 				} else if (bestMatch.candidate == TokenType::whitespace || bestMatch.candidate == TokenType::comment) {
-					column += bestMatch.match.capturedLength();
+					column += bestMatch.length;
 				} else {
 					line = tokenEndLine;
 					column = tokenEndColumn + 1;
 				}
 
-				absolutePosition += bestMatch.match.capturedLength();
+				absolutePosition += bestMatch.length;
 			} else {
 				const auto errorConnection = Connection(absolutePosition, line, column);
 				QString skippedSymbols;
@@ -178,26 +196,23 @@ public:
 private:
 	struct CandidateMatch {
 		TokenType candidate;
-		QRegularExpressionMatch match;
+
+		/// Length of matched lexeme, 0 if there is no match.
+		int length;
 	};
 
-	TokenType checkForKeyword(const QString &identifier) const
+	CandidateMatch findBestMatch(const QString &input, const int absolutePosition) const
 	{
-		for (const TokenType keyword : mPatterns.allKeywords()) {
-			if (mPatterns.keywordPattern(keyword) == identifier) {
-				return keyword;
-			}
+		if (mAutomaton.isValid()) {
+			int pattern = -1;
+			const int length = mAutomaton.match(input, absolutePosition, pattern);
+			return CandidateMatch{pattern >= 0 ? mTokenTypes[pattern] : TokenType::whitespace, length};
 		}
 
-		return TokenType::identifier;
-	}
-
-	CandidateMatch findBestMatch(const QString &input, const int absolutePosition) const
-	{
 		TokenType candidate = TokenType::whitespace;
-		QRegularExpressionMatch bestMatch;
+		int bestLength = 0;
 
-		for (const TokenType token : mPatterns.allPatterns()) {
+		for (const TokenType token : mTokenTypes) {
 			const QRegularExpression &regExp = mPatterns.tokenPattern(token);
 
 			const QRegularExpressionMatch &match = regExp.match(
@@ -207,18 +222,23 @@ private:
 					, QRegularExpression::AnchoredMatchOption);
 
 			if (match.hasMatch()) {
-				if (match.capturedLength() > bestMatch.capturedLength()) {
-					bestMatch = match;
+				if (match.capturedLength() > bestLength) {
+					bestLength = match.capturedLength();
 					candidate = token;
 				}
 			}
 		}
 
-		return CandidateMatch{candidate, bestMatch};
+		return CandidateMatch{candidate, bestLength};
 	}
 
 	TokenPatterns<TokenType> const mPatterns;
 
+	/// Token types in the same order as patterns in automaton.
+	QList<TokenType> mTokenTypes;
+	TokenAutomaton mAutomaton;
+	QHash<QString, TokenType> mKeywords;
+
 	QRegularExpression mWhitespaceRegexp;
 	QRegularExpression mNewLineRegexp;
 
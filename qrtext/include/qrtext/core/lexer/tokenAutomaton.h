@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "qrtext/declSpec.h"
+
+namespace qrtext {
+namespace core {
+
+/// Deterministic finite automaton that recognizes a set of token patterns at once. It is built from regular
+/// expressions by Thompson and subset constructions, so a token is recognized in one pass over input with one table
+/// lookup per symbol instead of trying every regular expression at every position.
+///
+/// Supports a subset of regular expressions syntax sufficient for token definitions: literal and escaped symbols, ".",
+/// character classes with ranges and negation, "\d", "\w", "\s", "\p{L}" and their negations, groups, alternation and
+/// greedy "*", "+" and "?" quantifiers. Automaton finds the longest match among all patterns, which is the same as
+/// what backtracking matcher finds for unambiguous token definitions. Patterns with other constructions (anchors,
+/// lazy quantifiers, counted repetitions, backreferences and so on) make automaton invalid, then a caller shall
+/// fall back to regular expressions matching.
+class QRTEXT_EXPORT TokenAutomaton
+{
+public:
+	/// Constructor of an invalid automaton.
+	TokenAutomaton();
+
+	/// Builds automaton for given patterns, match results refer to patterns by their indices in this list.
+	explicit TokenAutomaton(const QStringList &patterns);
+
+	/// Returns true if all patterns were successfully compiled.
+	bool isValid() const;
+
+	/// Finds longest nonempty prefix of input starting at given position matched by some pattern. Returns its length
+	/// or 0 if there is no such prefix, index of matched pattern is stored into "pattern", or -1 if nothing matched.
+	/// If several patterns match the longest prefix, the first of them is chosen.
+	int match(const QString &input, int position, int &pattern) const;
+
+private:
+	/// Segment of non-ASCII symbols that belong to the same character classes, except that letters and non-letters
+	/// may belong to different classes.
+	struct Interval
+	{
+		ushort from;
+		int letterClass;
+		int otherClass;
+	};
+
+	int symbolClass(QChar symbol) const;
+
+	bool mValid;
+	int mClassesCount;
+
+	/// Symbol classes of ASCII symbols.
+	QVector<int> mAsciiClasses;
+
+	/// Symbol classes of other symbols, sorted by start of an interval.
+	QVector<Interval> mIntervals;
+
+	/// Transitions table, row for each state and column for each symbol class, -1 is a dead state.
+	QVector<int> mTransitions;
+
+	/// Index of pattern accepted in each state or -1 for non-accepting states.
+	QVector<int> mAcceptedPatterns;
+};
+
+}
+}
@@ -12,6 +12,7 @@ HEADERS += \
 	$$PWD/include/qrtext/core/ast/unaryOperator.h \
 	$$PWD/include/qrtext/core/lexer/lexer.h \
 	$$PWD/include/qrtext/core/lexer/token.h \
+	$$PWD/include/qrtext/core/lexer/tokenAutomaton.h \
 	$$PWD/include/qrtext/core/lexer/tokenPatterns.h \
 	$$PWD/include/qrtext/core/parser/parser.h \
 	$$PWD/include/qrtext/core/parser/parserContext.h \
@@ -94,6 +95,8 @@ HEADERS += \
 	$$PWD/include/qrtext/lua/types/number.h \
 	$$PWD/include/qrtext/lua/types/string.h \
 	$$PWD/include/qrtext/lua/types/table.h \
+	$$PWD/src/lua/luaBytecode.h \
+	$$PWD/src/lua/luaCompiler.h \
 	$$PWD/src/lua/luaGeneralizationsTable.h \
 	$$PWD/src/lua/luaInterpreter.h \
 	$$PWD/src/lua/luaLexer.h \
@@ -101,14 +104,17 @@ HEADERS += \
 	$$PWD/src/lua/luaPrecedenceTable.h \
 	$$PWD/src/lua/luaSemanticAnalyzer.h \
 	$$PWD/src/lua/luaTokenTypes.h \
+	$$PWD/src/lua/luaValue.h \
 
 SOURCES += \
 	$$PWD/src/core/connection.cpp \
 	$$PWD/src/core/error.cpp \
 	$$PWD/src/core/range.cpp \
 	$$PWD/src/core/ast/node.cpp \
+	$$PWD/src/core/lexer/tokenAutomaton.cpp \
 	$$PWD/src/core/semantics/semanticAnalyzer.cpp \
 	$$PWD/src/core/types/typeVariable.cpp \
+	$$PWD/src/lua/luaCompiler.cpp \
 	$$PWD/src/lua/luaGeneralizationsTable.cpp \
 	$$PWD/src/lua/luaInterpreter.cpp \
 	$$PWD/src/lua/luaLexer.cpp \
@@ -116,6 +122,7 @@ SOURCES += \
 	$$PWD/src/lua/luaPrecedenceTable.cpp \
 	$$PWD/src/lua/luaSemanticAnalyzer.cpp \
 	$$PWD/src/lua/luaToolbox.cpp \
+	$$PWD/src/lua/luaValue.cpp \
 
 TRANSLATIONS = $$PWD/../qrtranslations/ru/qrtext_ru.ts
 
@@ -0,0 +1,579 @@
+#include "qrtext/core/lexer/tokenAutomaton.h"
+
+#include <algorithm>
+
+#include <QtCore/QHash>
+#include <QtCore/QPair>
+#include <QtCore/QRegularExpression>
+
+using namespace qrtext::core;
+
+/// Maximal number of automaton states, patterns that need more are matched by regular expressions.
+const int maxStatesCount = 4096;
+
+namespace {
+
+/// Set of symbols matched by one item of a regular expression.
+struct SymbolSet
+{
+	QVector<QPair<ushort, ushort>> ranges;
+	bool letters = false;
+	bool negated = false;
+
+	bool contains(ushort symbol, bool isLetter) const
+	{
+		bool result = letters && isLetter;
+		for (const auto &range : ranges) {
+			result = result || (symbol >= range.first && symbol <= range.second);
+		}
+
+		return result != negated;
+	}
+};
+
+/// Nondeterministic automaton, each state has at most one transition by symbol.
+struct Nfa
+{
+	struct State
+	{
+		QVector<int> epsilonTransitions;
+		int symbolSet = -1;
+		int target = -1;
+		int acceptedPattern = -1;
+	};
+
+	/// Part of automaton built for a part of a regular expression.
+	struct Fragment
+	{
+		int start;
+		int end;
+	};
+
+	int addState()
+	{
+		states << State();
+		return states.size() - 1;
+	}
+
+	Fragment symbol(const SymbolSet &set)
+	{
+		const Fragment result{addState(), addState()};
+		symbolSets << set;
+		states[result.start].symbolSet = symbolSets.size() - 1;
+		states[result.start].target = result.end;
+		return result;
+	}
+
+	Fragment empty()
+	{
+		const Fragment result{addState(), addState()};
+		states[result.start].epsilonTransitions << result.end;
+		return result;
+	}
+
+	Fragment concatenation(const Fragment &first, const Fragment &second)
+	{
+		states[first.end].epsilonTransitions << second.start;
+		return Fragment{first.start, second.end};
+	}
+
+	Fragment alternative(const Fragment &first, const Fragment &second)
+	{
+		const Fragment result{addState(), addState()};
+		states[result.start].epsilonTransitions << first.start << second.start;
+		states[first.end].epsilonTransitions << result.end;
+		states[second.end].epsilonTransitions << result.end;
+		return result;
+	}
+
+	Fragment repetition(const Fragment &fragment, bool allowNone, bool allowMany)
+	{
+		const Fragment result{addState(), addState()};
+		states[result.start].epsilonTransitions << fragment.start;
+		if (allowNone) {
+			states[result.start].epsilonTransitions << result.end;
+		}
+
+		if (allowMany) {
+			states[fragment.end].epsilonTransitions << fragment.start;
+		}
+
+		states[fragment.end].epsilonTransitions << result.end;
+		return result;
+	}
+
+	QVector<State> states;
+	QVector<SymbolSet> symbolSets;
+};
+
+/// Recursive descent parser of supported subset of regular expressions syntax, builds nondeterministic automaton.
+class RegexpParser
+{
+public:
+	RegexpParser(const QString &pattern, Nfa &nfa)
+		: mPattern(pattern)
+		, mPosition(0)
+		, mNfa(nfa)
+	{
+	}
+
+	/// Parses whole pattern, returns false if it uses unsupported syntax.
+	bool parse(Nfa::Fragment &result)
+	{
+		return parseAlternative(result) && mPosition == mPattern.size();
+	}
+
+private:
+	bool atEnd() const
+	{
+		return mPosition >= mPattern.size();
+	}
+
+	QChar current() const
+	{
+		return mPattern[mPosition];
+	}
+
+	bool parseAlternative(Nfa::Fragment &result)
+	{
+		if (!parseConcatenation(result)) {
+			return false;
+		}
+
+		while (!atEnd() && current() == '|') {
+			++mPosition;
+			Nfa::Fragment alternative;
+			if (!parseConcatenation(alternative)) {
+				return false;
+			}
+
+			result = mNfa.alternative(result, alternative);
+		}
+
+		return true;
+	}
+
+	bool parseConcatenation(Nfa::Fragment &result)
+	{
+		result = mNfa.empty();
+		while (!atEnd() && current() != '|' && current() != ')') {
+			Nfa::Fragment item;
+			if (!parseRepetition(item)) {
+				return false;
+			}
+
+			result = mNfa.concatenation(result, item);
+		}
+
+		return true;
+	}
+
+	bool parseRepetition(Nfa::Fragment &result)
+	{
+		if (!parseAtom(result)) {
+			return false;
+		}
+
+		if (atEnd() || !isQuantifier(current())) {
+			return true;
+		}
+
+		const QChar quantifier = current();
+		++mPosition;
+		if (!atEnd() && (isQuantifier(current()) || isCountedRepetition())) {
+			// Lazy and possessive quantifiers and repetitions of quantified items are not supported.
+			return false;
+		}
+
+		result = mNfa.repetition(result, quantifier != '+', quantifier != '?');
+		return true;
+	}
+
+	static bool isQuantifier(QChar symbol)
+	{
+		return symbol == '*' || symbol == '+' || symbol == '?';
+	}
+
+	/// Returns true if there is "{n}", "{n,}" or "{n,m}" at current position, otherwise "{" is a literal symbol.
+	bool isCountedRepetition() const
+	{
+		static const QRegularExpression countedRepetition("\\{[0-9]+(,[0-9]*)?\\}");
+		return !atEnd() && current() == '{' && countedRepetition.match(mPattern, mPosition
+				, QRegularExpression::NormalMatch, QRegularExpression::AnchoredMatchOption).hasMatch();
+	}
+
+	bool parseAtom(Nfa::Fragment &result)
+	{
+		const QChar symbol = current();
+		if (symbol == '(') {
+			++mPosition;
+			if (!atEnd() && current() == '?') {
+				if (mPattern.mid(mPosition, 2) != "?:") {
+					return false;
+				}
+
+				mPosition += 2;
+			}
+
+			if (!parseAlternative(result) || atEnd() || current() != ')') {
+				return false;
+			}
+
+			++mPosition;
+			return true;
+		}
+
+		SymbolSet set;
+		if (symbol == '[') {
+			++mPosition;
+			if (!parseClass(set)) {
+				return false;
+			}
+		} else if (symbol == '\\') {
+			++mPosition;
+			if (!parseEscape(set, false)) {
+				return false;
+			}
+		} else if (symbol == '.') {
+			++mPosition;
+			set.ranges << qMakePair<ushort, ushort>('\n', '\n');
+			set.negated = true;
+		} else if (symbol == '^' || symbol == '$' || isQuantifier(symbol) || isCountedRepetition()) {
+			return false;
+		} else {
+			++mPosition;
+			set.ranges << qMakePair(symbol.unicode(), symbol.unicode());
+		}
+
+		result = mNfa.symbol(set);
+		return true;
+	}
+
+	/// Parses character class after opening bracket.
+	bool parseClass(SymbolSet &result)
+	{
+		if (!atEnd() && current() == '^') {
+			result.negated = true;
+			++mPosition;
+		}
+
+		bool first = true;
+		while (!atEnd() && (current() != ']' || first)) {
+			first = false;
+			ushort from = 0;
+			if (current() == '\\') {
+				++mPosition;
+				SymbolSet escaped;
+				if (!parseEscape(escaped, true)) {
+					return false;
+				}
+
+				if (escaped.ranges.size() != 1 || escaped.ranges.first().first != escaped.ranges.first().second
+						|| escaped.letters)
+				{
+					// Shorthand class like "\d" or "\p{L}", it can not be a start of a range.
+					result.ranges << escaped.ranges;
+					result.letters = result.letters || escaped.letters;
+					continue;
+				}
+
+				from = escaped.ranges.first().first;
+			} else if (current() == '[') {
+				// POSIX classes like "[:alpha:]" are not supported.
+				return false;
+			} else {
+				from = current().unicode();
+				++mPosition;
+			}
+
+			ushort to = from;
+			if (mPosition + 1 < mPattern.size() && current() == '-' && mPattern[mPosition + 1] != ']') {
+				++mPosition;
+				if (current() == '\\') {
+					++mPosition;
+					SymbolSet escaped;
+					if (!parseEscape(escaped, true) || escaped.letters || escaped.ranges.size() != 1
+							|| escaped.ranges.first().first != escaped.ranges.first().second)
+					{
+						return false;
+					}
+
+					to = escaped.ranges.first().first;
+				} else {
+					to = current().unicode();
+					++mPosition;
+				}
+
+				if (to < from) {
+					return false;
+				}
+			}
+
+			result.ranges << qMakePair(from, to);
+		}
+
+		if (atEnd()) {
+			return false;
+		}
+
+		++mPosition;
+		return true;
+	}
+
+	/// Parses escape sequence after backslash. Negated shorthand classes are not supported inside character classes.
+	bool parseEscape(SymbolSet &result, bool insideClass)
+	{
+		if (atEnd()) {
+			return false;
+		}
+
+		const QChar symbol = current();
+		++mPosition;
+
+		const QChar lowerSymbol = symbol.toLower();
+		const bool negated = symbol.isUpper();
+		if (lowerSymbol == 'd' || lowerSymbol == 'w' || lowerSymbol == 's' || lowerSymbol == 'p') {
+			if (negated && insideClass) {
+				return false;
+			}
+
+			result.negated = negated;
+		}
+
+		switch (symbol.unicode()) {
+		case 'n':
+			result.ranges << qMakePair<ushort, ushort>('\n', '\n');
+			return true;
+		case 't':
+			result.ranges << qMakePair<ushort, ushort>('\t', '\t');
+			return true;
+		case 'r':
+			result.ranges << qMakePair<ushort, ushort>('\r', '\r');
+			return true;
+		case 'f':
+			result.ranges << qMakePair<ushort, ushort>('\f', '\f');
+			return true;
+		case 'v':
+			result.ranges << qMakePair<ushort, ushort>('\v', '\v');
+			return true;
+		case 'd':
+		case 'D':
+			result.ranges << qMakePair<ushort, ushort>('0', '9');
+			return true;
+		case 'w':
+		case 'W':
+			result.ranges << qMakePair<ushort, ushort>('0', '9') << qMakePair<ushort, ushort>('a', 'z')
+					<< qMakePair<ushort, ushort>('A', 'Z') << qMakePair<ushort, ushort>('_', '_');
+			return true;
+		case 's':
+		case 'S':
+			result.ranges << qMakePair<ushort, ushort>('\t', '\r') << qMakePair<ushort, ushort>(' ', ' ');
+			return true;
+		case 'p':
+		case 'P':
+			if (mPattern.mid(mPosition, 3) != "{L}") {
+				return false;
+			}
+
+			mPosition += 3;
+			result.letters = true;
+			return true;
+		default:
+			if (symbol.isLetterOrNumber()) {
+				// Anchors, backreferences, hexadecimal codes and so on.
+				return false;
+			}
+
+			result.ranges << qMakePair(symbol.unicode(), symbol.unicode());
+			return true;
+		}
+	}
+
+	const QString &mPattern;
+	int mPosition;
+	Nfa &mNfa;
+};
+
+/// Returns sorted set of states reachable from given states by epsilon transitions.
+QVector<int> closure(const Nfa &nfa, const QVector<int> &states)
+{
+	QVector<bool> visited(nfa.states.size(), false);
+	QVector<int> stack = states;
+	QVector<int> result;
+	while (!stack.isEmpty()) {
+		const int state = stack.takeLast();
+		if (visited[state]) {
+			continue;
+		}
+
+		visited[state] = true;
+		result << state;
+		stack << nfa.states[state].epsilonTransitions;
+	}
+
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+QByteArray key(const QVector<int> &states)
+{
+	return QByteArray(reinterpret_cast<const char *>(states.constData()), states.size() * sizeof(int));
+}
+
+}
+
+TokenAutomaton::TokenAutomaton()
+	: mValid(false)
+	, mClassesCount(0)
+{
+}
+
+TokenAutomaton::TokenAutomaton(const QStringList &patterns)
+	: TokenAutomaton()
+{
+	Nfa nfa;
+	const int start = nfa.addState();
+	for (int i = 0; i < patterns.size(); ++i) {
+		Nfa::Fragment fragment;
+		if (!RegexpParser(patterns[i], nfa).parse(fragment)) {
+			return;
+		}
+
+		nfa.states[start].epsilonTransitions << fragment.start;
+		nfa.states[fragment.end].acceptedPattern = i;
+	}
+
+	// Splitting symbols into classes that are not distinguished by any pattern. Class is identified by a signature,
+	// which tells what symbol sets of automaton contain symbols of the class.
+	QHash<QByteArray, int> classes;
+	QVector<QByteArray> signatures;
+	const auto classOf = [&](ushort symbol, bool isLetter) {
+		QByteArray signature(nfa.symbolSets.size(), 0);
+		for (int i = 0; i < nfa.symbolSets.size(); ++i) {
+			signature[i] = nfa.symbolSets[i].contains(symbol, isLetter) ? 1 : 0;
+		}
+
+		if (!classes.contains(signature)) {
+			classes.insert(signature, signatures.size());
+			signatures << signature;
+		}
+
+		return classes.value(signature);
+	};
+
+	for (ushort symbol = 0; symbol < 128; ++symbol) {
+		mAsciiClasses << classOf(symbol, QChar(symbol).isLetter());
+	}
+
+	QVector<ushort> bounds = {128};
+	for (const SymbolSet &set : nfa.symbolSets) {
+		for (const auto &range : set.ranges) {
+			if (range.first >= 128) {
+				bounds << range.first;
+			}
+
+			if (range.second >= 127 && range.second < 0xFFFF) {
+				bounds << static_cast<ushort>(range.second + 1);
+			}
+		}
+	}
+
+	std::sort(bounds.begin(), bounds.end());
+	bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+	for (const ushort from : bounds) {
+		mIntervals << Interval{from, classOf(from, true), classOf(from, false)};
+	}
+
+	mClassesCount = signatures.size();
+
+	// Subset construction.
+	QVector<QVector<int>> states = {closure(nfa, {start})};
+	QHash<QByteArray, int> stateNumbers = {{key(states.first()), 0}};
+	for (int current = 0; current < states.size(); ++current) {
+		int acceptedPattern = -1;
+		for (const int nfaState : states[current]) {
+			const int pattern = nfa.states[nfaState].acceptedPattern;
+			if (pattern >= 0 && (acceptedPattern < 0 || pattern < acceptedPattern)) {
+				acceptedPattern = pattern;
+			}
+		}
+
+		mAcceptedPatterns << acceptedPattern;
+
+		for (int symbolClass = 0; symbolClass < mClassesCount; ++symbolClass) {
+			QVector<int> targets;
+			for (const int nfaState : states[current]) {
+				const Nfa::State &state = nfa.states[nfaState];
+				if (state.symbolSet >= 0 && signatures[symbolClass][state.symbolSet]) {
+					targets << state.target;
+				}
+			}
+
+			if (targets.isEmpty()) {
+				mTransitions << -1;
+				continue;
+			}
+
+			const QVector<int> target = closure(nfa, targets);
+			const QByteArray targetKey = key(target);
+			if (!stateNumbers.contains(targetKey)) {
+				if (states.size() >= maxStatesCount) {
+					mTransitions.clear();
+					mAcceptedPatterns.clear();
+					return;
+				}
+
+				stateNumbers.insert(targetKey, states.size());
+				states << target;
+			}
+
+			mTransitions << stateNumbers.value(targetKey);
+		}
+	}
+
+	mValid = true;
+}
+
+bool TokenAutomaton::isValid() const
+{
+	return mValid;
+}
+
+int TokenAutomaton::symbolClass(QChar symbol) const
+{
+	const ushort code = symbol.unicode();
+	if (code < 128) {
+		return mAsciiClasses[code];
+	}
+
+	const auto interval = std::upper_bound(mIntervals.constBegin(), mIntervals.constEnd(), code
+			, [](ushort value, const Interval &interval) { return value < interval.from; }) - 1;
+	return symbol.isLetter() ? interval->letterClass : interval->otherClass;
+}
+
+int TokenAutomaton::match(const QString &input, int position, int &pattern) const
+{
+	pattern = -1;
+	if (!mValid) {
+		return 0;
+	}
+
+	const QChar * const data = input.constData();
+	const int size = input.size();
+	const int * const transitions = mTransitions.constData();
+	int length = 0;
+	int state = 0;
+	for (int i = position; i < size; ++i) {
+		state = transitions[state * mClassesCount + symbolClass(data[i])];
+		if (state < 0) {
+			break;
+		}
+
+		if (mAcceptedPatterns[state] >= 0) {
+			pattern = mAcceptedPatterns[state];
+			length = i - position + 1;
+		}
+	}
+
+	return length;
+}
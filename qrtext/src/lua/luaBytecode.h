@@ -0,0 +1,117 @@
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
+
+#include "qrtext/core/connection.h"
+#include "qrtext/core/ast/node.h"
+
+#include "qrtext/src/lua/luaValue.h"
+
+namespace qrtext {
+namespace lua {
+namespace details {
+
+/// Operation codes of bytecode executed by LuaInterpreter. Operands are fields a, b, c and d of an instruction,
+/// in comments R(x) denotes register number x, K(x) - constant, V(x) - variable slot, F(x) - intrinsic function slot,
+/// L(x) - location in code used for error reporting.
+enum class Opcode
+{
+	/// R(a) = K(b)
+	loadConstant
+	/// R(a) = nil
+	, loadNil
+	/// R(a) = V(b)
+	, loadVariable
+	/// V(a) = R(b)
+	, storeVariable
+	/// R(a) = F(b)(R(c), ..., R(c + d - 1))
+	, call
+	/// R(a) = {}
+	, newTable
+	/// Appends R(b) to the end of table R(a).
+	, appendToTable
+	/// R(a)[R(b)] = R(c)
+	, setTableField
+	/// R(a) = V(b)[R(c)]
+	, getIndexed
+	/// V(a)[R(b)] = R(c)
+	, setIndexed
+
+	/// R(a) = op R(b)
+	, unaryMinus
+	, logicalNot
+	, length
+	, bitwiseNegation
+
+	/// R(a) = R(b) op R(c), division by zero is reported at L(d).
+	, addition
+	, subtraction
+	, multiplication
+	, division
+	, integerDivision
+	, modulo
+	, exponentiation
+	, bitwiseAnd
+	, bitwiseOr
+	, bitwiseXor
+	, bitwiseLeftShift
+	, bitwiseRightShift
+	, concatenation
+	, lessThan
+	, lessOrEqual
+	, greaterThan
+	, greaterOrEqual
+	, equality
+	, inequality
+
+	/// R(a) = R(b) converted to integer is not zero.
+	, toBoolean
+	/// Jumps to instruction b if R(a) is false.
+	, jumpIfFalse
+	/// Jumps to instruction b if R(a) is true.
+	, jumpIfTrue
+
+	/// Reports runtime error with message K(a) at L(d).
+	, error
+};
+
+/// One instruction of a bytecode.
+struct Instruction
+{
+	Opcode opcode;
+	int a;
+	int b;
+	int c;
+	int d;
+};
+
+/// Result of compilation of some Lua AST, executed by LuaInterpreter.
+struct Bytecode
+{
+	/// Type information that compiler relied on: some operations are compiled differently depending on types
+	/// of operands. Types may change when other code is analyzed, then bytecode shall be recompiled.
+	struct TypeGuard
+	{
+		QSharedPointer<core::ast::Node> node;
+		bool isNumber;
+		bool isString;
+	};
+
+	QVector<Instruction> code;
+	QVector<Value> constants;
+	QVector<core::Connection> locations;
+
+	/// Number of registers used by code. Result of execution is placed into register 0.
+	int registersCount = 0;
+
+	QList<TypeGuard> typeGuards;
+
+	/// Compiled AST, kept to make sure that nodes are not reused while bytecode is cached.
+	QSharedPointer<core::ast::Node> root;
+};
+
+}
+}
+}
@@ -0,0 +1,480 @@
+#include "qrtext/src/lua/luaCompiler.h"
+
+#include "qrtext/lua/types/number.h"
+#include "qrtext/lua/types/string.h"
+
+#include "qrtext/lua/ast/assignment.h"
+#include "qrtext/lua/ast/floatNumber.h"
+#include "qrtext/lua/ast/functionCall.h"
+#include "qrtext/lua/ast/identifier.h"
+#include "qrtext/lua/ast/integerNumber.h"
+#include "qrtext/lua/ast/string.h"
+#include "qrtext/lua/ast/true.h"
+#include "qrtext/lua/ast/false.h"
+#include "qrtext/lua/ast/nil.h"
+#include "qrtext/lua/ast/tableConstructor.h"
+#include "qrtext/lua/ast/indexingExpression.h"
+#include "qrtext/lua/ast/block.h"
+
+#include "qrtext/lua/ast/unaryMinus.h"
+#include "qrtext/lua/ast/not.h"
+#include "qrtext/lua/ast/length.h"
+#include "qrtext/lua/ast/bitwiseNegation.h"
+
+#include "qrtext/lua/ast/addition.h"
+#include "qrtext/lua/ast/subtraction.h"
+#include "qrtext/lua/ast/multiplication.h"
+#include "qrtext/lua/ast/division.h"
+#include "qrtext/lua/ast/integerDivision.h"
+#include "qrtext/lua/ast/exponentiation.h"
+#include "qrtext/lua/ast/modulo.h"
+#include "qrtext/lua/ast/bitwiseAnd.h"
+#include "qrtext/lua/ast/bitwiseXor.h"
+#include "qrtext/lua/ast/bitwiseOr.h"
+#include "qrtext/lua/ast/bitwiseRightShift.h"
+#include "qrtext/lua/ast/bitwiseLeftShift.h"
+#include "qrtext/lua/ast/concatenation.h"
+#include "qrtext/lua/ast/lessThan.h"
+#include "qrtext/lua/ast/greaterThan.h"
+#include "qrtext/lua/ast/lessOrEqual.h"
+#include "qrtext/lua/ast/greaterOrEqual.h"
+#include "qrtext/lua/ast/equality.h"
+#include "qrtext/lua/ast/inequality.h"
+#include "qrtext/lua/ast/logicalAnd.h"
+#include "qrtext/lua/ast/logicalOr.h"
+
+using namespace qrtext::lua::details;
+using namespace qrtext;
+
+LuaCompiler::LuaCompiler(const core::SemanticAnalyzer &semanticAnalyzer
+		, const std::function<int(const QString &)> &variableSlot
+		, const std::function<int(const QString &)> &functionSlot)
+	: mSemanticAnalyzer(semanticAnalyzer)
+	, mVariableSlot(variableSlot)
+	, mFunctionSlot(functionSlot)
+	, mTarget(0)
+	, mNextRegister(0)
+{
+}
+
+Bytecode LuaCompiler::compile(const QSharedPointer<core::ast::Node> &root)
+{
+	mBytecode = Bytecode();
+	mBytecode.root = root;
+	mNextRegister = 0;
+	compile(root, allocateRegister());
+
+	Bytecode result;
+	qSwap(result, mBytecode);
+	return result;
+}
+
+void LuaCompiler::compile(const QSharedPointer<core::ast::Node> &node, int target)
+{
+	const int firstFreeRegister = mNextRegister;
+	mTarget = target;
+	node->accept(*this);
+	mNextRegister = firstFreeRegister;
+}
+
+int LuaCompiler::allocateRegister()
+{
+	const int result = mNextRegister++;
+	mBytecode.registersCount = qMax(mBytecode.registersCount, mNextRegister);
+	return result;
+}
+
+int LuaCompiler::addInstruction(Opcode opcode, int a, int b, int c, int d)
+{
+	mBytecode.code << Instruction{opcode, a, b, c, d};
+	return mBytecode.code.size() - 1;
+}
+
+int LuaCompiler::addConstant(const Value &value)
+{
+	mBytecode.constants << value;
+	return mBytecode.constants.size() - 1;
+}
+
+int LuaCompiler::addLocation(const core::Connection &location)
+{
+	mBytecode.locations << location;
+	return mBytecode.locations.size() - 1;
+}
+
+void LuaCompiler::emitError(const QString &message, const core::ast::Node &node)
+{
+	addInstruction(Opcode::error, addConstant(Value(message)), 0, 0, addLocation(node.start()));
+}
+
+void LuaCompiler::compileUnsupported(const core::ast::Node &node)
+{
+	const int target = mTarget;
+	emitError(QObject::tr("This construction is not supported by interpreter"), node);
+	addInstruction(Opcode::loadNil, target);
+}
+
+bool LuaCompiler::isNumber(const QSharedPointer<core::ast::Node> &node)
+{
+	guardType(node);
+	return mBytecode.typeGuards.last().isNumber;
+}
+
+bool LuaCompiler::isString(const QSharedPointer<core::ast::Node> &node)
+{
+	guardType(node);
+	return mBytecode.typeGuards.last().isString;
+}
+
+void LuaCompiler::guardType(const QSharedPointer<core::ast::Node> &node)
+{
+	const auto type = mSemanticAnalyzer.type(node);
+	mBytecode.typeGuards << Bytecode::TypeGuard{node, type->is<types::Number>(), type->is<types::String>()};
+}
+
+void LuaCompiler::visit(const core::ast::Node &node)
+{
+	compileUnsupported(node);
+}
+
+void LuaCompiler::visit(const core::ast::Expression &node)
+{
+	compileUnsupported(node);
+}
+
+void LuaCompiler::visit(const core::ast::BinaryOperator &node)
+{
+	compileUnsupported(node);
+}
+
+void LuaCompiler::visit(const core::ast::UnaryOperator &node)
+{
+	compileUnsupported(node);
+}
+
+void LuaCompiler::visit(const ast::Number &node)
+{
+	compileUnsupported(node);
+}
+
+void LuaCompiler::visit(const ast::FieldInitialization &node)
+{
+	compileUnsupported(node);
+}
+
+void LuaCompiler::visit(const ast::MethodCall &node)
+{
+	compileUnsupported(node);
+}
+
+void LuaCompiler::visit(const ast::IntegerNumber &node)
+{
+	/// @todo Integer and float literals may differ from those recognized in toInt() and toDouble().
+	bool ok = false;
+	addInstruction(Opcode::loadConstant, mTarget, addConstant(Value(node.stringRepresentation().toInt(&ok, 0))));
+}
+
+void LuaCompiler::visit(const ast::FloatNumber &node)
+{
+	addInstruction(Opcode::loadConstant, mTarget, addConstant(Value(node.stringRepresentation().toDouble())));
+}
+
+void LuaCompiler::visit(const ast::String &node)
+{
+	addInstruction(Opcode::loadConstant, mTarget, addConstant(Value(node.string())));
+}
+
+void LuaCompiler::visit(const ast::True &node)
+{
+	Q_UNUSED(node)
+	addInstruction(Opcode::loadConstant, mTarget, addConstant(Value(true)));
+}
+
+void LuaCompiler::visit(const ast::False &node)
+{
+	Q_UNUSED(node)
+	addInstruction(Opcode::loadConstant, mTarget, addConstant(Value(false)));
+}
+
+void LuaCompiler::visit(const ast::Nil &node)
+{
+	Q_UNUSED(node)
+	addInstruction(Opcode::loadNil, mTarget);
+}
+
+void LuaCompiler::visit(const ast::Identifier &node)
+{
+	addInstruction(Opcode::loadVariable, mTarget, mVariableSlot(node.name()));
+}
+
+void LuaCompiler::visit(const ast::FunctionCall &node)
+{
+	const int target = mTarget;
+	if (!node.function()->is<ast::Identifier>()) {
+		compileUnsupported(node);
+		return;
+	}
+
+	const int function = mFunctionSlot(as<ast::Identifier>(node.function())->name());
+	const auto &arguments = node.arguments();
+	const int firstArgument = mNextRegister;
+	for (int i = 0; i < arguments.size(); ++i) {
+		allocateRegister();
+	}
+
+	for (int i = 0; i < arguments.size(); ++i) {
+		compile(arguments[i], firstArgument + i);
+	}
+
+	addInstruction(Opcode::call, target, function, firstArgument, arguments.size());
+}
+
+void LuaCompiler::visit(const ast::TableConstructor &node)
+{
+	const int target = mTarget;
+	const int firstFreeRegister = mNextRegister;
+	addInstruction(Opcode::newTable, target);
+	for (const auto &initializer : node.initializers()) {
+		if (initializer->implicitKey()) {
+			const int value = allocateRegister();
+			compile(initializer->value(), value);
+			addInstruction(Opcode::appendToTable, target, value);
+		} else if (isNumber(initializer->key())) {
+			const int key = allocateRegister();
+			const int value = allocateRegister();
+			compile(initializer->key(), key);
+			compile(initializer->value(), value);
+			addInstruction(Opcode::setTableField, target, key, value);
+		} else {
+			emitError(QObject::tr("Explicit table indexes of non-integer type are not supported"), node);
+		}
+
+		mNextRegister = firstFreeRegister;
+	}
+}
+
+bool LuaCompiler::compileIndexer(const ast::IndexingExpression &node, int &tableSlot, int &indexRegister)
+{
+	if (node.table()->is<ast::Identifier>() && isNumber(node.indexer())) {
+		tableSlot = mVariableSlot(as<ast::Identifier>(node.table())->name());
+		indexRegister = allocateRegister();
+		compile(node.indexer(), indexRegister);
+		return true;
+	}
+
+	/// @todo Support more complex cases of table assignment, like
+	///       "f(x)['a'] = 1". Note that field access in form of "a.x = 1" is parsed as "a['x'] = 1", so
+	///       no special handling is needed for that case.
+	emitError(QObject::tr("Currently interpreter allows only tables denoted by identifier and "
+			"by integer expression index, as in 'a[1 + 2] = 3'"), node);
+	return false;
+}
+
+void LuaCompiler::visit(const ast::IndexingExpression &node)
+{
+	const int target = mTarget;
+	int table = 0;
+	int index = 0;
+	if (compileIndexer(node, table, index)) {
+		addInstruction(Opcode::getIndexed, target, table, index);
+	} else {
+		addInstruction(Opcode::loadNil, target);
+	}
+}
+
+void LuaCompiler::visit(const ast::Assignment &node)
+{
+	const int target = mTarget;
+	const int value = allocateRegister();
+	compile(node.value(), value);
+
+	const auto &variable = node.variable();
+	if (variable->is<ast::Identifier>()) {
+		addInstruction(Opcode::storeVariable, mVariableSlot(as<ast::Identifier>(variable)->name()), value);
+	} else if (variable->is<ast::IndexingExpression>()) {
+		int table = 0;
+		int index = 0;
+		if (compileIndexer(*as<ast::IndexingExpression>(variable), table, index)) {
+			addInstruction(Opcode::setIndexed, table, index, value);
+		}
+	} else {
+		emitError(QObject::tr("This construction is not supported by interpreter"), node);
+	}
+
+	addInstruction(Opcode::loadNil, target);
+}
+
+void LuaCompiler::visit(const ast::Block &node)
+{
+	const int target = mTarget;
+	const auto statements = node.children();
+	if (statements.isEmpty()) {
+		addInstruction(Opcode::loadNil, target);
+		return;
+	}
+
+	// Results of all statements except the last one are not used, so they share one register.
+	const int unused = allocateRegister();
+	for (int i = 0; i < statements.size() - 1; ++i) {
+		compile(statements[i], unused);
+	}
+
+	compile(statements.last(), target);
+}
+
+void LuaCompiler::compileUnaryOperator(const core::ast::UnaryOperator &node, Opcode opcode)
+{
+	const int target = mTarget;
+	compile(node.operand(), target);
+	addInstruction(opcode, target, target);
+}
+
+void LuaCompiler::compileBinaryOperator(const core::ast::BinaryOperator &node, Opcode opcode)
+{
+	const int target = mTarget;
+	const int right = allocateRegister();
+	compile(node.leftOperand(), target);
+	compile(node.rightOperand(), right);
+	addInstruction(opcode, target, target, right, addLocation(node.start()));
+}
+
+void LuaCompiler::compileLogicalOperator(const core::ast::BinaryOperator &node, Opcode jump)
+{
+	const int target = mTarget;
+	compile(node.leftOperand(), target);
+	addInstruction(Opcode::toBoolean, target, target);
+	const int jumpInstruction = addInstruction(jump, target);
+	compile(node.rightOperand(), target);
+	addInstruction(Opcode::toBoolean, target, target);
+	mBytecode.code[jumpInstruction].b = mBytecode.code.size();
+}
+
+void LuaCompiler::visit(const ast::UnaryMinus &node)
+{
+	compileUnaryOperator(node, Opcode::unaryMinus);
+}
+
+void LuaCompiler::visit(const ast::Not &node)
+{
+	compileUnaryOperator(node, Opcode::logicalNot);
+}
+
+void LuaCompiler::visit(const ast::Length &node)
+{
+	if (isString(node.operand())) {
+		compileUnaryOperator(node, Opcode::length);
+	} else {
+		/// @todo Support everything else.
+		addInstruction(Opcode::loadNil, mTarget);
+	}
+}
+
+void LuaCompiler::visit(const ast::BitwiseNegation &node)
+{
+	compileUnaryOperator(node, Opcode::bitwiseNegation);
+}
+
+void LuaCompiler::visit(const ast::Addition &node)
+{
+	compileBinaryOperator(node, Opcode::addition);
+}
+
+void LuaCompiler::visit(const ast::Subtraction &node)
+{
+	compileBinaryOperator(node, Opcode::subtraction);
+}
+
+void LuaCompiler::visit(const ast::Multiplication &node)
+{
+	compileBinaryOperator(node, Opcode::multiplication);
+}
+
+void LuaCompiler::visit(const ast::Division &node)
+{
+	compileBinaryOperator(node, Opcode::division);
+}
+
+void LuaCompiler::visit(const ast::IntegerDivision &node)
+{
+	compileBinaryOperator(node, Opcode::integerDivision);
+}
+
+void LuaCompiler::visit(const ast::Modulo &node)
+{
+	compileBinaryOperator(node, Opcode::modulo);
+}
+
+void LuaCompiler::visit(const ast::Exponentiation &node)
+{
+	compileBinaryOperator(node, Opcode::exponentiation);
+}
+
+void LuaCompiler::visit(const ast::BitwiseAnd &node)
+{
+	compileBinaryOperator(node, Opcode::bitwiseAnd);
+}
+
+void LuaCompiler::visit(const ast::BitwiseOr &node)
+{
+	compileBinaryOperator(node, Opcode::bitwiseOr);
+}
+
+void LuaCompiler::visit(const ast::BitwiseXor &node)
+{
+	compileBinaryOperator(node, Opcode::bitwiseXor);
+}
+
+void LuaCompiler::visit(const ast::BitwiseLeftShift &node)
+{
+	compileBinaryOperator(node, Opcode::bitwiseLeftShift);
+}
+
+void LuaCompiler::visit(const ast::BitwiseRightShift &node)
+{
+	compileBinaryOperator(node, Opcode::bitwiseRightShift);
+}
+
+void LuaCompiler::visit(const ast::Concatenation &node)
+{
+	compileBinaryOperator(node, Opcode::concatenation);
+}
+
+void LuaCompiler::visit(const ast::LessThan &node)
+{
+	compileBinaryOperator(node, Opcode::lessThan);
+}
+
+void LuaCompiler::visit(const ast::LessOrEqual &node)
+{
+	compileBinaryOperator(node, Opcode::lessOrEqual);
+}
+
+void LuaCompiler::visit(const ast::GreaterThan &node)
+{
+	compileBinaryOperator(node, Opcode::greaterThan);
+}
+
+void LuaCompiler::visit(const ast::GreaterOrEqual &node)
+{
+	compileBinaryOperator(node, Opcode::greaterOrEqual);
+}
+
+void LuaCompiler::visit(const ast::Equality &node)
+{
+	compileBinaryOperator(node, Opcode::equality);
+}
+
+void LuaCompiler::visit(const ast::Inequality &node)
+{
+	compileBinaryOperator(node, Opcode::inequality);
+}
+
+void LuaCompiler::visit(const ast::LogicalAnd &node)
+{
+	compileLogicalOperator(node, Opcode::jumpIfFalse);
+}
+
+void LuaCompiler::visit(const ast::LogicalOr &node)
+{
+	compileLogicalOperator(node, Opcode::jumpIfTrue);
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <functional>
+
+#include "qrtext/core/semantics/semanticAnalyzer.h"
+#include "qrtext/lua/luaAstVisitorInterface.h"
+
+#include "qrtext/src/lua/luaBytecode.h"
+
+namespace qrtext {
+namespace lua {
+namespace details {
+
+/// Compiles analyzed Lua AST into bytecode for LuaInterpreter. Literals are decoded during compilation, variables and
+/// intrinsic functions are resolved to slots by given functions, so no name lookups are performed during execution.
+/// Expressions are compiled into register machine code, every subexpression gets its own register.
+class LuaCompiler : public LuaAstVisitorInterface
+{
+public:
+	/// Constructor.
+	/// @param semanticAnalyzer - analyzer that has already analyzed trees to be compiled.
+	/// @param variableSlot - returns slot of a variable with given name, creates new slot if needed.
+	/// @param functionSlot - returns slot of an intrinsic function with given name, creates new slot if needed.
+	LuaCompiler(const core::SemanticAnalyzer &semanticAnalyzer
+			, const std::function<int(const QString &)> &variableSlot
+			, const std::function<int(const QString &)> &functionSlot);
+
+	/// Compiles given tree. Unsupported constructions are compiled into instructions that report runtime errors,
+	/// as the tree-walking interpreter did.
+	Bytecode compile(const QSharedPointer<core::ast::Node> &root);
+
+	void visit(const core::ast::Node &node) override;
+	void visit(const core::ast::Expression &node) override;
+	void visit(const core::ast::BinaryOperator &node) override;
+	void visit(const core::ast::UnaryOperator &node) override;
+
+	void visit(const ast::Number &node) override;
+	void visit(const ast::FieldInitialization &node) override;
+	void visit(const ast::MethodCall &node) override;
+	void visit(const ast::IntegerNumber &node) override;
+	void visit(const ast::FloatNumber &node) override;
+	void visit(const ast::String &node) override;
+	void visit(const ast::True &node) override;
+	void visit(const ast::False &node) override;
+	void visit(const ast::Nil &node) override;
+	void visit(const ast::Identifier &node) override;
+	void visit(const ast::FunctionCall &node) override;
+	void visit(const ast::TableConstructor &node) override;
+	void visit(const ast::IndexingExpression &node) override;
+	void visit(const ast::Assignment &node) override;
+	void visit(const ast::Block &node) override;
+
+	void visit(const ast::UnaryMinus &node) override;
+	void visit(const ast::Not &node) override;
+	void visit(const ast::Length &node) override;
+	void visit(const ast::BitwiseNegation &node) override;
+
+	void visit(const ast::Addition &node) override;
+	void visit(const ast::Subtraction &node) override;
+	void visit(const ast::Multiplication &node) override;
+	void visit(const ast::Division &node) override;
+	void visit(const ast::IntegerDivision &node) override;
+	void visit(const ast::Modulo &node) override;
+	void visit(const ast::Exponentiation &node) override;
+	void visit(const ast::BitwiseAnd &node) override;
+	void visit(const ast::BitwiseOr &node) override;
+	void visit(const ast::BitwiseXor &node) override;
+	void visit(const ast::BitwiseLeftShift &node) override;
+	void visit(const ast::BitwiseRightShift &node) override;
+	void visit(const ast::Concatenation &node) override;
+	void visit(const ast::LessThan &node) override;
+	void visit(const ast::LessOrEqual &node) override;
+	void visit(const ast::GreaterThan &node) override;
+	void visit(const ast::GreaterOrEqual &node) override;
+	void visit(const ast::Equality &node) override;
+	void visit(const ast::Inequality &node) override;
+	void visit(const ast::LogicalAnd &node) override;
+	void visit(const ast::LogicalOr &node) override;
+
+private:
+	/// Compiles given expression so that its value is placed into given register.
+	void compile(const QSharedPointer<core::ast::Node> &node, int target);
+
+	int allocateRegister();
+	int addInstruction(Opcode opcode, int a = 0, int b = 0, int c = 0, int d = 0);
+	int addConstant(const Value &value);
+	int addLocation(const core::Connection &location);
+	void emitError(const QString &message, const core::ast::Node &node);
+
+	/// Compiles construction not supported by interpreter: reports error and returns nil.
+	void compileUnsupported(const core::ast::Node &node);
+
+	void compileUnaryOperator(const core::ast::UnaryOperator &node, Opcode opcode);
+	void compileBinaryOperator(const core::ast::BinaryOperator &node, Opcode opcode);
+	void compileLogicalOperator(const core::ast::BinaryOperator &node, Opcode jump);
+
+	/// Compiles indexer of an indexing expression with a table denoted by identifier and number indexer into
+	/// a new register. Returns false and reports error if expression is of any other kind.
+	bool compileIndexer(const ast::IndexingExpression &node, int &tableSlot, int &indexRegister);
+
+	/// Checks type of an expression and remembers that bytecode depends on it.
+	bool isNumber(const QSharedPointer<core::ast::Node> &node);
+	bool isString(const QSharedPointer<core::ast::Node> &node);
+	void guardType(const QSharedPointer<core::ast::Node> &node);
+
+	const core::SemanticAnalyzer &mSemanticAnalyzer;
+	std::function<int(const QString &)> mVariableSlot;
+	std::function<int(const QString &)> mFunctionSlot;
+
+	Bytecode mBytecode;
+
+	/// Register where currently visited expression shall place its value.
+	int mTarget;
+
+	/// First free register.
+	int mNextRegister;
+};
+
+}
+}
+}
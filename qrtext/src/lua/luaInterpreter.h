@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <QtCore/QHash>
+#include <QtCore/QVector>
 
 #include "qrtext/core/error.h"
 #include "qrtext/core/ast/node.h"
@@ -10,11 +11,16 @@
 
 #include "qrtext/lua/types/function.h"
 
+#include "qrtext/src/lua/luaBytecode.h"
+
 namespace qrtext {
 namespace lua {
 namespace details {
 
-/// Interpreter of AST for Lua language.
+/// Interpreter of AST for Lua language. Each tree is compiled into bytecode by LuaCompiler once and cached, then
+/// bytecode is executed by a register machine, with variables and intrinsic functions accessed by slot numbers.
+/// Values are represented by tagged Value objects during execution, they are converted to QVariant only when passed
+/// to intrinsic functions or to interpreter clients.
 class LuaInterpreter
 {
 public:
@@ -47,18 +53,32 @@ public:
 	void clear();
 
 private:
-	QVariant interpretUnaryOperator(const QSharedPointer<core::ast::Node> &root
-			, const core::SemanticAnalyzer &semanticAnalyzer);
+	/// Returns bytecode for given tree, compiling it if there is no valid cached one.
+	Bytecode bytecode(const QSharedPointer<core::ast::Node> &root, const core::SemanticAnalyzer &semanticAnalyzer);
+
+	/// Returns true if types that bytecode relies on are still the same.
+	static bool isValid(const Bytecode &bytecode, const core::SemanticAnalyzer &semanticAnalyzer);
+
+	Value execute(const Bytecode &bytecode);
+
+	int variableSlot(const QString &name);
+	int functionSlot(const QString &name);
+
+	/// Reports runtime error at given location of given bytecode.
+	void reportError(const Bytecode &bytecode, int location, const QString &message);
+
+	QHash<QString, int> mVariableSlots;
+	QVector<Value> mVariableValues;
 
-	QVariant interpretBinaryOperator(const QSharedPointer<core::ast::Node> &root
-			, const core::SemanticAnalyzer &semanticAnalyzer);
+	/// True for variables that were assigned at least once, as slots are also created for unassigned variables
+	/// that are just read.
+	QVector<bool> mVariableDefined;
 
-	QVariant operateOnIndexingExpression(const QSharedPointer<core::ast::Node> &indexingExpression
-			, const core::SemanticAnalyzer &semanticAnalyzer
-			, std::function<QVariant(const QString &, QStringList &, int)> const &action);
+	QHash<QString, int> mFunctionSlots;
+	QVector<std::function<QVariant(const QList<QVariant> &)>> mIntrinsicFunctions;
 
-	QHash<QString, QVariant> mIdentifierValues;
-	QHash<QString, std::function<QVariant(const QList<QVariant> &)>> mIntrinsicFunctions;
+	/// Compiled trees. Keys are roots of trees, they are kept alive by bytecode itself.
+	QHash<const core::ast::Node *, Bytecode> mBytecodeCache;
 
 	QList<core::Error> &mErrors;
 };
@@ -0,0 +1,138 @@
+#include "qrtext/src/lua/luaValue.h"
+
+using namespace qrtext::lua::details;
+
+Value::Value(const QString &value)
+	: mType(Type::string)
+	, mReal(0)
+	, mString(value)
+{
+}
+
+Value::Value(const QStringList &table)
+	: mType(Type::table)
+	, mReal(0)
+	, mVariant(table)
+{
+}
+
+Value Value::fromVariant(const QVariant &value)
+{
+	switch (value.userType()) {
+	case QMetaType::UnknownType:
+		return Value();
+	case QMetaType::Bool:
+		return Value(value.toBool());
+	case QMetaType::Int:
+		return Value(value.toInt());
+	case QMetaType::Double:
+		return Value(value.toDouble());
+	case QMetaType::QString:
+		return Value(value.toString());
+	case QMetaType::QStringList:
+		return Value(value.toStringList());
+	default: {
+		Value result;
+		result.mType = Type::variant;
+		result.mVariant = value;
+		return result;
+	}
+	}
+}
+
+QVariant Value::toVariant() const
+{
+	switch (mType) {
+	case Type::nil:
+		return QVariant();
+	case Type::boolean:
+		return mBoolean;
+	case Type::integer:
+		return mInteger;
+	case Type::real:
+		return mReal;
+	case Type::string:
+		return mString;
+	case Type::table:
+	case Type::variant:
+		return mVariant;
+	}
+
+	return QVariant();
+}
+
+bool Value::isNull() const
+{
+	switch (mType) {
+	case Type::nil:
+		return true;
+	case Type::string:
+		return mString.isNull();
+	case Type::table:
+	case Type::variant:
+		return mVariant.isNull();
+	default:
+		return false;
+	}
+}
+
+bool Value::toBool() const
+{
+	switch (mType) {
+	case Type::boolean:
+		return mBoolean;
+	case Type::integer:
+		return mInteger != 0;
+	default:
+		return toVariant().toBool();
+	}
+}
+
+float Value::toFloat() const
+{
+	switch (mType) {
+	case Type::boolean:
+	case Type::integer:
+	case Type::real:
+		return static_cast<float>(toDouble());
+	default:
+		return toVariant().toFloat();
+	}
+}
+
+QString Value::toString() const
+{
+	switch (mType) {
+	case Type::string:
+		return mString;
+	case Type::integer:
+		return QString::number(mInteger);
+	default:
+		return toVariant().toString();
+	}
+}
+
+QStringList Value::toTable() const
+{
+	return mType == Type::table ? mVariant.toStringList() : toVariant().value<QStringList>();
+}
+
+bool Value::operator ==(const Value &other) const
+{
+	const bool integral = (mType == Type::boolean || mType == Type::integer)
+			&& (other.mType == Type::boolean || other.mType == Type::integer);
+	if (integral) {
+		return toInt() == other.toInt();
+	}
+
+	if (mType == Type::string && other.mType == Type::string) {
+		return mString == other.mString;
+	}
+
+	return toVariant() == other.toVariant();
+}
+
+bool Value::operator !=(const Value &other) const
+{
+	return !(*this == other);
+}
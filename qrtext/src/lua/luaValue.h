@@ -0,0 +1,133 @@
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+
+namespace qrtext {
+namespace lua {
+namespace details {
+
+/// Value used by LuaInterpreter during execution. Booleans and numbers are stored inline with a type tag, so
+/// arithmetic on them needs neither boxing nor QVariant type dispatch. Strings and tables are implicitly shared
+/// handles. Values of any other type that intrinsic functions may return are kept as QVariant.
+/// All conversions follow QVariant conversion rules, so interpretation results are the same as if all values were
+/// QVariants; conversion to and from QVariant happens only when values are passed to or from interpreter clients.
+class Value
+{
+public:
+	enum class Type
+	{
+		nil
+		, boolean
+		, integer
+		, real
+		, string
+		, table
+		, variant
+	};
+
+	/// Constructor of nil value.
+	Value();
+
+	explicit Value(bool value);
+	explicit Value(int value);
+	explicit Value(double value);
+	explicit Value(const QString &value);
+
+	/// Constructs table value, tables are currently represented as lists of strings.
+	explicit Value(const QStringList &table);
+
+	static Value fromVariant(const QVariant &value);
+	QVariant toVariant() const;
+
+	Type type() const;
+
+	/// Returns true for nil and for null strings, as QVariant::isNull() does.
+	bool isNull() const;
+
+	bool toBool() const;
+	int toInt() const;
+	float toFloat() const;
+	double toDouble() const;
+	QString toString() const;
+
+	/// Returns table contained in this value or a result of conversion of this value to QStringList.
+	QStringList toTable() const;
+
+	/// Compares values like QVariant::operator==() does.
+	bool operator ==(const Value &other) const;
+	bool operator !=(const Value &other) const;
+
+private:
+	Type mType;
+	union {
+		bool mBoolean;
+		int mInteger;
+		double mReal;
+	};
+
+	QString mString;
+
+	/// Table or value of other type.
+	QVariant mVariant;
+};
+
+inline Value::Value()
+	: mType(Type::nil)
+	, mReal(0)
+{
+}
+
+inline Value::Value(bool value)
+	: mType(Type::boolean)
+	, mBoolean(value)
+{
+}
+
+inline Value::Value(int value)
+	: mType(Type::integer)
+	, mInteger(value)
+{
+}
+
+inline Value::Value(double value)
+	: mType(Type::real)
+	, mReal(value)
+{
+}
+
+inline Value::Type Value::type() const
+{
+	return mType;
+}
+
+inline int Value::toInt() const
+{
+	switch (mType) {
+	case Type::boolean:
+		return mBoolean ? 1 : 0;
+	case Type::integer:
+		return mInteger;
+	default:
+		return toVariant().toInt();
+	}
+}
+
+inline double Value::toDouble() const
+{
+	switch (mType) {
+	case Type::boolean:
+		return mBoolean ? 1.0 : 0.0;
+	case Type::integer:
+		return mInteger;
+	case Type::real:
+		return mReal;
+	default:
+		return toVariant().toDouble();
+	}
+}
+
+}
+}
+}
@@ -1,6 +1,7 @@
 #include "baseGraphTransformationUnit.h"
 
 #include <QtCore/QEventLoop>
+#include <QtCore/QSet>
 
 using namespace qReal;
 
@@ -50,8 +51,23 @@ bool BaseGraphTransformationUnit::checkRuleMatching()
 
 bool BaseGraphTransformationUnit::checkRuleMatching(const IdList &elements)
 {
-	mMatch = QHash<Id, Id>();
+	if (!startMatching(elements)) {
+		return false;
+	}
+
 	bool isMatched = false;
+	while (nextMatch()) {
+		mMatches.append(mMatch);
+		isMatched = true;
+	}
+
+	return isMatched;
+}
+
+bool BaseGraphTransformationUnit::startMatching(const IdList &elements)
+{
+	mMatch = QHash<Id, Id>();
+	mMatcher.reset();
 
 	const Id startElem = startElement();
 	if (startElem == Id::rootId()) {
@@ -62,186 +78,112 @@ bool BaseGraphTransformationUnit::checkRuleMatching(const IdList &elements)
 		return false;
 	}
 
-	mNodesHavingOutsideLinks.append(startElem);
-
-	foreach (const Id &element, elements) {
-		if (compareElements(element, startElem)) {
-			mCurrentMatchedGraphInRule.clear();
-			mCurrentMatchedGraphInModel.clear();
-			mNodesHavingOutsideLinks.clear();
-			mMatch.clear();
-			mPos = 0;
+	QHash<QString, int> types;
+	const auto typeNumber = [&types](const Id &element) {
+		const QString type = element.diagram() + "/" + element.element();
+		if (!types.contains(type)) {
+			types.insert(type, types.size());
+		}
 
-			mCurrentMatchedGraphInRule.append(startElem);
-			mCurrentMatchedGraphInModel.append(element);
-			mNodesHavingOutsideLinks.append(startElem);
+		return types.value(type);
+	};
+
+	// Only the part of the rule connected to start element is matched.
+	utils::SubgraphMatcher::Graph ruleGraph;
+	QHash<Id, int> ruleNodes;
+	QSet<Id> ruleLinks;
+	mRuleNodes = IdList() << startElem;
+	mRuleLinks.clear();
+	for (int i = 0; i < mRuleNodes.size(); ++i) {
+		const Id nodeInRule = mRuleNodes.at(i);
+		ruleNodes.insert(nodeInRule, ruleGraph.addNode(isWildcardInRule(nodeInRule)
+				? utils::SubgraphMatcher::anyType : typeNumber(nodeInRule)));
+
+		foreach (const Id &linkInRule, linksInRule(nodeInRule)) {
+			if (ruleLinks.contains(linkInRule)) {
+				continue;
+			}
 
-			mMatch.insert(startElem, element);
+			const Id linkEndInRuleElement = linkEndInRule(linkInRule, nodeInRule);
+			if (linkEndInRuleElement == Id::rootId()) {
+				report(tr("Rule '") + property(mRuleToFind, "ruleName").toString()
+						+ tr("' has unconnected link"), true);
+				mHasRuleSyntaxErr = true;
+				return false;
+			}
 
-			if (checkRuleMatchingRecursively()) {
-				isMatched = true;
+			if (!mRuleNodes.contains(linkEndInRuleElement)) {
+				mRuleNodes.append(linkEndInRuleElement);
 			}
+
+			ruleLinks.insert(linkInRule);
+			mRuleLinks.append(linkInRule);
 		}
 	}
 
-	return isMatched;
-}
-
-bool BaseGraphTransformationUnit::checkRuleMatchingRecursively()
-{
-	if (mNodesHavingOutsideLinks.length() == mPos) {
-		QHash<Id, Id> currentMatch = mMatch;
-		mMatches.append(currentMatch);
-		return true;
+	foreach (const Id &linkInRule, mRuleLinks) {
+		ruleGraph.addLink(ruleNodes.value(fromInRule(linkInRule)), ruleNodes.value(toInRule(linkInRule))
+				, isWildcardInRule(linkInRule) ? utils::SubgraphMatcher::anyType : typeNumber(linkInRule));
 	}
 
-	bool isMatched = false;
-
-	const Id nodeInRule = mNodesHavingOutsideLinks.at(mPos);
-	const Id linkInRule = outsideLink(nodeInRule);
-
-	if (linkInRule != Id::rootId()) {
-		const Id linkEndInRuleElement = linkEndInRule(linkInRule, nodeInRule);
-		if (linkEndInRuleElement == Id::rootId()) {
-			report(tr("Rule '") + property(mRuleToFind, "ruleName").toString() + tr("' has unconnected link"), true);
-			mHasRuleSyntaxErr = true;
-			return false;
-		}
-
-		const Id nodeInModel = mMatch.value(nodeInRule);
-		const IdList linksInModel = properLinks(nodeInModel, linkInRule);
-
-		QHash<Id, Id> matchBackup = mMatch;
-		IdList nodesHavingOutsideLinksBackup = mNodesHavingOutsideLinks;
-		IdList currentMatchedGraphInRuleBackup = mCurrentMatchedGraphInRule;
-		IdList currentMatchedGraphInModelBackup = mCurrentMatchedGraphInModel;
-		const int posBackup = mPos;
-
-		foreach (const Id &linkInModel, linksInModel) {
-			const Id linkEndInModelElement = linkEndInModel(linkInModel, nodeInModel);
-			if (checkNodeForAddingToMatch(linkEndInModelElement, linkEndInRuleElement)) {
-				if (checkRuleMatchingRecursively()) {
-					isMatched = true;
-					mMatch = QHash<Id, Id>();
-					foreach (const Id id, matchBackup.keys()) {
-						mMatch.insert(id, matchBackup.value(id));
-					}
-
-					mNodesHavingOutsideLinks = IdList();
-					foreach (const Id id, nodesHavingOutsideLinksBackup) {
-						mNodesHavingOutsideLinks.append(id);
-					}
-					mCurrentMatchedGraphInRule = IdList();
-					foreach (const Id id, currentMatchedGraphInRuleBackup) {
-						mCurrentMatchedGraphInRule.append(id);
-					}
-					mCurrentMatchedGraphInModel = IdList();
-					foreach (const Id id, currentMatchedGraphInModelBackup) {
-						mCurrentMatchedGraphInModel.append(id);
-					}
-
-					mPos = posBackup;
-				} else {
-					rollback();
-				}
-			}
+	utils::SubgraphMatcher::Graph modelGraph;
+	QHash<Id, int> modelNodes;
+	IdList linksInDiagram;
+	mModelNodes.clear();
+	mModelLinks.clear();
+	foreach (const Id &element, elementsFromActiveDiagram()) {
+		if (isEdgeInModel(element)) {
+			linksInDiagram.append(element);
+		} else {
+			modelNodes.insert(element, modelGraph.addNode(typeNumber(element)));
+			mModelNodes.append(element);
 		}
-		return isMatched;
-	} else {
-		mPos++;
-		return checkRuleMatchingRecursively();
 	}
-}
 
-bool BaseGraphTransformationUnit::checkNodeForAddingToMatch(const Id &nodeInModel, const Id &nodeInRule)
-{
-	if (nodeInModel == Id::rootId()) {
-		return false;
+	foreach (const Id &linkInModel, linksInDiagram) {
+		const Id from = fromInModel(linkInModel);
+		const Id to = toInModel(linkInModel);
+		if (modelNodes.contains(from) && modelNodes.contains(to)) {
+			modelGraph.addLink(modelNodes.value(from), modelNodes.value(to), typeNumber(linkInModel));
+			mModelLinks.append(linkInModel);
+		}
 	}
 
-	QHash<Id, Id> *linksToAddToMatch = new QHash<Id, Id>();
-
-	bool res = checkExistingLinks(nodeInModel, nodeInRule, linksToAddToMatch);
-
-	if (res) {
-		mMatch.unite(*linksToAddToMatch);
-		mMatch.insert(nodeInRule, nodeInModel);
-		mCurrentMatchedGraphInRule.append(nodeInRule);
-		mCurrentMatchedGraphInModel.append(nodeInModel);
-		mNodesHavingOutsideLinks.append(nodeInRule);
+	QVector<int> startCandidates;
+	foreach (const Id &element, elements) {
+		if (modelNodes.contains(element)) {
+			startCandidates.append(modelNodes.value(element));
+		}
 	}
 
-	return res;
-}
-
-bool BaseGraphTransformationUnit::checkExistingLinks(const Id &nodeInModel
-		, const Id &nodeInRule, QHash<Id, Id> *linksToAddInMatch)
-{
-	const IdList linksInRuleElement = linksInRule(nodeInRule);
-
-	foreach (const Id &linkInRule, linksInRuleElement) {
-		const Id linkEndInR = linkEndInRule(linkInRule, nodeInRule);
-		if (mCurrentMatchedGraphInRule.contains(linkEndInR)) {
-			Id properLinkInModel = properLink(nodeInModel, linkInRule, linkEndInR);
-			if (properLinkInModel == Id::rootId()) {
-				return false;
-			} else {
-				if (mLogicalModelApi.logicalRepoApi().isLogicalElement(properLinkInModel)) {
-					const IdList properGraphicalLinks = mGraphicalModelApi.graphicalIdsByLogicalId(properLinkInModel);
-					if (!properGraphicalLinks.isEmpty()) {
-						properLinkInModel = properGraphicalLinks.first();
-					}
-				}
-				linksToAddInMatch->insert(linkInRule, properLinkInModel);
+	mMatcher.reset(new utils::SubgraphMatcher(ruleGraph, modelGraph, ruleNodes.value(startElem)
+			, [this](int nodeInRule, int nodeInModel) {
+				return compareElements(mModelNodes.at(nodeInModel), mRuleNodes.at(nodeInRule));
 			}
-		}
-	}
+			, [this](int linkInRule, int linkInModel) {
+				return compareElementTypesAndProperties(mModelLinks.at(linkInModel), mRuleLinks.at(linkInRule));
+			}));
 
+	mMatcher->setStartCandidates(startCandidates);
 	return true;
 }
 
-void BaseGraphTransformationUnit::rollback()
+bool BaseGraphTransformationUnit::nextMatch()
 {
-	const Id nodeToRemove = mCurrentMatchedGraphInRule.last();
-
-	mMatch.remove(nodeToRemove);
-	mCurrentMatchedGraphInRule.removeLast();
-	mCurrentMatchedGraphInModel.removeLast();
-	mNodesHavingOutsideLinks.removeLast();
-	if (mPos == mNodesHavingOutsideLinks.length()) {
-		mPos--;
-	}
-
-	const IdList links = linksToMatchedSubgraph(nodeToRemove);
-	foreach (const Id &link, links) {
-		mMatch.remove(link);
+	if (!mMatcher || !mMatcher->next()) {
+		return false;
 	}
-}
 
-IdList BaseGraphTransformationUnit::linksToMatchedSubgraph(const Id &nodeInRule) const
-{
-	IdList result;
-	const IdList lnksInRule = linksInRule(nodeInRule);
-	foreach (const Id &link, lnksInRule) {
-		const Id linkEnd = linkEndInRule(link, nodeInRule);
-		if (mCurrentMatchedGraphInRule.contains(linkEnd)) {
-			result.append(link);
-		}
+	mMatch.clear();
+	for (int i = 0; i < mRuleNodes.size(); ++i) {
+		mMatch.insert(mRuleNodes.at(i), mModelNodes.at(mMatcher->nodeMatch().at(i)));
 	}
-	return result;
-}
 
-Id BaseGraphTransformationUnit::outsideLink(const Id &nodeInRule) const
-{
-	const IdList lnksInRule = linksInRule(nodeInRule);
-	foreach (const Id &linkInRule, lnksInRule) {
-		const Id linkEndInR = linkEndInRule(linkInRule, nodeInRule);
-		if (!mCurrentMatchedGraphInRule.contains(linkEndInR)) {
-			return linkInRule;
-		}
+	for (int i = 0; i < mRuleLinks.size(); ++i) {
+		mMatch.insert(mRuleLinks.at(i), mModelLinks.at(mMatcher->linkMatch().at(i)));
 	}
 
-	return Id::rootId();
+	return true;
 }
 
 Id BaseGraphTransformationUnit::linkEndInModel(const Id &linkInModel, const Id &nodeInModel) const
@@ -262,84 +204,6 @@ Id BaseGraphTransformationUnit::linkEndInRule(const Id &linkInRule, const Id &no
 	return linkTo;
 }
 
-Id BaseGraphTransformationUnit::properLink(const Id &nodeInModel, const Id &linkInRule, const Id &linkEndInR) const
-{
-	const IdList lnksInModel = linksInModel(nodeInModel);
-	foreach (const Id &linkInModel, lnksInModel) {
-		if (compareLinks(linkInModel, linkInRule)) {
-			Id linkEndInM = linkEndInModel(linkInModel, nodeInModel);
-			if (!mLogicalModelApi.isLogicalId(linkEndInM)) {
-				linkEndInM = mGraphicalModelApi.logicalId(linkEndInM);
-			}
-			Id linkEndInRValue = mMatch.value(linkEndInR);
-			if (!mLogicalModelApi.isLogicalId(linkEndInRValue)) {
-				linkEndInRValue = mGraphicalModelApi.logicalId(linkEndInRValue);
-			}
-			if (linkEndInM == linkEndInRValue) {
-				return linkInModel;
-			}
-		}
-	}
-
-	return Id::rootId();
-}
-
-IdList BaseGraphTransformationUnit::properLinks(const Id &nodeInModel, const Id &linkInRule) const
-{
-	IdList result;
-	const IdList lnksInModel = linksInModel(nodeInModel);
-	foreach (const Id &linkInModel, lnksInModel) {
-		if (mCurrentMatchedGraphInModel.contains(linkEndInModel(linkInModel, nodeInModel))) {
-			continue;
-		}
-
-		if (compareLinks(linkInModel, linkInRule)) {
-			if (!mLogicalModelApi.isLogicalId(linkInModel)) {
-				result.append(linkInModel);
-			} else {
-				result.append(mGraphicalModelApi.graphicalIdsByLogicalId(linkInModel));
-			}
-		}
-	}
-	return result;
-}
-
-bool BaseGraphTransformationUnit::compareLinks(const Id &first,const Id &second) const
-{
-	Id  idTo1 = toInModel(first);
-	const Id idTo2 = toInRule(second);
-	Id idFrom1 = fromInModel(first);
-	const Id idFrom2 = fromInRule(second);
-
-	bool result = compareElementTypesAndProperties(first, second)
-			&& compareElements(idTo1, idTo2)
-			&& compareElements(idFrom1, idFrom2);
-
-	if (mMatch.contains(idTo2)) {
-		Id matchTo = mMatch.value(idTo2);
-		if (!mLogicalModelApi.isLogicalId(matchTo)) {
-			matchTo = mGraphicalModelApi.logicalId(matchTo);
-		}
-		if (!mLogicalModelApi.isLogicalId(idTo1)) {
-			idTo1 = mGraphicalModelApi.logicalId(idTo1);
-		}
-		result = result && matchTo == idTo1;
-	}
-
-	if (mMatch.contains(idFrom2)) {
-		Id matchTo = mMatch.value(idFrom2);
-		if (!mLogicalModelApi.isLogicalId(matchTo)) {
-			matchTo = mGraphicalModelApi.logicalId(matchTo);
-		}
-		if (!mLogicalModelApi.isLogicalId(idFrom1)) {
-			idFrom1 = mGraphicalModelApi.logicalId(idFrom1);
-		}
-		result = result && matchTo == idFrom1;
-	}
-
-	return result;
-}
-
 bool BaseGraphTransformationUnit::compareElements(const Id &first, const Id &second) const
 {
 	return compareElementTypesAndProperties(first, second);
@@ -367,6 +231,12 @@ bool BaseGraphTransformationUnit::compareElementTypesAndProperties(const Id &fir
 	return false;
 }
 
+bool BaseGraphTransformationUnit::isWildcardInRule(const Id &element) const
+{
+	Q_UNUSED(element)
+	return false;
+}
+
 bool BaseGraphTransformationUnit::hasProperty(const Id &id, const QString &propertyName) const
 {
 	if (mLogicalModelApi.isLogicalId(id)) {
@@ -381,7 +251,7 @@ QHash<QString, QVariant> BaseGraphTransformationUnit::properties(const Id &id) c
 	QHash<QString, QVariant> res;
 
 	if (id != Id::rootId()) {
-		QMapIterator<QString, QVariant> properties = propertiesIterator(id);
+		qrRepo::PropertiesIterator properties = propertiesIterator(id);
 
 		while (properties.hasNext()) {
 			properties.next();
@@ -395,7 +265,7 @@ QHash<QString, QVariant> BaseGraphTransformationUnit::properties(const Id &id) c
 	return res;
 }
 
-QMapIterator<QString, QVariant> BaseGraphTransformationUnit::propertiesIterator(const Id &id) const
+qrRepo::PropertiesIterator BaseGraphTransformationUnit::propertiesIterator(const Id &id) const
 {
 	return (mLogicalModelApi.isLogicalId(id))
 			? mLogicalModelApi.logicalRepoApi().propertiesIterator(id)
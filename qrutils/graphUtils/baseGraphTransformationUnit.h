@@ -1,6 +1,9 @@
 #pragma once
 
+#include <QtCore/QScopedPointer>
+
 #include "qrutils/utilsDeclSpec.h"
+#include "qrutils/graphUtils/subgraphMatcher.h"
 
 #include <qrgui/plugins/toolPluginInterface/usedInterfaces/mainWindowInterpretersInterface.h>
 #include <qrgui/plugins/toolPluginInterface/usedInterfaces/logicalModelAssistInterface.h>
@@ -31,45 +34,22 @@ protected:
 	/// Finds first element and starts checking process
 	bool virtual checkRuleMatching();
 
-	/// Finds first element in specified elements and starts checking process
+	/// Finds all matches of the rule which start element corresponds to one of specified elements,
+	/// appends them to mMatches
 	bool checkRuleMatching(const IdList &elements);
 
-	/// Checks rule matching recursively accordingly to given initial data
-	bool checkRuleMatchingRecursively();
-
-	/// Checks can given node in model be added to match as corresponding node
-	/// to given node in rule at curren step
-	bool checkNodeForAddingToMatch(const Id &nodeInModel, const Id &nodeInRule);
-
-	/// Checks if node in model has all links to the current matched subgraph
-	/// as node in rule has
-	bool checkExistingLinks(const Id &nodeInModel, const Id &nodeInRule
-			, QHash<Id, Id> *linksToAddInMatch);
+	/// Prepares lazy search for matches of the rule in active diagram, start element of the rule
+	/// can correspond only to specified elements. Returns false if the rule has syntax errors
+	bool startMatching(const IdList &elements);
 
-	/// Performs a rollback in match algo, removes last added node to the current
-	/// matched subgraph.
-	void rollback();
-
-	/// Get link from node in rule which leads outside current matched graph
-	Id outsideLink(const Id &nodeInRule) const;
+	/// Finds next match of the rule prepared by startMatching() and stores it in mMatch,
+	/// returns false if there are no more matches
+	bool nextMatch();
 
 	/// Get second link end
 	Id linkEndInModel(const Id &linkInModel, const Id &nodeInModel) const;
 	Id linkEndInRule(const Id &linkInRule, const Id &nodeInRule) const;
 
-	/// Returns link id in model which has one of its ends given node in model
-	/// and correspond to link in rule and its ends and
-	/// returns root id if it can not be found
-	Id properLink(const Id &nodeInModel, const Id &linkInRule
-			, const Id &linkEndInR) const;
-
-	/// Get all links from given node in model which can correspond
-	/// given link in rule
-	IdList properLinks(const Id &nodeInModel, const Id &linkInRule) const;
-
-	/// Get all links from given node in rule to current matched subgraph
-	IdList linksToMatchedSubgraph(const Id &nodeInRule) const;
-
 	/// Get all elements from active diagram
 	IdList elementsFromActiveDiagram() const;
 
@@ -84,17 +64,20 @@ protected:
 
 	/// Functions for working with properties of elements on model
 	QVariant property(const Id &id, const QString &propertyName) const;
-	virtual QMapIterator<QString, QVariant> propertiesIterator(const Id &id) const;
+	virtual qrRepo::PropertiesIterator propertiesIterator(const Id &id) const;
 	bool hasProperty(const Id &id, const QString &propertyName) const;
 	void setProperty(const Id &id, const QString &propertyName
 			, const QVariant &value) const;
 	QHash<QString, QVariant> properties(const Id &id) const;
 
 	/// Functions for test elements for equality
-	virtual bool compareLinks(const Id &first, const Id &second) const;
 	virtual bool compareElements(const Id &first, const Id &second) const;
 	virtual bool compareElementTypesAndProperties(const Id &first, const Id &second) const;
 
+	/// True if given element of rule can correspond to model element of any type, other elements
+	/// correspond only to elements of the same type
+	virtual bool isWildcardInRule(const Id &element) const;
+
 	bool isEdgeInModel(const Id &element) const;
 	bool isEdgeInRule(const Id &element) const;
 
@@ -131,17 +114,14 @@ protected:
 	/// List contains all matches of rule
 	QList<QHash<Id, Id> > mMatches;
 
-	/// Nodes of rule subgraph which matched model subgraph at current step
-	IdList mCurrentMatchedGraphInRule;
-
-	/// Nodes of model subgraph which matched model subgraph at current step
-	IdList mCurrentMatchedGraphInModel;
-
-	/// Nodes which have links
-	IdList mNodesHavingOutsideLinks;
+	/// Elements of rule and active diagram numbered as nodes and links in graphs of mMatcher
+	IdList mRuleNodes;
+	IdList mRuleLinks;
+	IdList mModelNodes;
+	IdList mModelLinks;
 
-	/// Current position in mNodesHavingOutsideLinks for quicker access
-	int mPos;
+	/// Search started by startMatching()
+	QScopedPointer<utils::SubgraphMatcher> mMatcher;
 
 	/// Set of properties that will not be checked in compare elements
 	QSet<QString> mDefaultProperties;
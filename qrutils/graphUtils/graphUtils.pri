@@ -2,8 +2,10 @@ HEADERS += \
 	$$PWD/baseGraphTransformationUnit.h \
 	$$PWD/tree.h \
 	$$PWD/deepFirstSearcher.h \
+	$$PWD/subgraphMatcher.h \
 
 SOURCES += \
 	$$PWD/baseGraphTransformationUnit.cpp \
 	$$PWD/tree.cpp \
 	$$PWD/deepFirstSearcher.cpp \
+	$$PWD/subgraphMatcher.cpp \
@@ -0,0 +1,332 @@
+#include "subgraphMatcher.h"
+
+#include <algorithm>
+
+using namespace utils;
+
+int SubgraphMatcher::Graph::addNode(int type)
+{
+	mNodes.append(Node{type, QVector<int>(), QVector<int>()});
+	return mNodes.size() - 1;
+}
+
+int SubgraphMatcher::Graph::addLink(int from, int to, int type)
+{
+	const int link = mLinks.size();
+	mLinks.append(Link{type, from, to});
+	mNodes[from].outgoingLinks.append(link);
+	mNodes[to].incomingLinks.append(link);
+	return link;
+}
+
+int SubgraphMatcher::Graph::nodesCount() const
+{
+	return mNodes.size();
+}
+
+int SubgraphMatcher::Graph::linksCount() const
+{
+	return mLinks.size();
+}
+
+int SubgraphMatcher::Graph::nodeType(int node) const
+{
+	return mNodes[node].type;
+}
+
+int SubgraphMatcher::Graph::linkType(int link) const
+{
+	return mLinks[link].type;
+}
+
+int SubgraphMatcher::Graph::from(int link) const
+{
+	return mLinks[link].from;
+}
+
+int SubgraphMatcher::Graph::to(int link) const
+{
+	return mLinks[link].to;
+}
+
+const QVector<int> &SubgraphMatcher::Graph::outgoingLinks(int node) const
+{
+	return mNodes[node].outgoingLinks;
+}
+
+const QVector<int> &SubgraphMatcher::Graph::incomingLinks(int node) const
+{
+	return mNodes[node].incomingLinks;
+}
+
+SubgraphMatcher::SubgraphMatcher(const Graph &pattern, const Graph &host, int startNode
+		, const Filter &nodeFilter, const Filter &linkFilter)
+	: mPattern(pattern)
+	, mHost(host)
+	, mNodeFilter(nodeFilter)
+	, mLinkFilter(linkFilter)
+	, mPatternSuccessors(distinctNeighboursCount(pattern, true))
+	, mPatternPredecessors(distinctNeighboursCount(pattern, false))
+	, mHostSuccessors(distinctNeighboursCount(host, true))
+	, mHostPredecessors(distinctNeighboursCount(host, false))
+	, mNodeCompatibility(pattern.nodesCount() * host.nodesCount(), 0)
+	, mLinkCompatibility(pattern.linksCount() * host.linksCount(), 0)
+	, mHasStartCandidates(false)
+	, mNodeMatch(pattern.nodesCount(), -1)
+	, mLinkMatch(pattern.linksCount(), -1)
+	, mHostNodeUsed(host.nodesCount(), false)
+	, mSeen(host.nodesCount(), 0)
+	, mSeenStamp(0)
+	, mDepth(0)
+	, mStarted(false)
+{
+	if (startNode >= 0 && startNode < pattern.nodesCount()) {
+		orderPatternNodes(startNode);
+	}
+
+	for (int node = 0; node < host.nodesCount(); ++node) {
+		mHostNodesByType[host.nodeType(node)].append(node);
+	}
+
+	mCandidates.resize(mOrder.size());
+	mCursors.fill(0, mOrder.size());
+}
+
+void SubgraphMatcher::orderPatternNodes(int startNode)
+{
+	QVector<int> position(mPattern.nodesCount(), -1);
+	QVector<int> linksToOrdered(mPattern.nodesCount(), 0);
+	QVector<int> parentLinks(mPattern.nodesCount(), -1);
+
+	int node = startNode;
+	while (node != -1) {
+		position[node] = mOrder.size();
+		mOrder.append(node);
+		mParentLinks.append(parentLinks[node]);
+		mCheckedLinks.append(QVector<int>());
+
+		for (const bool outgoing : { true, false }) {
+			for (const int link : outgoing ? mPattern.outgoingLinks(node) : mPattern.incomingLinks(node)) {
+				const int other = outgoing ? mPattern.to(link) : mPattern.from(link);
+				if (position[other] == -1) {
+					++linksToOrdered[other];
+					if (parentLinks[other] == -1) {
+						parentLinks[other] = link;
+					}
+				} else if (outgoing || other != node) {
+					// Self-loop is both outgoing and incoming, it is checked once.
+					mCheckedLinks.last().append(link);
+				}
+			}
+		}
+
+		// The most constrained node goes next: connected to matched part by the most links, then the one with
+		// the most neighbours.
+		node = -1;
+		for (int candidate = 0; candidate < mPattern.nodesCount(); ++candidate) {
+			if (position[candidate] != -1 || linksToOrdered[candidate] == 0) {
+				continue;
+			}
+
+			const int neighbours = mPatternSuccessors[candidate] + mPatternPredecessors[candidate];
+			if (node == -1 || linksToOrdered[candidate] > linksToOrdered[node]
+					|| (linksToOrdered[candidate] == linksToOrdered[node]
+							&& neighbours > mPatternSuccessors[node] + mPatternPredecessors[node]))
+			{
+				node = candidate;
+			}
+		}
+	}
+}
+
+QVector<int> SubgraphMatcher::distinctNeighboursCount(const Graph &graph, bool outgoing)
+{
+	QVector<int> result(graph.nodesCount(), 0);
+	QVector<int> neighbours;
+	for (int node = 0; node < graph.nodesCount(); ++node) {
+		neighbours.clear();
+		for (const int link : outgoing ? graph.outgoingLinks(node) : graph.incomingLinks(node)) {
+			neighbours.append(outgoing ? graph.to(link) : graph.from(link));
+		}
+
+		std::sort(neighbours.begin(), neighbours.end());
+		result[node] = std::unique(neighbours.begin(), neighbours.end()) - neighbours.begin();
+	}
+
+	return result;
+}
+
+void SubgraphMatcher::setStartCandidates(const QVector<int> &hostNodes)
+{
+	mStartCandidates = hostNodes;
+	mHasStartCandidates = true;
+}
+
+bool SubgraphMatcher::isCompatibleNode(int patternNode, int hostNode)
+{
+	const int patternType = mPattern.nodeType(patternNode);
+	if ((patternType != anyType && patternType != mHost.nodeType(hostNode))
+			|| mPatternSuccessors[patternNode] > mHostSuccessors[hostNode]
+			|| mPatternPredecessors[patternNode] > mHostPredecessors[hostNode])
+	{
+		return false;
+	}
+
+	char &compatibility = mNodeCompatibility[patternNode * mHost.nodesCount() + hostNode];
+	if (compatibility == 0) {
+		compatibility = !mNodeFilter || mNodeFilter(patternNode, hostNode) ? 1 : 2;
+	}
+
+	return compatibility == 1;
+}
+
+bool SubgraphMatcher::isCompatibleLink(int patternLink, int hostLink)
+{
+	const int patternType = mPattern.linkType(patternLink);
+	if (patternType != anyType && patternType != mHost.linkType(hostLink)) {
+		return false;
+	}
+
+	char &compatibility = mLinkCompatibility[patternLink * mHost.linksCount() + hostLink];
+	if (compatibility == 0) {
+		compatibility = !mLinkFilter || mLinkFilter(patternLink, hostLink) ? 1 : 2;
+	}
+
+	return compatibility == 1;
+}
+
+void SubgraphMatcher::fillCandidates(int depth)
+{
+	QVector<int> &candidates = mCandidates[depth];
+	candidates.clear();
+	mCursors[depth] = 0;
+	++mSeenStamp;
+
+	const int node = mOrder[depth];
+	const int parentLink = mParentLinks[depth];
+	if (parentLink == -1) {
+		const int type = mPattern.nodeType(node);
+		QVector<int> allNodes;
+		if (!mHasStartCandidates && type == anyType) {
+			allNodes.reserve(mHost.nodesCount());
+			for (int hostNode = 0; hostNode < mHost.nodesCount(); ++hostNode) {
+				allNodes.append(hostNode);
+			}
+		}
+
+		const QVector<int> &pool = mHasStartCandidates
+				? mStartCandidates
+				: type == anyType ? allNodes : mHostNodesByType.value(type);
+		for (const int hostNode : pool) {
+			if (mSeen[hostNode] != mSeenStamp && isCompatibleNode(node, hostNode)) {
+				mSeen[hostNode] = mSeenStamp;
+				candidates.append(hostNode);
+			}
+		}
+
+		return;
+	}
+
+	const bool outgoing = mPattern.from(parentLink) != node;
+	const int matchedNode = mNodeMatch[outgoing ? mPattern.from(parentLink) : mPattern.to(parentLink)];
+	for (const int link : outgoing ? mHost.outgoingLinks(matchedNode) : mHost.incomingLinks(matchedNode)) {
+		const int hostNode = outgoing ? mHost.to(link) : mHost.from(link);
+		if (mSeen[hostNode] != mSeenStamp && !mHostNodeUsed[hostNode]
+				&& isCompatibleLink(parentLink, link) && isCompatibleNode(node, hostNode))
+		{
+			mSeen[hostNode] = mSeenStamp;
+			candidates.append(hostNode);
+		}
+	}
+}
+
+int SubgraphMatcher::hostLink(int patternLink)
+{
+	const int from = mNodeMatch[mPattern.from(patternLink)];
+	const int to = mNodeMatch[mPattern.to(patternLink)];
+	const bool byOutgoing = mHost.outgoingLinks(from).size() <= mHost.incomingLinks(to).size();
+	for (const int link : byOutgoing ? mHost.outgoingLinks(from) : mHost.incomingLinks(to)) {
+		if ((byOutgoing ? mHost.to(link) == to : mHost.from(link) == from) && isCompatibleLink(patternLink, link)) {
+			return link;
+		}
+	}
+
+	return -1;
+}
+
+bool SubgraphMatcher::assign(int depth, int hostNode)
+{
+	mNodeMatch[mOrder[depth]] = hostNode;
+	mHostNodeUsed[hostNode] = true;
+	for (const int link : mCheckedLinks[depth]) {
+		mLinkMatch[link] = hostLink(link);
+		if (mLinkMatch[link] == -1) {
+			unassign(depth);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void SubgraphMatcher::unassign(int depth)
+{
+	const int node = mOrder[depth];
+	mHostNodeUsed[mNodeMatch[node]] = false;
+	mNodeMatch[node] = -1;
+	for (const int link : mCheckedLinks[depth]) {
+		mLinkMatch[link] = -1;
+	}
+}
+
+bool SubgraphMatcher::next()
+{
+	if (!mStarted) {
+		mStarted = true;
+		if (mOrder.isEmpty()) {
+			mDepth = -1;
+			return false;
+		}
+
+		fillCandidates(0);
+	} else if (mDepth == mOrder.size()) {
+		// Continuing after reported match.
+		--mDepth;
+		unassign(mDepth);
+	}
+
+	while (mDepth >= 0) {
+		if (mCursors[mDepth] == mCandidates[mDepth].size()) {
+			--mDepth;
+			if (mDepth >= 0) {
+				unassign(mDepth);
+			}
+
+			continue;
+		}
+
+		const int hostNode = mCandidates[mDepth][mCursors[mDepth]++];
+		if (!assign(mDepth, hostNode)) {
+			continue;
+		}
+
+		++mDepth;
+		if (mDepth == mOrder.size()) {
+			return true;
+		}
+
+		fillCandidates(mDepth);
+	}
+
+	return false;
+}
+
+const QVector<int> &SubgraphMatcher::nodeMatch() const
+{
+	return mNodeMatch;
+}
+
+const QVector<int> &SubgraphMatcher::linkMatch() const
+{
+	return mLinkMatch;
+}
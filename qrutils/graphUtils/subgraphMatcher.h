@@ -0,0 +1,134 @@
+#pragma once
+
+#include <functional>
+
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+
+#include "qrutils/utilsDeclSpec.h"
+
+namespace utils {
+
+/// Finds occurrences of a small connected pattern graph in a big host graph in VF2 manner. Pattern nodes are
+/// matched in the order that keeps each of them connected to already matched ones, so candidates for a node are
+/// taken only from neighbours of its matched neighbour, not from the whole host graph. Host nodes are prefiltered
+/// by type and by the number of distinct neighbours, results of user checks are cached for the whole search.
+/// Search state is undone in place on backtracking, nothing is copied. Node correspondence is injective, each
+/// pattern link must have a host link of compatible type between corresponding nodes in the same direction.
+/// Matches are found lazily, one per next() call.
+class QRUTILS_EXPORT SubgraphMatcher
+{
+public:
+	/// Directed multigraph with typed nodes and links, numbered from 0 in the order they were added.
+	class QRUTILS_EXPORT Graph
+	{
+	public:
+		/// Adds node of given type, returns its number.
+		int addNode(int type);
+
+		/// Adds link of given type between existing nodes, returns its number.
+		int addLink(int from, int to, int type);
+
+		int nodesCount() const;
+		int linksCount() const;
+		int nodeType(int node) const;
+		int linkType(int link) const;
+		int from(int link) const;
+		int to(int link) const;
+		const QVector<int> &outgoingLinks(int node) const;
+		const QVector<int> &incomingLinks(int node) const;
+
+	private:
+		struct Node
+		{
+			int type;
+			QVector<int> outgoingLinks;
+			QVector<int> incomingLinks;
+		};
+
+		struct Link
+		{
+			int type;
+			int from;
+			int to;
+		};
+
+		QVector<Node> mNodes;
+		QVector<Link> mLinks;
+	};
+
+	/// Type of pattern nodes and links that can correspond to host elements of any type.
+	static const int anyType = -1;
+
+	/// Additional check that pattern node or link (first argument) can correspond to host one (second argument),
+	/// called only for elements of compatible types. Must not depend on the state of the search.
+	typedef std::function<bool(int, int)> Filter;
+
+	/// Creates matcher of the part of @p pattern connected to @p startNode. Filters may be empty.
+	SubgraphMatcher(const Graph &pattern, const Graph &host, int startNode
+			, const Filter &nodeFilter = Filter(), const Filter &linkFilter = Filter());
+
+	/// Restricts host nodes that can correspond to start node, by default any host node can. Must be called
+	/// before the first next().
+	void setStartCandidates(const QVector<int> &hostNodes);
+
+	/// Finds next match, returns false if there are no more matches.
+	bool next();
+
+	/// Returns host nodes corresponding to pattern nodes in current match, -1 for pattern nodes not connected
+	/// to start node.
+	const QVector<int> &nodeMatch() const;
+
+	/// Returns host links corresponding to pattern links in current match, -1 for pattern links not connected
+	/// to start node. If there are several suitable host links, the first one is taken.
+	const QVector<int> &linkMatch() const;
+
+private:
+	void orderPatternNodes(int startNode);
+	static QVector<int> distinctNeighboursCount(const Graph &graph, bool outgoing);
+
+	bool isCompatibleNode(int patternNode, int hostNode);
+	bool isCompatibleLink(int patternLink, int hostLink);
+	void fillCandidates(int depth);
+	bool assign(int depth, int hostNode);
+	void unassign(int depth);
+	int hostLink(int patternLink);
+
+	const Graph mPattern;
+	const Graph mHost;
+	const Filter mNodeFilter;
+	const Filter mLinkFilter;
+
+	/// Pattern nodes in the order they are matched and links by which they are reached from earlier nodes.
+	QVector<int> mOrder;
+	QVector<int> mParentLinks;
+
+	/// Pattern links that are checked when node at corresponding depth is matched, they connect it to itself
+	/// or to earlier nodes.
+	QVector<QVector<int>> mCheckedLinks;
+
+	QVector<int> mPatternSuccessors;
+	QVector<int> mPatternPredecessors;
+	QVector<int> mHostSuccessors;
+	QVector<int> mHostPredecessors;
+	QHash<int, QVector<int>> mHostNodesByType;
+
+	/// Cached results of filters: 0 if not checked yet, 1 if compatible, 2 if not.
+	QVector<char> mNodeCompatibility;
+	QVector<char> mLinkCompatibility;
+
+	QVector<int> mStartCandidates;
+	bool mHasStartCandidates;
+
+	QVector<int> mNodeMatch;
+	QVector<int> mLinkMatch;
+	QVector<bool> mHostNodeUsed;
+	QVector<QVector<int>> mCandidates;
+	QVector<int> mCursors;
+	QVector<int> mSeen;
+	int mSeenStamp;
+	int mDepth;
+	bool mStarted;
+};
+
+}
@@ -104,11 +104,13 @@ QBrush AbstractItem::brush() const
 void AbstractItem::setBrush(const QBrush &brush)
 {
 	mBrush = brush;
+	emit changed(this);
 }
 
 void AbstractItem::setPen(const QPen &pen)
 {
 	mPen = pen;
+	emit changed(this);
 }
 
 QPointF AbstractItem::getX1andY1()
@@ -126,6 +128,7 @@ void AbstractItem::setX1andY1(qreal x, qreal y)
 	mX1 = x;
 	mY1 = y;
 	update();
+	emit changed(this);
 }
 
 void AbstractItem::setX1andY2(qreal x, qreal y)
@@ -133,6 +136,7 @@ void AbstractItem::setX1andY2(qreal x, qreal y)
 	mX1 = x;
 	mY2 = y;
 	update();
+	emit changed(this);
 }
 
 void AbstractItem::setX2andY1(qreal x, qreal y)
@@ -140,6 +144,7 @@ void AbstractItem::setX2andY1(qreal x, qreal y)
 	mX2 = x;
 	mY1 = y;
 	update();
+	emit changed(this);
 }
 
 void AbstractItem::setX2andY2(qreal x, qreal y)
@@ -147,6 +152,7 @@ void AbstractItem::setX2andY2(qreal x, qreal y)
 	mX2 = x;
 	mY2 = y;
 	update();
+	emit changed(this);
 }
 
 void AbstractItem::setCoordinates(const QRectF &pos)
@@ -156,6 +162,7 @@ void AbstractItem::setCoordinates(const QRectF &pos)
 	mX2 = pos.right();
 	mY2 = pos.bottom();
 	update();
+	emit changed(this);
 }
 
 void AbstractItem::reshapeRectWithShift()
@@ -259,16 +266,20 @@ void AbstractItem::setPenStyle(const QString &text)
 		mPen.setStyle(Qt::DashDotDotLine);
 	else if (text == "None")
 		mPen.setStyle(Qt::NoPen);
+
+	emit changed(this);
 }
 
 void AbstractItem::setPenWidth(int width)
 {
 	mPen.setWidth(width);
+	emit changed(this);
 }
 
 void AbstractItem::setPenColor(const QString &text)
 {
 	mPen.setColor(QColor(text));
+	emit changed(this);
 }
 
 void AbstractItem::setBrushStyle(const QString &text)
@@ -278,11 +289,14 @@ void AbstractItem::setBrushStyle(const QString &text)
 	} else if (text == "None") {
 		mBrush.setStyle(Qt::NoBrush);
 	}
+
+	emit changed(this);
 }
 
 void AbstractItem::setBrushColor(const QString &text)
 {
 	mBrush.setColor(QColor(text));
+	emit changed(this);
 }
 
 void AbstractItem::setPen(const QString &penStyle, int width, const QString &penColor)
@@ -393,6 +407,8 @@ void AbstractItem::readPenBrush(const QDomElement &docItem)
 	} else if (penStyle == "none") {
 		mPen.setStyle(Qt::NoPen);
 	}
+
+	emit changed(this);
 }
 
 QStringList AbstractItem::getPenStyleList()
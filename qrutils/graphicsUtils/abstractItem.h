@@ -15,6 +15,8 @@ namespace graphicsUtils {
 
 class QRUTILS_EXPORT AbstractItem : public QGraphicsObject
 {
+	Q_OBJECT
+
 public:
 	enum DragState {
 		None
@@ -87,6 +89,11 @@ public:
 	/// Sets a unique identifier of an item.
 	void setId(const QString &id);
 
+signals:
+	/// Emitted when coordinates, pen or brush of an item are changed. Changes of position, z-value and rotation
+	/// are reported by QGraphicsObject signals.
+	void changed(graphicsUtils::AbstractItem *item);
+
 protected:
 	virtual void serialize(QDomElement &element);
 	virtual void deserialize(const QDomElement &element);
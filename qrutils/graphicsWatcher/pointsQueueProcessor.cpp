@@ -3,22 +3,21 @@
 using namespace utils::sensorsGraph;
 
 PointsQueueProcessor::PointsQueueProcessor(const qreal viewPortHeight, const qreal leftLimit)
-	: mMinCurrent(0)
+	: mNewest(0)
+	, mColumnsCount(0)
+	, mNewestHasValues(false)
+	, mMinCurrent(0)
 	, mMaxCurrent(1)
-	, mNextToDraw(QPointF(0, -80))
+	, mLatestValue(0)
+	, mStep(1)
+	, mGraphHeight(viewPortHeight)
+	, mLeftLimit(leftLimit)
 {
-	setViewParams(viewPortHeight, leftLimit);
-}
-
-PointsQueueProcessor::~PointsQueueProcessor()
-{
-	mPointsQueue.clear();
+	resizeBuffer();
 }
 
 void PointsQueueProcessor::addNewValue(const qreal newValue)
 {
-	const qreal oldMax = mMaxCurrent;
-	const qreal oldMin = mMinCurrent;
 	if (newValue > mMaxCurrent) {
 		mMaxCurrent = newValue;
 	}
@@ -27,45 +26,65 @@ void PointsQueueProcessor::addNewValue(const qreal newValue)
 		mMinCurrent = newValue;
 	}
 
-	if (oldMax != mMaxCurrent || oldMin != mMinCurrent) {
-		recalcPointsQueue(oldMin, oldMax, mGraphHeight);
+	mLatestValue = newValue;
+	if (mColumnsCount == 0) {
+		startColumn();
 	}
 
-	mNextToDraw.setY(absoluteValueToPoint(newValue));
-	filterLastValues();
-	mPointsQueue.append(QPointF(0, absoluteValueToPoint(newValue)));
+	Column &newest = mColumns[mNewest];
+	if (!mNewestHasValues) {
+		newest = Column{newValue, newValue, newValue, newValue};
+		mNewestHasValues = true;
+		return;
+	}
+
+	newest.min = qMin(newest.min, newValue);
+	newest.max = qMax(newest.max, newValue);
+	newest.last = newValue;
 }
 
-void PointsQueueProcessor::recalcPointsQueue(const qreal oldMin, const qreal oldMax, const qreal oldViewHeight)
+void PointsQueueProcessor::makeShiftLeft(const qreal step)
 {
-	qreal currentValue = 0;
-	for (int i = 0; i < mPointsQueue.size(); i++) {
-		currentValue = pointToAbsoluteValue(mPointsQueue[i].y(), oldMin, oldMax, oldViewHeight);
-		mPointsQueue[i].setY(absoluteValueToPoint(currentValue));
+	if (step != mStep) {
+		mStep = step;
+		resizeBuffer();
+	}
+
+	// Nothing to continue until the first value.
+	if (mColumnsCount > 0) {
+		startColumn();
 	}
 }
 
-void PointsQueueProcessor::filterLastValues()
+void PointsQueueProcessor::startColumn()
 {
-	if (mPointsQueue.size() < 2) {
-		return;
-	}
+	mNewest = (mNewest + 1) % mColumns.size();
+	mColumns[mNewest] = Column{mLatestValue, mLatestValue, mLatestValue, mLatestValue};
+	mColumnsCount = qMin(mColumnsCount + 1, mColumns.size());
+	mNewestHasValues = false;
+}
 
-	const qreal filterPixelDiff = 2;
-	if (qAbs(mPointsQueue.at(mPointsQueue.size() - 2).y() - mPointsQueue.last().y()) < filterPixelDiff) {
-		mPointsQueue.removeLast();
-	}
+const PointsQueueProcessor::Column &PointsQueueProcessor::column(const int age) const
+{
+	return mColumns[(mNewest - age + mColumns.size()) % mColumns.size()];
 }
 
-void PointsQueueProcessor::makeShiftLeft(const qreal step)
+void PointsQueueProcessor::resizeBuffer()
 {
-	mPointsQueue.append(latestPosition());
-	for (int i = 0; i < mPointsQueue.size(); i++) {
-		mPointsQueue[i].setX(mPointsQueue[i].x() - step);
-		if (mPointsQueue[i].x() < mLeftLimit) {
-			mPointsQueue.removeAt(i--);
-		}
+	const int capacity = qMax(1, static_cast<int>(-mLeftLimit / mStep) + 1);
+	if (capacity == mColumns.size()) {
+		return;
 	}
+
+	const int kept = qMin(mColumnsCount, capacity);
+	QVector<Column> columns(capacity);
+	for (int age = 0; age < kept; ++age) {
+		columns[kept - 1 - age] = column(age);
+	}
+
+	mColumns = columns;
+	mColumnsCount = kept;
+	mNewest = (kept - 1 + capacity) % capacity;
 }
 
 qreal PointsQueueProcessor::absoluteValueToPoint(const qreal value) const
@@ -90,79 +109,71 @@ void PointsQueueProcessor::clearData()
 {
 	mMinCurrent = 0;
 	mMaxCurrent = 1;
-	mPointsQueue.clear();
+	mColumnsCount = 0;
+	mNewestHasValues = false;
 }
 
 QPointF PointsQueueProcessor::latestPosition() const
 {
-	return mNextToDraw;
+	return QPointF(0, absoluteValueToPoint(mLatestValue));
 }
 
 qreal PointsQueueProcessor::latestValue() const
 {
-	return pointToAbsoluteValue(mNextToDraw.y(), mMinCurrent, mMaxCurrent, mGraphHeight);
+	return mLatestValue;
 }
 
-const QList<QPointF> &PointsQueueProcessor::pointsBase() const
+void PointsQueueProcessor::plotLines(QVector<QLineF> &lines) const
 {
-	return mPointsQueue;
+	lines.clear();
+	for (int age = mColumnsCount - 1; age >= 0; --age) {
+		const Column &current = column(age);
+		const qreal x = -age * mStep;
+		if (age < mColumnsCount - 1) {
+			lines << QLineF(x - mStep, absoluteValueToPoint(column(age + 1).last), x
+					, absoluteValueToPoint(current.first));
+		}
+
+		if (current.min != current.max) {
+			lines << QLineF(x, absoluteValueToPoint(current.min), x, absoluteValueToPoint(current.max));
+		}
+	}
 }
 
 void PointsQueueProcessor::checkPeaks()
 {
-	const qreal oldMin = mMinCurrent;
-	const qreal oldMax = mMaxCurrent;
-
-	mMaxCurrent = std::numeric_limits<qreal>::min();
-	mMinCurrent = std::numeric_limits<qreal>::max();
+	if (mColumnsCount == 0) {
+		return;
+	}
 
-	for (int i = 0; i < mPointsQueue.size(); i++) {
-		if (pointToAbsoluteValue(mPointsQueue[i].y(), oldMin, oldMax, mGraphHeight) > mMaxCurrent) {
-			mMaxCurrent = pointToAbsoluteValue(mPointsQueue[i].y(), oldMin, oldMax, mGraphHeight);
-		}
-		if (pointToAbsoluteValue(mPointsQueue[i].y(), oldMin, oldMax, mGraphHeight) < mMinCurrent) {
-			mMinCurrent = pointToAbsoluteValue(mPointsQueue[i].y(), oldMin, oldMax, mGraphHeight);
-		}
+	mMinCurrent = column(0).min;
+	mMaxCurrent = column(0).max;
+	for (int age = 1; age < mColumnsCount; ++age) {
+		mMinCurrent = qMin(mMinCurrent, column(age).min);
+		mMaxCurrent = qMax(mMaxCurrent, column(age).max);
 	}
 
-	recalcPointsQueue(oldMin, oldMax, mGraphHeight);
+	// Constant value is drawn at the bottom instead of dividing by zero.
+	if (mMaxCurrent == mMinCurrent) {
+		mMaxCurrent = mMinCurrent + 1;
+	}
 }
 
 QPointF PointsQueueProcessor::pointOfVerticalIntersection(const QPointF &position) const
 {
-	if (mPointsQueue.isEmpty())
+	if (mColumnsCount == 0) {
 		return QPointF(0, 0);
-	const qreal accuracyCoefficient = 2; // accuracy = diameter * accCoefficient
-	const qreal diameter = (mPointsQueue.last().x() - mPointsQueue.first().x()) / mPointsQueue.size();
-
-	QPointF result;
-	int leftBound = 0;
-	int rightBound = mPointsQueue.size() - 1;
-	while (leftBound < rightBound) {
-		int middleIndex = (rightBound + leftBound) / 2;
-		result = mPointsQueue.at(middleIndex);
-		if (qAbs(result.x() - position.x()) < diameter * accuracyCoefficient) {
-			break;
-		}
-
-		if (position.x() < result.x()) {
-			rightBound = middleIndex - 1;
-		}
-
-		if (position.x() > result.x()) {
-			leftBound = middleIndex + 1;
-		}
 	}
 
-	return result;
+	const int age = qBound(0, qRound(-position.x() / mStep), mColumnsCount - 1);
+	return QPointF(-age * mStep, absoluteValueToPoint(column(age).last));
 }
 
 void PointsQueueProcessor::setViewParams(const qreal viewPortHeight, const qreal leftLimit)
 {
-	const qreal oldViewHeight = mGraphHeight;
 	mGraphHeight = viewPortHeight;
-	recalcPointsQueue(mMinCurrent, mMaxCurrent, oldViewHeight);
 	mLeftLimit = leftLimit;
+	resizeBuffer();
 }
 
 qreal PointsQueueProcessor::minLimit() const
@@ -1,31 +1,32 @@
 #pragma once
 
-#include <QtCore/QList>
+#include <QtCore/QVector>
 #include <QtCore/QPointF>
-#include <limits>
+#include <QtCore/QLineF>
 
 namespace utils {
 namespace sensorsGraph {
 
-/// @class PointsQueueProcessor provides all necessary transformations with points
+/// @class PointsQueueProcessor keeps plotted values and provides all necessary transformations with them
 /// Features: scaling by search of peaks on plot
-/// Full recount of current plot with new min/max rate
 /// Convertion absolute value to plot-Y-value and back
-/// @remarks get out point list to draw plot with them
+/// Values are kept as they are in a fixed-capacity ring buffer of plot columns, one column per frame. Column keeps
+/// first, min, max and last value received during its frame, so the cost of drawing does not depend on sampling
+/// rate, and rescaling does not touch the buffer: values are converted to plot coordinates only when drawing.
+/// @remarks get out plot lines to draw plot with them
 class PointsQueueProcessor
 {
 public:
 	/// @param viewPortHeight takes amplitude for graphics without top and bottom bounds
-	/// @param leftLimit takes sceneRect.left() for deleting out_to_date points
+	/// @param leftLimit takes sceneRect.left(), columns beyond it are dropped
 	PointsQueueProcessor(const qreal viewPortHeight, const qreal leftLimit);
-	~PointsQueueProcessor();
 
 	void addNewValue(const qreal newValue);
 	void clearData();
 
-	/// Shifts left points queue to animate plot
+	/// Shifts plot left to animate it: newest column at x = 0 is closed and the next one is started
 	/// use this func on each iteration
-	/// @param step one shift in pixels
+	/// @param step one shift in pixels, it is the width of a column
 	void makeShiftLeft(const qreal step);
 
 	/// function scales plot with current peaks
@@ -42,8 +43,9 @@ public:
 	QPointF latestPosition() const;
 	qreal latestValue() const;
 
-	/// get points data to draw a plot
-	const QList<QPointF> &pointsBase() const;
+	/// Fills @p lines with plot segments in current plot coordinates, from the oldest column to the newest one.
+	/// Each column gives a segment from the last value of the previous column and a vertical segment of its range.
+	void plotLines(QVector<QLineF> &lines) const;
 
 	qreal minLimit() const;
 	qreal maxLimit() const;
@@ -53,17 +55,37 @@ public:
 	qreal pointToAbsoluteValue(const qreal yValue) const;
 
 protected:
-	void recalcPointsQueue(const qreal oldMin, const qreal oldMax, const qreal oldViewHeight);
-	/// Removes last values if they have no difference
-	void filterLastValues();
+	struct Column
+	{
+		qreal first;
+		qreal min;
+		qreal max;
+		qreal last;
+	};
+
+	/// Returns column by its age, 0 is the newest one
+	const Column &column(const int age) const;
+
+	/// Starts new newest column that continues the latest value, overwriting the oldest column if buffer is full
+	void startColumn();
+
+	/// Reallocates ring buffer for columns that fit between left limit and 0, keeping the newest ones
+	void resizeBuffer();
 
 	qreal pointToAbsoluteValue(const qreal yValue, const qreal minValue
 			, const qreal maxValue, const qreal graphHeight) const;
 
-	QList<QPointF> mPointsQueue;
+	QVector<Column> mColumns;
+	/// Index of the newest column in mColumns
+	int mNewest;
+	int mColumnsCount;
+	/// True if newest column has received values, otherwise it only continues the previous one
+	bool mNewestHasValues;
+
 	qreal mMinCurrent;
 	qreal mMaxCurrent;
-	QPointF mNextToDraw;
+	qreal mLatestValue;
+	qreal mStep;
 	qreal mGraphHeight;
 	qreal mLeftLimit;
 };
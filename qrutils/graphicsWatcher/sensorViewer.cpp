@@ -20,6 +20,12 @@ SensorViewer::SensorViewer(QWidget *parent)
 {
 	initGraphicsOutput();
 
+	if (mHistoryFile.open()) {
+		mPendingHistory.reserve(historyBatchSize);
+	} else {
+		QLOG_ERROR() << "Could not create temporary file for sensor values history, history will not be saved";
+	}
+
 	connect(&mVisualTimer, SIGNAL(timeout()), this, SLOT(visualTimerEvent()));
 }
 
@@ -84,14 +90,12 @@ void SensorViewer::stopJob()
 void SensorViewer::clear()
 {
 	mPointsDataProcessor->clearData();
+	viewport()->update();
 
-	foreach (QGraphicsItem *item, mScene->items()) {
-		QGraphicsLineItem *curLine = qgraphicsitem_cast<QGraphicsLineItem *>(item);
-		if (curLine == nullptr) {
-			continue;
-		}
-
-		mScene->removeItem(curLine);
+	mPendingHistory.clear();
+	if (mHistoryFile.isOpen()) {
+		mHistoryFile.resize(0);
+		mHistoryFile.seek(0);
 	}
 
 	QMatrix defaultMatrix;
@@ -114,9 +118,25 @@ void SensorViewer::exportHistory()
 	try {
 		OutFile out(fileName);
 		out() << "time" << ";" << "value" << "\n";
-		for (int i = 0; i < mPointsDataProcessor->pointsBase().size(); ++i) {
-			const qreal plotValue = mPointsDataProcessor->pointsBase()[i].y();
-			out() << i << ";" << mPointsDataProcessor->pointToAbsoluteValue(plotValue) << "\n";
+		if (mHistoryFile.isOpen()) {
+			// History is copied by chunks, it may be too big to be read at once.
+			flushHistory();
+			mHistoryFile.seek(0);
+			qint64 time = 0;
+			QVector<qreal> values(historyBatchSize);
+			while (!mHistoryFile.atEnd()) {
+				const qint64 bytes = mHistoryFile.read(reinterpret_cast<char *>(values.data())
+						, historyBatchSize * sizeof(qreal));
+				if (bytes <= 0) {
+					break;
+				}
+
+				for (int i = 0; i < bytes / static_cast<qint64>(sizeof(qreal)); ++i) {
+					out() << time++ << ";" << values[i] << "\n";
+				}
+			}
+
+			mHistoryFile.seek(mHistoryFile.size());
 		}
 	} catch (const qReal::Exception &exception) {
 		QLOG_ERROR() << "An error occured during exporting sensor values to" << fileName << ":" << exception.message();
@@ -126,6 +146,25 @@ void SensorViewer::exportHistory()
 void SensorViewer::setNextValue(const qreal newValue)
 {
 	mPointsDataProcessor->addNewValue(newValue);
+	if (!mHistoryFile.isOpen()) {
+		return;
+	}
+
+	// Values are written by batches without formatting, so GUI thread does not wait for disk on each value.
+	mPendingHistory << newValue;
+	if (mPendingHistory.size() == historyBatchSize) {
+		flushHistory();
+	}
+}
+
+void SensorViewer::flushHistory()
+{
+	const qint64 bytes = mPendingHistory.size() * sizeof(qreal);
+	if (mHistoryFile.write(reinterpret_cast<const char *>(mPendingHistory.constData()), bytes) != bytes) {
+		QLOG_ERROR() << "Could not write sensor values history, it will be incomplete";
+	}
+
+	mPendingHistory.clear();
 }
 
 void SensorViewer::drawNextFrame()
@@ -135,21 +174,8 @@ void SensorViewer::drawNextFrame()
 	// shifting lines left
 	mPointsDataProcessor->makeShiftLeft(stepSize);
 
-	foreach (QGraphicsItem *item, mScene->items()) {
-		QGraphicsLineItem *curLine = qgraphicsitem_cast<QGraphicsLineItem *>(item);
-		if (curLine == nullptr) {
-			continue;
-		}
-
-		delete curLine;
-	}
-
-	const QPen regularPen = QPen(mPenBrush, 2, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
-	for (int i = 0; i < mPointsDataProcessor->pointsBase().size() - 1; i++) {
-		QLineF quantOfGraph(mPointsDataProcessor->pointsBase()[i]
-				, mPointsDataProcessor->pointsBase()[i + 1]);
-		mScene->addLine(quantOfGraph, regularPen);
-	}
+	// Plot is not made of scene items, it is painted with the background.
+	viewport()->update();
 }
 
 void SensorViewer::visualTimerEvent()
@@ -196,6 +222,15 @@ void SensorViewer::drawBackground(QPainter *painter, const QRectF &rect)
 	painter->drawText(textRect.translated(sceneRect.width() - 35, sceneRect.height() - 20), currentDisplay);
 	painter->setPen(Qt::black);
 	Q_UNUSED(rect);
+
+	drawPlot(painter);
+}
+
+void SensorViewer::drawPlot(QPainter *painter)
+{
+	mPointsDataProcessor->plotLines(mPlotLines);
+	painter->setPen(QPen(mPenBrush, 2, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+	painter->drawLines(mPlotLines);
 }
 
 void SensorViewer::mouseMoveEvent(QMouseEvent *event)
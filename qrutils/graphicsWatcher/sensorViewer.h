@@ -2,6 +2,7 @@
 
 #include <QtWidgets/QGraphicsView>
 #include <QtCore/QTimer>
+#include <QtCore/QTemporaryFile>
 #include <QtGui/QPainter>
 #include <QtGui/QMouseEvent>
 #include <QtWidgets/QToolTip>
@@ -35,12 +36,15 @@ public slots:
 	void zoomOut();
 	void onSensorChange();
 
-	/// Save sensor's values history into the ".csv" file.
+	/// Save sensor's values history into the ".csv" file: all values received since the last clear(). Time of
+	/// a value is its number since the last clear().
 	void exportHistory();
 
 protected:
 	void drawNextFrame();
 	void drawBackground(QPainter *painter, const QRectF &rect);
+	/// Paints plot from points processor data, under key points like items used to be
+	void drawPlot(QPainter *painter);
 	/// Renders hint with value under cursor
 	void mouseMoveEvent(QMouseEvent *event);
 	void leaveEvent(QEvent *);
@@ -52,6 +56,9 @@ private slots:
 	void visualTimerEvent();
 
 private:
+	/// Writes pending values to the history file by one write call.
+	void flushHistory();
+
 	QGraphicsScene *mScene;
 	QTimer mVisualTimer;
 	KeyPoint *mMainPoint;
@@ -74,6 +81,17 @@ private:
 	int mAutoScaleTimer;
 	int mUpdateCurrValueTimer;
 	qreal mOutputValue;
+
+	/// Plot lines buffer reused by each frame
+	QVector<QLineF> mPlotLines;
+
+	/// Number of values written to the history file at once
+	static const int historyBatchSize = 4096;
+
+	/// All values since the last clear in binary form, streamed to disk instead of being kept in memory
+	QTemporaryFile mHistoryFile;
+	/// Values that are not written to the history file yet
+	QVector<qreal> mPendingHistory;
 };
 
 }
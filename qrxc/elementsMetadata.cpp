@@ -0,0 +1,154 @@
+#include "elementsMetadata.h"
+
+#include <algorithm>
+
+#include <QtCore/QSet>
+
+ElementsMetadata::ElementsMetadata(const QStringList &diagrams, const QStringList &elements
+		, const QList<int> &elementDiagrams, const QList<QStringList> &parents)
+	: mDiagrams(diagrams)
+	, mElements(elements)
+	, mElementDiagrams(elementDiagrams)
+{
+	buildPerfectHash();
+	buildAncestors(parents);
+}
+
+quint32 ElementsMetadata::nameHash(const QString &name, quint32 seed)
+{
+	quint32 result = 2166136261u ^ (seed * 2654435761u);
+	for (const QChar &character : name) {
+		result = (result ^ character.unicode()) * 16777619u;
+	}
+
+	return result;
+}
+
+const QVector<quint32> &ElementsMetadata::displacements() const
+{
+	return mDisplacements;
+}
+
+const QVector<int> &ElementsMetadata::elementSlots() const
+{
+	return mElementSlots;
+}
+
+const QVector<QVector<quint32>> &ElementsMetadata::ancestors() const
+{
+	return mAncestors;
+}
+
+int ElementsMetadata::elementIndex(const QString &element) const
+{
+	const quint32 displacement = mDisplacements[nameHash(element, 0) % mDisplacements.size()];
+	const int index = mElementSlots[nameHash(element, displacement) % mElementSlots.size()];
+	return index >= 0 && mElements[index] == element ? index : -1;
+}
+
+bool ElementsMetadata::isParentOf(const QString &parentDiagram, const QString &parentElement
+		, const QString &childDiagram, const QString &childElement) const
+{
+	if (childDiagram != parentDiagram) {
+		return false;
+	}
+
+	if (childElement == parentElement) {
+		return true;
+	}
+
+	const int child = elementIndex(childElement);
+	const int parent = elementIndex(parentElement);
+	return child >= 0 && parent >= 0
+			&& mElementDiagrams[child] >= 0 && mDiagrams[mElementDiagrams[child]] == childDiagram
+			&& (mAncestors[child][parent / 32] & (1u << (parent % 32)));
+}
+
+void ElementsMetadata::buildPerfectHash()
+{
+	// A name goes to bucket hash(name, 0) % buckets count and then to slot hash(name, displacement of its bucket)
+	// % slots count, where displacements are picked, starting from the largest bucket, so that all names get
+	// different slots.
+	const int bucketsCount = qMax(1, mElements.size());
+	QVector<QList<int>> buckets(bucketsCount);
+	for (int i = 0; i < mElements.size(); ++i) {
+		buckets[nameHash(mElements[i], 0) % bucketsCount] << i;
+	}
+
+	QList<int> order;
+	for (int i = 0; i < bucketsCount; ++i) {
+		order << i;
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&buckets](int left, int right) {
+		return buckets[left].size() > buckets[right].size();
+	});
+
+	// Table has twice as many slots as there are names, so displacements are found quickly. If some bucket still
+	// does not fit, table is enlarged.
+	const quint32 maxDisplacement = 100000;
+	for (int slotsCount = 2 * bucketsCount; ; slotsCount *= 2) {
+		mDisplacements.fill(0, bucketsCount);
+		mElementSlots.fill(-1, slotsCount);
+		bool success = true;
+		for (const int bucket : order) {
+			bool placed = buckets[bucket].isEmpty();
+			for (quint32 displacement = 1; !placed && displacement <= maxDisplacement; ++displacement) {
+				QList<int> bucketSlots;
+				for (const int name : buckets[bucket]) {
+					const int slot = nameHash(mElements[name], displacement) % slotsCount;
+					if (mElementSlots[slot] != -1 || bucketSlots.contains(slot)) {
+						break;
+					}
+
+					bucketSlots << slot;
+				}
+
+				if (bucketSlots.size() == buckets[bucket].size()) {
+					for (int i = 0; i < bucketSlots.size(); ++i) {
+						mElementSlots[bucketSlots[i]] = buckets[bucket][i];
+					}
+
+					mDisplacements[bucket] = displacement;
+					placed = true;
+				}
+			}
+
+			if (!placed) {
+				success = false;
+				break;
+			}
+		}
+
+		if (success) {
+			return;
+		}
+	}
+}
+
+void ElementsMetadata::buildAncestors(const QList<QStringList> &parents)
+{
+	// Generated requests used to walk through parents only while they were in the diagram of the element asked
+	// about, transitive closure keeps this behaviour.
+	const int words = qMax(1, (mElements.size() + 31) / 32);
+	mAncestors.fill(QVector<quint32>(words, 0), mElements.size());
+	for (int i = 0; i < mElements.size(); ++i) {
+		QSet<int> visited;
+		QList<int> toVisit = { i };
+		while (!toVisit.isEmpty()) {
+			const int element = toVisit.takeLast();
+			if (element != i && mElementDiagrams[element] != mElementDiagrams[i]) {
+				continue;
+			}
+
+			for (const QString &parentName : parents[element]) {
+				const int parent = mElements.indexOf(parentName);
+				if (parent >= 0 && !visited.contains(parent)) {
+					visited << parent;
+					mAncestors[i][parent / 32] |= 1u << (parent % 32);
+					toVisit << parent;
+				}
+			}
+		}
+	}
+}
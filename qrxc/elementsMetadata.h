@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+/// Tables describing elements of an editor that are generated into plugin source as constant arrays: "hash and
+/// displace" perfect hash from element names to their indices and transitive closure of generalization relation.
+/// Lookups here are done exactly the same way as generated code does them, so tables can be checked without
+/// compiling a plugin.
+class ElementsMetadata
+{
+public:
+	/// @param diagrams - normalized names of diagrams of an editor.
+	/// @param elements - distinct normalized names of elements.
+	/// @param elementDiagrams - index in @p diagrams of a diagram of each element, -1 for parents from other editors.
+	/// @param parents - names of direct parents of each element.
+	ElementsMetadata(const QStringList &diagrams, const QStringList &elements, const QList<int> &elementDiagrams
+			, const QList<QStringList> &parents);
+
+	/// Hash of element names: FNV-1a over UTF-16 code units with a seed mixed into its offset basis. Generated
+	/// plugins compute exactly the same function, so it shall not be changed without changing generated code.
+	static quint32 nameHash(const QString &name, quint32 seed);
+
+	/// Displacements of buckets of perfect hash table, a bucket of a name is nameHash(name, 0) % buckets count.
+	const QVector<quint32> &displacements() const;
+
+	/// Slots of perfect hash table with element indices, -1 for empty slots. A slot of a name is
+	/// nameHash(name, displacement of its bucket) % slots count.
+	const QVector<int> &elementSlots() const;
+
+	/// Rows of bit matrix of generalization relation closure, bit j of row i is set if element j is a parent of i.
+	const QVector<QVector<quint32>> &ancestors() const;
+
+	/// Returns index of element with given name or -1.
+	int elementIndex(const QString &element) const;
+
+	/// Returns true if @p parentElement is @p childElement or its parent, directly or not, and both are from the
+	/// same diagram. Generalization is followed only through parents from the diagram of a child.
+	bool isParentOf(const QString &parentDiagram, const QString &parentElement
+			, const QString &childDiagram, const QString &childElement) const;
+
+private:
+	void buildPerfectHash();
+	void buildAncestors(const QList<QStringList> &parents);
+
+	const QStringList mDiagrams;
+	const QStringList mElements;
+	const QList<int> mElementDiagrams;
+
+	QVector<quint32> mDisplacements;
+	QVector<int> mElementSlots;
+	QVector<QVector<quint32>> mAncestors;
+};
@@ -659,9 +659,9 @@ void GraphicType::generateOneCase(OutFile &out, bool isNotFirst) const
 	const QString name = NameNormalizer::normalize(qualifiedName());
 
 	if (!isNotFirst) {
-		out() << "\tif (element == \"" << name << "\") {\n";
+		out() << "\tif (index == metadata::Element::" << name << ") {\n";
 	} else {
-		out() << "\telse if (element == \"" << name << "\") {\n";
+		out() << "\telse if (index == metadata::Element::" << name << ") {\n";
 	}
 }
 
@@ -716,21 +716,14 @@ bool GraphicType::generateListForElement(utils::OutFile &out, bool isNotFirst, c
 	return true;
 }
 
-void GraphicType::generateParentsMapping(utils::OutFile &out)
+QStringList GraphicType::parentNames() const
 {
-	if (mParents.isEmpty()) {
-		return;
-	}
-
-	const QString diagramName = NameNormalizer::normalize(mDiagram->name());
-	const QString normalizedName = NameNormalizer::normalize(qualifiedName());
-	out() << "\tmParentsMap[\"" << diagramName << "\"][\"" << normalizedName << "\"]\n";
+	QStringList result;
 	for (const GeneralizationProperties &parent : mParents) {
-		out() << "\t\t<< qMakePair(QString(\"" << diagramName << "\"), QString(\""
-				<< NameNormalizer::normalize(parent.name) << "\"))\n";
+		result << NameNormalizer::normalize(parent.name);
 	}
 
-	out() << "\t;\n";
+	return result;
 }
 
 QVector<int> GraphicType::toIntVector(const QString &s, bool *isOk) const
@@ -34,7 +34,6 @@ public:
 	virtual void generatePropertyTypes(utils::OutFile &out);
 	virtual void generatePropertyDefaults(utils::OutFile &out);
 	virtual void generateMouseGesturesMap(utils::OutFile &out);
-	virtual void generateParentsMapping(utils::OutFile &out);
 	virtual void generateExplosionsMap(utils::OutFile &out);
 	virtual bool copyPorts(NodeType *parent) = 0;
 	void copyLabels(GraphicType *parent);
@@ -43,6 +42,9 @@ public:
 	QString description() const;
 	void setDescription(const QString &description);
 
+	/// Returns normalized names of direct parents of this type (by generalization relation).
+	QStringList parentNames() const;
+
 protected:
 	/// @todo Remove this sh~.
 	typedef QPair<QPair<QString,QString>,QPair<bool,QString> > PossibleEdge;  // Lol
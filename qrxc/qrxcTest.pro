@@ -31,6 +31,7 @@ HEADERS += association.h \
 	diagram.h \
 	edgeType.h \
 	editor.h \
+	elementsMetadata.h \
 	enumType.h \
 	graphicType.h \
 	label.h \
@@ -52,6 +53,7 @@ SOURCES += association.cpp \
 	diagram.cpp \
 	edgeType.cpp \
 	editor.cpp \
+	elementsMetadata.cpp \
 	enumType.cpp \
 	graphicType.cpp \
 	label.cpp \
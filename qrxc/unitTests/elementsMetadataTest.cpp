@@ -0,0 +1,117 @@
+#include <QtCore/QMap>
+#include <QtCore/QPair>
+
+#include "../elementsMetadata.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+typedef QPair<QString, QString> StringPair;
+
+/// isParentOf() as generated plugins implemented it before tables were introduced, on a map from diagram and
+/// element to direct parents of the element, each one taken from the same diagram.
+bool mapIsParentOf(const QMap<QString, QMap<QString, QList<StringPair>>> &parentsMap
+		, const QString &parentDiagram, const QString &parentElement
+		, const QString &childDiagram, const QString &childElement)
+{
+	if (childDiagram == parentDiagram && childElement == parentElement) {
+		return true;
+	}
+
+	const QList<StringPair> parents = parentsMap.value(childDiagram).value(childElement);
+	if (parents.contains(qMakePair(parentDiagram, parentElement))) {
+		return true;
+	}
+
+	for (const StringPair &pair : parents) {
+		if (mapIsParentOf(parentsMap, parentDiagram, parentElement, pair.first, pair.second)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+}
+
+TEST(ElementsMetadataTest, elementIndexTest) {
+	QStringList elements;
+	QList<int> elementDiagrams;
+	QList<QStringList> parents;
+	for (int i = 0; i < 500; ++i) {
+		elements << QString("Element%1").arg(i);
+		elementDiagrams << 0;
+		parents << QStringList();
+	}
+
+	const ElementsMetadata metadata({ "Diagram" }, elements, elementDiagrams, parents);
+
+	for (int i = 0; i < elements.size(); ++i) {
+		EXPECT_EQ(metadata.elementIndex(elements[i]), i);
+	}
+
+	EXPECT_EQ(metadata.elementIndex("Element500"), -1);
+	EXPECT_EQ(metadata.elementIndex("element0"), -1);
+	EXPECT_EQ(metadata.elementIndex(""), -1);
+}
+
+TEST(ElementsMetadataTest, emptyEditorTest) {
+	const ElementsMetadata metadata({}, {}, {}, {});
+
+	EXPECT_EQ(metadata.elementIndex("Element"), -1);
+	EXPECT_FALSE(metadata.isParentOf("Diagram", "Parent", "Diagram", "Child"));
+	EXPECT_TRUE(metadata.isParentOf("Diagram", "Element", "Diagram", "Element"));
+}
+
+TEST(ElementsMetadataTest, isParentOfTest) {
+	// Diagram "Second" refers to parents from "First", "External" is a parent from another editor.
+	const QStringList diagrams = { "First", "Second" };
+	const QStringList elements = { "Root", "Middle", "Leaf", "Extended", "Foreign", "ForeignLeaf", "Mixed"
+			, "External" };
+	const QList<int> elementDiagrams = { 0, 0, 0, 0, 1, 1, 1, -1 };
+	const QList<QStringList> parents = {
+		{}
+		, { "Root" }
+		, { "Middle" }
+		, { "External", "Root" }
+		, { "Root" }
+		, { "Foreign" }
+		, { "Leaf", "Foreign" }
+		, {}
+	};
+
+	QMap<QString, QMap<QString, QList<StringPair>>> parentsMap;
+	for (int i = 0; i < elements.size(); ++i) {
+		if (elementDiagrams[i] < 0) {
+			continue;
+		}
+
+		const QString diagram = diagrams[elementDiagrams[i]];
+		for (const QString &parent : parents[i]) {
+			parentsMap[diagram][elements[i]] << qMakePair(diagram, parent);
+		}
+	}
+
+	const ElementsMetadata metadata(diagrams, elements, elementDiagrams, parents);
+
+	const QStringList askedDiagrams = diagrams + QStringList({ "Unknown" });
+	const QStringList askedElements = elements + QStringList({ "Missing" });
+	for (const QString &parentDiagram : askedDiagrams) {
+		for (const QString &parent : askedElements) {
+			for (const QString &childDiagram : askedDiagrams) {
+				for (const QString &child : askedElements) {
+					EXPECT_EQ(metadata.isParentOf(parentDiagram, parent, childDiagram, child)
+							, mapIsParentOf(parentsMap, parentDiagram, parent, childDiagram, child))
+							<< qPrintable(parentDiagram + "::" + parent + " of " + childDiagram + "::" + child);
+				}
+			}
+		}
+	}
+
+	EXPECT_TRUE(metadata.isParentOf("First", "Root", "First", "Leaf"));
+	EXPECT_TRUE(metadata.isParentOf("First", "External", "First", "Extended"));
+	EXPECT_TRUE(metadata.isParentOf("Second", "Root", "Second", "ForeignLeaf"));
+	EXPECT_FALSE(metadata.isParentOf("First", "Root", "Second", "Foreign"));
+	EXPECT_FALSE(metadata.isParentOf("Second", "Middle", "Second", "Mixed"));
+}
@@ -0,0 +1,2 @@
+SOURCES += \
+	$$PWD/elementsMetadataTest.cpp \
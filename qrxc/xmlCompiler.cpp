@@ -9,9 +9,11 @@
 #include <qrutils/xmlUtils.h>
 
 #include "editor.h"
+#include "elementsMetadata.h"
 #include "nameNormalizer.h"
 #include "diagram.h"
 #include "type.h"
+#include "graphicType.h"
 #include "edgeType.h"
 #include "nodeType.h"
 #include "portType.h"
@@ -19,6 +21,22 @@
 
 using namespace utils;
 
+/// Writes array initializer values separated by commas, given number of values per line.
+static void generateArrayValues(OutFile &out, const QStringList &values, int valuesPerLine)
+{
+	for (int i = 0; i < values.size(); ++i) {
+		if (i % valuesPerLine == 0) {
+			out() << (i == 0 ? "\t" : ",\n\t");
+		} else {
+			out() << ", ";
+		}
+
+		out() << values[i];
+	}
+
+	out() << "\n";
+}
+
 XmlCompiler::XmlCompiler()
 {
 	mResources = "<!DOCTYPE RCC><RCC version=\"1.0\">\n<qresource>\n";
@@ -52,8 +70,7 @@ bool XmlCompiler::compile(const QString &inputXmlFileName, const QString &source
 
 	mPluginVersion = mEditors[mCurrentEditor]->version();
 
-	generateCode();
-	return true;
+	return generateCode();
 }
 
 Editor* XmlCompiler::loadXmlFile(const QDir &currentDir, const QString &inputXmlFileName)
@@ -97,17 +114,23 @@ Diagram * XmlCompiler::getDiagram(const QString &diagramName)
 	return nullptr;
 }
 
-void XmlCompiler::generateCode()
+bool XmlCompiler::generateCode()
 {
 	if (!mEditors.contains(mCurrentEditor)) {
 		qDebug() << "ERROR: Main editor xml was not loaded, generation aborted";
-		return;
+		return false;
+	}
+
+	if (!collectElements()) {
+		qDebug() << "ERROR: Element names are ambiguous, generation aborted";
+		return false;
 	}
 
 	generateElementClasses();
 	generatePluginHeader();
 	generatePluginSource();
 	generateResourceFile();
+	return true;
 }
 
 void XmlCompiler::addResource(const QString &resourceName)
@@ -222,7 +245,6 @@ void XmlCompiler::generatePluginHeader()
 		<< "\tvirtual void initPropertyMap();\n"
 		<< "\tvirtual void initPropertyDefaultsMap();\n"
 		<< "\tvirtual void initDescriptionMap();\n"
-		<< "\tvirtual void initParentsMap();\n"
 		<< "\tvirtual void initPaletteGroupsMap();\n"
 		<< "\tvirtual void initPaletteGroupsDescriptionMap();\n"
 		<< "\tvirtual void initShallPaletteBeSortedMap();\n"
@@ -238,8 +260,6 @@ void XmlCompiler::generatePluginHeader()
 		<< "\tQMap<QString, QMap<QString, QMap<QString, QString>>> mPropertiesDescriptionMap;\n"
 		<< "\tQMap<QString, QMap<QString, QMap<QString, QString>>> mPropertiesDisplayedNamesMap;\n"
 		<< "\tQMap<QString, QMap<QString, QString>> mElementMouseGesturesMap;\n"
-		<< "\tQMap<QString, QMap<QString, QList<QPair<QString, QString>>>> mParentsMap;  // Maps diagram and element"
-				" to a list of diagram-element pairs of parents (generalization relation).\n"
 		<< "\tQMap<QString, QList<QPair<QString, QStringList>>> mPaletteGroupsMap;  // Maps element`s lists of all "
 				"palette groups.\n"
 		<< "\tQMap<QString, QMap<QString, QString>> mPaletteGroupsDescriptionMap;\n"
@@ -256,6 +276,7 @@ void XmlCompiler::generatePluginSource()
 	OutFile out(fileName);
 
 	generateIncludes(out);
+	generateElementsMetadata(out);
 	generateInitPlugin(out);
 	generateNameMappingsRequests(out);
 	generateGraphicalObjectRequest(out);
@@ -294,6 +315,184 @@ void XmlCompiler::generateIncludes(OutFile &out)
 		<< "}\n\n";
 }
 
+bool XmlCompiler::collectElements()
+{
+	mElements.clear();
+	mElementTypes.clear();
+	mElementDiagrams.clear();
+	mDiagrams.clear();
+
+	const QList<Diagram *> diagrams = mEditors[mCurrentEditor]->diagrams().values();
+	for (int i = 0; i < diagrams.size(); ++i) {
+		mDiagrams << NameNormalizer::normalize(diagrams[i]->name());
+		for (Type * const type : diagrams[i]->types().values()) {
+			// Generated element classes and lookups are named by normalized names only, so two elements with the
+			// same name could not be told apart.
+			const QString name = NameNormalizer::normalize(type->qualifiedName());
+			const int existing = mElements.indexOf(name);
+			if (existing >= 0) {
+				qDebug() << "ERROR: Element" << name << "is defined in diagrams" << mDiagrams[mElementDiagrams[existing]]
+						<< "and" << mDiagrams[i];
+				return false;
+			}
+
+			mElements << name;
+			mElementTypes << type;
+			mElementDiagrams << i;
+		}
+	}
+
+	// Parents from other editors can be asked about in isParentOf(), so they get indices too.
+	const int typesCount = mElementTypes.size();
+	for (int i = 0; i < typesCount; ++i) {
+		const GraphicType * const type = dynamic_cast<GraphicType *>(mElementTypes[i]);
+		if (!type) {
+			continue;
+		}
+
+		for (const QString &parent : type->parentNames()) {
+			if (!mElements.contains(parent)) {
+				mElements << parent;
+				mElementTypes << nullptr;
+				mElementDiagrams << -1;
+			}
+		}
+	}
+
+	return true;
+}
+
+void XmlCompiler::generateElementsMetadata(OutFile &out)
+{
+	QList<QStringList> parents;
+	for (Type * const type : mElementTypes) {
+		const GraphicType * const graphicType = dynamic_cast<GraphicType *>(type);
+		parents << (graphicType ? graphicType->parentNames() : QStringList());
+	}
+
+	const ElementsMetadata metadata(mDiagrams, mElements, mElementDiagrams, parents);
+
+	QStringList names;
+	QStringList nodesOrEdges;
+	QStringList elementDiagrams;
+	for (int i = 0; i < mElements.size(); ++i) {
+		names << "QStringLiteral(\"" + mElements[i] + "\")";
+		nodesOrEdges << QString::number(dynamic_cast<EdgeType *>(mElementTypes[i])
+				? -1
+				: dynamic_cast<NodeType *>(mElementTypes[i]) ? 1 : 0);
+		elementDiagrams << QString::number(mElementDiagrams[i]);
+	}
+
+	QStringList diagramNames;
+	for (const QString &diagram : mDiagrams) {
+		diagramNames << "QStringLiteral(\"" + diagram + "\")";
+	}
+
+	const int ancestorsWords = metadata.ancestors().isEmpty() ? 1 : metadata.ancestors().first().size();
+	QStringList ancestorsRows;
+	for (const QVector<quint32> &words : metadata.ancestors()) {
+		QStringList row;
+		for (const quint32 word : words) {
+			row << QString("0x%1u").arg(word, 8, 16, QChar('0'));
+		}
+
+		ancestorsRows << "{ " + row.join(", ") + " }";
+	}
+
+	QStringList displacementValues;
+	for (const quint32 displacement : metadata.displacements()) {
+		displacementValues << QString::number(displacement) + "u";
+	}
+
+	QStringList slotValues;
+	for (const int slot : metadata.elementSlots()) {
+		slotValues << QString::number(slot);
+	}
+
+	// Tables shall not be empty, so editors without elements get dummy entries that are never looked at.
+	if (mElements.isEmpty()) {
+		names << "QString()";
+		nodesOrEdges << "0";
+		elementDiagrams << "-1";
+		ancestorsRows << "{ 0 }";
+	}
+
+	if (diagramNames.isEmpty()) {
+		diagramNames << "QString()";
+	}
+
+	out() << "namespace metadata {\n\n"
+		<< "/// Elements of the editor and their parents from other editors, in order of tables below.\n"
+		<< "enum class Element\n"
+		<< "{\n"
+		<< "\tnone = -1\n";
+
+	for (const QString &element : mElements) {
+		out() << "\t, " << element << "\n";
+	}
+
+	out() << "};\n\n"
+		<< "/// Perfect hash table from element names to elements.\n"
+		<< "const quint32 bucketsCount = " << QString::number(metadata.displacements().size()) << ";\n"
+		<< "const quint32 displacements[] = {\n";
+	generateArrayValues(out, displacementValues, 16);
+	out() << "};\n\n"
+		<< "const quint32 slotsCount = " << QString::number(metadata.elementSlots().size()) << ";\n"
+		<< "const int elementSlots[] = {\n";
+	generateArrayValues(out, slotValues, 16);
+	out() << "};\n\n"
+		<< "/// (-1) means \"edge\", (+1) means \"node\", 0 means neither of them.\n"
+		<< "const int nodesOrEdges[] = {\n";
+	generateArrayValues(out, nodesOrEdges, 16);
+	out() << "};\n\n"
+		<< "/// Diagrams of elements, -1 for parents from other editors.\n"
+		<< "const int elementDiagrams[] = {\n";
+	generateArrayValues(out, elementDiagrams, 16);
+	out() << "};\n\n"
+		<< "/// Bit matrix of generalization relation closure, bit j of row i is set if element j is a parent of i.\n"
+		<< "const quint32 ancestors[][" << QString::number(ancestorsWords) << "] = {\n";
+	generateArrayValues(out, ancestorsRows, 1);
+	out() << "};\n\n"
+		<< "/// Hash that was used by qrxc to build the perfect hash table.\n"
+		<< "inline quint32 nameHash(const QString &name, quint32 seed)\n"
+		<< "{\n"
+		<< "\tquint32 result = 2166136261u ^ (seed * 2654435761u);\n"
+		<< "\tfor (const QChar &character : name) {\n"
+		<< "\t\tresult = (result ^ character.unicode()) * 16777619u;\n"
+		<< "\t}\n"
+		<< "\n"
+		<< "\treturn result;\n"
+		<< "}\n\n"
+		<< "/// Returns element with given name or Element::none, compares given name with one element name at most.\n"
+		<< "inline Element elementIndex(const QString &element)\n"
+		<< "{\n"
+		<< "\tstatic const QString names[] = {\n";
+	generateArrayValues(out, names, 1);
+	out() << "\t};\n"
+		<< "\n"
+		<< "\tconst quint32 displacement = displacements[nameHash(element, 0) % bucketsCount];\n"
+		<< "\tconst int index = elementSlots[nameHash(element, displacement) % slotsCount];\n"
+		<< "\treturn index >= 0 && names[index] == element ? static_cast<Element>(index) : Element::none;\n"
+		<< "}\n\n"
+		<< "/// Returns true if element is defined in a diagram with given name.\n"
+		<< "inline bool belongsTo(Element element, const QString &diagram)\n"
+		<< "{\n"
+		<< "\tstatic const QString diagramNames[] = {\n";
+	generateArrayValues(out, diagramNames, 1);
+	out() << "\t};\n"
+		<< "\n"
+		<< "\tconst int diagramIndex = elementDiagrams[static_cast<int>(element)];\n"
+		<< "\treturn diagramIndex >= 0 && diagramNames[diagramIndex] == diagram;\n"
+		<< "}\n\n"
+		<< "/// Returns true if ancestor is a parent of element, directly or not.\n"
+		<< "inline bool isAncestor(Element ancestor, Element element)\n"
+		<< "{\n"
+		<< "\tconst int index = static_cast<int>(ancestor);\n"
+		<< "\treturn ancestors[static_cast<int>(element)][index / 32] & (1u << (index % 32));\n"
+		<< "}\n\n"
+		<< "}\n\n";
+}
+
 void XmlCompiler::generateInitPlugin(OutFile &out)
 {
 	out() << "void " << mPluginName << "Plugin::initPlugin()\n{\n"
@@ -302,7 +501,6 @@ void XmlCompiler::generateInitPlugin(OutFile &out)
 		<< "\tinitPropertyMap();\n"
 		<< "\tinitPropertyDefaultsMap();\n"
 		<< "\tinitDescriptionMap();\n"
-		<< "\tinitParentsMap();\n"
 		<< "\tinitPaletteGroupsMap();\n"
 		<< "\tinitPaletteGroupsDescriptionMap();\n"
 		<< "\tinitShallPaletteBeSortedMap();\n"
@@ -316,7 +514,6 @@ void XmlCompiler::generateInitPlugin(OutFile &out)
 	generatePropertyMap(out);
 	generatePropertyDefaultsMap(out);
 	generateDescriptionMappings(out);
-	generateParentsMappings(out);
 	generateShallPaletteBeSorted(out);
 	generateExplosionsMappings(out);
 }
@@ -433,22 +630,6 @@ void XmlCompiler::generateDescriptionMappings(OutFile &out)
 	out() << "}\n\n";
 }
 
-void XmlCompiler::generateParentsMappings(OutFile &out)
-{
-	out() << "void " << mPluginName << "Plugin::initParentsMap()\n"
-		<< "{\n";
-
-	foreach (Diagram *diagram, mEditors[mCurrentEditor]->diagrams().values())
-		foreach (Type *type, diagram->types().values()) {
-			GraphicType *obj = dynamic_cast<GraphicType *>(type);
-			if (obj) {
-				obj->generateParentsMapping(out);
-			}
-		}
-
-	out() << "}\n\n";
-}
-
 void XmlCompiler::generateMouseGestureMap(OutFile &out)
 {
 	out() << "void " << mPluginName << "Plugin::initMouseGestureMap()\n{\n";
@@ -601,7 +782,8 @@ void XmlCompiler::generateNameMappingsRequests(OutFile &out)
 void XmlCompiler::generateGraphicalObjectRequest(OutFile &out)
 {
 	out() << "qReal::ElementImpl* " << mPluginName
-		<< "Plugin::getGraphicalObject(const QString &/*diagram*/, const QString &element) const\n{\n";
+		<< "Plugin::getGraphicalObject(const QString &/*diagram*/, const QString &element) const\n{\n"
+		<< "\tconst metadata::Element index = metadata::elementIndex(element);\n";
 
 	bool isNotFirst = false;
 
@@ -615,7 +797,8 @@ void XmlCompiler::generateGraphicalObjectRequest(OutFile &out)
 			<< "		return nullptr;\n"
 			<< "	}\n";
 	} else {
-		out() << "	Q_ASSERT(!\"Request for creation of an element with unknown name\");\n"
+		out() << "	Q_UNUSED(index);\n"
+			<< "	Q_ASSERT(!\"Request for creation of an element with unknown name\");\n"
 			<< "	return nullptr;\n";
 	}
 	out() << "}\n\n";
@@ -626,15 +809,18 @@ void XmlCompiler::generateIsParentOfRequest(OutFile &out)
 	out() << "bool " << mPluginName << "Plugin::isParentOf(const QString &parentDiagram"
 			 << ", const QString &parentElement, const QString &childDiagram, const QString &childElement) const\n"
 		<< "{\n"
-		<< "\tif (childDiagram == parentDiagram && childElement == parentElement)\n"
-		<< "\t\treturn true;\n"
-		<< "\tif (mParentsMap[childDiagram][childElement].contains(qMakePair(parentDiagram, parentElement)))\n"
+		<< "\tif (childDiagram != parentDiagram) {\n"
+		<< "\t\treturn false;\n"
+		<< "\t}\n"
+		<< "\n"
+		<< "\tif (childElement == parentElement) {\n"
 		<< "\t\treturn true;\n"
-		<< "\ttypedef QPair<QString, QString> StringPair;\n"
-		<< "\tfor (const StringPair &pair : mParentsMap[childDiagram][childElement])\n"
-		<< "\t\tif (isParentOf(parentDiagram, parentElement, pair.first, pair.second))\n"
-		<< "\t\t\treturn true;\n"
-		<< "\treturn false;\n"
+		<< "\t}\n"
+		<< "\n"
+		<< "\tconst metadata::Element child = metadata::elementIndex(childElement);\n"
+		<< "\tconst metadata::Element parent = metadata::elementIndex(parentElement);\n"
+		<< "\treturn child != metadata::Element::none && parent != metadata::Element::none\n"
+		<< "\t\t\t&& metadata::belongsTo(child, childDiagram) && metadata::isAncestor(parent, child);\n"
 		<< "}\n"
 	;
 }
@@ -644,7 +830,31 @@ void XmlCompiler::generateGetParentsOfRequest(OutFile &out)
 	out() << "QList<QPair<QString, QString> > " << mPluginName << "Plugin::getParentsOf(const QString &diagram"
 		<< ", const QString &element) const\n"
 		<< "{\n"
-		<< "\treturn mParentsMap[diagram][element];\n"
+		<< "\tconst metadata::Element index = metadata::elementIndex(element);\n"
+		<< "\tif (index == metadata::Element::none || !metadata::belongsTo(index, diagram)) {\n"
+		<< "\t\treturn {};\n"
+		<< "\t}\n"
+		<< "\n"
+		<< "\tswitch (index) {\n";
+
+	for (int i = 0; i < mElements.size(); ++i) {
+		const GraphicType * const type = dynamic_cast<GraphicType *>(mElementTypes[i]);
+		if (!type || type->parentNames().isEmpty()) {
+			continue;
+		}
+
+		QStringList parents;
+		for (const QString &parent : type->parentNames()) {
+			parents << "qMakePair(QString(\"" + mDiagrams[mElementDiagrams[i]] + "\"), QString(\"" + parent + "\"))";
+		}
+
+		out() << "\tcase metadata::Element::" << mElements[i] << ":\n"
+			<< "\t\treturn { " << parents.join("\n\t\t\t\t, ") << " };\n";
+	}
+
+	out() << "\tdefault:\n"
+		<< "\t\treturn {};\n"
+		<< "\t}\n"
 		<< "}\n"
 	;
 }
@@ -722,7 +932,8 @@ void XmlCompiler::generateListMethod(OutFile &out, const QString &signature, con
 {
 	out() << "QStringList " << mPluginName << "Plugin::" << signature << " const\n"
 		<< "{\n"
-		<< "\tQStringList result;\n";
+		<< "\tQStringList result;\n"
+		<< "\tconst metadata::Element index = metadata::elementIndex(element);\n";
 
 	bool isNotFirst = false;
 
@@ -731,7 +942,7 @@ void XmlCompiler::generateListMethod(OutFile &out, const QString &signature, con
 			isNotFirst |= generator.generate(type, out, isNotFirst);
 
 	if (!isNotFirst)
-		out() << "\tQ_UNUSED(element);\n";
+		out() << "\tQ_UNUSED(index);\n";
 	out() << "\treturn result;\n"
 		<< "}\n\n";
 }
@@ -742,7 +953,8 @@ void XmlCompiler::generatePossibleEdges(utils::OutFile &out)
 		out() << "QList<QPair<QPair<QString,QString>,QPair<bool,QString> > > " << mPluginName
 			<< "Plugin::getPossibleEdges(const QString &element) const\n"
 			<< "{\n"
-			<< "\tQList<QPair<QPair<QString,QString>,QPair<bool,QString> > > result;\n";
+			<< "\tQList<QPair<QPair<QString,QString>,QPair<bool,QString> > > result;\n"
+			<< "\tconst metadata::Element index = metadata::elementIndex(element);\n";
 	bool isNotFirst = false;
 
 	foreach (Diagram *diagram, mEditors[mCurrentEditor]->diagrams().values())
@@ -750,7 +962,7 @@ void XmlCompiler::generatePossibleEdges(utils::OutFile &out)
 			isNotFirst |= generator.generate(type, out, isNotFirst);
 
 	if (!isNotFirst)
-		out() << "\tQ_UNUSED(element);\n";
+		out() << "\tQ_UNUSED(index);\n";
 		out() << "\treturn result;\n"
 		<< "}\n\n";
 }
@@ -759,30 +971,10 @@ void XmlCompiler::generateNodesAndEdges(utils::OutFile &out)
 {
 	out() << "//(-1) means \"edge\", (+1) means \"node\"\n";
 	out() << "int " << mPluginName << "Plugin::isNodeOrEdge(const QString &element) const\n"
-		<< "{\n";
-	bool isFirst = true;
-	foreach (Diagram *diagram, mEditors[mCurrentEditor]->diagrams().values())
-		foreach (Type* type, diagram->types().values()) {
-			int result = 0;
-			EdgeType* edge = dynamic_cast<EdgeType*>(type);
-			NodeType* node = dynamic_cast<NodeType*>(type);
-			if (edge)
-				result = (-1);
-			else if (node)
-				result = 1;
-
-			if (!isFirst)
-				out() << "\telse ";
-			else {
-				isFirst = false;
-				out() << "\t";
-			}
-			out() << "if (element == \""
-				<< NameNormalizer::normalize(type->qualifiedName())
-				<< "\")\n"
-				<< "\t\treturn " << result << ";\n";
-		}
-	out() << "\treturn 0;\n}\n";
+		<< "{\n"
+		<< "\tconst metadata::Element index = metadata::elementIndex(element);\n"
+		<< "\treturn index == metadata::Element::none ? 0 : metadata::nodesOrEdges[static_cast<int>(index)];\n"
+		<< "}\n";
 }
 
 void XmlCompiler::generateProperties(OutFile &out)
@@ -2,10 +2,12 @@
 
 #include <QtCore/QMap>
 #include <QtCore/QString>
+#include <QtCore/QStringList>
 #include <QtCore/QDir>
 
 class Editor;
 class Diagram;
+class Type;
 
 namespace utils {
 	class OutFile;
@@ -22,18 +24,27 @@ public:
 	void addResource(const QString &resourceName);
 
 private:
-	void generateCode();
+	/// @returns false if generation was aborted.
+	bool generateCode();
 	void generateElementClasses();
 	void generatePluginHeader();
 	void generatePluginSource();
 	void generateIncludes(utils::OutFile &out);
+
+	/// Collects all elements of current editor and assigns them indices used in generated tables.
+	/// @returns false if two types of different diagrams have the same normalized name.
+	bool collectElements();
+
+	/// Generates "metadata" namespace of plugin source: element enumeration, perfect hash from element names to it,
+	/// tables of diagrams, nodes and edges and transitive closure of generalization relation. All tables are
+	/// constant arrays, so plugin does not build them on start.
+	void generateElementsMetadata(utils::OutFile &out);
 	void generateInitPlugin(utils::OutFile &out);
 	void generateNameMappings(utils::OutFile &out);
 	void generateMouseGestureMap(utils::OutFile &out);
 	void generatePropertyMap(utils::OutFile &out);
 	void generatePropertyDefaultsMap(utils::OutFile &out);
 	void generateDescriptionMappings(utils::OutFile &out);
-	void generateParentsMappings(utils::OutFile &out);
 	void generateExplosionsMappings(utils::OutFile &out);
 	void generateNameMappingsRequests(utils::OutFile &out);
 	void generateGraphicalObjectRequest(utils::OutFile &out);
@@ -71,4 +82,17 @@ private:
 	QString mResources;
 	QString mCurrentEditor;
 	QString mSourcesRootFolder;
+
+	/// Normalized names of all types of current editor and of their parents from other editors, in order of their
+	/// indices in generated tables. Names are unique, generation is aborted otherwise.
+	QStringList mElements;
+
+	/// Types corresponding to mElements, nullptr for parents from other editors.
+	QList<Type *> mElementTypes;
+
+	/// Indices of diagrams in mDiagrams corresponding to mElements, -1 for parents from other editors.
+	QList<int> mElementDiagrams;
+
+	/// Normalized names of diagrams of current editor.
+	QStringList mDiagrams;
 };